@@ -36,6 +36,10 @@ using namespace std;
 
 void testTutorialOne();
 
+// Splitting the time range among threads must not change the results of
+// history-free analyses.
+void testParallelAnalyze();
+
 // Test different default activations are respected when activation
 // states are not provided.
 void testTugOfWar(const string& dataFileName, const double& defaultAct);
@@ -49,6 +53,11 @@ int main()
         cout << e.what() << endl; failures.push_back("testTutorialOne");
     }
 
+    try { testParallelAnalyze(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl; failures.push_back("testParallelAnalyze");
+    }
+
     // produce passive force-length curve
     try { testTugOfWar("Tug_of_War_ConstantVelocity.sto", 0.01); }
     catch (const std::exception& e) {
@@ -104,6 +113,25 @@ void testTutorialOne() {
     cout << "testAnalyzeTutorialOne passed" << endl;
 }
 
+void testParallelAnalyze() {
+    for (int numThreads : {1, 3}) {
+        AnalyzeTool analyze("PlotterTool.xml");
+        analyze.setName("BothLegsThreads" + std::to_string(numThreads));
+        analyze.setNumThreads(numThreads);
+        analyze.run();
+    }
+    for (const std::string& name : {"FiberLength", "Length", "TendonForce"}) {
+        Storage serial("testPlotterTool/BothLegsThreads1__" + name + ".sto");
+        Storage parallel("testPlotterTool/BothLegsThreads3__" + name + ".sto");
+        SimTK_ASSERT_ALWAYS(serial.getSize() == parallel.getSize(),
+                "Parallel analysis has a different number of rows.");
+        CHECK_STORAGE_AGAINST_STANDARD(parallel, serial,
+            std::vector<double>(serial.getSmallestNumberOfStates(), 1e-10),
+            __FILE__, __LINE__, "testParallelAnalyze failed for " + name);
+    }
+    cout << "testParallelAnalyze passed" << endl;
+}
+
 void testTugOfWar(const string& dataFileName, const double& defaultAct) {
     AnalyzeTool analyze("Tug_of_War_Setup_Analyze.xml");
     analyze.setCoordinatesFileName("");
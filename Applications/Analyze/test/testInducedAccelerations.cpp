@@ -29,6 +29,7 @@
 #include <OpenSim/Tools/AnalyzeTool.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 #include <OpenSim/Analyses/InducedAccelerationsSolver.h>
+#include <OpenSim/Analyses/InducedAccelerations.h>
 
 using namespace OpenSim;
 using namespace SimTK;
@@ -37,6 +38,7 @@ using namespace std;
 // Prototypes
 void testDoublePendulumWithSolver();
 void testDoublePendulum();
+void testParallelInducedAccelerations();
 Vector calcDoublePendulumUdot(const Model &model, State &s, double Torq1, double Torq2, bool gravity, bool velocity);
 
 int main()
@@ -57,6 +59,8 @@ int main()
             std::vector<double>(result1.getSmallestNumberOfStates(), 0.15),
             __FILE__, __LINE__, "Induced Accelerations of Running failed");
         cout << "Induced Accelerations of Running passed\n" << endl;
+
+        testParallelInducedAccelerations();
     }
     catch (const OpenSim::Exception& e) {
         e.print(cerr);
@@ -251,3 +255,30 @@ Vector calcDoublePendulumUdot(const Model &model, State &s, double Torq1, double
 
     return s.getUDot();
 }
+
+// Evaluating the contributors on multiple threads must reproduce the serial
+// results.
+void testParallelInducedAccelerations()
+{
+    auto runAnalysis = [&](int numThreads, const std::string& resultsDir) {
+        AnalyzeTool analyze("subject02_Setup_IAA_02_232.xml");
+        analyze.setFinalTime(0.80);
+        analyze.setResultsDir(resultsDir);
+        auto& iaa = dynamic_cast<InducedAccelerations&>(
+                analyze.updAnalysisSet().get("InducedAccelerations"));
+        iaa.setNumThreads(numThreads);
+        analyze.run();
+    };
+
+    runAnalysis(1, "ResultsInducedAccelerationsSerial");
+    runAnalysis(3, "ResultsInducedAccelerationsParallel");
+
+    Storage serial("ResultsInducedAccelerationsSerial/"
+            "subject02_running_arms_InducedAccelerations_center_of_mass.sto");
+    Storage parallel("ResultsInducedAccelerationsParallel/"
+            "subject02_running_arms_InducedAccelerations_center_of_mass.sto");
+    CHECK_STORAGE_AGAINST_STANDARD(parallel, serial,
+        std::vector<double>(serial.getSmallestNumberOfStates(), 1e-8),
+        __FILE__, __LINE__, "Parallel Induced Accelerations failed");
+    cout << "Parallel Induced Accelerations passed\n" << endl;
+}
@@ -42,6 +42,7 @@ void checkMarkersReferenceConsistencyFromTool(InverseKinematicsTool& ik);
 
 void testInverseKinematicsSolverWithOrientations();
 void testInverseKinematicsSolverWithEulerAnglesFromFile();
+void testParallelInverseKinematics();
 
 int main()
 {
@@ -132,6 +133,14 @@ int main()
         failures.push_back("testInverseKinematicsScapulothoracicAbduction");
     }
 
+    try {
+        ++itc;
+        testParallelInverseKinematics();
+    } catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testParallelInverseKinematics");
+    }
+
 
     if (!failures.empty()) {
         cout << "Done, with " << failures.size() << " failure(s) out of ";
@@ -489,3 +498,53 @@ void testInverseKinematicsSolverWithEulerAnglesFromFile()
     const TimeSeriesTable standard("std_subject01_walk1_ik.mot");
     compareMotionTables(report, standard);
 }
+
+void testParallelInverseKinematics()
+{
+    auto runIK = [](int numThreads, int framesPerBlock,
+                         const std::string& name) {
+        InverseKinematicsTool ik("subject01_Setup_InverseKinematics.xml");
+        ik.setNumThreads(numThreads);
+        ik.setFramesPerBlock(framesPerBlock);
+        ik.setOutputMotionFileName("subject01_walk1_ik_" + name + ".mot");
+        ik.run();
+        return TimeSeriesTable(ik.getOutputMotionFileName());
+    };
+    auto checkIdentical = [](const TimeSeriesTable& a,
+                                  const TimeSeriesTable& b) {
+        ASSERT(a.getNumRows() == b.getNumRows());
+        ASSERT(a.getColumnLabels() == b.getColumnLabels());
+        ASSERT(a.getIndependentColumn() == b.getIndependentColumn());
+        const auto& matA = a.getMatrix();
+        const auto& matB = b.getMatrix();
+        for (int i = 0; i < matA.nrow(); ++i) {
+            for (int j = 0; j < matA.ncol(); ++j) {
+                ASSERT(matA(i, j) == matB(i, j));
+            }
+        }
+    };
+
+    const auto serial = runIK(1, 0, "serial");
+
+    // A single block reproduces the serial solution exactly.
+    checkIdentical(serial, runIK(4, 1000, "one_block"));
+
+    // For a given block size, the solution does not depend on the number of
+    // threads. A positive block size is honored even with a single thread.
+    const auto blocks = runIK(1, 12, "blocks_1");
+    for (int numThreads : {2, 3}) {
+        checkIdentical(blocks,
+                runIK(numThreads, 12, "blocks_" + std::to_string(numThreads)));
+    }
+
+    // Restarting the solution at block boundaries stays close to the
+    // regression standard.
+    for (const auto& name : {"blocks_1", "blocks_2"}) {
+        Storage standard("std_subject01_walk1_ik.mot");
+        Storage result("subject01_walk1_ik_" + std::string(name) + ".mot");
+        CHECK_STORAGE_AGAINST_STANDARD(result, standard,
+                std::vector<double>(24, 0.2), __FILE__, __LINE__,
+                "testParallelInverseKinematics failed");
+    }
+    cout << "testParallelInverseKinematics passed" << endl;
+}
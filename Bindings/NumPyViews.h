@@ -0,0 +1,116 @@
+#ifndef OPENSIM_BINDINGS_NUMPY_VIEWS_H_
+#define OPENSIM_BINDINGS_NUMPY_VIEWS_H_
+/* -------------------------------------------------------------------------- *
+ *                           OpenSim:  NumPyViews.h                           *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2020 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+// Helpers for the Python bindings to expose memory owned by OpenSim objects
+// as NumPy arrays without copying. This file is included in the SWIG-generated
+// wrapper code after numpy.i's header code (numpy/arrayobject.h), and relies
+// on each module calling import_array() in its %init block.
+
+#include <OpenSim/Common/TimeSeriesTable.h>
+
+#include <vector>
+
+namespace {
+
+/// Create a read-only NumPy array of doubles that refers to the given data
+/// instead of copying it. The array holds a reference to `owner` (the Python
+/// proxy of the object that holds the data). This keeps the data alive only if
+/// the proxy owns the object; if the object is borrowed from another C++
+/// object (e.g., a reporter's table), the array is valid only while that
+/// object exists. Strides are in bytes. Returns nullptr, with a Python
+/// exception set, on failure.
+inline PyObject* createNumPyView(PyObject* owner, const double* data,
+        int nd, npy_intp* dims, npy_intp* strides) {
+    for (int i = 0; i < nd; ++i) {
+        // Empty matrices may not have any storage to refer to.
+        if (dims[i] == 0) return PyArray_ZEROS(nd, dims, NPY_DOUBLE, 0);
+    }
+    PyObject* array = PyArray_New(&PyArray_Type, nd, dims, NPY_DOUBLE,
+            strides, const_cast<double*>(data), 0, NPY_ARRAY_ALIGNED,
+            nullptr);
+    if (!array) return nullptr;
+    Py_INCREF(owner);
+    // This steals the reference to owner, even on failure.
+    if (PyArray_SetBaseObject(reinterpret_cast<PyArrayObject*>(array),
+                owner) < 0) {
+        Py_DECREF(array);
+        return nullptr;
+    }
+    return array;
+}
+
+/// A 1-D view of a std::vector<double> (e.g., the independent column of a
+/// table).
+inline PyObject* createNumPyView(PyObject* owner,
+        const std::vector<double>& vec) {
+    npy_intp dims[1] = {static_cast<npy_intp>(vec.size())};
+    npy_intp strides[1] = {sizeof(double)};
+    return createNumPyView(owner, vec.data(), 1, dims, strides);
+}
+
+/// The distance, in bytes, between two elements of a matrix.
+template <typename T>
+npy_intp byteDistance(const T& first, const T& second) {
+    return reinterpret_cast<const char*>(&second) -
+           reinterpret_cast<const char*>(&first);
+}
+
+/// A (numRows x numColumns) view of the dependent columns of a table of
+/// doubles. The strides are taken from the matrix itself so that we do not
+/// depend on its storage order.
+inline PyObject* createDependentsNumPyView(PyObject* owner,
+        const OpenSim::TimeSeriesTable_<double>& table) {
+    const auto& matrix = table.getMatrix();
+    npy_intp dims[2] = {matrix.nrow(), matrix.ncol()};
+    if (dims[0] == 0 || dims[1] == 0)
+        return createNumPyView(owner, nullptr, 2, dims, nullptr);
+    npy_intp strides[2] = {
+        matrix.nrow() > 1 ? byteDistance(matrix(0, 0), matrix(1, 0))
+                          : matrix.ncol() * npy_intp(sizeof(double)),
+        matrix.ncol() > 1 ? byteDistance(matrix(0, 0), matrix(0, 1))
+                          : matrix.nrow() * npy_intp(sizeof(double))};
+    return createNumPyView(owner, &matrix(0, 0), 2, dims, strides);
+}
+
+/// A (numRows x numColumns x 3) view of the dependent columns of a table of
+/// Vec3s.
+inline PyObject* createDependentsNumPyView(PyObject* owner,
+        const OpenSim::TimeSeriesTable_<SimTK::Vec3>& table) {
+    const auto& matrix = table.getMatrix();
+    npy_intp dims[3] = {matrix.nrow(), matrix.ncol(), 3};
+    if (dims[0] == 0 || dims[1] == 0)
+        return createNumPyView(owner, nullptr, 3, dims, nullptr);
+    const npy_intp eltSize = sizeof(SimTK::Vec3);
+    npy_intp strides[3] = {
+        matrix.nrow() > 1 ? byteDistance(matrix(0, 0), matrix(1, 0))
+                          : matrix.ncol() * eltSize,
+        matrix.ncol() > 1 ? byteDistance(matrix(0, 0), matrix(0, 1))
+                          : matrix.nrow() * eltSize,
+        sizeof(double)};
+    return createNumPyView(owner, &matrix(0, 0)[0], 3, dims, strides);
+}
+
+} // anonymous namespace
+
+#endif // OPENSIM_BINDINGS_NUMPY_VIEWS_H_
@@ -143,6 +143,7 @@
 #include <OpenSim/Simulation/OpenSense/OpenSenseUtilities.h>
 
 #include <OpenSim/Simulation/StatesTrajectory.h>
+#include <OpenSim/Simulation/CompactStatesTrajectory.h>
 #include <OpenSim/Simulation/StatesTrajectoryReporter.h>
 
 #include <OpenSim/Simulation/SimulationUtilities.h>
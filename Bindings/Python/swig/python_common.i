@@ -19,6 +19,15 @@ using namespace OpenSim;
 using namespace SimTK;
 %}
 
+// Add support for converting between NumPy and C arrays (for TimeSeriesTable).
+%include "numpy.i"
+%init %{
+    import_array();
+%}
+%{
+#include <Bindings/NumPyViews.h>
+%}
+
 %include "python_preliminaries.i"
 
 // Tell SWIG about the simbody module.
@@ -167,8 +176,6 @@ note: ## is a "glue" operator: `a ## b` --> `ab`.
 // ====================
 //%include <OpenSim/Common/LoadOpenSimLibrary.h>
 
-// %include "numpy.i"
-
 // Pythonic operators
 // ==================
 // Extend the template Vec class; these methods will apply for all template
@@ -289,6 +296,126 @@ note: ## is a "glue" operator: `a ## b` --> `ab`.
     }
 }
 
+// NumPy access to TimeSeriesTable
+// ===============================
+// The views returned by the methods below refer to the table's memory instead
+// of copying it, and keep the Python object of the table alive for as long as
+// they exist. That keeps the table itself alive only if the Python object owns
+// it: a view of a table that belongs to another object (e.g., the table
+// returned by TableReporter.getTable()) is valid only while that object
+// exists. Use the view of a copy (e.g., TimeSeriesTable(reporter.getTable()))
+// to outlive the owner. A view is read-only; edit the table through
+// updMatrix(), etc. Any operation that changes the number of rows or columns
+// of the table (e.g., appendRow()) may move the table's memory and
+// invalidates existing views.
+%apply (int DIM1, double* IN_ARRAY1) {
+    (int ntime, double* numpytime)
+};
+%apply (int DIM1, int DIM2, double* IN_ARRAY2) {
+    (int nrow, int ncol, double* numpydata)
+};
+%apply (int DIM1, int DIM2, int DIM3, double* IN_ARRAY3) {
+    (int nrow, int ncol, int nvec, double* numpydata)
+};
+%extend OpenSim::TimeSeriesTable_<double> {
+    PyObject* _getIndependentColumnNumPyView(PyObject* owner) const {
+        return createNumPyView(owner, $self->getIndependentColumn());
+    }
+    PyObject* _getDependentsNumPyView(PyObject* owner) const {
+        return createDependentsNumPyView(owner, *$self);
+    }
+    /** Create a table from a 1-D NumPy array of times, a 2-D NumPy array of
+    data (one row per time), and a list of column labels. */
+    static OpenSim::TimeSeriesTable_<double> createFromMat(
+            int ntime, double* numpytime,
+            int nrow, int ncol, double* numpydata,
+            const std::vector<std::string>& labels) {
+        OPENSIM_THROW_IF(ntime != nrow, OpenSim::Exception,
+                "Expected the data to have " + std::to_string(ntime) +
+                " rows (the number of times), but it has " +
+                std::to_string(nrow) + ".");
+        return OpenSim::TimeSeriesTable_<double>(
+                std::vector<double>(numpytime, numpytime + ntime),
+                SimTK::Matrix(nrow, ncol, numpydata), labels);
+    }
+%pythoncode %{
+    def getIndependentColumnNumPyView(self):
+        """A read-only 1-D NumPy array that refers to (does not copy) the
+        times in this table. The view is invalidated if the number of rows in
+        the table changes, or if the table is owned by another object that
+        is deleted."""
+        return self._getIndependentColumnNumPyView(self)
+    def getDependentsNumPyView(self):
+        """A read-only 2-D NumPy array (one row per time) that refers to (does
+        not copy) the data in this table. The view is invalidated if the
+        number of rows or columns in the table changes, or if the table is
+        owned by another object that is deleted."""
+        return self._getDependentsNumPyView(self)
+%}
+};
+%extend OpenSim::TimeSeriesTable_<SimTK::Vec3> {
+    PyObject* _getIndependentColumnNumPyView(PyObject* owner) const {
+        return createNumPyView(owner, $self->getIndependentColumn());
+    }
+    PyObject* _getDependentsNumPyView(PyObject* owner) const {
+        return createDependentsNumPyView(owner, *$self);
+    }
+    /** Create a table from a 1-D NumPy array of times, a 3-D NumPy array of
+    data (one row per time, and 3 elements in the last dimension), and a list
+    of column labels. */
+    static OpenSim::TimeSeriesTable_<SimTK::Vec3> createFromMat(
+            int ntime, double* numpytime,
+            int nrow, int ncol, int nvec, double* numpydata,
+            const std::vector<std::string>& labels) {
+        OPENSIM_THROW_IF(ntime != nrow, OpenSim::Exception,
+                "Expected the data to have " + std::to_string(ntime) +
+                " rows (the number of times), but it has " +
+                std::to_string(nrow) + ".");
+        OPENSIM_THROW_IF(nvec != 3, OpenSim::Exception,
+                "Expected the last dimension of the data to have size 3, "
+                "but it has size " + std::to_string(nvec) + ".");
+        SimTK::Matrix_<SimTK::Vec3> matrix(nrow, ncol);
+        for (int irow = 0; irow < nrow; ++irow) {
+            for (int icol = 0; icol < ncol; ++icol) {
+                matrix(irow, icol) = SimTK::Vec3::getAs(
+                        numpydata + 3 * (irow * ncol + icol));
+            }
+        }
+        return OpenSim::TimeSeriesTable_<SimTK::Vec3>(
+                std::vector<double>(numpytime, numpytime + ntime),
+                matrix, labels);
+    }
+%pythoncode %{
+    def getIndependentColumnNumPyView(self):
+        """A read-only 1-D NumPy array that refers to (does not copy) the
+        times in this table. The view is invalidated if the number of rows in
+        the table changes, or if the table is owned by another object that
+        is deleted."""
+        return self._getIndependentColumnNumPyView(self)
+    def getDependentsNumPyView(self):
+        """A read-only 3-D NumPy array (one row per time, and the 3 elements of
+        each Vec3 along the last dimension) that refers to (does not copy) the
+        data in this table. The view is invalidated if the number of rows or
+        columns in the table changes, or if the table is owned by another
+        object that is deleted."""
+        return self._getDependentsNumPyView(self)
+%}
+};
+
+// Storage keeps each row in a separate array, so its data cannot be viewed
+// without copying. Instead, we copy all the data in one call.
+%extend OpenSim::Storage {
+%pythoncode %{
+    def to_numpy(self):
+        """Copy the times and data of this Storage into NumPy arrays, returned
+        as the tuple (times, data), where data has one row per time."""
+        table = self.exportToTable()
+        # The views keep the (temporary) table alive.
+        return (table.getIndependentColumnNumPyView(),
+                table.getDependentsNumPyView())
+%}
+};
+
 // Include all the OpenSim code.
 // =============================
 %include <Bindings/preliminaries.i>
@@ -247,7 +247,16 @@ namespace SimTK {
                 "Number of rows must be %i.", $self->nrow());
         SimTK_ASSERT1_ALWAYS(ncol == $self->ncol(),
                 "Number of columns must be %i.", $self->ncol());
-        std::copy_n($self->getContiguousScalarData(), nrow * ncol, numpyout);
+        if ($self->hasContiguousData()) {
+            std::copy_n($self->getContiguousScalarData(), nrow * ncol,
+                    numpyout);
+        } else {
+            // E.g., a view of some of the rows of a matrix. The NumPy array
+            // is in column-major order.
+            for (int icol = 0; icol < ncol; ++icol)
+                for (int irow = 0; irow < nrow; ++irow)
+                    numpyout[irow + icol * nrow] = $self->getElt(irow, icol);
+        }
     }
 %pythoncode %{
     def to_numpy(self):
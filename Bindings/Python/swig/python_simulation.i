@@ -22,6 +22,16 @@ using namespace SimTK;
 %ignore OpenSim::Coordinate::setRange;
 
 
+// Add support for converting between NumPy and C arrays (for
+// StatesTrajectory and CompactStatesTrajectory).
+%include "numpy.i"
+%init %{
+    import_array();
+%}
+%{
+#include <Bindings/NumPyViews.h>
+%}
+
 %include "python_preliminaries.i"
 
 // Tell SWIG about the modules we depend on.
@@ -126,6 +136,99 @@ MODEL_ADOPT_HELPER(Controller);
 %}
 };
 
+// NumPy access to states trajectories
+// ===================================
+// The states in a StatesTrajectory are stored separately, so we copy their
+// times and Y vectors into NumPy arrays in a single call. A
+// CompactStatesTrajectory stores them contiguously, so it provides read-only
+// views that refer to (do not copy) its memory and keep the Python object of
+// the trajectory alive. That keeps the trajectory itself alive only if the
+// Python object owns it: views of a trajectory that belongs to another object
+// (e.g., StatesTrajectoryReporter.getCompactStates()) are valid only while
+// that object exists. Appending to a CompactStatesTrajectory may move its
+// memory and invalidates existing views.
+%apply (int DIM1, double* ARGOUT_ARRAY1) {
+    (int n, double* numpyout)
+};
+%apply (int DIM1, int DIM2, double* INPLACE_FARRAY2) {
+    (int nrow, int ncol, double* numpyout)
+};
+%extend OpenSim::StatesTrajectory {
+    void _getTimeMat(int n, double* numpyout) const {
+        SimTK_ASSERT1_ALWAYS(n == (int)$self->getSize(),
+                "Number of times must be %i.", (int)$self->getSize());
+        for (int i = 0; i < n; ++i) numpyout[i] = $self->get(i).getTime();
+    }
+    void _getYMat(int nrow, int ncol, double* numpyout) const {
+        SimTK_ASSERT1_ALWAYS(nrow == (int)$self->getSize(),
+                "Number of rows must be %i.", (int)$self->getSize());
+        for (int irow = 0; irow < nrow; ++irow) {
+            const SimTK::Vector& y = $self->get(irow).getY();
+            SimTK_ASSERT2_ALWAYS(ncol == y.size(),
+                    "State %i has %i state variables, but the number of "
+                    "columns is different.", irow, y.size());
+            // The array is in column-major order.
+            for (int icol = 0; icol < ncol; ++icol)
+                numpyout[irow + icol * nrow] = y[icol];
+        }
+    }
+%pythoncode %{
+    def getTimeMat(self):
+        """Copy the times of all the states into a 1-D NumPy array."""
+        return self._getTimeMat(self.getSize())
+    def getYMat(self):
+        """Copy the Y vectors of all the states into a 2-D NumPy array, with
+        one row per state."""
+        import numpy as np
+        ny = self.get(0).getNY() if self.getSize() else 0
+        mat = np.empty([self.getSize(), ny])
+        self._getYMat(mat)
+        return mat
+%}
+};
+
+%extend OpenSim::CompactStatesTrajectory {
+    PyObject* _getTimesNumPyView(PyObject* owner) const {
+        return createNumPyView(owner, $self->getTimes());
+    }
+    PyObject* _getYNumPyView(PyObject* owner) const {
+        npy_intp dims[2] = {(npy_intp)$self->getSize(), $self->getNumY()};
+        if (dims[0] == 0 || dims[1] == 0)
+            return createNumPyView(owner, nullptr, 2, dims, nullptr);
+        const double* first = &$self->getY(0)[0];
+        npy_intp strides[2] = {
+            dims[0] > 1 ? byteDistance(*first, $self->getY(1)[0])
+                        : dims[1] * npy_intp(sizeof(double)),
+            dims[1] > 1 ? byteDistance(*first, $self->getY(0)[1])
+                        : npy_intp(sizeof(double))};
+        return createNumPyView(owner, first, 2, dims, strides);
+    }
+    const SimTK::State& __getitem__(int i) const {
+        return $self->getState(i);
+    }
+    int __len__() const {
+        return (int)$self->getSize();
+    }
+%pythoncode %{
+    def getTimesNumPyView(self):
+        """A read-only 1-D NumPy array that refers to (does not copy) the
+        times of the states. The view is invalidated by append(), or if the
+        trajectory is owned by another object that is deleted."""
+        return self._getTimesNumPyView(self)
+    def getYNumPyView(self):
+        """A read-only 2-D NumPy array, with one row per state, that refers to
+        (does not copy) the Y vectors of the states. The view is invalidated
+        by append(), or if the trajectory is owned by another object that is
+        deleted."""
+        return self._getYNumPyView(self)
+    def __iter__(self):
+        """Iterate over the states, reconstituting each one in turn. The
+        yielded state is only valid until the next state is reconstituted."""
+        for i in range(self.getSize()):
+            yield self.getState(i)
+%}
+};
+
 // TODO we already made a StdVectorState in simbody.i, but this is required
 // to create type traits for the simulation module. Ideally, we would not need
 // the following line:
@@ -4,6 +4,9 @@ Test DataTable interface.
 import os, unittest
 import opensim as osim
 
+test_dir = os.path.join(os.path.dirname(os.path.abspath(osim.__file__)),
+                        'tests')
+
 class TestDataTable(unittest.TestCase):
     def test_clone(self):
         # Make sure the clone() method works (we have to implement this in a
@@ -564,4 +567,56 @@ class TestDataTable(unittest.TestCase):
                                                  '1_x', '1_y', '1_z',
                                                  '2_x', '2_y', '2_z')
         print(tableDouble)
-        
+
+    def test_TimeSeriesTable_numpy(self):
+        try:
+            import numpy as np
+        except ImportError as e:
+            print("Could not import numpy; skipping test.")
+            return
+
+        times = np.linspace(0, 0.4, 5)
+        data = np.random.rand(5, 3)
+        table = osim.TimeSeriesTable.createFromMat(times, data,
+                                                   ['a', 'b', 'c'])
+        assert table.getNumRows() == 5
+        assert table.getNumColumns() == 3
+        assert table.getColumnLabels() == ('a', 'b', 'c')
+        assert table.getRowAtIndex(3)[1] == data[3, 1]
+
+        timesView = table.getIndependentColumnNumPyView()
+        dataView = table.getDependentsNumPyView()
+        assert np.array_equal(timesView, times)
+        assert np.array_equal(dataView, data)
+        # The views refer to the table's memory.
+        table.updDependentColumnAtIndex(0)[2] = 100
+        assert dataView[2, 0] == 100
+        self.assertRaises(ValueError, dataView.__setitem__, (0, 0), 1)
+        # The views keep the table alive.
+        del table
+        assert np.array_equal(timesView, times)
+        assert dataView[4, 2] == data[4, 2]
+
+        # The number of times must match the number of rows.
+        self.assertRaises(RuntimeError, osim.TimeSeriesTable.createFromMat,
+                          times[:4], data, ['a', 'b', 'c'])
+
+        empty = osim.TimeSeriesTable()
+        assert empty.getDependentsNumPyView().shape == (0, 0)
+        assert empty.getIndependentColumnNumPyView().shape == (0,)
+
+        data = np.random.rand(5, 2, 3)
+        table = osim.TimeSeriesTableVec3.createFromMat(times, data,
+                                                       ['m0', 'm1'])
+        assert table.getNumRows() == 5
+        assert table.getNumColumns() == 2
+        assert table.getRowAtIndex(4)[1][2] == data[4, 1, 2]
+        dataView = table.getDependentsNumPyView()
+        assert dataView.shape == (5, 2, 3)
+        assert np.array_equal(dataView, data)
+
+        sto = osim.Storage(os.path.join(test_dir, 'storage.sto'))
+        stoTimes, stoData = sto.to_numpy()
+        assert stoData.shape == (sto.getSize(),
+                                 sto.getColumnLabels().getSize() - 1)
+        assert stoTimes[-1] == sto.getLastTime()
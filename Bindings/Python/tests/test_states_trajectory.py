@@ -165,4 +165,43 @@ class TestStatesTrajectory(unittest.TestCase):
         for i in range(6):
             assert states[i].getTime() == i * 0.01
 
+    def test_numpy(self):
+        try:
+            import numpy as np
+        except ImportError as e:
+            print("Could not import numpy; skipping test.")
+            return
 
+        model = osim.Model(os.path.join(test_dir,
+            "gait10dof18musc_subject01.osim"))
+        state = model.initSystem()
+        states = osim.StatesTrajectory()
+        compact = osim.CompactStatesTrajectory(model)
+        for i in range(3):
+            state.setTime(0.1 * i)
+            state.updY()[0] = i
+            states.append(state)
+            compact.append(state)
+
+        times = states.getTimeMat()
+        Y = states.getYMat()
+        assert Y.shape == (3, state.getNY())
+        for i in range(3):
+            assert times[i] == states[i].getTime()
+            assert Y[i, 0] == i
+            assert Y[i, -1] == states[i].getY()[state.getNY() - 1]
+
+        timesView = compact.getTimesNumPyView()
+        YView = compact.getYNumPyView()
+        assert np.array_equal(timesView, times)
+        assert np.array_equal(YView, Y)
+        # The views keep the trajectory alive.
+        del compact
+        assert np.array_equal(YView, Y)
+
+        compact = osim.CompactStatesTrajectory(model)
+        assert compact.getYNumPyView().shape[0] == 0
+        compact.append(state)
+        assert len(compact) == 1
+        assert compact[0].getTime() == state.getTime()
+        assert sum(1 for s in compact) == 1
@@ -12,6 +12,7 @@
 %include <OpenSim/Actuators/Millard2012AccelerationMuscle.h>
 %include <OpenSim/Actuators/McKibbenActuator.h>
 %include <OpenSim/Actuators/DeGrooteFregly2016Muscle.h>
+%include <OpenSim/Actuators/DeGrooteFregly2016MuscleBank.h>
 
 %include <OpenSim/Actuators/ModelFactory.h>
 
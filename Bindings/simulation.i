@@ -238,6 +238,7 @@ OpenSim::ModelComponentSet<OpenSim::Controller>;
 // This enables iterating using the getBetween() method.
 %template(IteratorRangeStatesTrajectoryIterator)
     SimTK::IteratorRange<OpenSim::StatesTrajectory::const_iterator>;
+%include <OpenSim/Simulation/CompactStatesTrajectory.h>
 %include <OpenSim/Simulation/StatesTrajectoryReporter.h>
 
 %include <OpenSim/Simulation/SimulationUtilities.h>
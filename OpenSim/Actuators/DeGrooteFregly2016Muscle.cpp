@@ -22,6 +22,7 @@
  * -------------------------------------------------------------------------- */
 
 #include "DeGrooteFregly2016Muscle.h"
+#include "DeGrooteFregly2016MuscleBank.h"
 
 #include <OpenSim/Actuators/Millard2012EquilibriumMuscle.h>
 #include <OpenSim/Actuators/Thelen2003Muscle.h>
@@ -162,6 +163,11 @@ void DeGrooteFregly2016Muscle::extendFinalizeFromProperties() {
            (1.0 + get_tendon_strain_at_one_norm_force() - c2);
     m_isTendonDynamicsExplicit =
             get_tendon_compliance_dynamics_mode() == "explicit";
+
+    // A DeGrooteFregly2016MuscleBank in the model adds this muscle again when
+    // connecting to the model.
+    m_bank.reset();
+    m_bankIndex = -1;
 }
 
 void DeGrooteFregly2016Muscle::extendAddToSystem(
@@ -474,6 +480,11 @@ void DeGrooteFregly2016Muscle::calcMusclePotentialEnergyInfoHelper(
 void DeGrooteFregly2016Muscle::calcMuscleLengthInfo(
         const SimTK::State& s, MuscleLengthInfo& mli) const {
 
+    if (m_bank) {
+        m_bank->calcMuscleLengthInfo(s, m_bankIndex, mli);
+        return;
+    }
+
     const auto& muscleTendonLength = getLength(s);
     SimTK::Real normTendonForce = SimTK::NaN;
     if (!get_ignore_tendon_compliance()) {
@@ -494,6 +505,11 @@ void DeGrooteFregly2016Muscle::calcMuscleLengthInfo(
 void DeGrooteFregly2016Muscle::calcFiberVelocityInfo(
         const SimTK::State& s, FiberVelocityInfo& fvi) const {
 
+    if (m_bank) {
+        m_bank->calcFiberVelocityInfo(s, m_bankIndex, fvi);
+        return;
+    }
+
     const auto& mli = getMuscleLengthInfo(s);
     const auto& muscleTendonVelocity = getLengtheningSpeed(s);
     const auto& activation = getActivation(s);
@@ -521,6 +537,11 @@ void DeGrooteFregly2016Muscle::calcFiberVelocityInfo(
 
 void DeGrooteFregly2016Muscle::calcMuscleDynamicsInfo(
         const SimTK::State& s, MuscleDynamicsInfo& mdi) const {
+    if (m_bank) {
+        m_bank->calcMuscleDynamicsInfo(s, m_bankIndex, mdi);
+        return;
+    }
+
     const auto& activation = getActivation(s);
     SimTK::Real normTendonForce = SimTK::NaN;
     if (!get_ignore_tendon_compliance()) {
@@ -31,6 +31,8 @@
 
 namespace OpenSim {
 
+class DeGrooteFregly2016MuscleBank;
+
 // TODO avoid checking ignore_tendon_compliance() in each function;
 //       might be slow.
 // TODO prohibit fiber length from going below 0.2.
@@ -80,6 +82,9 @@ that support implicit dynamics (i.e. Moco) and cannot be used to perform a
 time-stepping forward simulation with Manager; use explicit mode for 
 time-stepping.
 
+To evaluate all of the DeGrooteFregly2016Muscle%s in a model together rather
+than one at a time, add a DeGrooteFregly2016MuscleBank to the model.
+
 @note Normalized tendon force is bounded in the range [0, 5] in this class.
    The methods getMinNormalizedTendonForce() and 
    getMaxNormalizedTendonForce() provide these bounds for use in custom solvers.
@@ -798,6 +803,8 @@ public:
     /// @}
 
 private:
+    friend class DeGrooteFregly2016MuscleBank;
+
     void constructProperties();
 
     void calcMuscleLengthInfoHelper(const SimTK::Real& muscleTendonLength,
@@ -941,6 +948,11 @@ private:
     SimTK::Real m_kT = SimTK::NaN;
     bool m_isTendonDynamicsExplicit = true;
 
+    // Set by a DeGrooteFregly2016MuscleBank that evaluates this muscle along
+    // with the other muscles in the model.
+    SimTK::ReferencePtr<const DeGrooteFregly2016MuscleBank> m_bank;
+    int m_bankIndex = -1;
+
     // Indices for MuscleDynamicsInfo::userDefinedDynamicsExtras.
     constexpr static int m_mdi_passiveFiberElasticForce = 0;
     constexpr static int m_mdi_passiveFiberDampingForce = 1;
@@ -0,0 +1,600 @@
+/* -------------------------------------------------------------------------- *
+ *                 OpenSim:  DeGrooteFregly2016MuscleBank.cpp                 *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2020 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "DeGrooteFregly2016MuscleBank.h"
+
+using namespace OpenSim;
+
+using M = DeGrooteFregly2016Muscle;
+
+namespace {
+// Columns of the workspace matrix. Each column holds one quantity for all
+// muscles in the bank (Matrix storage is column-major, so each column is a
+// contiguous array).
+enum Column {
+    // Inputs.
+    MuscleTendonLength,
+    MuscleTendonVelocity,
+    Activation,
+    NormTendonForce,
+    NormTendonForceDerivative,
+    // MuscleLengthInfo.
+    NormTendonLength,
+    TendonLength,
+    FiberLengthAlongTendon,
+    FiberLength,
+    NormFiberLength,
+    CosPennationAngle,
+    SinPennationAngle,
+    PennationAngle,
+    PassiveForceLengthMultiplier,
+    ActiveForceLengthMultiplier,
+    // FiberVelocityInfo.
+    ForceVelocityMultiplier,
+    NormFiberVelocity,
+    FiberVelocity,
+    FiberVelocityAlongTendon,
+    TendonVelocity,
+    NormTendonVelocity,
+    PennationAngularVelocity,
+    // MuscleDynamicsInfo.
+    ActiveFiberForce,
+    ConPassiveFiberForce,
+    NonConPassiveFiberForce,
+    FiberForce,
+    FiberStiffness,
+    PartialPennationAnglePartialFiberLength,
+    PartialFiberForceAlongTendonPartialFiberLength,
+    FiberStiffnessAlongTendon,
+    TendonStiffness,
+    PartialTendonForcePartialFiberLength,
+    NumColumns
+};
+} // namespace
+
+void DeGrooteFregly2016MuscleBank::extendConnectToModel(Model& model) {
+    Super::extendConnectToModel(model);
+
+    std::vector<const M*> rigid;
+    std::vector<const M*> explicitTendon;
+    std::vector<const M*> implicitTendon;
+    for (const auto& muscle : model.getComponentList<M>()) {
+        if (muscle.get_ignore_tendon_compliance()) {
+            rigid.push_back(&muscle);
+        } else if (muscle.m_isTendonDynamicsExplicit) {
+            explicitTendon.push_back(&muscle);
+        } else {
+            implicitTendon.push_back(&muscle);
+        }
+    }
+    m_numRigidTendon = (int)rigid.size();
+    m_numExplicitTendon = (int)explicitTendon.size();
+    std::vector<const M*> muscles(rigid);
+    muscles.insert(muscles.end(), explicitTendon.begin(), explicitTendon.end());
+    muscles.insert(muscles.end(), implicitTendon.begin(), implicitTendon.end());
+
+    m_muscles.clear();
+    m_maxIsometricForce.clear();
+    m_optimalFiberLength.clear();
+    m_tendonSlackLength.clear();
+    m_fiberWidth.clear();
+    m_squareFiberWidth.clear();
+    m_maxContractionVelocity.clear();
+    m_kT.clear();
+    m_activeForceWidthScale.clear();
+    m_fiberDamping.clear();
+    m_passiveFiberStrain.clear();
+    m_ignorePassiveFiberForce.clear();
+    m_passiveOffset.clear();
+    m_passiveDenominator.clear();
+    m_passiveDerivativeDenominator.clear();
+
+    for (const M* muscle : muscles) {
+        // The muscles hold on to the bank so that they can defer to it when
+        // their cache is invalid.
+        auto& mutableMuscle = const_cast<M&>(*muscle);
+        mutableMuscle.m_bank.reset(this);
+        mutableMuscle.m_bankIndex = (int)m_muscles.size();
+        m_muscles.emplace_back(muscle);
+
+        m_maxIsometricForce.push_back(muscle->get_max_isometric_force());
+        m_optimalFiberLength.push_back(muscle->get_optimal_fiber_length());
+        m_tendonSlackLength.push_back(muscle->get_tendon_slack_length());
+        m_fiberWidth.push_back(muscle->m_fiberWidth);
+        m_squareFiberWidth.push_back(muscle->m_squareFiberWidth);
+        m_maxContractionVelocity.push_back(
+                muscle->m_maxContractionVelocityInMetersPerSecond);
+        m_kT.push_back(muscle->m_kT);
+        m_activeForceWidthScale.push_back(
+                muscle->get_active_force_width_scale());
+        m_fiberDamping.push_back(muscle->get_fiber_damping());
+        const double e0 = muscle->get_passive_fiber_strain_at_one_norm_force();
+        m_passiveFiberStrain.push_back(e0);
+        m_ignorePassiveFiberForce.push_back(
+                muscle->get_ignore_passive_fiber_force() ? 1 : 0);
+        // These match the terms in calcPassiveForceMultiplier() and
+        // calcPassiveForceMultiplierDerivative().
+        const double offset = exp(M::kPE * (M::m_minNormFiberLength - 1.0) / e0);
+        m_passiveOffset.push_back(offset);
+        m_passiveDenominator.push_back(exp(M::kPE) - offset);
+        m_passiveDerivativeDenominator.push_back(e0 * (exp(M::kPE) - offset));
+    }
+}
+
+void DeGrooteFregly2016MuscleBank::extendAddToSystem(
+        SimTK::MultibodySystem& system) const {
+    Super::extendAddToSystem(system);
+    m_workspaceCV = addCacheVariable("workspace",
+            SimTK::Matrix(getNumMuscles(), NumColumns, SimTK::NaN),
+            SimTK::Stage::Dynamics);
+}
+
+void DeGrooteFregly2016MuscleBank::calcMuscleLengthInfo(
+        const SimTK::State& s, int index, MuscleLengthInfo& mli) const {
+    using SimTK::square;
+    const int n = getNumMuscles();
+    const int numRigid = m_numRigidTendon;
+    auto& ws = updCacheVariableValue(s, m_workspaceCV);
+    auto col = [&ws](Column c) { return &ws(0, c); };
+
+    // Gather.
+    // -------
+    double* muscleTendonLength = col(MuscleTendonLength);
+    double* normTendonForce = col(NormTendonForce);
+    for (int i = 0; i < n; ++i) {
+        muscleTendonLength[i] = m_muscles[i]->getLength(s);
+        normTendonForce[i] = i < numRigid
+                                     ? SimTK::NaN
+                                     : m_muscles[i]->getNormalizedTendonForce(s);
+    }
+
+    // Evaluate.
+    // ---------
+    // See DeGrooteFregly2016Muscle::calcMuscleLengthInfoHelper().
+    const double* tendonSlackLength = m_tendonSlackLength.data();
+    const double* optimalFiberLength = m_optimalFiberLength.data();
+    const double* fiberWidth = m_fiberWidth.data();
+    const double* squareFiberWidth = m_squareFiberWidth.data();
+    const double* kT = m_kT.data();
+    const double* scale = m_activeForceWidthScale.data();
+    const double* e0 = m_passiveFiberStrain.data();
+    const int* ignorePassive = m_ignorePassiveFiberForce.data();
+    const double* passiveOffset = m_passiveOffset.data();
+    const double* passiveDenominator = m_passiveDenominator.data();
+    double* normTendonLength = col(NormTendonLength);
+    double* tendonLength = col(TendonLength);
+    double* fiberLengthAlongTendon = col(FiberLengthAlongTendon);
+    double* fiberLength = col(FiberLength);
+    double* normFiberLength = col(NormFiberLength);
+    double* cosPennationAngle = col(CosPennationAngle);
+    double* sinPennationAngle = col(SinPennationAngle);
+    double* pennationAngle = col(PennationAngle);
+    double* passiveMultiplier = col(PassiveForceLengthMultiplier);
+    double* activeMultiplier = col(ActiveForceLengthMultiplier);
+
+    for (int i = 0; i < numRigid; ++i) { normTendonLength[i] = 1.0; }
+    for (int i = numRigid; i < n; ++i) {
+        normTendonLength[i] =
+                log((1.0 / M::c1) * (normTendonForce[i] + M::c3)) / kT[i] +
+                M::c2;
+    }
+    for (int i = 0; i < n; ++i) {
+        tendonLength[i] = tendonSlackLength[i] * normTendonLength[i];
+        fiberLengthAlongTendon[i] = muscleTendonLength[i] - tendonLength[i];
+        fiberLength[i] = sqrt(square(fiberLengthAlongTendon[i]) +
+                              squareFiberWidth[i]);
+        normFiberLength[i] = fiberLength[i] / optimalFiberLength[i];
+        cosPennationAngle[i] = fiberLengthAlongTendon[i] / fiberLength[i];
+        sinPennationAngle[i] = fiberWidth[i] / fiberLength[i];
+        pennationAngle[i] = asin(sinPennationAngle[i]);
+    }
+    for (int i = 0; i < n; ++i) {
+        const double passive =
+                (exp(M::kPE * (normFiberLength[i] - 1.0) / e0[i]) -
+                        passiveOffset[i]) /
+                passiveDenominator[i];
+        passiveMultiplier[i] = ignorePassive[i] ? 0.0 : passive;
+    }
+    for (int i = 0; i < n; ++i) {
+        const double x = (normFiberLength[i] - 1.0) / scale[i] + 1.0;
+        activeMultiplier[i] =
+                M::calcGaussianLikeCurve(x, M::b11, M::b21, M::b31, M::b41) +
+                M::calcGaussianLikeCurve(x, M::b12, M::b22, M::b32, M::b42) +
+                M::calcGaussianLikeCurve(x, M::b13, M::b23, M::b33, M::b43);
+    }
+
+    // Scatter.
+    // --------
+    for (int i = 0; i < n; ++i) {
+        const auto& muscle = *m_muscles[i];
+        MuscleLengthInfo* out = &mli;
+        if (i != index) {
+            if (muscle.isCacheVariableValid(s, "lengthInfo")) continue;
+            out = &muscle.updMuscleLengthInfo(s);
+        }
+        out->normTendonLength = normTendonLength[i];
+        out->tendonStrain = normTendonLength[i] - 1.0;
+        out->tendonLength = tendonLength[i];
+        out->fiberLengthAlongTendon = fiberLengthAlongTendon[i];
+        out->fiberLength = fiberLength[i];
+        out->normFiberLength = normFiberLength[i];
+        out->cosPennationAngle = cosPennationAngle[i];
+        out->sinPennationAngle = sinPennationAngle[i];
+        out->pennationAngle = pennationAngle[i];
+        out->fiberPassiveForceLengthMultiplier = passiveMultiplier[i];
+        out->fiberActiveForceLengthMultiplier = activeMultiplier[i];
+        if (out->tendonLength < tendonSlackLength[i]) {
+            log_info("DeGrooteFregly2016Muscle '{}' is buckling (length < "
+                     "tendon_slack_length) at time {} s.",
+                    muscle.getName(), s.getTime());
+        }
+        if (i != index) muscle.markCacheVariableValid(s, "lengthInfo");
+    }
+}
+
+void DeGrooteFregly2016MuscleBank::calcFiberVelocityInfo(
+        const SimTK::State& s, int index, FiberVelocityInfo& fvi) const {
+    const int n = getNumMuscles();
+    const int numRigid = m_numRigidTendon;
+    const int explicitEnd = m_numRigidTendon + m_numExplicitTendon;
+    auto& ws = updCacheVariableValue(s, m_workspaceCV);
+    auto col = [&ws](Column c) { return &ws(0, c); };
+
+    // Gather.
+    // -------
+    double* muscleTendonVelocity = col(MuscleTendonVelocity);
+    double* activation = col(Activation);
+    double* normTendonForce = col(NormTendonForce);
+    double* normTendonForceDerivative = col(NormTendonForceDerivative);
+    double* normTendonLength = col(NormTendonLength);
+    double* fiberLengthAlongTendon = col(FiberLengthAlongTendon);
+    double* fiberLength = col(FiberLength);
+    double* cosPennationAngle = col(CosPennationAngle);
+    double* passiveMultiplier = col(PassiveForceLengthMultiplier);
+    double* activeMultiplier = col(ActiveForceLengthMultiplier);
+    for (int i = 0; i < n; ++i) {
+        const auto& muscle = *m_muscles[i];
+        // This evaluates the length info of all muscles on the first call.
+        const auto& mli = muscle.getMuscleLengthInfo(s);
+        normTendonLength[i] = mli.normTendonLength;
+        fiberLengthAlongTendon[i] = mli.fiberLengthAlongTendon;
+        fiberLength[i] = mli.fiberLength;
+        cosPennationAngle[i] = mli.cosPennationAngle;
+        passiveMultiplier[i] = mli.fiberPassiveForceLengthMultiplier;
+        activeMultiplier[i] = mli.fiberActiveForceLengthMultiplier;
+        muscleTendonVelocity[i] = muscle.getLengtheningSpeed(s);
+        activation[i] = muscle.getActivation(s);
+        normTendonForce[i] = SimTK::NaN;
+        normTendonForceDerivative[i] = SimTK::NaN;
+        if (i >= numRigid && i < explicitEnd) {
+            normTendonForce[i] = muscle.getNormalizedTendonForce(s);
+        } else if (i >= explicitEnd) {
+            normTendonForceDerivative[i] =
+                    muscle.getNormalizedTendonForceDerivative(s);
+        }
+    }
+
+    // Evaluate.
+    // ---------
+    // See DeGrooteFregly2016Muscle::calcFiberVelocityInfoHelper().
+    const double* tendonSlackLength = m_tendonSlackLength.data();
+    const double* fiberWidth = m_fiberWidth.data();
+    const double* maxContractionVelocity = m_maxContractionVelocity.data();
+    const double* kT = m_kT.data();
+    double* forceVelocityMultiplier = col(ForceVelocityMultiplier);
+    double* normFiberVelocity = col(NormFiberVelocity);
+    double* fiberVelocity = col(FiberVelocity);
+    double* fiberVelocityAlongTendon = col(FiberVelocityAlongTendon);
+    double* tendonVelocity = col(TendonVelocity);
+    double* normTendonVelocity = col(NormTendonVelocity);
+    double* pennationAngularVelocity = col(PennationAngularVelocity);
+
+    // Explicit tendon compliance dynamics: the fiber velocity follows from the
+    // tendon force.
+    for (int i = numRigid; i < explicitEnd; ++i) {
+        const double normFiberForce = normTendonForce[i] / cosPennationAngle[i];
+        forceVelocityMultiplier[i] =
+                (normFiberForce - passiveMultiplier[i]) /
+                (activation[i] * activeMultiplier[i]);
+        normFiberVelocity[i] =
+                M::calcForceVelocityInverseCurve(forceVelocityMultiplier[i]);
+        fiberVelocity[i] = normFiberVelocity[i] * maxContractionVelocity[i];
+        fiberVelocityAlongTendon[i] = fiberVelocity[i] / cosPennationAngle[i];
+        tendonVelocity[i] =
+                muscleTendonVelocity[i] - fiberVelocityAlongTendon[i];
+        normTendonVelocity[i] = tendonVelocity[i] / tendonSlackLength[i];
+    }
+
+    // Rigid tendon or implicit tendon compliance dynamics: the fiber velocity
+    // follows from the tendon velocity.
+    for (int i = 0; i < numRigid; ++i) { normTendonVelocity[i] = 0.0; }
+    for (int i = explicitEnd; i < n; ++i) {
+        normTendonVelocity[i] =
+                normTendonForceDerivative[i] /
+                (M::c1 * kT[i] * exp(kT[i] * (normTendonLength[i] - M::c2)));
+    }
+    auto fiberVelocityFromTendon = [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            tendonVelocity[i] = tendonSlackLength[i] * normTendonVelocity[i];
+            fiberVelocityAlongTendon[i] =
+                    muscleTendonVelocity[i] - tendonVelocity[i];
+            fiberVelocity[i] =
+                    fiberVelocityAlongTendon[i] * cosPennationAngle[i];
+            normFiberVelocity[i] = fiberVelocity[i] / maxContractionVelocity[i];
+            forceVelocityMultiplier[i] =
+                    M::calcForceVelocityMultiplier(normFiberVelocity[i]);
+        }
+    };
+    fiberVelocityFromTendon(0, numRigid);
+    fiberVelocityFromTendon(explicitEnd, n);
+
+    for (int i = 0; i < n; ++i) {
+        const double tanPennationAngle =
+                fiberWidth[i] / fiberLengthAlongTendon[i];
+        pennationAngularVelocity[i] =
+                -fiberVelocity[i] / fiberLength[i] * tanPennationAngle;
+    }
+
+    // Scatter.
+    // --------
+    for (int i = 0; i < n; ++i) {
+        const auto& muscle = *m_muscles[i];
+        FiberVelocityInfo* out = &fvi;
+        if (i != index) {
+            if (muscle.isCacheVariableValid(s, "velInfo")) continue;
+            out = &muscle.updFiberVelocityInfo(s);
+        }
+        out->fiberForceVelocityMultiplier = forceVelocityMultiplier[i];
+        out->normFiberVelocity = normFiberVelocity[i];
+        out->fiberVelocity = fiberVelocity[i];
+        out->fiberVelocityAlongTendon = fiberVelocityAlongTendon[i];
+        out->tendonVelocity = tendonVelocity[i];
+        out->normTendonVelocity = normTendonVelocity[i];
+        out->pennationAngularVelocity = pennationAngularVelocity[i];
+        if (out->normFiberVelocity < -1.0) {
+            log_info("DeGrooteFregly2016Muscle '{}' is exceeding maximum "
+                     "contraction velocity at time {} s.",
+                    muscle.getName(), s.getTime());
+        }
+        if (i != index) muscle.markCacheVariableValid(s, "velInfo");
+    }
+}
+
+void DeGrooteFregly2016MuscleBank::calcMuscleDynamicsInfo(
+        const SimTK::State& s, int index, MuscleDynamicsInfo& mdi) const {
+    using SimTK::square;
+    const int n = getNumMuscles();
+    const int numRigid = m_numRigidTendon;
+    auto& ws = updCacheVariableValue(s, m_workspaceCV);
+    auto col = [&ws](Column c) { return &ws(0, c); };
+
+    // Gather.
+    // -------
+    double* muscleTendonVelocity = col(MuscleTendonVelocity);
+    double* activation = col(Activation);
+    double* normTendonForce = col(NormTendonForce);
+    double* normTendonLength = col(NormTendonLength);
+    double* fiberLength = col(FiberLength);
+    double* normFiberLength = col(NormFiberLength);
+    double* cosPennationAngle = col(CosPennationAngle);
+    double* sinPennationAngle = col(SinPennationAngle);
+    double* passiveMultiplier = col(PassiveForceLengthMultiplier);
+    double* activeMultiplier = col(ActiveForceLengthMultiplier);
+    double* forceVelocityMultiplier = col(ForceVelocityMultiplier);
+    double* normFiberVelocity = col(NormFiberVelocity);
+    double* fiberVelocity = col(FiberVelocity);
+    double* tendonVelocity = col(TendonVelocity);
+    for (int i = 0; i < n; ++i) {
+        const auto& muscle = *m_muscles[i];
+        const auto& mli = muscle.getMuscleLengthInfo(s);
+        // This evaluates the velocity info of all muscles on the first call.
+        const auto& fvi = muscle.getFiberVelocityInfo(s);
+        normTendonLength[i] = mli.normTendonLength;
+        fiberLength[i] = mli.fiberLength;
+        normFiberLength[i] = mli.normFiberLength;
+        cosPennationAngle[i] = mli.cosPennationAngle;
+        sinPennationAngle[i] = mli.sinPennationAngle;
+        passiveMultiplier[i] = mli.fiberPassiveForceLengthMultiplier;
+        activeMultiplier[i] = mli.fiberActiveForceLengthMultiplier;
+        forceVelocityMultiplier[i] = fvi.fiberForceVelocityMultiplier;
+        normFiberVelocity[i] = fvi.normFiberVelocity;
+        fiberVelocity[i] = fvi.fiberVelocity;
+        tendonVelocity[i] = fvi.tendonVelocity;
+        muscleTendonVelocity[i] = muscle.getLengtheningSpeed(s);
+        activation[i] = muscle.getActivation(s);
+        normTendonForce[i] = i < numRigid
+                                     ? SimTK::NaN
+                                     : muscle.getNormalizedTendonForce(s);
+    }
+
+    // Evaluate.
+    // ---------
+    // See DeGrooteFregly2016Muscle::calcMuscleDynamicsInfoHelper().
+    const double* maxIsometricForce = m_maxIsometricForce.data();
+    const double* optimalFiberLength = m_optimalFiberLength.data();
+    const double* tendonSlackLength = m_tendonSlackLength.data();
+    const double* fiberWidth = m_fiberWidth.data();
+    const double* kT = m_kT.data();
+    const double* scale = m_activeForceWidthScale.data();
+    const double* fiberDamping = m_fiberDamping.data();
+    const double* e0 = m_passiveFiberStrain.data();
+    const int* ignorePassive = m_ignorePassiveFiberForce.data();
+    const double* passiveDerivativeDenominator =
+            m_passiveDerivativeDenominator.data();
+    double* activeFiberForce = col(ActiveFiberForce);
+    double* conPassiveFiberForce = col(ConPassiveFiberForce);
+    double* nonConPassiveFiberForce = col(NonConPassiveFiberForce);
+    double* fiberForce = col(FiberForce);
+    double* fiberStiffness = col(FiberStiffness);
+    double* partialPennationAnglePartialFiberLength =
+            col(PartialPennationAnglePartialFiberLength);
+    double* partialFiberForceAlongTendonPartialFiberLength =
+            col(PartialFiberForceAlongTendonPartialFiberLength);
+    double* fiberStiffnessAlongTendon = col(FiberStiffnessAlongTendon);
+    double* tendonStiffness = col(TendonStiffness);
+    double* partialTendonForcePartialFiberLength =
+            col(PartialTendonForcePartialFiberLength);
+
+    // Fiber force (see calcFiberForce()).
+    for (int i = 0; i < n; ++i) {
+        activeFiberForce[i] = maxIsometricForce[i] *
+                              (activation[i] * activeMultiplier[i] *
+                                      forceVelocityMultiplier[i]);
+        conPassiveFiberForce[i] = maxIsometricForce[i] * passiveMultiplier[i];
+        nonConPassiveFiberForce[i] =
+                maxIsometricForce[i] * fiberDamping[i] * normFiberVelocity[i];
+        fiberForce[i] = activeFiberForce[i] + conPassiveFiberForce[i] +
+                        nonConPassiveFiberForce[i];
+    }
+
+    // Fiber stiffness (see calcFiberStiffness()).
+    for (int i = 0; i < n; ++i) {
+        const double x = (normFiberLength[i] - 1.0) / scale[i] + 1.0;
+        const double activeDerivative =
+                (1.0 / scale[i]) *
+                (M::calcGaussianLikeCurveDerivative(
+                         x, M::b11, M::b21, M::b31, M::b41) +
+                        M::calcGaussianLikeCurveDerivative(
+                                x, M::b12, M::b22, M::b32, M::b42) +
+                        M::calcGaussianLikeCurveDerivative(
+                                x, M::b13, M::b23, M::b33, M::b43));
+        const double passiveDerivative =
+                (M::kPE * exp((M::kPE * (normFiberLength[i] - 1)) / e0[i])) /
+                passiveDerivativeDenominator[i];
+        const double partialNormFiberLengthPartialFiberLength =
+                1.0 / optimalFiberLength[i];
+        const double partialNormActiveForcePartialFiberLength =
+                partialNormFiberLengthPartialFiberLength * activeDerivative;
+        const double partialNormPassiveForcePartialFiberLength =
+                partialNormFiberLengthPartialFiberLength *
+                (ignorePassive[i] ? 0.0 : passiveDerivative);
+        fiberStiffness[i] = maxIsometricForce[i] *
+                            (activation[i] *
+                                            partialNormActiveForcePartialFiberLength *
+                                            forceVelocityMultiplier[i] +
+                                    partialNormPassiveForcePartialFiberLength);
+    }
+
+    // Stiffness along the tendon (see
+    // calcPartialPennationAnglePartialFiberLength(),
+    // calcPartialFiberForceAlongTendonPartialFiberLength(),
+    // calcFiberStiffnessAlongTendon(), and
+    // calcPartialTendonLengthPartialFiberLength()).
+    for (int i = 0; i < n; ++i) {
+        partialPennationAnglePartialFiberLength[i] =
+                (-fiberWidth[i] / square(fiberLength[i])) /
+                sqrt(1.0 - square(fiberWidth[i] / fiberLength[i]));
+        const double partialCosPennationAnglePartialFiberLength =
+                -sinPennationAngle[i] *
+                partialPennationAnglePartialFiberLength[i];
+        partialFiberForceAlongTendonPartialFiberLength[i] =
+                fiberStiffness[i] * cosPennationAngle[i] +
+                fiberForce[i] * partialCosPennationAnglePartialFiberLength;
+        const double partialFiberLengthAlongTendonPartialFiberLength =
+                cosPennationAngle[i] -
+                fiberLength[i] * sinPennationAngle[i] *
+                        partialPennationAnglePartialFiberLength[i];
+        fiberStiffnessAlongTendon[i] =
+                partialFiberForceAlongTendonPartialFiberLength[i] *
+                (1.0 / partialFiberLengthAlongTendonPartialFiberLength);
+    }
+
+    // Tendon stiffness (see calcTendonStiffness()).
+    for (int i = 0; i < numRigid; ++i) {
+        tendonStiffness[i] = SimTK::Infinity;
+    }
+    for (int i = numRigid; i < n; ++i) {
+        tendonStiffness[i] =
+                (maxIsometricForce[i] / tendonSlackLength[i]) *
+                (M::c1 * kT[i] * exp(kT[i] * (normTendonLength[i] - M::c2)));
+    }
+    for (int i = 0; i < n; ++i) {
+        const double partialTendonLengthPartialFiberLength =
+                fiberLength[i] * sinPennationAngle[i] *
+                        partialPennationAnglePartialFiberLength[i] -
+                cosPennationAngle[i];
+        partialTendonForcePartialFiberLength[i] =
+                tendonStiffness[i] * partialTendonLengthPartialFiberLength;
+    }
+
+    // Scatter.
+    // --------
+    for (int i = 0; i < n; ++i) {
+        const auto& muscle = *m_muscles[i];
+        MuscleDynamicsInfo* out = &mdi;
+        if (i != index) {
+            if (muscle.isCacheVariableValid(s, "dynamicsInfo")) continue;
+            out = &muscle.updMuscleDynamicsInfo(s);
+        }
+        const bool rigidTendon = i < numRigid;
+        out->activation = activation[i];
+        out->fiberForce = fiberForce[i];
+        out->activeFiberForce = activeFiberForce[i];
+        out->passiveFiberForce =
+                conPassiveFiberForce[i] + nonConPassiveFiberForce[i];
+        out->normFiberForce = fiberForce[i] / maxIsometricForce[i];
+        out->fiberForceAlongTendon = fiberForce[i] * cosPennationAngle[i];
+        if (rigidTendon) {
+            out->normTendonForce =
+                    out->normFiberForce * cosPennationAngle[i];
+            out->tendonForce = out->fiberForceAlongTendon;
+        } else {
+            out->normTendonForce = normTendonForce[i];
+            out->tendonForce = maxIsometricForce[i] * out->normTendonForce;
+        }
+
+        out->fiberStiffness = fiberStiffness[i];
+        out->fiberStiffnessAlongTendon = fiberStiffnessAlongTendon[i];
+        out->tendonStiffness = tendonStiffness[i];
+        // See calcMuscleStiffness().
+        if (rigidTendon) {
+            out->muscleStiffness = fiberStiffnessAlongTendon[i];
+        } else {
+            out->muscleStiffness =
+                    (fiberStiffnessAlongTendon[i] * tendonStiffness[i]) /
+                    (fiberStiffnessAlongTendon[i] + tendonStiffness[i]);
+        }
+
+        out->fiberActivePower =
+                -(activeFiberForce[i] + nonConPassiveFiberForce[i]) *
+                fiberVelocity[i];
+        out->fiberPassivePower = -conPassiveFiberForce[i] * fiberVelocity[i];
+        out->tendonPower = -out->tendonForce * tendonVelocity[i];
+        out->musclePower = -out->tendonForce * muscleTendonVelocity[i];
+
+        out->userDefinedDynamicsExtras.resize(5);
+        out->userDefinedDynamicsExtras[M::m_mdi_passiveFiberElasticForce] =
+                conPassiveFiberForce[i];
+        out->userDefinedDynamicsExtras[M::m_mdi_passiveFiberDampingForce] =
+                nonConPassiveFiberForce[i];
+        out->userDefinedDynamicsExtras
+                [M::m_mdi_partialPennationAnglePartialFiberLength] =
+                partialPennationAnglePartialFiberLength[i];
+        out->userDefinedDynamicsExtras
+                [M::m_mdi_partialFiberForceAlongTendonPartialFiberLength] =
+                partialFiberForceAlongTendonPartialFiberLength[i];
+        out->userDefinedDynamicsExtras
+                [M::m_mdi_partialTendonForcePartialFiberLength] =
+                partialTendonForcePartialFiberLength[i];
+        if (i != index) muscle.markCacheVariableValid(s, "dynamicsInfo");
+    }
+}
@@ -0,0 +1,113 @@
+#ifndef OPENSIM_DEGROOTEFREGLY2016MUSCLEBANK_H
+#define OPENSIM_DEGROOTEFREGLY2016MUSCLEBANK_H
+/* -------------------------------------------------------------------------- *
+ *                  OpenSim:  DeGrooteFregly2016MuscleBank.h                  *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2020 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "DeGrooteFregly2016Muscle.h"
+
+namespace OpenSim {
+
+/** This component evaluates all of the DeGrooteFregly2016Muscle%s in a model
+together, rather than one muscle at a time. When any muscle in the bank needs
+its MuscleLengthInfo, FiberVelocityInfo, or MuscleDynamicsInfo, the bank
+gathers the inputs for all of its muscles into contiguous arrays, evaluates
+the muscle curves for all muscles in a single pass over these arrays, and
+stores the results in the cache of each muscle. The passes contain no
+per-muscle virtual calls or branches on muscle properties, so that the
+compiler can vectorize them. This is most useful for models with many muscles
+(e.g., Rajagopal2015) that are evaluated many times, as in Moco.
+
+To use the bank, add it to the model:
+@code
+model.addComponent(new DeGrooteFregly2016MuscleBank());
+model.initSystem();
+@endcode
+
+The bank contains the DeGrooteFregly2016Muscle%s that are in the model when
+the model's connections are finalized (e.g., by initSystem()), and it copies
+their properties at that time. The results are identical to those obtained
+without the bank. MusclePotentialEnergyInfo and the functions that take
+muscle quantities as arguments (e.g., calcEquilibriumResidual()) are still
+evaluated one muscle at a time. */
+class OSIMACTUATORS_API DeGrooteFregly2016MuscleBank : public ModelComponent {
+    OpenSim_DECLARE_CONCRETE_OBJECT(
+            DeGrooteFregly2016MuscleBank, ModelComponent);
+
+public:
+    DeGrooteFregly2016MuscleBank() = default;
+
+    /// The number of muscles evaluated by this bank.
+    int getNumMuscles() const { return (int)m_muscles.size(); }
+
+protected:
+    void extendConnectToModel(Model& model) override;
+    void extendAddToSystem(SimTK::MultibodySystem& system) const override;
+
+private:
+    friend class DeGrooteFregly2016Muscle;
+    using MuscleLengthInfo = DeGrooteFregly2016Muscle::MuscleLengthInfo;
+    using FiberVelocityInfo = DeGrooteFregly2016Muscle::FiberVelocityInfo;
+    using MuscleDynamicsInfo = DeGrooteFregly2016Muscle::MuscleDynamicsInfo;
+
+    // Each of these computes the quantity for all muscles in the bank, stores
+    // it in the cache of the muscles whose cache is not yet valid, and
+    // stores it in the provided struct for the muscle with the given index.
+    void calcMuscleLengthInfo(const SimTK::State& s, int index,
+            MuscleLengthInfo& mli) const;
+    void calcFiberVelocityInfo(const SimTK::State& s, int index,
+            FiberVelocityInfo& fvi) const;
+    void calcMuscleDynamicsInfo(const SimTK::State& s, int index,
+            MuscleDynamicsInfo& mdi) const;
+
+    // The muscles are ordered by how they handle tendon compliance: first the
+    // muscles with rigid tendons, then those with explicit tendon compliance
+    // dynamics, then those with implicit tendon compliance dynamics.
+    std::vector<SimTK::ReferencePtr<const DeGrooteFregly2016Muscle>> m_muscles;
+    int m_numRigidTendon = 0;
+    int m_numExplicitTendon = 0;
+
+    // Muscle parameters, in the same order as m_muscles.
+    std::vector<double> m_maxIsometricForce;
+    std::vector<double> m_optimalFiberLength;
+    std::vector<double> m_tendonSlackLength;
+    std::vector<double> m_fiberWidth;
+    std::vector<double> m_squareFiberWidth;
+    std::vector<double> m_maxContractionVelocity;
+    std::vector<double> m_kT;
+    std::vector<double> m_activeForceWidthScale;
+    std::vector<double> m_fiberDamping;
+    std::vector<double> m_passiveFiberStrain;
+    std::vector<int> m_ignorePassiveFiberForce;
+    // Terms of the passive force-length curve that do not depend on fiber
+    // length.
+    std::vector<double> m_passiveOffset;
+    std::vector<double> m_passiveDenominator;
+    std::vector<double> m_passiveDerivativeDenominator;
+
+    // The arrays used during the computations, one column per quantity. These
+    // are in the State so that separate States can be evaluated concurrently.
+    mutable CacheVariable<SimTK::Matrix> m_workspaceCV;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_DEGROOTEFREGLY2016MUSCLEBANK_H
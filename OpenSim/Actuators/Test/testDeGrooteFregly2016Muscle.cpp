@@ -22,6 +22,7 @@
  * -------------------------------------------------------------------------- */
 
 #include <OpenSim/Actuators/DeGrooteFregly2016Muscle.h>
+#include <OpenSim/Actuators/DeGrooteFregly2016MuscleBank.h>
 #include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/STOFileAdapter.h>
 #include <OpenSim/Moco/osimMoco.h>
@@ -31,6 +32,7 @@
 #include <OpenSim/Actuators/CoordinateActuator.h>
 
 #define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
 #include <OpenSim/Auxiliary/catch.hpp>
 
 using namespace OpenSim;
@@ -1085,3 +1087,165 @@ TEST_CASE("DeGrooteFregly2016Muscle basics") {
         CHECK(state.getY()[2] == Approx(0.451));
     }
 }
+
+namespace {
+// Add muscles covering the different configurations of
+// DeGrooteFregly2016Muscle to a model with a single slider joint.
+void addMusclesForBank(Model& model, int numMuscles) {
+    model.setName("muscle_bank");
+    auto* body = new Body("body", 0.5, SimTK::Vec3(0), SimTK::Inertia(0.1));
+    model.addComponent(body);
+    auto* joint = new SliderJoint("joint", model.getGround(), *body);
+    joint->updCoordinate(SliderJoint::Coord::TranslationX).setName("x");
+    model.addComponent(joint);
+    for (int i = 0; i < numMuscles; ++i) {
+        auto* muscle = new DeGrooteFregly2016Muscle();
+        muscle->setName("muscle" + std::to_string(i));
+        muscle->set_max_isometric_force(500 + 100 * i);
+        muscle->set_optimal_fiber_length(0.10 + 0.01 * (i % 5));
+        muscle->set_tendon_slack_length(0.05 + 0.01 * (i % 3));
+        muscle->set_pennation_angle_at_optimal(0.05 * (i % 4));
+        muscle->set_fiber_damping(0.01 * (i % 2));
+        muscle->set_active_force_width_scale(1.0 + 0.5 * (i % 2));
+        muscle->set_ignore_passive_fiber_force(i % 7 == 6);
+        muscle->set_ignore_tendon_compliance(i % 3 == 0);
+        muscle->set_tendon_compliance_dynamics_mode(
+                i % 3 == 2 ? "implicit" : "explicit");
+        muscle->set_ignore_activation_dynamics(i % 6 == 0);
+        muscle->addNewPathPoint("origin", model.updGround(), SimTK::Vec3(0));
+        muscle->addNewPathPoint(
+                "insertion", *body, SimTK::Vec3(0, 0.01 * i, 0));
+        model.addComponent(muscle);
+    }
+}
+} // namespace
+
+TEST_CASE("DeGrooteFregly2016MuscleBank") {
+    const int numMuscles = 12;
+    Model model;
+    addMusclesForBank(model, numMuscles);
+    Model modelWithBank = model;
+    auto* bank = new DeGrooteFregly2016MuscleBank();
+    modelWithBank.addComponent(bank);
+
+    SimTK::State state = model.initSystem();
+    SimTK::State stateWithBank = modelWithBank.initSystem();
+    CHECK(bank->getNumMuscles() == numMuscles);
+
+    const auto check = [](double value, double expected) {
+        // Tendon stiffness is infinite for rigid tendons.
+        if (SimTK::isInf(expected)) {
+            CHECK(value == expected);
+        } else {
+            CHECK(value == Approx(expected).epsilon(1e-12));
+        }
+    };
+
+    for (const double speed : {-0.1, 0.0, 0.2}) {
+        CAPTURE(speed);
+        for (auto* s : {&state, &stateWithBank}) {
+            s->updQ()[0] = 0.18;
+            s->updU()[0] = speed;
+        }
+        for (int i = 2; i < numMuscles; i += 3) {
+            // Muscles in implicit mode.
+            const std::string name = "muscle" + std::to_string(i);
+            const auto deriv = DeGrooteFregly2016Muscle::
+                    getImplicitDynamicsDerivativeName();
+            model.getComponent<DeGrooteFregly2016Muscle>(name)
+                    .setDiscreteVariableValue(state, deriv, 0.5 * speed);
+            modelWithBank.getComponent<DeGrooteFregly2016Muscle>(name)
+                    .setDiscreteVariableValue(stateWithBank, deriv,
+                            0.5 * speed);
+        }
+        model.realizeDynamics(state);
+        modelWithBank.realizeDynamics(stateWithBank);
+
+        // Query the muscles in reverse order so that the bank is not always
+        // invoked by the first muscle.
+        for (int i = numMuscles - 1; i >= 0; --i) {
+            const std::string name = "muscle" + std::to_string(i);
+            CAPTURE(name);
+            const auto& m = model.getComponent<DeGrooteFregly2016Muscle>(name);
+            const auto& b =
+                    modelWithBank.getComponent<DeGrooteFregly2016Muscle>(name);
+            const auto& s = state;
+            const auto& sb = stateWithBank;
+            check(b.getTendonForce(sb), m.getTendonForce(s));
+            check(b.getFiberLength(sb), m.getFiberLength(s));
+            check(b.getPennationAngle(sb), m.getPennationAngle(s));
+            check(b.getTendonLength(sb), m.getTendonLength(s));
+            check(b.getNormalizedFiberLength(sb),
+                    m.getNormalizedFiberLength(s));
+            check(b.getActiveForceLengthMultiplier(sb),
+                    m.getActiveForceLengthMultiplier(s));
+            check(b.getPassiveForceMultiplier(sb),
+                    m.getPassiveForceMultiplier(s));
+            check(b.getFiberVelocity(sb), m.getFiberVelocity(s));
+            check(b.getNormalizedFiberVelocity(sb),
+                    m.getNormalizedFiberVelocity(s));
+            check(b.getTendonVelocity(sb), m.getTendonVelocity(s));
+            check(b.getPennationAngularVelocity(sb),
+                    m.getPennationAngularVelocity(s));
+            check(b.getForceVelocityMultiplier(sb),
+                    m.getForceVelocityMultiplier(s));
+            check(b.getFiberForce(sb), m.getFiberForce(s));
+            check(b.getActiveFiberForce(sb), m.getActiveFiberForce(s));
+            check(b.getPassiveFiberForce(sb), m.getPassiveFiberForce(s));
+            check(b.getPassiveFiberElasticForce(sb),
+                    m.getPassiveFiberElasticForce(s));
+            check(b.getPassiveFiberDampingForce(sb),
+                    m.getPassiveFiberDampingForce(s));
+            check(b.getFiberStiffness(sb), m.getFiberStiffness(s));
+            check(b.getFiberStiffnessAlongTendon(sb),
+                    m.getFiberStiffnessAlongTendon(s));
+            check(b.getTendonStiffness(sb), m.getTendonStiffness(s));
+            check(b.getMuscleStiffness(sb), m.getMuscleStiffness(s));
+            check(b.getFiberActivePower(sb), m.getFiberActivePower(s));
+            check(b.getFiberPassivePower(sb), m.getFiberPassivePower(s));
+            check(b.getTendonPower(sb), m.getTendonPower(s));
+            check(b.getMusclePower(sb), m.getMusclePower(s));
+        }
+        check(modelWithBank.getMultibodySystem()
+                        .getRigidBodyForces(stateWithBank,
+                                SimTK::Stage::Dynamics)[1][1][0],
+                model.getMultibodySystem()
+                        .getRigidBodyForces(state, SimTK::Stage::Dynamics)[1]
+                                                                          [1][0]);
+    }
+
+    SECTION("Copies of the model have their own bank") {
+        Model copy = modelWithBank;
+        copy.initSystem();
+        CHECK(copy.getComponentList<DeGrooteFregly2016MuscleBank>()
+                        .begin()
+                        ->getNumMuscles() == numMuscles);
+    }
+}
+
+TEST_CASE("DeGrooteFregly2016MuscleBank benchmark", "[.benchmark]") {
+    const int numMuscles = 90;
+    Model model;
+    addMusclesForBank(model, numMuscles);
+    Model modelWithBank = model;
+    modelWithBank.addComponent(new DeGrooteFregly2016MuscleBank());
+    SimTK::State state = model.initSystem();
+    SimTK::State stateWithBank = modelWithBank.initSystem();
+    for (auto* s : {&state, &stateWithBank}) {
+        s->updQ()[0] = 0.18;
+        s->updU()[0] = 0.1;
+    }
+
+    // Changing the speed invalidates the muscles' velocity and dynamics
+    // quantities, but not the length quantities.
+    BENCHMARK("per-muscle") {
+        state.updU()[0] = 0.1;
+        model.realizeDynamics(state);
+        return state.getSystemStage();
+    };
+    BENCHMARK("muscle bank") {
+        stateWithBank.updU()[0] = 0.1;
+        modelWithBank.realizeDynamics(stateWithBank);
+        return stateWithBank.getSystemStage();
+    };
+}
@@ -24,11 +24,14 @@
 //=============================================================================
 // INCLUDES
 //=============================================================================
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/IO.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/Model/ExternalForce.h>
 #include "InducedAccelerations.h"
 
+#include <algorithm>
+
 using namespace OpenSim;
 using namespace std;
 
@@ -68,7 +71,8 @@ InducedAccelerations::InducedAccelerations(Model *aModel) :
     _constraintSet((ConstraintSet&)_constraintSetProp.getValueObj()),
     _forceThreshold(_forceThresholdProp.getValueDbl()),
     _computePotentialsOnly(_computePotentialsOnlyProp.getValueBool()),
-    _reportConstraintReactions(_reportConstraintReactionsProp.getValueBool())
+    _reportConstraintReactions(_reportConstraintReactionsProp.getValueBool()),
+    _numThreads(_numThreadsProp.getValueInt())
 {
     // make sure members point to NULL if not valid. 
     setNull();
@@ -96,7 +100,8 @@ InducedAccelerations::InducedAccelerations(const std::string &aFileName):
     _constraintSet((ConstraintSet&)_constraintSetProp.getValueObj()),
     _forceThreshold(_forceThresholdProp.getValueDbl()),
     _computePotentialsOnly(_computePotentialsOnlyProp.getValueBool()),
-    _reportConstraintReactions(_reportConstraintReactionsProp.getValueBool())
+    _reportConstraintReactions(_reportConstraintReactionsProp.getValueBool()),
+    _numThreads(_numThreadsProp.getValueInt())
 {
     setNull();
 
@@ -120,7 +125,8 @@ InducedAccelerations::InducedAccelerations(const InducedAccelerations &aInducedA
     _constraintSet((ConstraintSet&)_constraintSetProp.getValueObj()),
     _forceThreshold(_forceThresholdProp.getValueDbl()),
     _computePotentialsOnly(_computePotentialsOnlyProp.getValueBool()),
-    _reportConstraintReactions(_reportConstraintReactionsProp.getValueBool())
+    _reportConstraintReactions(_reportConstraintReactionsProp.getValueBool()),
+    _numThreads(_numThreadsProp.getValueInt())
 {
     setNull();
     // COPY TYPE AND NAME
@@ -152,6 +158,7 @@ operator=(const InducedAccelerations &aInducedAccelerations)
     _forceThreshold = aInducedAccelerations._forceThreshold;
     _computePotentialsOnly = aInducedAccelerations._computePotentialsOnly;
     _reportConstraintReactions = aInducedAccelerations._reportConstraintReactions;
+    _numThreads = aInducedAccelerations._numThreads;
     _includeCOM = aInducedAccelerations._includeCOM;
     return(*this);
 }
@@ -171,6 +178,7 @@ void InducedAccelerations::setNull()
     _bodyNames[0] = CENTER_OF_MASS_NAME;
     _computePotentialsOnly = false;
     _reportConstraintReactions = false;
+    _numThreads = 1;
     // Analysis does not own contents of these sets
     _coordSet.setMemoryOwner(false);
     _bodySet.setMemoryOwner(false);
@@ -213,6 +221,10 @@ void InducedAccelerations::setupProperties()
     _reportConstraintReactionsProp.setName("report_constraint_reactions");
     _reportConstraintReactionsProp.setComment("Report individual contributions to constraint reactions in addition to accelerations.");
     _propertySet.append(&_reportConstraintReactionsProp);
+
+    _numThreadsProp.setName("num_threads");
+    _numThreadsProp.setComment("Number of threads used to evaluate the contributors at each time (default: 1). Use 0 to use all available hardware threads.");
+    _propertySet.append(&_numThreadsProp);
 }
 
 //=============================================================================
@@ -498,7 +510,6 @@ void InducedAccelerations::setModel(Model &aModel)
  */
 int InducedAccelerations::record(const SimTK::State& s)
 {
-    int nu = _model->getNumSpeeds();
     double aT = s.getTime();
     log_info("time = {}", aT);
 
@@ -531,7 +542,9 @@ int InducedAccelerations::record(const SimTK::State& s)
 
     // Hang on to a state that has the right flags for contact constraints turned on/off
     _model->setPropertiesFromState(s_analysis);
-    // Use this state for the remainder of this step (record)
+    // Use this state for the remainder of this step (record). The contact
+    // points are topology-stage defaults of the constraints, so the topology
+    // is realized here, once for all contributors.
     s_analysis = _model->getMultibodySystem().realizeTopology();
     // DO NOT recreate the system, will lose location of constraint
     _model->initStateWithoutRecreatingSystem(s_analysis);
@@ -539,252 +552,313 @@ int InducedAccelerations::record(const SimTK::State& s)
     //Use same conditions on constraints
     s_analysis.setTime(aT);
 
-    // Cycle through the force contributors to the system acceleration
-    for(int c=0; c< _contributors.getSize(); c++){          
-        //cout << "Solving for contributor: " << _contributors[c] << endl;
-        // Need to be at the dynamics stage to disable a force
-        _model->getMultibodySystem().realize(s_analysis, SimTK::Stage::Dynamics);
-        
-        if(_contributors[c] == "total"){
-            // Set gravity ON
-            _model->getGravityForce().enable(s_analysis);
-
-            // Set the configuration (gen. coords and speeds) of the model.
-            s_analysis.setQ(Q);
-            s_analysis.setU(s.getU());
-            s_analysis.setZ(s.getZ());
-
-            //Make sure all the actuators are on!
-            for(int f=0; f<_model->getActuators().getSize(); f++){
-                _model->updActuators().get(f).setAppliesForce(s_analysis, true);
-            }
+    // The accelerations induced by each contributor (see recordContributor()).
+    const int nContributors = _contributors.getSize();
+    std::vector<Array<double>> accelerations(nContributors);
+
+    // "total" determines which contact constraints are enforced for all of
+    // the other contributors, so it is evaluated first.
+    int first = 0;
+    if(nContributors > 0 && _contributors[0] == "total"){
+        recordContributor(s_analysis, _contributors[0], s, constraintOn,
+                accelerations[0]);
+        first = 1;
+    }
 
-            // Get to  the point where we can evaluate unilateral constraint conditions
-             _model->getMultibodySystem().realize(s_analysis, SimTK::Stage::Acceleration);
+    const int numThreads =
+            std::min(resolveNumThreads(_numThreads), nContributors - first);
 
-            /* *********************************** ERROR CHECKING *******************************
-            SimTK::Vec3 pcom =_model->getMultibodySystem().getMatterSubsystem().calcSystemMassCenterLocationInGround(s_analysis);
-            SimTK::Vec3 vcom =_model->getMultibodySystem().getMatterSubsystem().calcSystemMassCenterVelocityInGround(s_analysis);
-            SimTK::Vec3 acom =_model->getMultibodySystem().getMatterSubsystem().calcSystemMassCenterAccelerationInGround(s_analysis);
+    if(numThreads <= 1){
+        // Cycle through the force contributors to the system acceleration
+        for(int c=first; c<nContributors; c++){
+            recordContributor(s_analysis, _contributors[c], s, constraintOn,
+                    accelerations[c]);
+        }
+    }
+    else{
+        // Realize everything once on this thread so that any data that the
+        // components create on first use is not created by the workers.
+        _model->getMultibodySystem().realize(s_analysis, SimTK::Stage::Acceleration);
 
-            SimTK::Matrix M;
-            _model->getMultibodySystem().getMatterSubsystem().calcM(s_analysis, M);
-            cout << "mass matrix: " << M << endl;
+        // Each worker evaluates a contiguous block of contributors on its own
+        // copy of the state. Every contributor sets all of the state that it
+        // depends on, so the results do not depend on the blocks.
+        parallelFor(numThreads, numThreads, [&](int block, int) {
+            const int n = nContributors - first;
+            const int begin = first + (n*block)/numThreads;
+            const int end = first + (n*(block + 1))/numThreads;
+            SimTK::State s_worker = s_analysis;
+            for(int c=begin; c<end; c++){
+                recordContributor(s_worker, _contributors[c], s,
+                        constraintOn, accelerations[c]);
+            }
+        });
+    }
 
-            SimTK::Inertia sysInertia = _model->getMultibodySystem().getMatterSubsystem().calcSystemCentralInertiaInGround(s_analysis);
-            cout << "system inertia: " << sysInertia << endl;
+    // Gather the accelerations of all contributors, in order.
+    int nc = _coordSet.getSize();
+    int nb = _bodySet.getSize();
+    for(int c=0; c<nContributors; c++){
+        const Array<double>& acc = accelerations[c];
+        int k = 0;
+        for(int i=0; i<nc; i++)
+            _coordIndAccs[i]->append(1, &acc[k++]);
+        for(int i=0; i<nb; i++, k+=6)
+            _bodyIndAccs[i]->append(6, &acc[k]);
+        if(_includeCOM){
+            _comIndAccs.append(3, &acc[k]);
+            k += 3;
+        }
+        if(_reportConstraintReactions){
+            for(; k<acc.getSize(); k++)
+                _constraintReactions.append(acc[k]);
+        }
+    }
 
-            SimTK::SpatialVec sysMomentum =_model->getMultibodySystem().getMatterSubsystem().calcSystemMomentumAboutGroundOrigin(s_analysis);
-            cout << "system momentum: " << sysMomentum << endl;
+    // Set the accelerations of coordinates into their storages
+    for(int i=0; i<nc; i++) {
+        _storeInducedAccelerations[i]->append(aT, _coordIndAccs[i]->getSize(),&(_coordIndAccs[i]->get(0)));
+    }
 
-            const SimTK::Vector &appliedMobilityForces = _model->getMultibodySystem().getMobilityForces(s_analysis, SimTK::Stage::Dynamics);
-            appliedMobilityForces.dump("All Applied Mobility Forces");
-        
-            // Get all applied body forces like those from contact
-            const SimTK::Vector_<SimTK::SpatialVec>& appliedBodyForces = _model->getMultibodySystem().getRigidBodyForces(s_analysis, SimTK::Stage::Dynamics);
-            appliedBodyForces.dump("All Applied Body Forces");
-
-            SimTK::Vector ucUdot;
-            SimTK::Vector_<SimTK::SpatialVec> ucA_GB;
-            _model->getMultibodySystem().getMatterSubsystem().calcAccelerationIgnoringConstraints(s_analysis, appliedMobilityForces, appliedBodyForces, ucUdot, ucA_GB) ;
-            ucUdot.dump("Udots Ignoring Constraints");
-            ucA_GB.dump("Body Accelerations");
-
-            SimTK::Vector_<SimTK::SpatialVec> constraintBodyForces(_constraintSet.getSize(), SimTK::SpatialVec(SimTK::Vec3(0)));
-            SimTK::Vector constraintMobilityForces(0);
-
-            int nc = _model->getMultibodySystem().getMatterSubsystem().getNumConstraints();
-            for (SimTK::ConstraintIndex cx(0); cx < nc; ++cx) {
-                if (!_model->getMultibodySystem().getMatterSubsystem().isConstraintDisabled(s_analysis, cx)){
-                    cout << "Constraint " << cx << " enabled!" << endl;
-                }
-            }
-            //int nMults = _model->getMultibodySystem().getMatterSubsystem().getTotalMultAlloc();
+    // Set the accelerations of bodies into their storages
+    for(int i=0; i<nb; i++) {
+        _storeInducedAccelerations[nc+i]->append(aT, _bodyIndAccs[i]->getSize(),&(_bodyIndAccs[i]->get(0)));
+    }
 
-            for(int i=0; i<constraintOn.getSize(); i++) {
-                if(constraintOn[i])
-                    _constraintSet[i].calcConstraintForces(s_analysis, constraintBodyForces, constraintMobilityForces);
-            }
-            constraintBodyForces.dump("Constraint Body Forces");
-            constraintMobilityForces.dump("Constraint Mobility Forces");
-            // ******************************* end ERROR CHECKING *******************************/
-    
-            for(int i=0; i<constraintOn.getSize(); i++) {
-                _constraintSet.get(i).setIsEnforced(s_analysis,
-                                                    constraintOn[i]);
-                // Make sure we stay at Dynamics so each constraint can evaluate its conditions
-                _model->getMultibodySystem().realize(s_analysis, SimTK::Stage::Acceleration);
-            }
+    // Set the accelerations of system center of mass into a storage
+    if(_includeCOM){
+        _storeInducedAccelerations[nc+nb]->append(aT, _comIndAccs.getSize(), &_comIndAccs[0]);
+    }
+    if(_reportConstraintReactions){
+        _storeConstraintReactions->append(aT, _constraintReactions.getSize(), &_constraintReactions[0]);
+    }
 
-            // This should also push changes to defaults for unilateral conditions
-            _model->setPropertiesFromState(s_analysis);
+    return(0);
+}
 
-        }
-        else if(_contributors[c] == "gravity"){
-            // Set gravity ON
-            _model->updForceSubsystem().setForceIsDisabled(s_analysis, _model->getGravityForce().getForceIndex(), false);
+//_____________________________________________________________________________
+/**
+ * Compute the accelerations induced by one contributor.
+ *
+ * The state is configured for the contributor (gravity, velocities, and which
+ * actuators apply force) and realized to the acceleration stage. The
+ * accelerations of the coordinates, then of the bodies (6 per body), then of
+ * the center of mass (3) if requested, then the constraint reactions if
+ * requested, are stored in accelerations.
+ *
+ * "total" also enforces the contact constraints and updates the model's
+ * defaults from the state; it must be evaluated on the calling thread before
+ * any other contributor. The other contributors only modify s_contributor,
+ * so they can be evaluated concurrently with different states.
+ */
+void InducedAccelerations::recordContributor(SimTK::State& s_contributor,
+        const std::string& contributor, const SimTK::State& s,
+        const Array<bool>& constraintOn, Array<double>& accelerations)
+{
+    int nu = _model->getNumSpeeds();
+    const SimTK::Vector& Q = s.getQ();
+    const Set<Actuator>& actuators = _model->getActuators();
 
-            s_analysis.setQ(Q);
+    accelerations.setSize(0);
 
-            // zero velocity
-            s_analysis.setU(SimTK::Vector(nu,0.0));
-            s_analysis.setZ(s.getZ());
+    //cout << "Solving for contributor: " << contributor << endl;
+    // Need to be at the dynamics stage to disable a force
+    _model->getMultibodySystem().realize(s_contributor, SimTK::Stage::Dynamics);
 
-            // disable actuator forces
-            for(int f=0; f<_model->getActuators().getSize(); f++){
-                _model->updActuators().get(f).setAppliesForce(s_analysis,
-                                                              false);
-            }
-        }
-        else if(_contributors[c] == "velocity"){        
-            // Set gravity off
-            _model->updForceSubsystem().setForceIsDisabled(s_analysis, _model->getGravityForce().getForceIndex(), true);
+    if(contributor == "total"){
+        // Set gravity ON
+        _model->getGravityForce().enable(s_contributor);
 
-            s_analysis.setQ(Q);
+        // Set the configuration (gen. coords and speeds) of the model.
+        s_contributor.setQ(Q);
+        s_contributor.setU(s.getU());
+        s_contributor.setZ(s.getZ());
 
-            // non-zero velocity
-            s_analysis.setU(s.getU());
-            s_analysis.setZ(s.getZ());
-            
-            // zero actuator forces
-            for(int f=0; f<_model->getActuators().getSize(); f++){
-                _model->updActuators().get(f).setAppliesForce(s_analysis,
-                                                              false);
-            }
-            // Set the configuration (gen. coords and speeds) of the model.
-            _model->getMultibodySystem().realize(s_analysis, SimTK::Stage::Velocity);
+        //Make sure all the actuators are on!
+        for(int f=0; f<actuators.getSize(); f++){
+            actuators.get(f).setAppliesForce(s_contributor, true);
         }
-        else{ //The rest are actuators      
-            // Set gravity OFF
-            _model->updForceSubsystem().setForceIsDisabled(s_analysis, _model->getGravityForce().getForceIndex(), true);
-
-            // zero actuator forces
-            for(int f=0; f<_model->getActuators().getSize(); f++){
-                _model->updActuators().get(f).setAppliesForce(s_analysis,
-                                                              false);
-            }
 
-            s_analysis.setQ(Q);
+        // Get to  the point where we can evaluate unilateral constraint conditions
+         _model->getMultibodySystem().realize(s_contributor, SimTK::Stage::Acceleration);
 
-            // zero velocity
-            SimTK::Vector U(nu,0.0);
-            s_analysis.setU(U);
-            s_analysis.setZ(s.getZ());
-            // light up the one actuator who's contribution we are looking for
-            int ai = _model->getActuators().getIndex(_contributors[c]);
-            if(ai<0)
-                throw Exception("InducedAcceleration: ERR- Could not find actuator '"+_contributors[c],__FILE__,__LINE__);
-            
-            Actuator &actuator = _model->getActuators().get(ai);
-            ScalarActuator* act = dynamic_cast<ScalarActuator*>(&actuator);
-            act->setAppliesForce(s_analysis, true);
-            act->overrideActuation(s_analysis, false);
-            Muscle *muscle = dynamic_cast<Muscle *>(&actuator);
-            if(muscle){
-                if(_computePotentialsOnly){
-                    muscle->overrideActuation(s_analysis, true);
-                    muscle->setOverrideActuation(s_analysis, 1.0);
-                }
-            }
-
-            // Set the configuration (gen. coords and speeds) of the model.
-            _model->getMultibodySystem().realize(s_analysis, SimTK::Stage::Model);
-            _model->getMultibodySystem().realize(s_analysis, SimTK::Stage::Velocity);
+        /* *********************************** ERROR CHECKING *******************************
+        SimTK::Vec3 pcom =_model->getMultibodySystem().getMatterSubsystem().calcSystemMassCenterLocationInGround(s_contributor);
+        SimTK::Vec3 vcom =_model->getMultibodySystem().getMatterSubsystem().calcSystemMassCenterVelocityInGround(s_contributor);
+        SimTK::Vec3 acom =_model->getMultibodySystem().getMatterSubsystem().calcSystemMassCenterAccelerationInGround(s_contributor);
 
-        }// End of if to select contributor 
+        SimTK::Matrix M;
+        _model->getMultibodySystem().getMatterSubsystem().calcM(s_contributor, M);
+        cout << "mass matrix: " << M << endl;
 
-        // cout << "Constraint 0 is of "<< _constraintSet[0].getConcreteClassName() << " and should be " << constraintOn[0] << " and is actually " <<  (_constraintSet[0].isDisabled(s_analysis) ? "off" : "on") << endl;
-        // cout << "Constraint 1 is of "<< _constraintSet[1].getConcreteClassName() << " and should be " << constraintOn[1] << " and is actually " <<  (_constraintSet[1].isDisabled(s_analysis) ? "off" : "on") << endl;
+        SimTK::Inertia sysInertia = _model->getMultibodySystem().getMatterSubsystem().calcSystemCentralInertiaInGround(s_contributor);
+        cout << "system inertia: " << sysInertia << endl;
 
-        // After setting the state of the model and applying forces
-        // Compute the derivative of the multibody system (speeds and accelerations)
-        _model->getMultibodySystem().realize(s_analysis, SimTK::Stage::Acceleration);
+        SimTK::SpatialVec sysMomentum =_model->getMultibodySystem().getMatterSubsystem().calcSystemMomentumAboutGroundOrigin(s_contributor);
+        cout << "system momentum: " << sysMomentum << endl;
 
-        // Sanity check that constraints hasn't totally changed the configuration of the model
-        // double error = (Q-s_analysis.getQ()).norm();
-
-        // Report reaction forces for debugging
-        /*
-        SimTK::Vector_<SimTK::SpatialVec> constraintBodyForces(_constraintSet.getSize());
-        SimTK::Vector mobilityForces(0);
+        const SimTK::Vector &appliedMobilityForces = _model->getMultibodySystem().getMobilityForces(s_contributor, SimTK::Stage::Dynamics);
+        appliedMobilityForces.dump("All Applied Mobility Forces");
+        
+        // Get all applied body forces like those from contact
+        const SimTK::Vector_<SimTK::SpatialVec>& appliedBodyForces = _model->getMultibodySystem().getRigidBodyForces(s_contributor, SimTK::Stage::Dynamics);
+        appliedBodyForces.dump("All Applied Body Forces");
+
+        SimTK::Vector ucUdot;
+        SimTK::Vector_<SimTK::SpatialVec> ucA_GB;
+        _model->getMultibodySystem().getMatterSubsystem().calcAccelerationIgnoringConstraints(s_contributor, appliedMobilityForces, appliedBodyForces, ucUdot, ucA_GB) ;
+        ucUdot.dump("Udots Ignoring Constraints");
+        ucA_GB.dump("Body Accelerations");
+
+        SimTK::Vector_<SimTK::SpatialVec> constraintBodyForces(_constraintSet.getSize(), SimTK::SpatialVec(SimTK::Vec3(0)));
+        SimTK::Vector constraintMobilityForces(0);
+
+        int nc = _model->getMultibodySystem().getMatterSubsystem().getNumConstraints();
+        for (SimTK::ConstraintIndex cx(0); cx < nc; ++cx) {
+            if (!_model->getMultibodySystem().getMatterSubsystem().isConstraintDisabled(s_contributor, cx)){
+                cout << "Constraint " << cx << " enabled!" << endl;
+            }
+        }
+        //int nMults = _model->getMultibodySystem().getMatterSubsystem().getTotalMultAlloc();
 
         for(int i=0; i<constraintOn.getSize(); i++) {
             if(constraintOn[i])
-                _constraintSet.get(i).calcConstraintForces(s_analysis, constraintBodyForces, mobilityForces);
-        }*/
+                _constraintSet[i].calcConstraintForces(s_contributor, constraintBodyForces, constraintMobilityForces);
+        }
+        constraintBodyForces.dump("Constraint Body Forces");
+        constraintMobilityForces.dump("Constraint Mobility Forces");
+        // ******************************* end ERROR CHECKING *******************************/
+    
+        for(int i=0; i<constraintOn.getSize(); i++) {
+            _constraintSet.get(i).setIsEnforced(s_contributor,
+                                                constraintOn[i]);
+            // Make sure we stay at Dynamics so each constraint can evaluate its conditions
+            _model->getMultibodySystem().realize(s_contributor, SimTK::Stage::Acceleration);
+        }
 
-        // VARIABLES
-        SimTK::Vec3 vec,angVec;
+        // This should also push changes to defaults for unilateral conditions
+        _model->setPropertiesFromState(s_contributor);
 
-        // Get Accelerations for kinematics of bodies
-        for(int i=0;i<_coordSet.getSize();i++) {
-            double acc = _coordSet.get(i).getAccelerationValue(s_analysis);
+    }
+    else if(contributor == "gravity"){
+        // Set gravity ON
+        _model->getGravityForce().enable(s_contributor);
 
-            if(getInDegrees()) 
-                acc *= SimTK_RADIAN_TO_DEGREE;  
-            _coordIndAccs[i]->append(1, &acc);
-        }
+        s_contributor.setQ(Q);
 
-        // cout << "Input Body Names: "<< _bodyNames << endl;
+        // zero velocity
+        s_contributor.setU(SimTK::Vector(nu,0.0));
+        s_contributor.setZ(s.getZ());
 
-        // Get Accelerations for kinematics of bodies
-        for(int i=0;i<_bodySet.getSize();i++) {
-            Body &body = _bodySet.get(i);
-            // cout << "Body Name: "<< body->getName() << endl;
-            const SimTK::Vec3& com = body.get_mass_center();
-            
-            // Get the body acceleration
-            vec = body.findStationAccelerationInGround(s_analysis, com);
-            angVec = body.getAccelerationInGround(s_analysis)[0];
+        // disable actuator forces
+        for(int f=0; f<actuators.getSize(); f++){
+            actuators.get(f).setAppliesForce(s_contributor, false);
+        }
+    }
+    else if(contributor == "velocity"){        
+        // Set gravity off
+        _model->getGravityForce().disable(s_contributor);
 
-            // CONVERT TO DEGREES?
-            if(getInDegrees()) 
-                angVec *= SimTK_RADIAN_TO_DEGREE;   
+        s_contributor.setQ(Q);
 
-            // FILL KINEMATICS ARRAY
-            _bodyIndAccs[i]->append(3, &vec[0]);
-            _bodyIndAccs[i]->append(3, &angVec[0]);
+        // non-zero velocity
+        s_contributor.setU(s.getU());
+        s_contributor.setZ(s.getZ());
+            
+        // zero actuator forces
+        for(int f=0; f<actuators.getSize(); f++){
+            actuators.get(f).setAppliesForce(s_contributor, false);
         }
+        // Set the configuration (gen. coords and speeds) of the model.
+        _model->getMultibodySystem().realize(s_contributor, SimTK::Stage::Velocity);
+    }
+    else{ //The rest are actuators      
+        // Set gravity OFF
+        _model->getGravityForce().disable(s_contributor);
 
-        // Get Accelerations for kinematics of COM
-        if(_includeCOM){
-            // Get the body acceleration in ground
-            vec = _model->getMultibodySystem().getMatterSubsystem().calcSystemMassCenterAccelerationInGround(s_analysis);
-
-            // FILL KINEMATICS ARRAY
-            _comIndAccs.append(3, &vec[0]);
+        // zero actuator forces
+        for(int f=0; f<actuators.getSize(); f++){
+            actuators.get(f).setAppliesForce(s_contributor, false);
         }
 
-        // Get induced constraint reactions for contributor
-        if(_reportConstraintReactions){
-            for(int j=0; j<_constraintSet.getSize(); j++){
-                _constraintReactions.append(_constraintSet[j].getRecordValues(s_analysis));
+        s_contributor.setQ(Q);
+
+        // zero velocity
+        SimTK::Vector U(nu,0.0);
+        s_contributor.setU(U);
+        s_contributor.setZ(s.getZ());
+        // light up the one actuator who's contribution we are looking for
+        int ai = actuators.getIndex(contributor);
+        if(ai<0)
+            throw Exception("InducedAcceleration: ERR- Could not find actuator '"+contributor,__FILE__,__LINE__);
+            
+        const Actuator &actuator = actuators.get(ai);
+        const ScalarActuator* act = dynamic_cast<const ScalarActuator*>(&actuator);
+        act->setAppliesForce(s_contributor, true);
+        act->overrideActuation(s_contributor, false);
+        const Muscle *muscle = dynamic_cast<const Muscle *>(&actuator);
+        if(muscle){
+            if(_computePotentialsOnly){
+                muscle->overrideActuation(s_contributor, true);
+                muscle->setOverrideActuation(s_contributor, 1.0);
             }
         }
 
-    } // End cycling through contributors at this time step
+        // Set the configuration (gen. coords and speeds) of the model.
+        _model->getMultibodySystem().realize(s_contributor, SimTK::Stage::Model);
+        _model->getMultibodySystem().realize(s_contributor, SimTK::Stage::Velocity);
 
-    // Set the accelerations of coordinates into their storages
-    int nc = _coordSet.getSize();
-    for(int i=0; i<nc; i++) {
-        _storeInducedAccelerations[i]->append(aT, _coordIndAccs[i]->getSize(),&(_coordIndAccs[i]->get(0)));
+    }// End of if to select contributor 
+
+    // After setting the state of the model and applying forces
+    // Compute the derivative of the multibody system (speeds and accelerations)
+    _model->getMultibodySystem().realize(s_contributor, SimTK::Stage::Acceleration);
+
+    // VARIABLES
+    SimTK::Vec3 vec,angVec;
+
+    // Get Accelerations for kinematics of bodies
+    for(int i=0;i<_coordSet.getSize();i++) {
+        double acc = _coordSet.get(i).getAccelerationValue(s_contributor);
+
+        if(getInDegrees()) 
+            acc *= SimTK_RADIAN_TO_DEGREE;  
+        accelerations.append(acc);
     }
 
-    // Set the accelerations of bodies into their storages
-    int nb = _bodySet.getSize();
-    for(int i=0; i<nb; i++) {
-        _storeInducedAccelerations[nc+i]->append(aT, _bodyIndAccs[i]->getSize(),&(_bodyIndAccs[i]->get(0)));
+    // Get Accelerations for kinematics of bodies
+    for(int i=0;i<_bodySet.getSize();i++) {
+        const Body &body = _bodySet.get(i);
+        const SimTK::Vec3& com = body.get_mass_center();
+            
+        // Get the body acceleration
+        vec = body.findStationAccelerationInGround(s_contributor, com);
+        angVec = body.getAccelerationInGround(s_contributor)[0];
+
+        // CONVERT TO DEGREES?
+        if(getInDegrees()) 
+            angVec *= SimTK_RADIAN_TO_DEGREE;   
+
+        // FILL KINEMATICS ARRAY
+        accelerations.append(3, &vec[0]);
+        accelerations.append(3, &angVec[0]);
     }
 
-    // Set the accelerations of system center of mass into a storage
+    // Get Accelerations for kinematics of COM
     if(_includeCOM){
-        _storeInducedAccelerations[nc+nb]->append(aT, _comIndAccs.getSize(), &_comIndAccs[0]);
+        // Get the body acceleration in ground
+        vec = _model->getMultibodySystem().getMatterSubsystem().calcSystemMassCenterAccelerationInGround(s_contributor);
+
+        // FILL KINEMATICS ARRAY
+        accelerations.append(3, &vec[0]);
     }
+
+    // Get induced constraint reactions for contributor
     if(_reportConstraintReactions){
-        _storeConstraintReactions->append(aT, _constraintReactions.getSize(), &_constraintReactions[0]);
+        for(int j=0; j<_constraintSet.getSize(); j++){
+            accelerations.append(_constraintSet[j].getRecordValues(s_contributor));
+        }
     }
-
-    return(0);
 }
 
 /**
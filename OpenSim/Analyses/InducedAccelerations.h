@@ -102,6 +102,10 @@ protected:
     PropertyBool _reportConstraintReactionsProp;
     bool &_reportConstraintReactions;
 
+    /** Number of threads used to evaluate the contributors at each time. */
+    PropertyInt _numThreadsProp;
+    int &_numThreads;
+
     /** Storages for recording induced accelerations for specified coordinates and/or bodies. */
     Array<Storage *> _storeInducedAccelerations;
     Storage* _storeConstraintReactions;
@@ -186,6 +190,13 @@ public:
     //-------------------------------------------------------------------------
     void setModel(Model &aModel) override;
 
+    /** %Set the number of threads used to evaluate the contributors (the
+    actuators, gravity, and velocity) at each time. The default, 1, evaluates
+    them one after the other; 0 uses all available hardware threads. The
+    results do not depend on the number of threads. */
+    void setNumThreads(int numThreads) { _numThreads = numThreads; }
+    int getNumThreads() const { return _numThreads; }
+
     //-------------------------------------------------------------------------
     // INTEGRATION
     //-------------------------------------------------------------------------
@@ -208,6 +219,9 @@ public:
 protected:
     //========================== Internal Methods =============================
     int record(const SimTK::State& s);
+    void recordContributor(SimTK::State& s_contributor,
+            const std::string& contributor, const SimTK::State& s,
+            const Array<bool>& constraintOn, Array<double>& accelerations);
     void constructDescription();
     void assembleContributors();
     Array<std::string> constructColumnLabelsForCoordinate();
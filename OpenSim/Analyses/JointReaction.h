@@ -199,6 +199,9 @@ public:
         printResults(const std::string &aBaseName,const std::string &aDir="",
         double aDT=-1.0,const std::string &aExtension=".sto") override;
 
+    /** The results at each time depend only on the state at that time. */
+    bool isHistoryFree() const override { return true; }
+
 
 protected:
     //========================== Internal Methods =============================
@@ -429,6 +429,7 @@ MuscleAnalysis& MuscleAnalysis::operator=(const MuscleAnalysis &aAnalysis)
 void MuscleAnalysis::setModel(Model& aModel)
 {
     Super::setModel(aModel);
+    _maSolver.reset();
     allocateStorageObjects();
 }
 //_____________________________________________________________________________
@@ -640,24 +641,36 @@ int MuscleAnalysis::record(const SimTK::State& s)
     _musclePowerStore->append(tReal,muscPower.getSize(),&muscPower[0]);
 
     if (_computeMoments){
+        int nq = _momentArmStorageArray.getSize();
+
+        // COMPUTE THE MOMENT ARMS OF ALL MUSCLES ABOUT ALL COORDINATES
+        // in one pass so that constraint coupling is computed once per
+        // coordinate instead of once per muscle-coordinate pair.
+        std::vector<const Coordinate*> coords(nq);
+        for(int i=0; i<nq; i++) {
+            coords[i] = _momentArmStorageArray[i]->q;
+        }
+        std::vector<const GeometryPath*> paths(nm);
+        for(int j=0; j<nm; j++) {
+            paths[j] = &_muscleArray[j]->getGeometryPath();
+        }
+
+        _model->getMultibodySystem().realize(s, s.getSystemStage());
+        if (!_maSolver) _maSolver.reset(new MomentArmSolver(*_model));
+        SimTK::Matrix maMatrix = _maSolver->solve(s, coords, paths);
+
         // LOOP OVER ACTIVE MOMENT ARM STORAGE OBJECTS
-        Coordinate *q = NULL;
         Storage *maStore=NULL, *mStore=NULL;
-        int nq = _momentArmStorageArray.getSize();
         Array<double> ma(0.0,nm),m(0.0,nm);
 
         for(int i=0; i<nq; i++) {
 
-            q = _momentArmStorageArray[i]->q;
             maStore = _momentArmStorageArray[i]->momentArmStore;
             mStore = _momentArmStorageArray[i]->momentStore;
-           
-            // bool locked = q->getLocked(s);
 
-            _model->getMultibodySystem().realize(s, s.getSystemStage());
             // LOOP OVER MUSCLES
             for(int j=0; j<nm; j++) {
-                ma[j] = _muscleArray[j]->computeMomentArm(s,*q);
+                ma[j] = maMatrix(j, i);
                 m[j] = ma[j] * force[j];
             }
             maStore->append(s.getTime(),nm,&ma[0]);
@@ -687,6 +700,9 @@ int MuscleAnalysis::begin(const SimTK::State&s )
 
     allocateStorageObjects();
 
+    // The system may have been rebuilt since the last analysis.
+    _maSolver.reset();
+
     // RESET STORAGE
     Storage *store;
     int size = _storageList.getSize();
@@ -30,6 +30,7 @@
 //=============================================================================
 #include <OpenSim/Simulation/Model/Analysis.h>
 #include <OpenSim/Simulation/Model/Muscle.h>
+#include <OpenSim/Simulation/MomentArmSolver.h>
 #include "osimAnalysesDLL.h"
 
 
@@ -140,6 +141,12 @@ private:
 #endif
     /** Array of active muscles. */
     ArrayPtrs<Muscle> _muscleArray;
+#ifndef SWIG
+    /** Solver used to compute the moment arms of all active muscles about
+    all active coordinates at once. Created on first use and cleared on copy
+    and whenever the model changes. */
+    SimTK::ResetOnCopy<std::unique_ptr<MomentArmSolver> > _maSolver;
+#endif
 
 //=============================================================================
 // METHODS
@@ -240,6 +247,9 @@ public:
     int
         printResults(const std::string &aBaseName,const std::string &aDir="",
         double aDT=-1.0,const std::string &aExtension=".sto") override;
+
+    /** The results at each time depend only on the state at that time. */
+    bool isHistoryFree() const override { return true; }
     /** 
      * Intended for use only by GUI that holds one MuscleAnalysis and keeps changing attributes to generate various plots
      * For all other use cases, the code handles the allocation/deallocation of resources internally.
@@ -0,0 +1,177 @@
+/* -------------------------------------------------------------------------- *
+ *                          OpenSim:  benchMoco.cpp                           *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2020 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+// Benchmarks of a small MocoInverse problem (muscle-driven inverse dynamics of
+// a short window of walking) and of evaluating the reference data of a
+// tracking problem with 100 markers. Run them through the `bench` target,
+// which writes the results to benchMoco.json.
+
+#include <OpenSim/Actuators/ModelOperators.h>
+#include <OpenSim/Common/LoadOpenSimLibrary.h>
+#include <OpenSim/Common/Logger.h>
+#include <OpenSim/Moco/osimMoco.h>
+#include <OpenSim/Simulation/SimbodyEngine/FreeJoint.h>
+
+#include <benchmark/benchmark.h>
+
+using namespace OpenSim;
+
+static void BM_MocoInverse(benchmark::State& bm) {
+    MocoInverse inverse;
+    inverse.setModel(ModelProcessor("subject_walk_armless_18musc.osim") |
+                     ModOpReplaceJointsWithWelds(
+                             {"subtalar_r", "subtalar_l", "mtp_r", "mtp_l"}) |
+                     ModOpReplaceMusclesWithDeGrooteFregly2016() |
+                     ModOpIgnorePassiveFiberForcesDGF() |
+                     ModOpAddExternalLoads(
+                             "subject_walk_armless_external_loads.xml"));
+    inverse.setKinematics(
+            TableProcessor("subject_walk_armless_coordinates.mot") |
+            TabOpLowPassFilter(6));
+    inverse.set_initial_time(0.45);
+    inverse.set_final_time(0.65);
+    inverse.set_kinematics_allow_extra_columns(true);
+    inverse.set_mesh_interval(0.05);
+    inverse.set_constraint_tolerance(1e-4);
+    inverse.set_convergence_tolerance(1e-4);
+    for (auto _ : bm) {
+        const MocoSolution solution = inverse.solve().getMocoSolution();
+        bm.counters["iterations"] = solution.getNumIterations();
+    }
+}
+// Each solve takes seconds; a few repetitions suffice.
+BENCHMARK(BM_MocoInverse)->Unit(benchmark::kSecond)->Iterations(3);
+
+// The tracking benchmarks evaluate the reference at the 101 times of a grid
+// with 50 mesh intervals (Hermite-Simpson), as a solver does for each
+// evaluation of the integrand.
+static const int numMarkers = 100;
+static const int numGridTimes = 101;
+
+static TimeSeriesTableVec3 createMarkerReference() {
+    std::vector<std::string> labels;
+    for (int im = 0; im < numMarkers; ++im) {
+        labels.push_back("marker" + std::to_string(im));
+    }
+    TimeSeriesTableVec3 table;
+    table.setColumnLabels(labels);
+    for (int itime = 0; itime < 201; ++itime) {
+        const double time = 0.005 * itime;
+        SimTK::RowVector_<SimTK::Vec3> row(numMarkers);
+        for (int im = 0; im < numMarkers; ++im) {
+            row[im] = SimTK::Vec3(std::sin(time + 0.1 * im),
+                    std::cos(2 * time - 0.1 * im), 0.01 * im * time);
+        }
+        table.appendRow(time, row);
+    }
+    return table;
+}
+
+static std::vector<double> createGridTimes() {
+    std::vector<double> times;
+    for (int i = 0; i < numGridTimes; ++i) {
+        times.push_back(i / double(numGridTimes - 1));
+    }
+    return times;
+}
+
+// One spline per column, evaluated one at a time (the original approach of
+// the tracking goals).
+static void BM_MarkerReferencePerSpline(benchmark::State& bm) {
+    const GCVSplineSet splines(createMarkerReference().flatten());
+    const auto times = createGridTimes();
+    SimTK::Vector values(splines.getSize());
+    for (auto _ : bm) {
+        for (const double time : times) {
+            const SimTK::Vector timeVec(1, time);
+            for (int i = 0; i < splines.getSize(); ++i) {
+                values[i] = splines[i].calcValue(timeVec);
+            }
+            benchmark::DoNotOptimize(values[0]);
+        }
+    }
+}
+BENCHMARK(BM_MarkerReferencePerSpline)->Unit(benchmark::kMicrosecond);
+
+// All splines evaluated together.
+static void BM_MarkerReferenceBatched(benchmark::State& bm) {
+    const GCVSplineSet splines(createMarkerReference().flatten());
+    const auto times = createGridTimes();
+    SimTK::Vector values(splines.getSize());
+    for (auto _ : bm) {
+        for (const double time : times) {
+            splines.calcValues(time, values);
+            benchmark::DoNotOptimize(values[0]);
+        }
+    }
+}
+BENCHMARK(BM_MarkerReferenceBatched)->Unit(benchmark::kMicrosecond);
+
+// Samples cached at the grid times, as in the tracking goals.
+static void BM_MarkerReferenceCached(benchmark::State& bm) {
+    const GCVSplineSet splines(createMarkerReference().flatten());
+    const auto times = createGridTimes();
+    GCVSplineSetSampleCache cache;
+    for (auto _ : bm) {
+        for (const double time : times) {
+            benchmark::DoNotOptimize(cache.getValues(splines, time)[0]);
+        }
+    }
+}
+BENCHMARK(BM_MarkerReferenceCached)->Unit(benchmark::kMicrosecond);
+
+// The integrand of MocoMarkerTrackingGoal, including the marker kinematics.
+static void BM_MocoMarkerTrackingGoal(benchmark::State& bm) {
+    Model model;
+    auto* body = new Body("body", 1, SimTK::Vec3(0), SimTK::Inertia(1));
+    model.addBody(body);
+    model.addJoint(new FreeJoint("joint", model.getGround(), *body));
+    for (int im = 0; im < numMarkers; ++im) {
+        model.addMarker(new Marker("marker" + std::to_string(im), *body,
+                SimTK::Vec3(0.01 * im, 0, 0)));
+    }
+    model.finalizeConnections();
+    SimTK::State state = model.initSystem();
+
+    MocoMarkerTrackingGoal goal;
+    goal.setMarkersReference(
+            MarkersReference(createMarkerReference(), Set<MarkerWeight>()));
+    goal.initializeOnModel(model);
+    const auto times = createGridTimes();
+    for (auto _ : bm) {
+        for (const double time : times) {
+            state.setTime(time);
+            benchmark::DoNotOptimize(
+                    goal.calcIntegrand({time, state, SimTK::Vector()}));
+        }
+    }
+}
+BENCHMARK(BM_MocoMarkerTrackingGoal)->Unit(benchmark::kMicrosecond);
+
+int main(int argc, char** argv) {
+    Logger::setLevel(Logger::Level::Warn);
+    LoadOpenSimLibrary("osimActuators");
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
@@ -0,0 +1,276 @@
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  benchSimulation.cpp                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2020 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+// Benchmarks of the core workflows of the OpenSim API. Run them through the
+// `bench` target, which writes the results to benchSimulation.json; compare
+// the results of two builds with Google Benchmark's tools/compare.py.
+
+#include <OpenSim/Common/ColumnMajorStorage.h>
+#include <OpenSim/Common/LoadOpenSimLibrary.h>
+#include <OpenSim/Common/Logger.h>
+#include <OpenSim/Common/STOFileAdapter.h>
+#include <OpenSim/Common/Storage.h>
+#include <OpenSim/Common/TRCFileAdapter.h>
+#include <OpenSim/Simulation/InverseDynamicsSolver.h>
+#include <OpenSim/Simulation/InverseKinematicsSolver.h>
+#include <OpenSim/Simulation/Manager/Manager.h>
+#include <OpenSim/Simulation/MarkersReference.h>
+#include <OpenSim/Simulation/Model/Model.h>
+
+#include <benchmark/benchmark.h>
+
+using namespace OpenSim;
+
+namespace {
+const std::string gaitModel = "gait10dof18musc_subject01.osim";
+const std::string gaitMarkers = "gait10dof18musc_walk_CRLF_line_ending.trc";
+const std::string gaitCoordinates = "gait10dof18musc_ik_CRLF_line_ending.mot";
+const std::string rajagopalModel = "model_Rajagopal2015_posed.osim";
+const std::string statesFile = "std_subject01_walk1_states.sto";
+
+// Set the coordinate values in `state` from a row of a coordinates table
+// whose angles are in degrees.
+void setCoordinateValues(const Model& model, const TimeSeriesTable& table,
+        int row, SimTK::State& state) {
+    state.setTime(table.getIndependentColumn()[row]);
+    for (const auto& label : table.getColumnLabels()) {
+        if (!model.getCoordinateSet().contains(label)) continue;
+        const Coordinate& coord = model.getCoordinateSet().get(label);
+        double value = table.getDependentColumn(label)[row];
+        if (coord.getMotionType() == Coordinate::Rotational)
+            value *= SimTK_DEGREE_TO_RADIAN;
+        coord.setValue(state, value, false);
+    }
+}
+
+// A Storage the size of a typical analysis output: 10k rows, 300 columns.
+Storage createAnalysisStorage() {
+    const int numRows = 10000;
+    const int numColumns = 300;
+    Storage sto(numRows);
+    Array<std::string> labels("", numColumns + 1);
+    labels[0] = "time";
+    for (int j = 0; j < numColumns; ++j)
+        labels[j + 1] = "c" + std::to_string(j);
+    sto.setColumnLabels(labels);
+    SimTK::Vector row(numColumns);
+    for (int i = 0; i < numRows; ++i) {
+        const double time = 0.001 * i;
+        for (int j = 0; j < numColumns; ++j) row[j] = std::sin(time * (j + 1));
+        sto.append(time, row);
+    }
+    return sto;
+}
+} // namespace
+
+static void BM_LoadModel(benchmark::State& bm, const std::string& file) {
+    for (auto _ : bm) {
+        Model model(file);
+        benchmark::DoNotOptimize(model);
+    }
+}
+BENCHMARK_CAPTURE(BM_LoadModel, gait10dof18musc, gaitModel)
+        ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_LoadModel, Rajagopal2015, rajagopalModel)
+        ->Unit(benchmark::kMillisecond);
+
+static void BM_InitSystem(benchmark::State& bm, const std::string& file) {
+    Model model(file);
+    for (auto _ : bm) {
+        SimTK::State& state = model.initSystem();
+        benchmark::DoNotOptimize(state);
+    }
+}
+BENCHMARK_CAPTURE(BM_InitSystem, gait10dof18musc, gaitModel)
+        ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_InitSystem, Rajagopal2015, rajagopalModel)
+        ->Unit(benchmark::kMillisecond);
+
+// Time realizing a state to Dynamics after its positions change, which is
+// the work done per right-hand side evaluation.
+static void BM_RealizeDynamics(benchmark::State& bm, const std::string& file) {
+    Model model(file);
+    SimTK::State& state = model.initSystem();
+    model.equilibrateMuscles(state);
+    const SimTK::Vector q = state.getQ();
+    for (auto _ : bm) {
+        state.updQ() = q;
+        model.realizeDynamics(state);
+    }
+}
+BENCHMARK_CAPTURE(BM_RealizeDynamics, gait10dof18musc, gaitModel);
+BENCHMARK_CAPTURE(BM_RealizeDynamics, Rajagopal2015, rajagopalModel);
+
+static void BM_EquilibrateMuscles(
+        benchmark::State& bm, const std::string& file) {
+    Model model(file);
+    SimTK::State& state = model.initSystem();
+    const SimTK::Vector y = state.getY();
+    for (auto _ : bm) {
+        state.updY() = y;
+        model.equilibrateMuscles(state);
+    }
+}
+BENCHMARK_CAPTURE(BM_EquilibrateMuscles, gait10dof18musc, gaitModel)
+        ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_EquilibrateMuscles, Rajagopal2015, rajagopalModel)
+        ->Unit(benchmark::kMicrosecond);
+
+// Solve inverse kinematics for one marker frame per iteration, cycling
+// through the frames of a walking trial.
+static void BM_InverseKinematicsFrame(benchmark::State& bm) {
+    Model model(gaitModel);
+    SimTK::State& state = model.initSystem();
+    const TimeSeriesTableVec3 markers(gaitMarkers);
+    const auto& times = markers.getIndependentColumn();
+    auto markersRef = std::make_shared<MarkersReference>(
+            gaitMarkers, Set<MarkerWeight>());
+    SimTK::Array_<CoordinateReference> coordinateRefs;
+    InverseKinematicsSolver ikSolver(
+            model, markersRef, coordinateRefs, SimTK::Infinity);
+    ikSolver.setAccuracy(1e-5);
+    state.updTime() = times[0];
+    ikSolver.assemble(state);
+    size_t frame = 0;
+    for (auto _ : bm) {
+        state.updTime() = times[frame];
+        ikSolver.track(state);
+        frame = (frame + 1) % times.size();
+    }
+    bm.SetItemsProcessed(bm.iterations());
+}
+BENCHMARK(BM_InverseKinematicsFrame)->Unit(benchmark::kMicrosecond);
+
+// Solve inverse dynamics for one frame of coordinates per iteration.
+static void BM_InverseDynamicsFrame(benchmark::State& bm) {
+    Model model(gaitModel);
+    SimTK::State& state = model.initSystem();
+    const TimeSeriesTable coordinates(gaitCoordinates);
+    const int numFrames = (int)coordinates.getNumRows();
+    const SimTK::Vector udot(state.getNU(), 0.0);
+    InverseDynamicsSolver idSolver(model);
+    int frame = 0;
+    for (auto _ : bm) {
+        setCoordinateValues(model, coordinates, frame, state);
+        benchmark::DoNotOptimize(idSolver.solve(state, udot));
+        frame = (frame + 1) % numFrames;
+    }
+    bm.SetItemsProcessed(bm.iterations());
+}
+BENCHMARK(BM_InverseDynamicsFrame)->Unit(benchmark::kMicrosecond);
+
+// Integrate a passive gait model forward; the reported rate is simulated
+// seconds per second of wall time.
+static void BM_ManagerIntegrate(benchmark::State& bm) {
+    Model model(gaitModel);
+    SimTK::State& initialState = model.initSystem();
+    model.equilibrateMuscles(initialState);
+    const double duration = 0.05;
+    for (auto _ : bm) {
+        SimTK::State state = initialState;
+        Manager manager(model);
+        manager.setIntegratorAccuracy(1e-4);
+        manager.initialize(state);
+        benchmark::DoNotOptimize(manager.integrate(duration));
+    }
+    bm.counters["simulated_seconds"] = benchmark::Counter(
+            duration * bm.iterations(), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_ManagerIntegrate)->Unit(benchmark::kMillisecond);
+
+static void BM_ReadSTO(benchmark::State& bm) {
+    for (auto _ : bm) {
+        TimeSeriesTable table(statesFile);
+        benchmark::DoNotOptimize(table);
+    }
+}
+BENCHMARK(BM_ReadSTO)->Unit(benchmark::kMillisecond);
+
+static void BM_WriteSTO(benchmark::State& bm) {
+    const TimeSeriesTable table(statesFile);
+    for (auto _ : bm) {
+        STOFileAdapter::write(table, "benchSimulation_written.sto");
+    }
+    bm.SetItemsProcessed(bm.iterations() * table.getNumRows());
+}
+BENCHMARK(BM_WriteSTO)->Unit(benchmark::kMillisecond);
+
+// Sum every column of an analysis output, through the rows of the Storage or
+// through a ColumnMajorStorage (including the copy into it).
+static void BM_StorageColumns(benchmark::State& bm) {
+    const Storage sto = createAnalysisStorage();
+    const int numColumns = sto.getSmallestNumberOfStates();
+    Array<double> column;
+    for (auto _ : bm) {
+        double sum = 0;
+        for (int j = 0; j < numColumns; ++j) {
+            sto.getDataColumn(j, column);
+            for (int i = 0; i < column.getSize(); ++i) sum += column[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_StorageColumns)->Unit(benchmark::kMillisecond);
+
+static void BM_ColumnMajorStorageColumns(benchmark::State& bm) {
+    const Storage sto = createAnalysisStorage();
+    for (auto _ : bm) {
+        const ColumnMajorStorage columns(sto);
+        double sum = 0;
+        for (int j = 0; j < columns.getNumColumns(); ++j) {
+            const double* data = columns.getColumn(j);
+            for (int i = 0; i < columns.getNumRows(); ++i) sum += data[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_ColumnMajorStorageColumns)->Unit(benchmark::kMillisecond);
+
+static void BM_StorageExportToTable(benchmark::State& bm) {
+    const Storage sto = createAnalysisStorage();
+    for (auto _ : bm) {
+        TimeSeriesTable table = sto.exportToTable();
+        benchmark::DoNotOptimize(table);
+    }
+}
+BENCHMARK(BM_StorageExportToTable)->Unit(benchmark::kMillisecond);
+
+static void BM_StoragePadAndFilter(benchmark::State& bm) {
+    const Storage original = createAnalysisStorage();
+    for (auto _ : bm) {
+        bm.PauseTiming();
+        Storage sto(original);
+        bm.ResumeTiming();
+        sto.pad(original.getSize() / 2);
+        sto.lowpassIIR(6.0);
+    }
+}
+BENCHMARK(BM_StoragePadAndFilter)->Unit(benchmark::kMillisecond);
+
+int main(int argc, char** argv) {
+    Logger::setLevel(Logger::Level::Warn);
+    LoadOpenSimLibrary("osimActuators");
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
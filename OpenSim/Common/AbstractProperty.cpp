@@ -74,6 +74,11 @@ void AbstractProperty::clear() {
     clearValues();
 }
 
+int AbstractProperty::adoptAndAppendValueAsObject(Object*) {
+    throw Exception("AbstractProperty::adoptAndAppendValueAsObject(): "
+                    "property " + getName() + " is not an Object property.");
+}
+
 // Set the use default flag for this property, and propagate that through
 // any contained Objects.
 void AbstractProperty::setAllPropertiesUseDefault(bool shouldUseDefault) {
@@ -214,6 +214,13 @@ public:
     If you already have a heap-allocated object you're willing to give up and
     want to avoid the extra copy, use adoptValueObject(). **/
     virtual void setValueAsObject(const Object& obj, int index=-1) = 0;
+    /** Append a heap-allocated object to the value list of an object
+    property, taking over ownership of it. This throws if this is not an
+    object property, if the object's type can't be stored in this property, or
+    if the list is already of maximum size, in which case the caller keeps
+    ownership of the object.
+    @returns The index assigned to the object in the list. **/
+    virtual int adoptAndAppendValueAsObject(Object* obj);
     // Implementation of these non-virtual templatized methods must be 
     // deferred until the concrete property declarations are known. 
     // See Object.h.
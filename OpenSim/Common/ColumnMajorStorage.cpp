@@ -0,0 +1,123 @@
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  ColumnMajorStorage.cpp                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2020 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "ColumnMajorStorage.h"
+
+#include "Storage.h"
+
+#include <algorithm>
+
+using namespace OpenSim;
+
+ColumnMajorStorage::ColumnMajorStorage(int numColumns, int capacity)
+        : _numColumns(numColumns) {
+    OPENSIM_THROW_IF(numColumns < 0, Exception,
+            "Expected a non-negative number of columns, but got {}.",
+            numColumns);
+    reserve(capacity);
+}
+
+ColumnMajorStorage::ColumnMajorStorage(const Storage& storage, int numColumns)
+        : ColumnMajorStorage(numColumns < 0
+                                     ? std::max(0,
+                                             storage.getSmallestNumberOfStates())
+                                     : numColumns,
+                  storage.getSize()) {
+    for (int i = 0; i < storage.getSize(); ++i) {
+        const StateVector& row = *storage.getStateVector(i);
+        appendRow(row.getTime(), row.getSize(), row.getData().get());
+    }
+}
+
+ColumnMajorStorage::ColumnMajorStorage(const TimeSeriesTable& table)
+        : ColumnMajorStorage((int)table.getNumColumns(),
+                  (int)table.getNumRows()) {
+    const auto& times = table.getIndependentColumn();
+    const auto& matrix = table.getMatrix();
+    _numRows = (int)times.size();
+    std::copy(times.begin(), times.end(), _times.begin());
+    for (int j = 0; j < _numColumns; ++j) {
+        double* column = updColumn(j);
+        for (int i = 0; i < _numRows; ++i) column[i] = matrix(i, j);
+    }
+}
+
+void ColumnMajorStorage::reserve(int capacity) {
+    if (capacity <= _capacity) return;
+    std::vector<double> data((size_t)capacity * _numColumns);
+    for (int j = 0; j < _numColumns; ++j) {
+        const double* column = getColumn(j);
+        std::copy(column, column + _numRows,
+                data.begin() + (size_t)j * capacity);
+    }
+    _data.swap(data);
+    _times.resize(capacity);
+    _capacity = capacity;
+}
+
+void ColumnMajorStorage::appendRow(double time, int n, const double* values) {
+    if (_numRows == _capacity) reserve(std::max(2 * _capacity, 16));
+    _times[_numRows] = time;
+    const int numValues = std::min(std::max(n, 0), _numColumns);
+    double* entry = _data.data() + _numRows;
+    for (int j = 0; j < numValues; ++j, entry += _capacity) *entry = values[j];
+    for (int j = numValues; j < _numColumns; ++j, entry += _capacity)
+        *entry = SimTK::NaN;
+    ++_numRows;
+}
+
+SimTK::MatrixView ColumnMajorStorage::getMatrixView() const {
+    // A Matrix constructed from a pointer borrows the memory; the block view
+    // refers to the same memory and remains valid after the Matrix is gone.
+    const SimTK::Matrix shared(_numRows, _numColumns, std::max(_capacity, 1),
+            _data.data());
+    return shared.block(0, 0, _numRows, _numColumns);
+}
+
+TimeSeriesTable ColumnMajorStorage::exportToTable(
+        const std::vector<std::string>& labels) const {
+    const SimTK::Matrix shared(_numRows, _numColumns, std::max(_capacity, 1),
+            _data.data());
+    return TimeSeriesTable(
+            std::vector<double>(_times.begin(), _times.begin() + _numRows),
+            shared, labels);
+}
+
+void ColumnMajorStorage::exportToStorage(Storage& storage) const {
+    storage.purge();
+    std::vector<double> row(_numColumns);
+    for (int i = 0; i < _numRows; ++i) {
+        for (int j = 0; j < _numColumns; ++j) row[j] = getValue(i, j);
+        storage.append(_times[i], _numColumns, row.data(), false);
+    }
+}
+
+void ColumnMajorStorage::setDataColumnsOf(Storage& storage) const {
+    OPENSIM_THROW_IF(storage.getSize() != _numRows, Exception,
+            "Expected the Storage to have {} rows, but it has {}.", _numRows,
+            storage.getSize());
+    for (int i = 0; i < _numRows; ++i) {
+        Array<double>& row = storage.getStateVector(i)->getData();
+        const int n = std::min(row.getSize(), _numColumns);
+        for (int j = 0; j < n; ++j) row[j] = getValue(i, j);
+    }
+}
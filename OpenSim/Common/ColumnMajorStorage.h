@@ -0,0 +1,133 @@
+#ifndef OPENSIM_COLUMN_MAJOR_STORAGE_H_
+#define OPENSIM_COLUMN_MAJOR_STORAGE_H_
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  ColumnMajorStorage.h                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2020 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimCommonDLL.h"
+#include "TimeSeriesTable.h"
+
+#include <vector>
+
+namespace OpenSim {
+
+class Storage;
+
+/** A time series of scalar data held in one contiguous, column-major block of
+memory. Each column (and the time column) is a contiguous array, so per-column
+operations (filtering, padding, splining) do not chase a separate heap
+allocation per row as they do with Storage, whose rows are StateVector%s.
+
+Rows are appended with appendRow(); the capacity (in rows) grows
+geometrically, so appending is amortized constant time. Use reserve() if the
+number of rows is known in advance. Column `j` starts at
+`getColumn(j) == getColumn(0) + j * getCapacity()`.
+
+Storage uses this class internally for its per-column operations (e.g.,
+lowpassIIR(), pad(), exportToTable()), and you can use it directly to build
+large tables of results:
+@code
+ColumnMajorStorage data(numColumns);
+data.reserve(numRows);
+for (...) data.appendRow(time, numColumns, values);
+TimeSeriesTable table = data.exportToTable(labels);
+@endcode
+
+getMatrixView() provides the data as a SimTK::MatrixView without copying it;
+any call that changes the number of rows or the capacity invalidates views and
+pointers obtained previously. */
+class OSIMCOMMON_API ColumnMajorStorage {
+public:
+    /** Create an empty storage with the given number of columns (not
+    including time) and room for `capacity` rows. */
+    explicit ColumnMajorStorage(int numColumns = 0, int capacity = 0);
+    /** Copy the data of a Storage. If `numColumns` is negative, the number of
+    columns is Storage::getSmallestNumberOfStates(); longer rows are
+    truncated. Rows shorter than `numColumns` are filled with NaN. */
+    explicit ColumnMajorStorage(const Storage& storage, int numColumns = -1);
+    /** Copy the data of a TimeSeriesTable. */
+    explicit ColumnMajorStorage(const TimeSeriesTable& table);
+
+    /// @name Size
+    /// @{
+    int getNumRows() const { return _numRows; }
+    int getNumColumns() const { return _numColumns; }
+    /** The number of rows for which memory is allocated; this is also the
+    distance between the starts of adjacent columns. */
+    int getCapacity() const { return _capacity; }
+    /** Ensure there is room for at least `capacity` rows without
+    reallocating. */
+    void reserve(int capacity);
+    /** Remove all rows; the capacity is unchanged. */
+    void clear() { _numRows = 0; }
+    /// @}
+
+    /// @name Data
+    /// @{
+    /** Append a row. If `n` is less than getNumColumns(), the remaining
+    entries of the row are NaN; if it is greater, the extra values are
+    ignored. */
+    void appendRow(double time, int n, const double* values);
+    void appendRow(double time, const SimTK::Vector& values) {
+        appendRow(time, values.size(), values.size() ? &values[0] : nullptr);
+    }
+    double getTime(int row) const { return _times[row]; }
+    /** Contiguous array of getNumRows() times. */
+    const double* getTimes() const { return _times.data(); }
+    double* updTimes() { return _times.data(); }
+    /** Contiguous array of the getNumRows() values of a column. */
+    const double* getColumn(int column) const
+    {   return _data.data() + (size_t)column * _capacity; }
+    double* updColumn(int column)
+    {   return _data.data() + (size_t)column * _capacity; }
+    double getValue(int row, int column) const
+    {   return getColumn(column)[row]; }
+    /** The data, without the time column, as a matrix that shares (does not
+    copy) the memory of this storage. */
+    SimTK::MatrixView getMatrixView() const;
+    /// @}
+
+    /// @name Conversion
+    /// @{
+    /** Create a TimeSeriesTable with the given column labels (not including
+    time). The data is copied once into the table's matrix, which has the
+    same (column-major) layout. */
+    TimeSeriesTable exportToTable(const std::vector<std::string>& labels) const;
+    /** Replace the rows of a Storage with the rows of this storage. The
+    column labels and other properties of the Storage are not changed. */
+    void exportToStorage(Storage& storage) const;
+    /** Write the columns of this storage into the existing rows of a Storage
+    (the first getNumColumns() states of each row), which must have
+    getNumRows() rows. Times are not changed. */
+    void setDataColumnsOf(Storage& storage) const;
+    /// @}
+
+private:
+    int _numColumns = 0;
+    int _numRows = 0;
+    int _capacity = 0;
+    std::vector<double> _times;
+    std::vector<double> _data;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_COLUMN_MAJOR_STORAGE_H_
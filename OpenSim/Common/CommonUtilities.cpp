@@ -26,11 +26,16 @@
 #include "PiecewiseLinearFunction.h"
 #include "STOFileAdapter.h"
 #include "TimeSeriesTable.h"
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <ctime>
+#include <exception>
 #include <iomanip>
 #include <memory>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 #include <SimTKcommon/internal/Pathname.h>
 
@@ -183,3 +188,46 @@ SimTK::Real OpenSim::solveBisection(
     }
     return midpoint;
 }
+
+int OpenSim::resolveNumThreads(int numThreads) {
+    if (numThreads >= 1) return numThreads;
+    return std::max(1, (int)std::thread::hardware_concurrency());
+}
+
+void OpenSim::parallelFor(int numTasks, int numThreads,
+        const std::function<void(int index, int thread)>& task) {
+    if (numTasks <= 0) return;
+    numThreads = std::min(resolveNumThreads(numThreads), numTasks);
+    if (numThreads == 1) {
+        for (int index = 0; index < numTasks; ++index) task(index, 0);
+        return;
+    }
+
+    std::atomic<int> nextIndex(0);
+    std::atomic<bool> failed(false);
+    std::mutex errorMutex;
+    int errorIndex = numTasks;
+    std::exception_ptr error;
+    auto work = [&](int thread) {
+        int index;
+        while (!failed && (index = nextIndex++) < numTasks) {
+            try {
+                task(index, thread);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (index < errorIndex) {
+                    errorIndex = index;
+                    error = std::current_exception();
+                }
+                failed = true;
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads - 1);
+    for (int thread = 1; thread < numThreads; ++thread)
+        threads.emplace_back(work, thread);
+    work(0);
+    for (auto& thread : threads) thread.join();
+    if (error) std::rethrow_exception(error);
+}
@@ -124,6 +124,23 @@ SimTK::Real solveBisection(std::function<double(const double&)> calcResidual,
         double left, double right, const double& tolerance = 1e-6,
         int maxIterations = 1000);
 
+/// The number of threads to use when `numThreads` threads are requested:
+/// values less than 1 mean all available hardware threads.
+/// @ingroup commonutil
+OSIMCOMMON_API int resolveNumThreads(int numThreads);
+
+/// Invoke `task(index, thread)` for each index in [0, numTasks), on up to
+/// `numThreads` threads (see resolveNumThreads()) but never more threads than
+/// tasks. The calling thread is thread 0. Each thread takes the next index
+/// from a shared counter, so the order in which tasks run is not fixed;
+/// `thread` (in [0, number of threads)) identifies the thread so that the task
+/// can use resources owned by that thread (e.g., a copy of a model). If a task
+/// throws, no new tasks are started, and the exception of the task with the
+/// lowest index is rethrown once all threads have finished.
+/// @ingroup commonutil
+OSIMCOMMON_API void parallelFor(int numTasks, int numThreads,
+        const std::function<void(int index, int thread)>& task);
+
 /// This class lets you store objects of a single type for reuse by multiple
 /// threads, ensuring threadsafe access to each of those objects.
 /// @ingroup commonutil
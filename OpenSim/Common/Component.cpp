@@ -26,6 +26,8 @@
 #include "Component.h"
 #include "OpenSim/Common/IO.h"
 #include "XMLDocument.h"
+#include <cmath>
+#include <mutex>
 #include <unordered_map>
 #include <set>
 #include <regex>
@@ -79,29 +81,65 @@ public:
     {   return this->getValueZero(); }
 
     void realizeMeasureTopologyVirtual(SimTK::State& s) const override final
-    {   _Component.extendRealizeTopology(s); }
+    {
+        ComponentProfiler::Scope scope(
+                _Component._profilerRecord, ComponentProfiler::RealizeTopology);
+        _Component.extendRealizeTopology(s);
+    }
     void realizeMeasureModelVirtual(SimTK::State& s) const override final
-    {   _Component.extendRealizeModel(s); }
+    {
+        ComponentProfiler::Scope scope(
+                _Component._profilerRecord, ComponentProfiler::RealizeModel);
+        _Component.extendRealizeModel(s);
+    }
     void realizeMeasureInstanceVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizeInstance(s); }
+    {
+        ComponentProfiler::Scope scope(
+                _Component._profilerRecord, ComponentProfiler::RealizeInstance);
+        _Component.extendRealizeInstance(s);
+    }
     void realizeMeasureTimeVirtual(const SimTK::State& s) const override final
-    {   _Component.extendRealizeTime(s); }
+    {
+        ComponentProfiler::Scope scope(
+                _Component._profilerRecord, ComponentProfiler::RealizeTime);
+        _Component.extendRealizeTime(s);
+    }
     void realizeMeasurePositionVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizePosition(s); }
+    {
+        ComponentProfiler::Scope scope(
+                _Component._profilerRecord, ComponentProfiler::RealizePosition);
+        _Component.extendRealizePosition(s);
+    }
     void realizeMeasureVelocityVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizeVelocity(s); }
+    {
+        ComponentProfiler::Scope scope(
+                _Component._profilerRecord, ComponentProfiler::RealizeVelocity);
+        _Component.extendRealizeVelocity(s);
+    }
     void realizeMeasureDynamicsVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizeDynamics(s); }
+    {
+        ComponentProfiler::Scope scope(
+                _Component._profilerRecord, ComponentProfiler::RealizeDynamics);
+        _Component.extendRealizeDynamics(s);
+    }
     void realizeMeasureAccelerationVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizeAcceleration(s); }
+    {
+        ComponentProfiler::Scope scope(
+                _Component._profilerRecord, ComponentProfiler::RealizeAcceleration);
+        _Component.extendRealizeAcceleration(s);
+    }
     void realizeMeasureReportVirtual(const SimTK::State& s)
         const override final
-    {   _Component.extendRealizeReport(s); }
+    {
+        ComponentProfiler::Scope scope(
+                _Component._profilerRecord, ComponentProfiler::RealizeReport);
+        _Component.extendRealizeReport(s);
+    }
 
 private:
     const Component& _Component;
@@ -392,6 +430,10 @@ void Component::addToSystem(SimTK::MultibodySystem& system) const
     extendAddToSystem(system);
     componentsAddToSystem(system);
     extendAddToSystemAfterSubcomponents(system);
+    // All state variables of this Component and its subcomponents now exist.
+    // Index them here, while the System is being built, so that the const
+    // accessors never modify the index (and can be called concurrently).
+    updateAllStateVariables();
 }
 
 // Base class implementation of virtual method.
@@ -411,6 +453,10 @@ void Component::baseAddToSystem(SimTK::MultibodySystem& system) const
     // Clear cached list of all related StateVariables if any from a previous
     // System.
     _allStateVariables.clear();
+    _stateVariablesByPath.clear();
+    _statesAssociatedSystem.reset(nullptr);
+    _stateVariableYIndices.clear();
+    _yIndicesSystem.reset(nullptr);
 
     // Briefly get write access to the Component to record some
     // information associated with the System; that info is const after this.
@@ -820,7 +866,7 @@ double Component::
     OPENSIM_THROW_IF_FRMOBJ(!hasSystem(), ComponentHasNoSystem);
 
     // find the state variable with this component or its subcomponents
-    const StateVariable* rsv = traverseToStateVariable(name);
+    const StateVariable* rsv = findStateVariable(name);
     if (rsv) {
         return rsv->getValue(s);
     }
@@ -842,19 +888,11 @@ double Component::
     OPENSIM_THROW_IF_FRMOBJ(!hasSystem(), ComponentHasNoSystem);
 
     computeStateVariableDerivatives(state);
-    
-    std::map<std::string, StateVariableInfo>::const_iterator it;
-    it = _namedStateVariableInfo.find(name);
 
-    if(it != _namedStateVariableInfo.end()) {
-        return it->second.stateVariable->getDerivative(state);
-    } 
-    else{
-        // otherwise find the component that variable belongs to
-        const StateVariable* rsv = traverseToStateVariable(name);
-        if (rsv) {
-            return rsv->getDerivative(state);
-        }
+    // find the state variable with this component or its subcomponents
+    const StateVariable* rsv = findStateVariable(name);
+    if (rsv) {
+        return rsv->getDerivative(state);
     }
 
     std::stringstream msg;
@@ -875,7 +913,7 @@ void Component::
     OPENSIM_THROW_IF_FRMOBJ(!hasSystem(), ComponentHasNoSystem);
 
     // find the state variable
-    const StateVariable* rsv = traverseToStateVariable(name);
+    const StateVariable* rsv = findStateVariable(name);
 
     if(rsv){ // find required rummaging through the state variable names
             return rsv->setValue(s, value);
@@ -915,6 +953,124 @@ bool Component::isAllStatesVariablesListValid() const
     return valid;
 }
 
+void Component::updateAllStateVariables() const
+{
+    const int nsv = getNumStateVariables();
+    _statesAssociatedSystem.reset(&getSystem());
+    _allStateVariables.clear();
+    _allStateVariables.resize(nsv);
+    _stateVariablesByPath.clear();
+
+    // State variables of this Component can be found by name, including
+    // hidden ones.
+    for (const auto& kv : _namedStateVariableInfo)
+        _stateVariablesByPath[kv.first] = kv.second.stateVariable.get();
+
+    // getStateVariableNames() returns absolute paths; also index the paths
+    // relative to this Component.
+    const std::string absPath = getAbsolutePathString();
+    const std::string prefix = hasOwner() ? absPath + "/" : absPath;
+    const Array<std::string> names = getStateVariableNames();
+    for (int i = 0; i < nsv; ++i) {
+        const StateVariable* sv = traverseToStateVariable(names[i]);
+        _allStateVariables[i].reset(sv);
+        _stateVariablesByPath[names[i]] = sv;
+        if (names[i].compare(0, prefix.size(), prefix) == 0)
+            _stateVariablesByPath[names[i].substr(prefix.size())] = sv;
+    }
+}
+
+const Component::StateVariable* Component::
+    findStateVariable(const std::string& pathName) const
+{
+    // The index is built by addToSystem() and is valid until the System is
+    // rebuilt.
+    auto it = _stateVariablesByPath.find(pathName);
+    if (it != _stateVariablesByPath.end()) return it->second;
+    // Paths such as "../name" are not indexed.
+    return traverseToStateVariable(pathName);
+}
+
+Component::StateVariableHandle Component::
+    getStateVariableHandle(const std::string& name) const
+{
+    // Must have already called initSystem.
+    OPENSIM_THROW_IF_FRMOBJ(!hasSystem(), ComponentHasNoSystem);
+
+    const StateVariable* sv = findStateVariable(name);
+    OPENSIM_THROW_IF_FRMOBJ(!sv, Exception,
+            "State variable '" + name + "' not found.");
+
+    // The Y indices need a realized System, so they cannot be computed in
+    // addToSystem(); compute them on first use, once per System, for all the
+    // state variables of this Component and its subcomponents.
+    static std::mutex yIndicesMutex;
+    std::lock_guard<std::mutex> lock(yIndicesMutex);
+    if (_yIndicesSystem.empty() ||
+            !getSystem().isSameSystem(_yIndicesSystem.getRef())) {
+        SimTK::State s = getSystem().getDefaultState();
+        for (int iy = 0; iy < s.getNY(); ++iy) s.updY()[iy] = iy;
+        _stateVariableYIndices.clear();
+        for (const auto& other : _allStateVariables) {
+            _stateVariableYIndices[other.get()] =
+                    findSystemYIndex(*other, s);
+        }
+        _yIndicesSystem.reset(&getSystem());
+    }
+    auto it = _stateVariableYIndices.find(sv);
+    if (it != _stateVariableYIndices.end())
+        return StateVariableHandle(sv, it->second);
+
+    // The state variable is not in this Component's subtree (e.g., the path
+    // starts with "..").
+    SimTK::State s = getSystem().getDefaultState();
+    for (int iy = 0; iy < s.getNY(); ++iy) s.updY()[iy] = iy;
+    return StateVariableHandle(sv, findSystemYIndex(*sv, s));
+}
+
+SimTK::SystemYIndex Component::findSystemYIndex(
+        const StateVariable& sv, SimTK::State& s)
+{
+    // `s` holds its own Y index in each slot of Y, so the value of a state
+    // variable stored in Y is its index. Check the candidate slot in case
+    // the value is computed from Y rather than stored in it.
+    const double value = sv.getValue(s);
+    if (!(value >= 0 && value < s.getNY() && value == std::floor(value)))
+        return SimTK::SystemYIndex();
+    const int iy = int(value);
+    s.updY()[iy] = -1;
+    const bool stored = sv.getValue(s) == -1;
+    s.updY()[iy] = iy;
+    return stored ? SimTK::SystemYIndex(iy) : SimTK::SystemYIndex();
+}
+
+const std::string& Component::StateVariableHandle::getName() const
+{
+    return _stateVariable->getName();
+}
+
+const Component& Component::StateVariableHandle::getOwner() const
+{
+    return _stateVariable->getOwner();
+}
+
+double Component::StateVariableHandle::getValue(const SimTK::State& s) const
+{
+    return _stateVariable->getValue(s);
+}
+
+void Component::StateVariableHandle::setValue(
+        SimTK::State& s, double value) const
+{
+    _stateVariable->setValue(s, value);
+}
+
+double Component::StateVariableHandle::getDerivative(
+        const SimTK::State& s) const
+{
+    return _stateVariable->getDerivative(s);
+}
+
 
 // Get all values of the state variables allocated by this Component. Includes
 // state variables allocated by its subcomponents.
@@ -926,14 +1082,7 @@ SimTK::Vector Component::
 
     int nsv = getNumStateVariables();
     // if the StateVariables are invalid (see above) rebuild the list
-    if (!isAllStatesVariablesListValid()) {
-        _statesAssociatedSystem.reset(&getSystem());
-        _allStateVariables.clear();
-        _allStateVariables.resize(nsv);
-        Array<std::string> names = getStateVariableNames();
-        for (int i = 0; i < nsv; ++i)
-            _allStateVariables[i].reset(traverseToStateVariable(names[i]));
-    }
+    if (!isAllStatesVariablesListValid()) updateAllStateVariables();
 
     Vector stateVariableValues(nsv, SimTK::NaN);
     for(int i=0; i<nsv; ++i){
@@ -959,14 +1108,7 @@ void Component::
         "number of state variables.");
 
     // if the StateVariables are invalid (see above) rebuild the list 
-    if (!isAllStatesVariablesListValid()) {
-        _statesAssociatedSystem.reset(&getSystem());
-        _allStateVariables.clear();
-        _allStateVariables.resize(nsv);
-        Array<std::string> names = getStateVariableNames();
-        for (int i = 0; i < nsv; ++i)
-            _allStateVariables[i].reset(traverseToStateVariable(names[i]));
-    }
+    if (!isAllStatesVariablesListValid()) updateAllStateVariables();
 
     for(int i=0; i<nsv; ++i){
         _allStateVariables[i]->setValue(state, values[i]);
@@ -1044,6 +1186,19 @@ setDiscreteVariableValue(SimTK::State& s, const std::string& name, double value)
     }
 }
 
+std::vector<std::pair<std::string, SimTK::DiscreteVariableIndex>> Component::
+getDiscreteVariableNamesAndIndices() const
+{
+    // Must have already called initSystem.
+    OPENSIM_THROW_IF_FRMOBJ(!hasSystem(), ComponentHasNoSystem);
+
+    std::vector<std::pair<std::string, SimTK::DiscreteVariableIndex>> indices;
+    for (const auto& kv : _namedDiscreteVariableInfo) {
+        indices.emplace_back(kv.first, kv.second.index);
+    }
+    return indices;
+}
+
 SimTK::CacheEntryIndex Component::getCacheVariableIndex(const std::string& name) const
 {
     auto it = this->_namedCacheVariables.find(name);
@@ -1070,6 +1225,7 @@ void Component::markCacheVariableValid(const SimTK::State& state, const std::str
     const SimTK::DefaultSystemSubsystem& subsystem = this->getDefaultSubsystem();
     const SimTK::CacheEntryIndex idx = this->getCacheVariableIndex(name);
     subsystem.markCacheValueRealized(state, idx);
+    countCacheComputation();
 }
 
 void Component::markCacheVariableInvalid(const SimTK::State& state, const std::string& name) const
@@ -1505,7 +1661,11 @@ void Component::extendRealizeAcceleration(const SimTK::State& s) const
         const SimTK::Subsystem& subSys = getDefaultSubsystem();
 
         // evaluate and set component state derivative values (in cache) 
-        computeStateVariableDerivatives(s);
+        {
+            ComponentProfiler::Scope scope(_profilerRecord,
+                    ComponentProfiler::ComputeStateVariableDerivatives);
+            computeStateVariableDerivatives(s);
+        }
     
         std::map<std::string, StateVariableInfo>::const_iterator it;
 
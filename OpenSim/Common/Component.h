@@ -43,6 +43,7 @@
 
 // INCLUDES
 #include "ComponentList.h"
+#include "ComponentProfiler.h"
 #include "ComponentPath.h"
 #include "Logger.h"
 #include "OpenSim/Common/Array.h"
@@ -875,7 +876,7 @@ public:
      *     const AbstractSocket& socket = getSocket(name);
      * }
      * @endcode */
-    std::vector<std::string> getSocketNames() {
+    std::vector<std::string> getSocketNames() const {
         std::vector<std::string> names;
         for (const auto& it : _socketsTable) {
             names.push_back(it.first);
@@ -1373,6 +1374,21 @@ public:
     void setDiscreteVariableValue(SimTK::State& state, const std::string& name,
                                   double value) const;
 
+#ifndef SWIG
+    /**
+     * Get the names of the discrete variables allocated by this Component
+     * (not by its subcomponents), in alphabetical order, each with its index
+     * in the default Subsystem of the System. This allows code that copies
+     * the discrete variables of many States to access them without looking
+     * them up by name.
+     *
+     * @throws ComponentHasNoSystem if this Component has not been added to a
+     *         System (i.e., if initSystem has not been called)
+     */
+    std::vector<std::pair<std::string, SimTK::DiscreteVariableIndex>>
+    getDiscreteVariableNamesAndIndices() const;
+#endif
+
     /**
      * A cache variable containing a value of type T.
      *
@@ -1595,6 +1611,7 @@ private:
         T& currentVal = SimTK::Value<T>::downcast(valWrapper).upd();
         currentVal = std::move(value);
         subsystem.markCacheValueRealized(state, idx);
+        countCacheComputation();
     }
 
 public:
@@ -1797,6 +1814,7 @@ public:
         const SimTK::DefaultSystemSubsystem& subsystem = this->getDefaultSubsystem();
         const SimTK::CacheEntryIndex idx = this->getCacheVariableIndex(cv);
         subsystem.markCacheValueRealized(state, idx);
+        countCacheComputation();
     }
 
     /**
@@ -1940,6 +1958,7 @@ protected:
     //template <class T> friend class ComponentSet;
     // Give the ComponentMeasure access to the realize() methods.
     template <class T> friend class ComponentMeasure;
+    friend class ComponentProfiler;
 
 #ifndef SWIG
     /// @class MemberSubcomponentIndex
@@ -2618,6 +2637,48 @@ public:
      */
     const StateVariable* traverseToStateVariable(
             const std::string& pathName) const;
+
+    /**
+     * A lightweight handle to a StateVariable of this Component or of one of
+     * its subcomponents, obtained with getStateVariableHandle(). Accessing a
+     * state variable through a handle avoids the lookup by name done by
+     * getStateVariableValue() and related methods, so handles are preferred
+     * in code that runs at every time step (e.g., controllers). A handle is
+     * invalidated when the System is rebuilt (e.g., by initSystem()).
+     */
+    class OSIMCOMMON_API StateVariableHandle {
+    public:
+        StateVariableHandle() = default;
+        /** Whether this handle refers to a state variable.                 */
+        bool isValid() const { return _stateVariable != nullptr; }
+        /** Name of the state variable within its owner.                    */
+        const std::string& getName() const;
+        /** The Component that owns the state variable.                      */
+        const Component& getOwner() const;
+        /** Index of the state variable in the System's Y vector; invalid if
+         * the state variable is not stored in Y.                            */
+        SimTK::SystemYIndex getSystemYIndex() const { return _yIndex; }
+        double getValue(const SimTK::State& state) const;
+        void setValue(SimTK::State& state, double value) const;
+        /** The state must be realized to Stage::Acceleration.              */
+        double getDerivative(const SimTK::State& state) const;
+    private:
+        friend class Component;
+        StateVariableHandle(const StateVariable* stateVariable,
+                SimTK::SystemYIndex yIndex) :
+                _stateVariable(stateVariable), _yIndex(yIndex) {}
+        const StateVariable* _stateVariable = nullptr;
+        SimTK::SystemYIndex _yIndex;
+    };
+
+    /**
+     * Get a handle to a state variable, given its path relative to this
+     * Component (as for getStateVariableValue()) or its absolute path.
+     * @throws ComponentHasNoSystem if this Component has not been added to a
+     *         System (i.e., if initSystem has not been called)
+     * @throws Exception if there is no state variable at the given path
+     */
+    StateVariableHandle getStateVariableHandle(const std::string& name) const;
 #endif
 
     /// @name Access to the owning component (advanced).
@@ -3203,11 +3264,44 @@ private:
     // Check that the list of _allStateVariables is valid
     bool isAllStatesVariablesListValid() const;
 
+    // Rebuild _allStateVariables and _stateVariablesByPath for the current
+    // System. Called by addToSystem().
+    void updateAllStateVariables() const;
+
+    // Find a state variable by path, using _stateVariablesByPath if possible.
+    // Returns nullptr if there is no such state variable.
+    const StateVariable* findStateVariable(const std::string& pathName) const;
+
+    // The index of the slot of Y that stores the given state variable, or an
+    // invalid index. `s` must hold its own index in each slot of Y.
+    static SimTK::SystemYIndex findSystemYIndex(
+            const StateVariable& sv, SimTK::State& s);
+
     // Array of all state variables for fast access during simulation
     mutable SimTK::Array_<SimTK::ReferencePtr<const StateVariable> >
                                                             _allStateVariables;
     // A handle the System associated with the above state variables
     mutable SimTK::ReferencePtr<const SimTK::System> _statesAssociatedSystem;
+    // The above state variables and those of this Component, by their
+    // absolute path and their path relative to this Component, for fast
+    // lookup by name.
+    mutable SimTK::ResetOnCopy<
+            std::unordered_map<std::string, const StateVariable*>>
+                                                        _stateVariablesByPath;
+    // The Y index of each state variable in _allStateVariables, and the
+    // System for which they were computed (see getStateVariableHandle()).
+    mutable SimTK::ResetOnCopy<std::unordered_map<const StateVariable*,
+            SimTK::SystemYIndex>>                           _stateVariableYIndices;
+    mutable SimTK::ReferencePtr<const SimTK::System>        _yIndicesSystem;
+
+    // Statistics of this Component if it is being profiled (see
+    // ComponentProfiler), or null.
+    mutable SimTK::ResetOnCopy<ComponentProfiler::Record*> _profilerRecord;
+
+    void countCacheComputation() const {
+        ComponentProfiler::Record* record = _profilerRecord;
+        if (record) record->cacheComputations += 1;
+    }
 
 //==============================================================================
 };  // END of class Component
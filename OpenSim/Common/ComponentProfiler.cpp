@@ -0,0 +1,170 @@
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  ComponentProfiler.cpp                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2020 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "ComponentProfiler.h"
+#include "Component.h"
+#include "DataTable.h"
+
+#include <functional>
+#include <sstream>
+#include <unordered_map>
+
+using namespace OpenSim;
+
+namespace {
+const char* const sectionNames[ComponentProfiler::NumSections] = {
+        "realize_topology", "realize_model", "realize_instance",
+        "realize_time", "realize_position", "realize_velocity",
+        "realize_dynamics", "realize_acceleration", "realize_report",
+        "compute_force", "compute_state_variable_derivatives"};
+
+std::string escapeJSON(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') escaped += '\\';
+        escaped += c;
+    }
+    return escaped;
+}
+}
+
+void ComponentProfiler::Record::reset() {
+    for (int i = 0; i < NumSections; ++i) {
+        calls[i] = 0;
+        nanoseconds[i] = 0;
+    }
+    cacheComputations = 0;
+}
+
+ComponentProfiler::ComponentProfiler(const Component& root) {
+    _components.push_back(&root);
+    for (const auto& component : root.getComponentList())
+        _components.push_back(&component);
+
+    std::unordered_map<const Component*, int> indices;
+    for (int i = 0; i < (int)_components.size(); ++i) {
+        const Component& component = *_components[i];
+        OPENSIM_THROW_IF(component._profilerRecord != nullptr, Exception,
+                "Component '{}' is already being profiled.",
+                component.getAbsolutePathString());
+        indices[&component] = i;
+        _names.push_back(component.getName());
+        _paths.push_back(component.getAbsolutePathString());
+        _records.emplace_back(new Record());
+    }
+    for (int i = 0; i < (int)_components.size(); ++i) {
+        const Component& component = *_components[i];
+        int parent = i > 0 ? 0 : -1;
+        if (i > 0 && component.hasOwner()) {
+            const auto it = indices.find(&component.getOwner());
+            if (it != indices.end()) parent = it->second;
+        }
+        _parents.push_back(parent);
+        component._profilerRecord = _records[i].get();
+    }
+    _profiling = true;
+}
+
+ComponentProfiler::~ComponentProfiler() {
+    stop();
+}
+
+void ComponentProfiler::stop() {
+    if (!_profiling) return;
+    for (const Component* component : _components)
+        component->_profilerRecord = nullptr;
+    _profiling = false;
+}
+
+void ComponentProfiler::reset() {
+    for (auto& record : _records) record->reset();
+}
+
+ComponentProfiler::Record* ComponentProfiler::getRecord(
+        const Component& component) {
+    return component._profilerRecord;
+}
+
+std::vector<std::string> ComponentProfiler::getStatisticNames() {
+    std::vector<std::string> names;
+    for (int i = 0; i < NumSections; ++i) {
+        names.push_back(std::string(sectionNames[i]) + "_calls");
+        names.push_back(std::string(sectionNames[i]) + "_seconds");
+    }
+    names.push_back("cache_computations");
+    return names;
+}
+
+DataTable_<double, double> ComponentProfiler::getTable() const {
+    const int numStatistics = 2 * NumSections + 1;
+    const int numComponents = (int)_records.size();
+    SimTK::Matrix values(numStatistics, numComponents);
+    for (int j = 0; j < numComponents; ++j) {
+        const Record& record = *_records[j];
+        for (int i = 0; i < NumSections; ++i) {
+            values(2 * i, j) = (double)record.calls[i];
+            values(2 * i + 1, j) = 1e-9 * record.nanoseconds[i];
+        }
+        values(numStatistics - 1, j) = (double)record.cacheComputations;
+    }
+    std::vector<double> indices(numStatistics);
+    for (int i = 0; i < numStatistics; ++i) indices[i] = i;
+    return DataTable_<double, double>(indices, values, _paths);
+}
+
+long long ComponentProfiler::getSelfNanoseconds(int index) const {
+    long long nanoseconds = 0;
+    for (int i = 0; i < NumSections; ++i) {
+        if (i != ComputeStateVariableDerivatives)
+            nanoseconds += _records[index]->nanoseconds[i];
+    }
+    return nanoseconds;
+}
+
+std::string ComponentProfiler::getFlameGraphJSON() const {
+    const int numComponents = (int)_records.size();
+    std::vector<std::vector<int>> children(numComponents);
+    for (int i = 0; i < numComponents; ++i) {
+        if (_parents[i] >= 0) children[_parents[i]].push_back(i);
+    }
+
+    // Components are listed after their owners, so the values can be
+    // accumulated from the last component to the first.
+    std::vector<long long> values(numComponents);
+    for (int i = numComponents - 1; i >= 0; --i) {
+        values[i] = getSelfNanoseconds(i);
+        for (int child : children[i]) values[i] += values[child];
+    }
+
+    std::ostringstream json;
+    std::function<void(int)> writeNode = [&](int node) {
+        json << "{\"name\":\"" << escapeJSON(_names[node])
+             << "\",\"value\":" << values[node] << ",\"children\":[";
+        for (size_t c = 0; c < children[node].size(); ++c) {
+            if (c > 0) json << ",";
+            writeNode(children[node][c]);
+        }
+        json << "]}";
+    };
+    writeNode(0);
+    return json.str();
+}
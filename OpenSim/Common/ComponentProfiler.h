@@ -0,0 +1,169 @@
+#ifndef OPENSIM_COMPONENT_PROFILER_H_
+#define OPENSIM_COMPONENT_PROFILER_H_
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  ComponentProfiler.h                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2020 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimCommonDLL.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace OpenSim {
+
+class Component;
+template <typename ETX, typename ETY> class DataTable_;
+
+/** Measure how much time each component of a model (or of any tree of
+components) spends in its realize methods (extendRealizeTopology() through
+extendRealizeReport()), in Force::computeForce(), and in
+computeStateVariableDerivatives(), and count how many times each component
+computes the values of its cache variables (i.e., marks a cache variable as
+valid, e.g., when a GeometryPath computes its path).
+
+Profiling starts when a ComponentProfiler is constructed and applies to the
+components that are in the tree at that time, so construct it after
+initSystem(). Profiling stops when the profiler is destroyed or stop() is
+called, which must happen before the components are destroyed. A component
+can only be profiled by one profiler at a time. Components that are not being
+profiled only check whether they are, so the overhead is negligible when no
+profiler exists.
+
+Times are inclusive: e.g., the time a component spends in
+extendRealizeAcceleration() includes the time it spends in
+computeStateVariableDerivatives(), and includes the time spent by any other
+component whose cache variables it causes to be computed.
+
+@code{.cpp}
+Model model("arm26.osim");
+SimTK::State& state = model.initSystem();
+ComponentProfiler profiler(model);
+simulate(model, state, 1.0);
+STOFileAdapter::write(profiler.getTable(), "arm26_profile.sto");
+std::ofstream("arm26_profile.json") << profiler.getFlameGraphJSON();
+@endcode */
+class OSIMCOMMON_API ComponentProfiler {
+public:
+    /** The parts of a component's work that are timed. */
+    enum Section {
+        RealizeTopology,
+        RealizeModel,
+        RealizeInstance,
+        RealizeTime,
+        RealizePosition,
+        RealizeVelocity,
+        RealizeDynamics,
+        RealizeAcceleration,
+        RealizeReport,
+        ComputeForce,
+        ComputeStateVariableDerivatives,
+        NumSections
+    };
+
+    /** The statistics collected for one component. */
+    struct Record {
+        std::atomic<long long> calls[NumSections];
+        std::atomic<long long> nanoseconds[NumSections];
+        std::atomic<long long> cacheComputations;
+        Record() { reset(); }
+        void reset();
+    };
+
+    /** Times a section of a component's work from construction to
+    destruction, if `record` is not null (i.e., if the component is being
+    profiled). */
+    class Scope {
+    public:
+        Scope(Record* record, Section section)
+                : _record(record), _section(section) {
+            if (_record) _start = std::chrono::steady_clock::now();
+        }
+        ~Scope() {
+            if (_record) {
+                const auto elapsed = std::chrono::steady_clock::now() - _start;
+                _record->calls[_section] += 1;
+                _record->nanoseconds[_section] +=
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                elapsed).count();
+            }
+        }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        Record* _record;
+        Section _section;
+        std::chrono::steady_clock::time_point _start;
+    };
+
+    /** Start profiling `root` and all of its subcomponents.
+    @throws Exception if any of them is already being profiled. */
+    explicit ComponentProfiler(const Component& root);
+    ~ComponentProfiler();
+
+    ComponentProfiler(const ComponentProfiler&) = delete;
+    ComponentProfiler& operator=(const ComponentProfiler&) = delete;
+
+    /** Stop profiling. The statistics collected so far remain available, but
+    only the paths of the components are used after this. */
+    void stop();
+    /** Set all the statistics collected so far to zero. */
+    void reset();
+
+    /** The names of the rows of getTable(), in order: for each Section, the
+    number of calls ("<section>_calls") and the total time in seconds
+    ("<section>_seconds"), followed by "cache_computations". Sections are
+    named, e.g., "realize_dynamics" and "compute_force". */
+    static std::vector<std::string> getStatisticNames();
+
+    /** A table with one column per profiled component, labeled with the
+    component's absolute path, and one row per statistic, in the order of
+    getStatisticNames(). The independent column holds the row indices. */
+    DataTable_<double, double> getTable() const;
+
+    /** A summary of the time spent by each component, arranged by the
+    ownership tree of the components, in the JSON format read by flame graph
+    viewers such as d3-flame-graph and speedscope: each node has a "name", a
+    "value" (nanoseconds spent by the component and its subcomponents), and
+    its "children". The time of a component is the sum of the times of its
+    sections, except compute_state_variable_derivatives, which is already
+    included in realize_acceleration. */
+    std::string getFlameGraphJSON() const;
+
+    /** The record of a component, or null if it is not being profiled. */
+    static Record* getRecord(const Component& component);
+
+private:
+    long long getSelfNanoseconds(int index) const;
+
+    std::vector<const Component*> _components;
+    std::vector<std::string> _names;
+    std::vector<std::string> _paths;
+    std::vector<int> _parents;
+    std::vector<std::unique_ptr<Record>> _records;
+    bool _profiling = false;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_COMPONENT_PROFILER_H_
@@ -22,10 +22,14 @@
  * See the License for the specific language governing permissions and        *
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
+#include <atomic>
 #include <queue>
+#include <thread>
+#include <vector>
 #include <condition_variable>
 #include <SimTKcommon.h>
 #include <OpenSim/Common/osimCommonDLL.h>
+#include <OpenSim/Common/Exception.h>
 
 namespace OpenSim {
 
@@ -42,23 +46,35 @@ namespace OpenSim {
  *
  * @author Ayman Habib
  */
-/** Template class to contain Queue Entries, typically timestamped */
+/** Template class to contain Queue Entries, typically timestamped. The entry
+ * owns a copy of its data. */
 template <class U> 
 class DataQueueEntry_ {
 public:
+    DataQueueEntry_() = default;
     DataQueueEntry_(double timeStamp, const SimTK::RowVectorView_<U>& data)
             : _timeStamp(timeStamp), _data(data){};
     DataQueueEntry_(const DataQueueEntry_& other)       = default;
     DataQueueEntry_(DataQueueEntry_&&)                  = default;
     DataQueueEntry_& operator=(const DataQueueEntry_&)  = default;
+    DataQueueEntry_& operator=(DataQueueEntry_&&)       = default;
     virtual ~DataQueueEntry_(){};
 
     double getTimeStamp() const { return _timeStamp; };
-    SimTK::RowVectorView_<U> getData() const { return _data; };
+    const SimTK::RowVector_<U>& getData() const { return _data; };
+
+    /** Overwrite the contents of this entry. When the entry already holds a
+     * row of the same length no memory is allocated. */
+    void assign(double timeStamp, const SimTK::RowVectorView_<U>& data) {
+        _timeStamp = timeStamp;
+        const int n = data.size();
+        if (_data.size() != n) _data.resize(n);
+        for (int i = 0; i < n; ++i) _data[i] = data[i];
+    }
 
 private:
-    double _timeStamp;
-    SimTK::RowVectorView_<U> _data;
+    double _timeStamp{SimTK::NaN};
+    SimTK::RowVector_<U> _data;
 };
 /**
  * DataQueue is a wrapper around the std::queue customized to handle data 
@@ -68,6 +84,14 @@ private:
  * making sure order is preserved.
  * timestamp is required to pass in data so that clients can enforce order,
  * however timestamp is not used/order-enforced internally.
+ *
+ * A DataQueue constructed with a capacity operates as a bounded, lock-free
+ * ring buffer instead. In this mode exactly one thread may push (the
+ * producer) and exactly one thread may pop (the consumer); all slots are
+ * allocated up front and reused, so once every slot has seen a row of the
+ * streamed length, neither side allocates memory or takes a lock. When the
+ * buffer is full, push_back() drops the new sample and increments the
+ * overflow count rather than blocking the producer.
  */
 // @TODO Test support of multiple consumers. 
 template<class T> class DataQueue_ {
@@ -81,53 +105,215 @@ public:
     virtual ~DataQueue_() {}
     
     DataQueue_()                                = default;
+    /** Create a bounded single-producer/single-consumer queue that holds at
+     * most `capacity` entries. */
+    explicit DataQueue_(int capacity) { setCapacity(capacity); }
     // using compiler generated methods here is problematic due to mutex 
     DataQueue_(const DataQueue_& other){ 
-        m_data_queue = other.m_data_queue;
+        copyFrom(other);
     };
     DataQueue_(DataQueue_&& other){ 
-        m_data_queue = other.m_data_queue;
+        copyFrom(other);
     };
     DataQueue_& operator=(const DataQueue_& other) { 
-        m_data_queue = other.m_data_queue;
+        if (this != &other) copyFrom(other);
         return (*this);
     };
 
+    //--------------------------------------------------------------------------
+    // CONFIGURATION
+    //--------------------------------------------------------------------------
+    /** Switch this queue to a bounded lock-free ring buffer holding at most
+     * `capacity` entries, or back to the unbounded (mutex-based) queue if
+     * `capacity` is 0. Any queued entries are discarded and the counters are
+     * reset. This must not be called while a producer or consumer is active.
+     */
+    void setCapacity(int capacity) {
+        OPENSIM_THROW_IF(capacity < 0, Exception,
+                "Expected a non-negative capacity, but got " +
+                std::to_string(capacity) + ".");
+        std::unique_lock<std::mutex> mlock(m_mutex);
+        m_data_queue = std::queue<DataQueueEntry_<T>>();
+        m_ring.clear();
+        // One slot is always left empty to distinguish full from empty.
+        if (capacity > 0) m_ring.resize(capacity + 1);
+        m_head.store(0);
+        m_tail.store(0);
+        m_num_overflows.store(0);
+        m_num_dropped.store(0);
+    }
+    /** The maximum number of entries the queue can hold, or 0 if the queue is
+     * unbounded. */
+    int getCapacity() const {
+        return m_ring.empty() ? 0 : (int)m_ring.size() - 1;
+    }
+    /** Whether this queue operates as a bounded lock-free ring buffer. */
+    bool isBounded() const { return !m_ring.empty(); }
+
     //--------------------------------------------------------------------------
     // DataQueue Interface
     //--------------------------------------------------------------------------
     // push data and associated timestamp to the end of the queue
     void push_back(const double time, const SimTK::RowVectorView_<T>& data) { 
-        SimTK::RowVector_<T>* deepCopy = new SimTK::RowVector_<T>(data);
+        if (isBounded()) {
+            try_push(time, data);
+            return;
+        }
         std::unique_lock<std::mutex> mlock(m_mutex);
-        m_data_queue.push(DataQueueEntry_<T>(time, *deepCopy));
+        m_data_queue.push(DataQueueEntry_<T>(time, data));
         mlock.unlock();     // unlock before notificiation to minimize mutex con
         m_cond.notify_one(); 
     }
+    /** Push data without blocking. For a bounded queue, return false (and
+     * increment the overflow and dropped counts) if the queue is full. An
+     * unbounded queue always accepts the data. */
+    bool try_push(const double time, const SimTK::RowVectorView_<T>& data) {
+        if (!isBounded()) {
+            push_back(time, data);
+            return true;
+        }
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        const std::size_t next = increment(tail);
+        if (next == m_head.load(std::memory_order_acquire)) {
+            m_num_overflows.fetch_add(1, std::memory_order_relaxed);
+            m_num_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        m_ring[tail].assign(time, data);
+        m_tail.store(next, std::memory_order_release);
+        return true;
+    }
     // pop the front of the queue and return data and associated timestamp
     void pop_front(double& time, SimTK::RowVector_<T>& data) { 
+        if (isBounded()) {
+            // The producer never blocks on the consumer, so wait without
+            // taking a lock until an entry is published.
+            while (!try_pop(time, data)) { std::this_thread::yield(); }
+            return;
+        }
         std::unique_lock<std::mutex> mlock(m_mutex);
         while (m_data_queue.empty()) { m_cond.wait(mlock); }
-        DataQueueEntry_<SimTK::Rotation> frontEntry = m_data_queue.front();
+        DataQueueEntry_<T> frontEntry = std::move(m_data_queue.front());
         m_data_queue.pop();
         mlock.unlock(); 
         time = frontEntry.getTimeStamp();
         data = frontEntry.getData();
     }
+    /** Pop the front of the queue if it is not empty. Return false, without
+     * waiting, if there is no data available. */
+    bool try_pop(double& time, SimTK::RowVector_<T>& data) {
+        if (!isBounded()) {
+            std::unique_lock<std::mutex> mlock(m_mutex);
+            if (m_data_queue.empty()) return false;
+            DataQueueEntry_<T> frontEntry = std::move(m_data_queue.front());
+            m_data_queue.pop();
+            mlock.unlock();
+            time = frontEntry.getTimeStamp();
+            data = frontEntry.getData();
+            return true;
+        }
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire)) return false;
+        copyOut(m_ring[head], time, data);
+        m_head.store(increment(head), std::memory_order_release);
+        return true;
+    }
+    /** Pop the most recent entry, discarding (and counting as dropped) any
+     * older entries still in the queue. This lets a consumer that fell behind
+     * catch up with a live stream. Return false if the queue is empty. */
+    bool try_pop_latest(double& time, SimTK::RowVector_<T>& data) {
+        if (!isBounded()) {
+            std::unique_lock<std::mutex> mlock(m_mutex);
+            if (m_data_queue.empty()) return false;
+            m_num_dropped.fetch_add(m_data_queue.size() - 1,
+                    std::memory_order_relaxed);
+            DataQueueEntry_<T> backEntry = std::move(m_data_queue.back());
+            m_data_queue = std::queue<DataQueueEntry_<T>>();
+            mlock.unlock();
+            time = backEntry.getTimeStamp();
+            data = backEntry.getData();
+            return true;
+        }
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        const std::size_t tail = m_tail.load(std::memory_order_acquire);
+        if (head == tail) return false;
+        const std::size_t last = tail == 0 ? m_ring.size() - 1 : tail - 1;
+        const std::size_t numSkipped =
+                (tail + m_ring.size() - head) % m_ring.size() - 1;
+        m_num_dropped.fetch_add(numSkipped, std::memory_order_relaxed);
+        copyOut(m_ring[last], time, data);
+        m_head.store(tail, std::memory_order_release);
+        return true;
+    }
     // check if the queue is empty
     bool isEmpty() { 
+        if (isBounded()) {
+            return m_head.load(std::memory_order_acquire) ==
+                   m_tail.load(std::memory_order_acquire);
+        }
         bool status = false;
         std::unique_lock<std::mutex> mlock(m_mutex);
         status = m_data_queue.empty();
         mlock.unlock(); 
         return status;
     }
+    /** The number of entries currently in the queue. When the producer or
+     * consumer is active, this is only a snapshot. */
+    std::size_t getSize() {
+        if (isBounded()) {
+            const std::size_t head = m_head.load(std::memory_order_acquire);
+            const std::size_t tail = m_tail.load(std::memory_order_acquire);
+            return (tail + m_ring.size() - head) % m_ring.size();
+        }
+        std::unique_lock<std::mutex> mlock(m_mutex);
+        return m_data_queue.size();
+    }
+    /** The number of push attempts rejected because the bounded queue was
+     * full. */
+    std::size_t getNumOverflows() const {
+        return m_num_overflows.load(std::memory_order_relaxed);
+    }
+    /** The number of entries that were never delivered to the consumer,
+     * either because the queue was full when they were pushed or because
+     * try_pop_latest() skipped them. */
+    std::size_t getNumDropped() const {
+        return m_num_dropped.load(std::memory_order_relaxed);
+    }
 private:
+    std::size_t increment(std::size_t index) const {
+        return index + 1 == m_ring.size() ? 0 : index + 1;
+    }
+    static void copyOut(const DataQueueEntry_<T>& entry, double& time,
+            SimTK::RowVector_<T>& data) {
+        time = entry.getTimeStamp();
+        const SimTK::RowVector_<T>& src = entry.getData();
+        const int n = src.size();
+        if (data.size() != n) data.resize(n);
+        for (int i = 0; i < n; ++i) data[i] = src[i];
+    }
+    void copyFrom(const DataQueue_& other) {
+        m_data_queue = other.m_data_queue;
+        m_ring = other.m_ring;
+        m_head.store(other.m_head.load());
+        m_tail.store(other.m_tail.load());
+        m_num_overflows.store(other.m_num_overflows.load());
+        m_num_dropped.store(other.m_num_dropped.load());
+    }
+
     // As of now we use std::queue but other data structures could be used as well
     std::queue<DataQueueEntry_<T>> m_data_queue;
     std::mutex m_mutex;
     std::condition_variable m_cond;
 
+    // Preallocated slots of the bounded (ring buffer) mode. Empty when the
+    // queue is unbounded. The consumer owns m_head and the producer owns
+    // m_tail; each only reads the other's index.
+    std::vector<DataQueueEntry_<T>> m_ring;
+    std::atomic<std::size_t> m_head{0};
+    std::atomic<std::size_t> m_tail{0};
+    std::atomic<std::size_t> m_num_overflows{0};
+    std::atomic<std::size_t> m_num_dropped{0};
+
     //=============================================================================
 };  // END of class templatized DataQueue_<T>
 //=============================================================================
@@ -662,15 +662,78 @@ public:
                              static_cast<size_t>(depRow.ncol()));
         }
 
+        // The underlying matrix may hold more rows than the table (see
+        // reserve()). Grow it geometrically so that appending n rows costs
+        // O(log n) reallocations rather than n.
+        const int numRows = static_cast<int>(_indData.size());
+        if(numRows == 0 && _depData.ncol() != depRow.ncol()) {
+            _depData.resize(std::max(_depData.nrow(), 1), depRow.ncol());
+        } else if(numRows == _depData.nrow()) {
+            _depData.resizeKeep(std::max(2 * numRows, 1), _depData.ncol());
+        }
+
+        _depData.updRow(numRows) = depRow;
         _indData.push_back(indRow);
+    }
+
+    /** Append multiple rows to the DataTable_. Storage for all the rows is
+    allocated once, up front, so this is the preferred way to append a block
+    of rows that is already available.
 
-        if(_depData.nrow() == 0) {
-            _depData.resize(1, depRow.size());
+    \param indCol Entries for the independent column corresponding to the rows
+                  to be appended.
+    \param depRows Matrix whose rows are to be appended. It must have as many
+                   rows as indCol has entries.
+
+    \throws IncorrectNumRows If depRows and indCol have different numbers of
+                             rows.
+    \throws IncorrectNumColumns If a row added is invalid. Validity of the
+    row added is decided by the derived class.                                */
+    void appendRows(const std::vector<ETX>& indCol,
+                    const SimTK::MatrixBase<ETY>& depRows) {
+        OPENSIM_THROW_IF(static_cast<size_t>(depRows.nrow()) != indCol.size(),
+                         IncorrectNumRows,
+                         indCol.size(),
+                         static_cast<size_t>(depRows.nrow()));
+        reserve(getNumRows() + indCol.size());
+        for(size_t r = 0; r < indCol.size(); ++r)
+            appendRow(indCol[r], depRows.row(static_cast<int>(r)));
+    }
+
+    /** Allocate storage for at least the given number of rows, so that rows
+    can then be appended without reallocating the underlying matrix. This is
+    analogous to std::vector::reserve(); the number of rows in the table is not
+    changed. If the table does not yet have rows, the number of columns is
+    taken from the column labels, if any. Requesting fewer rows than are
+    already allocated has no effect. The unused storage is released by
+    shrinkToFit(), or by the first subsequent call to updMatrix(),
+    appendColumn(), or removeColumnAtIndex().                                 */
+    void reserve(size_t numRows) {
+        if(static_cast<int>(numRows) <= _depData.nrow()) return;
+        int numColumns = _depData.ncol();
+        if(_indData.empty() && _dependentsMetaData.hasKey("labels")) {
+            numColumns = static_cast<int>(
+                _dependentsMetaData.getValueArrayForKey("labels").size());
         }
-        else 
-            _depData.resizeKeep(_depData.nrow() + 1, _depData.ncol());
-            
-        _depData.updRow(_depData.nrow() - 1) = depRow;
+        if(numColumns != _depData.ncol()) {
+            _depData.resize(static_cast<int>(numRows), numColumns);
+        } else {
+            _depData.resizeKeep(static_cast<int>(numRows), numColumns);
+        }
+    }
+
+    /** Number of rows for which storage is currently allocated. This is never
+    less than getNumRows().                                                   */
+    size_t getRowCapacity() const {
+        return static_cast<size_t>(_depData.nrow());
+    }
+
+    /** Release storage allocated for rows beyond getNumRows(). See
+    reserve().                                                                */
+    void shrinkToFit() {
+        const int numRows = static_cast<int>(_indData.size());
+        if(_depData.nrow() != numRows)
+            _depData.resizeKeep(numRows, _depData.ncol());
     }
 
     /** Get row at index.                                                     
@@ -789,7 +852,7 @@ public:
             for(size_t r = index; r < getNumRows() - 1; ++r)
                 _depData.updRow((int)r) = _depData.row((int)(r + 1));
         
-        _depData.resizeKeep(_depData.nrow() - 1, _depData.ncol());
+        // The last row of the matrix is now unused storage.
         _indData.erase(_indData.begin() + index);
     }
 
@@ -943,6 +1006,7 @@ public:
                          static_cast<size_t>(getNumRows()),
                          static_cast<size_t>(depCol.nrow()));
         
+        shrinkToFit();
         _depData.resizeKeep(_depData.nrow(), _depData.ncol() + 1);
         _depData.updCol(_depData.ncol() - 1) = depCol;
         appendColumnLabel(columnLabel);
@@ -956,6 +1020,8 @@ public:
             ColumnIndexOutOfRange,
             index, 0, static_cast<unsigned>(_depData.ncol() - 1));
 
+        shrinkToFit();
+
         // get copy of labels
         auto labels = getColumnLabels();
 
@@ -998,7 +1064,7 @@ public:
                          ColumnIndexOutOfRange, index, 0,
                          static_cast<size_t>(_depData.ncol() - 1));
 
-        return _depData.col(static_cast<int>(index));
+        return _depData.col(static_cast<int>(index))(0, (int)getNumRows());
     }
 
     /** Get dependent Column which has the given column label.                
@@ -1006,7 +1072,8 @@ public:
     \throws KeyNotFound If columnLabel is not found to be label of any existing
                         column.                                               */
     VectorView getDependentColumn(const std::string& columnLabel) const {
-        return _depData.col(static_cast<int>(getColumnIndex(columnLabel)));
+        return _depData.col(static_cast<int>(getColumnIndex(columnLabel)))(
+                0, (int)getNumRows());
     }
 
     /** Update dependent column at index.
@@ -1020,7 +1087,7 @@ public:
                          ColumnIndexOutOfRange, index, 0,
                          static_cast<size_t>(_depData.ncol() - 1));
 
-        return _depData.updCol(static_cast<int>(index));
+        return _depData.updCol(static_cast<int>(index))(0, (int)getNumRows());
     }
 
     /** Update dependent Column which has the given column label.
@@ -1028,7 +1095,9 @@ public:
     \throws KeyNotFound If columnLabel is not found to be label of any existing
                         column.                                               */
     VectorView updDependentColumn(const std::string& columnLabel) {
-        return _depData.updCol(static_cast<int>(getColumnIndex(columnLabel)));
+        return _depData.updCol(
+                static_cast<int>(getColumnIndex(columnLabel)))(
+                        0, (int)getNumRows());
     }
 
     /** %Set value of the independent column at index.
@@ -1055,9 +1124,13 @@ public:
     /// column.
     /// @{
 
-    /** Get a read-only view to the underlying matrix.                        */
-    const MatrixView& getMatrix() const {
-        return _depData.getAsMatrixView();
+    /** Get a read-only view to the underlying matrix. The view has
+    getNumRows() rows. If storage was reserved for more rows than the table
+    has (see reserve()), the view does not include the unused storage, and
+    its rows are then not contiguous in memory.                               */
+    const MatrixView getMatrix() const {
+        return _depData.block(0, 0, static_cast<int>(_indData.size()),
+                              _depData.ncol());
     }
 
     /** Get a read-only view of a block of the underlying matrix.             
@@ -1079,11 +1152,11 @@ public:
         OPENSIM_THROW_IF(isRowIndexOutOfRange(rowStart),
                          RowIndexOutOfRange,
                          rowStart, 0, 
-                         static_cast<unsigned>(_depData.nrow() - 1));
+                         static_cast<unsigned>(getNumRows() - 1));
         OPENSIM_THROW_IF(isRowIndexOutOfRange(rowStart + numRows - 1),
                          RowIndexOutOfRange,
                          rowStart + numRows - 1, 0, 
-                         static_cast<unsigned>(_depData.nrow() - 1));
+                         static_cast<unsigned>(getNumRows() - 1));
         OPENSIM_THROW_IF(isColumnIndexOutOfRange(columnStart),
                          ColumnIndexOutOfRange,
                          columnStart, 0, 
@@ -1099,8 +1172,11 @@ public:
                               static_cast<int>(numColumns));
     }
 
-    /** Get a writable view to the underlying matrix.                         */
+    /** Get a writable view to the underlying matrix. If storage was reserved
+    for more rows than the table has (see reserve()), the unused storage is
+    released first.                                                           */
     MatrixView& updMatrix() {
+        shrinkToFit();
         return _depData.updAsMatrixView();
     }
 
@@ -1123,11 +1199,11 @@ public:
         OPENSIM_THROW_IF(isRowIndexOutOfRange(rowStart),
                          RowIndexOutOfRange,
                          rowStart, 0, 
-                         static_cast<unsigned>(_depData.nrow() - 1));
+                         static_cast<unsigned>(getNumRows() - 1));
         OPENSIM_THROW_IF(isRowIndexOutOfRange(rowStart + numRows - 1),
                          RowIndexOutOfRange,
                          rowStart + numRows - 1, 0, 
-                         static_cast<unsigned>(_depData.nrow() - 1));
+                         static_cast<unsigned>(getNumRows() - 1));
         OPENSIM_THROW_IF(isColumnIndexOutOfRange(columnStart),
                          ColumnIndexOutOfRange,
                          columnStart, 0, 
@@ -1557,7 +1633,7 @@ protected:
 
     /** Get number of rows.                                                   */
     size_t implementGetNumRows() const override {
-        return _depData.nrow();
+        return _indData.size();
     }
 
     /** Get number of columns.                                                */
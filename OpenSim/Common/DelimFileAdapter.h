@@ -25,7 +25,9 @@
 #include "SimTKcommon.h"
 
 #include "About.h"
+#include "DelimTextParser.h"
 #include "FileAdapter.h"
+#include "MappedFile.h"
 #include "TimeSeriesTable.h"
 #include "OpenSim/Common/IO.h"
 
@@ -78,7 +80,11 @@ set the delimiters appropriately for the files they parse. The read/write
 functions return/accept a specific type of DataTable referred to as Table in 
 this class.                                                                   
 Header in the file is assumed to end with string "endheader" occupying a full
-line.                                                                         */
+line.                                                                         
+Files are read through a MappedFile and parsed in place with a
+DelimTextParser: the data rows are counted first so that the table is
+allocated once, and the rows can then be parsed on multiple threads (see
+setNumReadThreads()).                                                         */
 template<typename T>
 class DelimFileAdapter : public FileAdapter {
     static_assert(std::is_same<T, double           >::value ||
@@ -116,6 +122,12 @@ public:
     /** Name of the data type T (template parameter).                         */
     static inline std::string dataTypeName();
 
+    /** Set the number of threads used to parse the data rows when reading.
+    The default is 1 (parse on the calling thread); 0 uses all hardware
+    threads. Files with few rows are always parsed on the calling thread.     */
+    void setNumReadThreads(int numThreads) { _numReadThreads = numThreads; }
+    int getNumReadThreads() const { return _numReadThreads; }
+
 protected:
     /** Implementation of the read functionality.                             */
     OutputTables extendRead(const std::string& filename) const override;
@@ -162,6 +174,31 @@ private:
     readElems_impl(const std::vector<std::string>& tokens,
                    SimTK::Vec<M>) const;
 
+    /** Following overloads parse one element of type T from a token of the
+    file being read. `comps` is scratch space for the components of the
+    element.                                                                  */
+    inline void parseElem_impl(const DelimTextParser::Token& token,
+                               std::vector<DelimTextParser::Token>& comps,
+                               double& elem) const;
+    inline void parseElem_impl(const DelimTextParser::Token& token,
+                               std::vector<DelimTextParser::Token>& comps,
+                               SimTK::UnitVec3& elem) const;
+    inline void parseElem_impl(const DelimTextParser::Token& token,
+                               std::vector<DelimTextParser::Token>& comps,
+                               SimTK::Quaternion& elem) const;
+    inline void parseElem_impl(const DelimTextParser::Token& token,
+                               std::vector<DelimTextParser::Token>& comps,
+                               SimTK::SpatialVec& elem) const;
+    template<int M>
+    inline void parseElem_impl(const DelimTextParser::Token& token,
+                               std::vector<DelimTextParser::Token>& comps,
+                               SimTK::Vec<M>& elem) const;
+
+    /** Split a token into the expected number of components.               */
+    inline void splitComps(const DelimTextParser::Token& token,
+                           std::vector<DelimTextParser::Token>& comps,
+                           size_t expected) const;
+
     /** Following overloads implement writeElem().                            */
     inline void writeElem_impl(std::ostream& stream,
                                const double& elem,
@@ -198,6 +235,8 @@ private:
     static const std::string _opensimVersionString;
     /** File version number.                                                  */
     static const std::string _versionNumber;
+    /** Number of threads used to parse the data rows.                        */
+    int _numReadThreads{1};
 };
 
 
@@ -310,40 +349,37 @@ DelimFileAdapter<T>::extendRead(const std::string& fileName) const {
     OPENSIM_THROW_IF(fileName.empty(),
                      EmptyFileName);
 
-    std::ifstream in_stream{fileName};
-    OPENSIM_THROW_IF(!in_stream.good(),
-                     FileDoesNotExist,
-                     fileName);
+    // Throws FileDoesNotExist if the file cannot be opened.
+    const MappedFile file{fileName};
     
-    OPENSIM_THROW_IF(in_stream.peek() == std::ifstream::traits_type::eof(),
+    OPENSIM_THROW_IF(file.size() == 0,
                      FileIsEmpty,
                      fileName);
 
-    size_t line_num{};
+    DelimTextParser parser{file.data(), file.end()};
+
     // All the lines until "endheader" is header.
-    std::regex endheader{R"([ \t]*)" + _endHeaderString + R"([ \t]*)"};
-    std::regex keyvalue{R"((.*)=(.*))"};
     std::string header{};
     std::string line{};
     ValueArrayDictionary keyValuePairs;
-    while(std::getline(in_stream, line)) {
-        ++line_num;
-
-        // We might be parsing a file with CRLF (\r\n) line endings on a
-        // platform that uses only LF (\n) line endings, in which case the \r
-        // is part of `line` and we must remove it manually.
-        if (!line.empty() && line.back() == '\r') 
-            line.pop_back();
-
-        if(std::regex_match(line, endheader))
+    while(!parser.atEnd()) {
+        line = parser.nextLine().str();
+
+        // The line may contain leading/trailing spaces or tabs.
+        const auto first = line.find_first_not_of(" \t");
+        if(first != std::string::npos &&
+                line.compare(first, _endHeaderString.size(),
+                             _endHeaderString) == 0 &&
+                line.find_first_not_of(" \t",
+                        first + _endHeaderString.size()) == std::string::npos)
             break;
 
         // Detect Key value pairs of the form "key = value" and add them to
-        // metadata.
-        std::smatch matchRes{};
-        if(std::regex_match(line, matchRes, keyvalue)) {
-            auto key = matchRes[1].str();
-            auto value = matchRes[2].str();
+        // metadata. The value follows the last '='.
+        const auto equals = line.rfind('=');
+        if(equals != std::string::npos) {
+            auto key = line.substr(0, equals);
+            auto value = line.substr(equals + 1);
             IO::TrimWhitespace(value);
             if(!key.empty() && !value.empty()) {
                 const auto trimmed_key = trim(key);
@@ -374,19 +410,14 @@ DelimFileAdapter<T>::extendRead(const std::string& fileName) const {
     }
     keyValuePairs.setValueForKey("header", header);
 
-    // Callable to get the next line in form of vector of tokens.
-    auto nextLine = [&] {
-        return getNextLine(in_stream, _delimitersRead);
-    };
-
     // Read the line containing column labels and fill up the column labels
     // container.
     std::vector<std::string> column_labels{};
-    while (column_labels.size() == 0) { // keep going down rows to find labels
-        column_labels = nextLine();
+    while (column_labels.size() == 0 && !parser.atEnd()) {
+        // keep going down rows to find labels
+        column_labels = tokenize(parser.nextLine().str(), _delimitersRead);
         // for labels we never expect empty elements, so remove them
         IO::eraseEmptyElements(column_labels);
-        ++line_num;
     }
 
     OPENSIM_THROW_IF(column_labels.size() == 0, Exception,
@@ -401,55 +432,40 @@ DelimFileAdapter<T>::extendRead(const std::string& fileName) const {
                      column_labels[0]);
     column_labels.erase(column_labels.begin());
 
-    // Read the rows one at a time and fill up the time column container and
-    // the data container. Start with a reasonable initial capacity for
-    // tradeoff between a small file and larger files. 100 worked well for
-    // a 50 MB file with ~80000 lines.
-    std::vector<double> timeVec;
-    int initCapacity = 100;
-    int ncol = static_cast<int>(column_labels.size());
-    timeVec.reserve(initCapacity);
-    SimTK::Matrix_<T> matrix(initCapacity, ncol);
-    
-    // Initialize current row and capacity
-    int curCapacity = initCapacity;
-    int curRow = 0;
-
-    // Start looping through each line
-    auto row = nextLine();
-    while (!row.empty()) {
-        ++line_num;
-        
-        // Double capacity if we reach the end of the containers.
-        // This is necessary until Simbody issue #401 is addressed.
-        if (curRow+1 > curCapacity) {
-            curCapacity *= 2;
-            timeVec.reserve(curCapacity);
-            matrix.resizeKeep(curCapacity, ncol);
+    // Find all the rows up to the first empty line before parsing any of
+    // them, so that the time column and the data matrix are allocated once.
+    const auto rowStarts = parser.findRowStarts();
+    const size_t first_line_num = parser.getLineNumber() + 1;
+    const int nrow = static_cast<int>(rowStarts.size());
+    const int ncol = static_cast<int>(column_labels.size());
+    std::vector<double> timeVec(nrow);
+    SimTK::Matrix_<T> matrix(nrow, ncol);
+
+    // Rows are independent, so they can be parsed in parallel; each chunk
+    // of rows writes to its own rows of the preallocated containers.
+    auto parseRows = [&](size_t firstRow, size_t lastRow) {
+        std::vector<DelimTextParser::Token> tokens{};
+        std::vector<DelimTextParser::Token> comps{};
+        for(size_t r = firstRow; r < lastRow; ++r) {
+            DelimTextParser::tokenize(parser.getLine(rowStarts[r]),
+                                      _delimitersRead, tokens);
+
+            OPENSIM_THROW_IF(tokens.size() != column_labels.size() + 1,
+                RowLengthMismatch,
+                fileName,
+                first_line_num + r,
+                column_labels.size(),
+                tokens.size() - 1);
+
+            // Time is column 0.
+            const int row = static_cast<int>(r);
+            timeVec[r] = DelimTextParser::parseDouble(tokens.front());
+            for(int c = 0; c < ncol; ++c)
+                parseElem_impl(tokens[c + 1], comps, matrix(row, c));
         }
-
-        // Time is column 0.
-        timeVec.push_back(std::stod(row.front()));
-        row.erase(row.begin());
-
-        auto row_vector = readElems(row);
-
-        OPENSIM_THROW_IF(row_vector.size() != (int)column_labels.size(),
-            RowLengthMismatch,
-            fileName,
-            line_num,
-            column_labels.size(),
-            static_cast<size_t>(row_vector.size()));
-        
-        matrix.updRow(curRow) = std::move(row_vector);
-
-        row = nextLine();
-        ++curRow;
-    }
-
-    // Resize the matrix down to the correct number of rows.
-    // This is necessary until Simbody issue #401 is addressed.
-    matrix.resizeKeep(curRow, ncol);
+    };
+    DelimTextParser::parseInParallel(rowStarts.size(), _numReadThreads,
+                                     parseRows);
 
     // Create the table and update other metadata from above
     auto table = 
@@ -462,6 +478,72 @@ DelimFileAdapter<T>::extendRead(const std::string& fileName) const {
     return output_tables;
 }
 
+template<typename T>
+void
+DelimFileAdapter<T>::splitComps(const DelimTextParser::Token& token,
+                                std::vector<DelimTextParser::Token>& comps,
+                                size_t expected) const {
+    DelimTextParser::tokenize(token, _compDelimRead, comps);
+    OPENSIM_THROW_IF(comps.size() != expected,
+                     IncorrectNumTokens,
+                     "Expected " + std::to_string(expected) +
+                     "x (multiple of " + std::to_string(expected) +
+                     ") number of tokens.");
+}
+
+template<typename T>
+void
+DelimFileAdapter<T>::parseElem_impl(const DelimTextParser::Token& token,
+                                    std::vector<DelimTextParser::Token>&,
+                                    double& elem) const {
+    elem = DelimTextParser::parseDouble(token);
+}
+
+template<typename T>
+void
+DelimFileAdapter<T>::parseElem_impl(const DelimTextParser::Token& token,
+                                    std::vector<DelimTextParser::Token>& comps,
+                                    SimTK::UnitVec3& elem) const {
+    splitComps(token, comps, 3);
+    elem = SimTK::UnitVec3{DelimTextParser::parseDouble(comps[0]),
+                           DelimTextParser::parseDouble(comps[1]),
+                           DelimTextParser::parseDouble(comps[2])};
+}
+
+template<typename T>
+void
+DelimFileAdapter<T>::parseElem_impl(const DelimTextParser::Token& token,
+                                    std::vector<DelimTextParser::Token>& comps,
+                                    SimTK::Quaternion& elem) const {
+    splitComps(token, comps, 4);
+    elem = SimTK::Quaternion{DelimTextParser::parseDouble(comps[0]),
+                             DelimTextParser::parseDouble(comps[1]),
+                             DelimTextParser::parseDouble(comps[2]),
+                             DelimTextParser::parseDouble(comps[3])};
+}
+
+template<typename T>
+void
+DelimFileAdapter<T>::parseElem_impl(const DelimTextParser::Token& token,
+                                    std::vector<DelimTextParser::Token>& comps,
+                                    SimTK::SpatialVec& elem) const {
+    splitComps(token, comps, 6);
+    for(int i = 0; i < 2; ++i)
+        for(int j = 0; j < 3; ++j)
+            elem[i][j] = DelimTextParser::parseDouble(comps[3 * i + j]);
+}
+
+template<typename T>
+template<int M>
+void
+DelimFileAdapter<T>::parseElem_impl(const DelimTextParser::Token& token,
+                                    std::vector<DelimTextParser::Token>& comps,
+                                    SimTK::Vec<M>& elem) const {
+    splitComps(token, comps, M);
+    for(int j = 0; j < M; ++j)
+        elem[j] = DelimTextParser::parseDouble(comps[j]);
+}
+
 template<typename T>
 SimTK::RowVector_<T>
 DelimFileAdapter<T>::readElems(const std::vector<std::string>& tokens) const {
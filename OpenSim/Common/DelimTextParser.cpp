@@ -0,0 +1,159 @@
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  DelimTextParser.cpp                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2020 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "DelimTextParser.h"
+
+#include "CommonUtilities.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+using namespace OpenSim;
+
+namespace {
+    // Same characters as IO::TrimWhitespace().
+    inline bool isWhitespace(char ch) {
+        return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n';
+    }
+} // namespace
+
+DelimTextParser::DelimTextParser(const char* begin, const char* end) :
+    _pos(begin), _end(end) {}
+
+const char* DelimTextParser::findLineEnd(const char* lineBegin) const {
+    const void* newline = std::memchr(lineBegin, '\n', _end - lineBegin);
+    return newline ? static_cast<const char*>(newline) : _end;
+}
+
+DelimTextParser::Token DelimTextParser::getLine(const char* lineBegin) const {
+    const char* lineEnd = findLineEnd(lineBegin);
+    // Files with CRLF line endings may be parsed on any platform.
+    if (lineEnd != lineBegin && *(lineEnd - 1) == '\r') --lineEnd;
+    return {lineBegin, lineEnd};
+}
+
+DelimTextParser::Token DelimTextParser::nextLine() {
+    if (atEnd()) return {_end, _end};
+    const Token line = getLine(_pos);
+    const char* next = findLineEnd(_pos);
+    _pos = next == _end ? _end : next + 1;
+    ++_lineNumber;
+    return line;
+}
+
+DelimTextParser::Token DelimTextParser::peekLine() const {
+    if (atEnd()) return {_end, _end};
+    return getLine(_pos);
+}
+
+std::vector<const char*> DelimTextParser::findRowStarts() const {
+    std::vector<const char*> rowStarts;
+    // Estimate the number of rows from the length of the first one to avoid
+    // repeatedly growing the vector for large files.
+    if (_pos != _end) {
+        const std::size_t firstLength = findLineEnd(_pos) - _pos + 1;
+        rowStarts.reserve((_end - _pos) / firstLength + 1);
+    }
+    const char* pos = _pos;
+    while (pos != _end) {
+        if (getLine(pos).empty()) break;
+        rowStarts.push_back(pos);
+        const char* lineEnd = findLineEnd(pos);
+        pos = lineEnd == _end ? _end : lineEnd + 1;
+    }
+    return rowStarts;
+}
+
+void DelimTextParser::tokenize(const Token& line, const std::string& delims,
+                               std::vector<Token>& tokens) {
+    tokens.clear();
+    if (line.empty()) return;
+    const char* tokenBegin = line.begin;
+    while (true) {
+        const char* tokenEnd = tokenBegin;
+        while (tokenEnd != line.end &&
+                delims.find(*tokenEnd) == std::string::npos)
+            ++tokenEnd;
+
+        // Trim whitespace.
+        const char* first = tokenBegin;
+        const char* last = tokenEnd;
+        while (first != last && isWhitespace(*first)) ++first;
+        while (last != first && isWhitespace(*(last - 1))) --last;
+
+        if (tokenEnd == line.end) {
+            // As in FileAdapter::tokenize(), a trailing delimiter does not
+            // produce an empty token.
+            if (tokenEnd != tokenBegin) tokens.push_back({first, last});
+            return;
+        }
+        tokens.push_back({first, last});
+        tokenBegin = tokenEnd + 1;
+    }
+}
+
+double DelimTextParser::parseDouble(const Token& token) {
+    // strtod() requires a null-terminated string, and the buffer may not
+    // contain one (e.g., at the end of a memory-mapped file). Numbers are
+    // short, so copy the token to the stack.
+    char buffer[64];
+    std::string longToken;
+    const char* str = buffer;
+    const std::size_t size = token.size();
+    if (size < sizeof(buffer)) {
+        std::memcpy(buffer, token.begin, size);
+        buffer[size] = '\0';
+    } else {
+        longToken = token.str();
+        str = longToken.c_str();
+    }
+
+    char* parsedEnd = nullptr;
+    errno = 0;
+    const double value = std::strtod(str, &parsedEnd);
+    if (parsedEnd == str) throw std::invalid_argument("stod");
+    if (errno == ERANGE) throw std::out_of_range("stod");
+    return value;
+}
+
+void DelimTextParser::parseInParallel(std::size_t numRows, int numThreads,
+        const std::function<void(std::size_t, std::size_t)>& parseChunk,
+        std::size_t minRowsPerThread) {
+    numThreads = resolveNumThreads(numThreads);
+    minRowsPerThread = std::max<std::size_t>(minRowsPerThread, 1);
+    const std::size_t numChunks = std::max<std::size_t>(1,
+            std::min<std::size_t>(numThreads, numRows / minRowsPerThread));
+    if (numChunks == 1) {
+        parseChunk(0, numRows);
+        return;
+    }
+
+    const std::size_t rowsPerChunk = (numRows + numChunks - 1) / numChunks;
+    parallelFor((int)numChunks, (int)numChunks, [&](int chunk, int) {
+        const std::size_t first = chunk * rowsPerChunk;
+        const std::size_t last = std::min(numRows, first + rowsPerChunk);
+        if (first < last) parseChunk(first, last);
+    });
+}
@@ -0,0 +1,112 @@
+#ifndef OPENSIM_DELIM_TEXT_PARSER_H_
+#define OPENSIM_DELIM_TEXT_PARSER_H_
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  DelimTextParser.h                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2020 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimCommonDLL.h"
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace OpenSim {
+
+/** Parser for delimited text (e.g., STO, MOT, CSV and TRC files) held in a
+contiguous, read-only buffer such as a MappedFile. Unlike
+FileAdapter::getNextLine() and FileAdapter::tokenize(), lines and tokens are
+returned as ranges into the buffer, so no strings are allocated while parsing
+the data rows. The tokenizing rules are the same as those of
+FileAdapter::tokenize(): each delimiter character separates two tokens, and
+whitespace is trimmed from both ends of every token.
+
+The data section of a file can be parsed in two passes: findRowStarts() finds
+the rows (so the destination matrix can be allocated once), and then each row
+is tokenized and converted independently, optionally on multiple threads with
+parseInParallel().                                                            */
+class OSIMCOMMON_API DelimTextParser {
+public:
+    /** Range [begin, end) of characters within the buffer.                   */
+    struct Token {
+        const char* begin;
+        const char* end;
+        bool empty() const { return begin == end; }
+        std::size_t size() const { return std::size_t(end - begin); }
+        std::string str() const { return std::string(begin, end); }
+    };
+
+    /** Parse the characters in [begin, end).                                 */
+    DelimTextParser(const char* begin, const char* end);
+
+    /** Whether all lines have been consumed.                                 */
+    bool atEnd() const { return _pos == _end; }
+    /** Number of lines consumed so far; after nextLine(), this is the 1-based
+    line number of the returned line.                                        */
+    std::size_t getLineNumber() const { return _lineNumber; }
+
+    /** Return the next line, without its line ending (LF or CRLF), and
+    advance past it.                                                          */
+    Token nextLine();
+
+    /** Return the next line, like nextLine(), without advancing.             */
+    Token peekLine() const;
+
+    /** Starting at the current position, find the beginning of every line up
+    to (but excluding) the first empty line or the end of the buffer. The
+    current position is not changed.                                          */
+    std::vector<const char*> findRowStarts() const;
+
+    /** Return the line that begins at `lineBegin`, without its line ending.  */
+    Token getLine(const char* lineBegin) const;
+
+    /** Split `line` into `tokens` at any of the characters in `delims` and
+    trim whitespace from each token. `tokens` is cleared first; reuse it
+    across calls to avoid allocation. An empty line produces no tokens.       */
+    static void tokenize(const Token& line, const std::string& delims,
+                         std::vector<Token>& tokens);
+
+    /** Convert a token to a double, with the same result as std::stod()
+    (including NaN and Inf), and throw std::invalid_argument or
+    std::out_of_range in the same circumstances.                              */
+    static double parseDouble(const Token& token);
+
+    /** Call `parseChunk(first, last)` on contiguous chunks of the row range
+    [0, numRows) using up to `numThreads` threads (the calling thread
+    included). A `numThreads` of 0 uses the hardware concurrency. Chunks are
+    never smaller than `minRowsPerThread`, so small files are parsed on the
+    calling thread. If any chunk throws, the exception from the earliest chunk
+    is rethrown after all threads have finished.                              */
+    static void parseInParallel(std::size_t numRows, int numThreads,
+            const std::function<void(std::size_t, std::size_t)>& parseChunk,
+            std::size_t minRowsPerThread = 1024);
+
+private:
+    const char* findLineEnd(const char* lineBegin) const;
+
+    const char* _pos;
+    const char* _end;
+    std::size_t _lineNumber{0};
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_DELIM_TEXT_PARSER_H_
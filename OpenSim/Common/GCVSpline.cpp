@@ -600,3 +600,8 @@ SimTK::Function* GCVSpline::createSimTKFunction() const {
     return spline;
 }
 
+void GCVSpline::fit() const {
+    if (_function == NULL)
+        _function = createSimTKFunction();
+}
+
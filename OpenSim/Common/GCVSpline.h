@@ -233,6 +233,13 @@ public:
     //--------------------------------------------------------------------------
     // EVALUATION
     //--------------------------------------------------------------------------
+    /**
+     * Fit the spline to its data points now instead of on its first
+     * evaluation, and keep the fit for later evaluations. This also fills in
+     * the coefficients. Evaluating a spline from several threads at once is
+     * only safe once it has been fit.
+     */
+    void fit() const;
 
 //=============================================================================
 };  // END class GCVSpline
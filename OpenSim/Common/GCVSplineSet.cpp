@@ -24,7 +24,10 @@
 #include "GCVSplineSet.h"
 #include "GCVSpline.h"
 #include "Storage.h"
+#include "gcvspl.h"
+#include "CommonUtilities.h"
 
+#include <algorithm>
 
 using namespace OpenSim;
 
@@ -42,7 +45,8 @@ GCVSplineSet::GCVSplineSet(const char *aFileName) :
 }
 GCVSplineSet::GCVSplineSet(int aDegree,
                            const Storage *aStore,
-                           double aErrorVariance) {
+                           double aErrorVariance,
+                           int numThreads) {
     setNull();
     if(aStore==NULL) return;
     setName(aStore->getName());
@@ -53,13 +57,14 @@ GCVSplineSet::GCVSplineSet(int aDegree,
     ensureCapacity(2*vec->getSize());
 
     // CONSTRUCT
-    construct(aDegree,aStore,aErrorVariance);
+    construct(aDegree,aStore,aErrorVariance,numThreads);
 }
 
 GCVSplineSet::GCVSplineSet(const TimeSeriesTable& table,
                            const std::vector<std::string>& labels,
                            int degree,
-                           double errorVariance) {
+                           double errorVariance,
+                           int numThreads) {
     const auto& time = table.getIndependentColumn();
     auto labelsToUse = labels;
     if (labelsToUse.empty()) labelsToUse = table.getColumnLabels();
@@ -68,6 +73,7 @@ GCVSplineSet::GCVSplineSet(const TimeSeriesTable& table,
         adoptAndAppend(new GCVSpline(degree, column.size(), time.data(),
                                      &column[0], label, errorVariance));
     }
+    fitSplines(numThreads);
 }
 
 void GCVSplineSet::setNull() {
@@ -76,7 +82,8 @@ void GCVSplineSet::setNull() {
 
 void GCVSplineSet::construct(int aDegree,
                              const Storage *aStore,
-                             double aErrorVariance) {
+                             double aErrorVariance,
+                             int numThreads) {
     if(aStore==NULL) return;
 
     // DESCRIPTION
@@ -118,8 +125,6 @@ void GCVSplineSet::construct(int aDegree,
         // CONSTRUCT SPLINE
         //printf("%s\t",name);
         spline = new GCVSpline(aDegree,nData,times,data,name,aErrorVariance);
-        SimTK::Function* fp = spline->createSimTKFunction();
-        delete fp;  
 
         // ADD SPLINE
         adoptAndAppend(spline);
@@ -129,6 +134,61 @@ void GCVSplineSet::construct(int aDegree,
     // CLEANUP
     if(times!=NULL) delete[] times;
     if(data!=NULL) delete[] data;
+
+    // FIT
+    fitSplines(numThreads);
+}
+
+void GCVSplineSet::fitSplines(int numThreads) const {
+    const int n = getSize();
+    numThreads = std::min(resolveNumThreads(numThreads), n);
+
+    // Each spline is fit independently of the others, so each thread fits a
+    // contiguous block of them.
+    parallelFor(numThreads, numThreads, [&](int block, int) {
+        const int begin = (n*block)/numThreads;
+        const int end = (n*(block + 1))/numThreads;
+        for(int i=begin; i<end; i++) {
+            const GCVSpline* spline = dynamic_cast<const GCVSpline*>(&get(i));
+            if(spline!=NULL) spline->fit();
+        }
+    });
+}
+
+void GCVSplineSet::calcValues(double aX, SimTK::Vector& rValues,
+        SimTK::Vector* rFirstDerivs, SimTK::Vector* rSecondDerivs) const {
+    const int n = getSize();
+    if(rValues.size()!=n) rValues.resize(n);
+    if(rFirstDerivs!=NULL && rFirstDerivs->size()!=n)
+        rFirstDerivs->resize(n);
+    if(rSecondDerivs!=NULL && rSecondDerivs->size()!=n)
+        rSecondDerivs->resize(n);
+
+    // The knot interval found for one spline is the starting guess for the
+    // next. Splines constructed from the same data share their knots, so
+    // only the first search bisects; search() accepts the guess otherwise.
+    int interval = 1;
+    // Work space for splder(): 2*halfOrder entries, at most 8 (heptic).
+    double work[8];
+    for(int i=0; i<n; i++) {
+        const GCVSpline* spline = dynamic_cast<const GCVSpline*>(&get(i));
+        if(spline==NULL) {
+            rValues[i] = evaluate(i,0,aX);
+            if(rFirstDerivs!=NULL) (*rFirstDerivs)[i] = evaluate(i,1,aX);
+            if(rSecondDerivs!=NULL) (*rSecondDerivs)[i] = evaluate(i,2,aX);
+            continue;
+        }
+        spline->fit();
+        const int m = spline->getHalfOrder();
+        const int nx = spline->getSize();
+        double* x = const_cast<double*>(spline->getXValues());
+        double* c = const_cast<double*>(&spline->getCoefficients()[0]);
+        rValues[i] = splder(0,m,nx,aX,x,c,&interval,work);
+        if(rFirstDerivs!=NULL)
+            (*rFirstDerivs)[i] = splder(1,m,nx,aX,x,c,&interval,work);
+        if(rSecondDerivs!=NULL)
+            (*rSecondDerivs)[i] = splder(2,m,nx,aX,x,c,&interval,work);
+    }
 }
 
 GCVSpline* GCVSplineSet::getGCVSpline(int aIndex) const {
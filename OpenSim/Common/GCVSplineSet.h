@@ -77,10 +77,14 @@ public:
      * the error variance assumed for each column in the Storage.  If different
      * variances should be set for the various columns, you will need to
      * construct each GCVSpline individually.
+     * @param numThreads Number of threads used to fit the splines. The
+     * default, 1, fits them one after the other; 0 uses all available
+     * hardware threads. The splines do not depend on the number of threads.
      * @see Storage
      * @see GCVSpline
      */
-    GCVSplineSet(int aDegree,const Storage *aStore,double aErrorVariance=0.0);
+    GCVSplineSet(int aDegree,const Storage *aStore,double aErrorVariance=0.0,
+            int numThreads=1);
 
     /**
      * Construct a set of generalized cross-validated splines based on the 
@@ -100,13 +104,16 @@ public:
      * the error variance assumed for each column in the TimeSeriesTable.  If 
      * different variances should be set for the various columns, you will need 
      * to construct each GCVSpline individually.
+     * @param numThreads Number of threads used to fit the splines (see
+     * above).
      * @see TimeSeriesTable.
      * @see GCVSpline
      */
     GCVSplineSet(const TimeSeriesTable& table,
                  const std::vector<std::string>& labels = {},
                  int degree                             = 5,
-                 double errorVariance                   = 0.0);
+                 double errorVariance                   = 0.0,
+                 int numThreads                         = 1);
     virtual ~GCVSplineSet();
 
 private:
@@ -122,8 +129,16 @@ private:
      * @param aDegree Degree of the constructed splines (1, 3, 5, or 7).
      * @param aStore Storage object.
      * @param aErrorVariance Error variance for the data.
+     * @param numThreads Number of threads used to fit the splines.
      */
-    void construct(int aDegree,const Storage *aStore,double aErrorVariance);
+    void construct(int aDegree,const Storage *aStore,double aErrorVariance,
+            int numThreads);
+
+    /**
+     * Fit all the splines in the set, using numThreads threads (all available
+     * hardware threads if numThreads <= 0).
+     */
+    void fitSplines(int numThreads) const;
 
 public:
     /**
@@ -154,6 +169,32 @@ public:
      */
     Storage* constructStorage(int aDerivOrder,double aDX=-1);
 
+    //--------------------------------------------------------------------------
+    // EVALUATION
+    //--------------------------------------------------------------------------
+    /**
+     * Evaluate all the functions in the set, and optionally their first and
+     * second derivatives, at aX. This is equivalent to calling
+     * evaluate(i, 0, aX), evaluate(i, 1, aX) and evaluate(i, 2, aX) for each
+     * function, but the GCVSplines are evaluated directly from their
+     * coefficients, and the search for the knot interval containing aX is
+     * done once and shared by all splines. The outputs are resized to
+     * getSize() if they have a different size, so they can be views (e.g.,
+     * of the Q's of a SimTK::State). Functions that are not GCVSplines (e.g., Constants) are
+     * evaluated through the Function interface.
+     *
+     * The splines constructed by this set are fit in its constructors, so
+     * this method can be called from several threads at once.
+     *
+     * @param aX Value of the independent variable.
+     * @param rValues Values of the functions.
+     * @param rFirstDerivs If not null, first derivatives of the functions.
+     * @param rSecondDerivs If not null, second derivatives of the functions.
+     */
+    void calcValues(double aX, SimTK::Vector& rValues,
+            SimTK::Vector* rFirstDerivs = nullptr,
+            SimTK::Vector* rSecondDerivs = nullptr) const;
+
 };  // END class GCVSplineSet
 
 }; //namespace
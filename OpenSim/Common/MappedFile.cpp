@@ -0,0 +1,107 @@
+/* -------------------------------------------------------------------------- *
+ *                          OpenSim:  MappedFile.cpp                          *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2020 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "MappedFile.h"
+
+#include "FileAdapter.h"
+
+#include <fstream>
+#include <iterator>
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+using namespace OpenSim;
+
+MappedFile::MappedFile(const std::string& fileName) : _fileName(fileName) {
+    OPENSIM_THROW_IF(fileName.empty(), EmptyFileName);
+#ifdef _WIN32
+    HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ,
+            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file != INVALID_HANDLE_VALUE) {
+        LARGE_INTEGER fileSize;
+        if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+            HANDLE mapping = CreateFileMappingA(
+                    file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping) {
+                const void* view =
+                        MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                if (view) {
+                    _data = static_cast<const char*>(view);
+                    _size = static_cast<std::size_t>(fileSize.QuadPart);
+                    _mapping = mapping;
+                } else {
+                    CloseHandle(mapping);
+                }
+            }
+        }
+        CloseHandle(file);
+    }
+#else
+    const int fd = ::open(fileName.c_str(), O_RDONLY);
+    if (fd != -1) {
+        struct stat info;
+        if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+            void* addr = ::mmap(nullptr, static_cast<std::size_t>(info.st_size),
+                    PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr != MAP_FAILED) {
+                // Files are parsed front to back.
+                ::madvise(addr, static_cast<std::size_t>(info.st_size),
+                        MADV_SEQUENTIAL);
+                _data = static_cast<const char*>(addr);
+                _size = static_cast<std::size_t>(info.st_size);
+                _mapping = addr;
+            }
+        }
+        ::close(fd);
+    }
+#endif
+    if (_mapping) return;
+
+    // Mapping is not available (e.g., empty files or special files); read
+    // the contents into memory instead.
+    std::ifstream stream(fileName, std::ios::in | std::ios::binary);
+    OPENSIM_THROW_IF(!stream.good(), FileDoesNotExist, fileName);
+    _buffer.assign(std::istreambuf_iterator<char>(stream),
+                   std::istreambuf_iterator<char>());
+    _data = _buffer.data();
+    _size = _buffer.size();
+}
+
+MappedFile::~MappedFile() {
+    if (!_mapping) return;
+#ifdef _WIN32
+    UnmapViewOfFile(_data);
+    CloseHandle(static_cast<HANDLE>(_mapping));
+#else
+    ::munmap(_mapping, _size);
+#endif
+}
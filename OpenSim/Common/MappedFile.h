@@ -0,0 +1,71 @@
+#ifndef OPENSIM_MAPPED_FILE_H_
+#define OPENSIM_MAPPED_FILE_H_
+/* -------------------------------------------------------------------------- *
+ *                           OpenSim:  MappedFile.h                           *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2020 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimCommonDLL.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace OpenSim {
+
+/** Read-only view of the entire contents of a file. The file is memory-mapped
+when the platform supports it, so that the operating system pages the contents
+in on demand and no copy of the file is made; otherwise (or if mapping fails)
+the contents are read into a buffer owned by this object. Either way, data()
+points to size() contiguous bytes that remain valid for the lifetime of this
+object.
+
+@note The file should not be modified while it is mapped.                     */
+class OSIMCOMMON_API MappedFile {
+public:
+    /** Open and map the given file. Throws FileDoesNotExist if the file
+    cannot be opened.                                                         */
+    explicit MappedFile(const std::string& fileName);
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile();
+
+    /** First byte of the file. Not null-terminated.                          */
+    const char* data() const { return _data; }
+    /** Number of bytes in the file.                                          */
+    std::size_t size() const { return _size; }
+    /** One past the last byte of the file.                                   */
+    const char* end() const { return _data + _size; }
+    /** Whether the contents are memory-mapped rather than copied.            */
+    bool isMapped() const { return _mapping != nullptr; }
+    const std::string& getFileName() const { return _fileName; }
+
+private:
+    std::string _fileName;
+    const char* _data{nullptr};
+    std::size_t _size{0};
+    // Platform handle of the mapping; null if the contents are in _buffer.
+    void* _mapping{nullptr};
+    std::vector<char> _buffer;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_MAPPED_FILE_H_
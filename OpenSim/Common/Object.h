@@ -1448,6 +1448,18 @@ ObjectProperty<T>::setValueAsObject(const Object& obj, int index) {
 
     objects[index] = newObjT;
 }
+
+template <class T> inline int
+ObjectProperty<T>::adoptAndAppendValueAsObject(Object* obj) {
+    T* objT = dynamic_cast<T*>(obj);
+    if (objT == NULL)
+        throw OpenSim::Exception
+            ("ObjectProperty<T>::adoptAndAppendValueAsObject(): the supplied "
+            "object " + obj->getName() + " was of type "
+            + obj->getConcreteClassName() + " which can't be stored in this "
+            + objectClassName + " property " + this->getName());
+    return this->adoptAndAppendValue(objT);
+}
 /** @endcond **/
 
 //==============================================================================
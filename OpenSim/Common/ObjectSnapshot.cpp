@@ -0,0 +1,427 @@
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  ObjectSnapshot.cpp                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2020 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "ObjectSnapshot.h"
+
+#include "Function.h"
+#include "Object.h"
+#include "Property.h"
+#include "PropertySet.h"
+#include "XMLDocument.h"
+
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <ostream>
+
+using namespace OpenSim;
+
+namespace {
+
+// How an object is stored.
+enum ObjectFormat : std::uint8_t { BinaryFormat = 0, XMLFormat = 1 };
+
+// How the values of a (non-deprecated) property are stored.
+enum ValueFormat : std::uint8_t {
+    ObjectValues = 0,
+    DoubleValues,
+    IntValues,
+    BoolValues,
+    StringValues,
+    Vec3Values,
+    // Any other simple type is stored as the text of its XML element.
+    TextValues
+};
+
+template <typename T>
+void writeValue(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+void writeValue(std::ostream& out, const std::string& value) {
+    writeValue<std::uint32_t>(out, (std::uint32_t)value.size());
+    out.write(value.data(), value.size());
+}
+void writeValue(std::ostream& out, bool value) {
+    writeValue<std::uint8_t>(out, value);
+}
+void writeValue(std::ostream& out, int value) {
+    writeValue<std::int32_t>(out, value);
+}
+
+template <typename T>
+T readValue(std::istream& in) {
+    T value;
+    in.read(reinterpret_cast<char*>(&value), sizeof(T));
+    OPENSIM_THROW_IF(!in, Exception, "Unexpected end of object snapshot.");
+    return value;
+}
+template <>
+std::string readValue<std::string>(std::istream& in) {
+    const auto size = readValue<std::uint32_t>(in);
+    std::string value(size, '\0');
+    in.read(&value[0], size);
+    OPENSIM_THROW_IF(!in, Exception, "Unexpected end of object snapshot.");
+    return value;
+}
+template <>
+bool readValue<bool>(std::istream& in) {
+    return readValue<std::uint8_t>(in) != 0;
+}
+template <>
+int readValue<int>(std::istream& in) {
+    return readValue<std::int32_t>(in);
+}
+
+// Functions compute their coefficients in updateFromXMLNode(), and objects
+// with deprecated vector or transform properties are rare, so these objects
+// are stored as XML.
+bool mustWriteAsXML(const Object& object) {
+    if (dynamic_cast<const Function*>(&object)) return true;
+    const PropertySet& propertySet = object.getPropertySet();
+    for (int i = 0; i < propertySet.getSize(); ++i) {
+        switch (propertySet.get(i)->getType()) {
+        case Property_Deprecated::Bool:
+        case Property_Deprecated::Int:
+        case Property_Deprecated::Dbl:
+        case Property_Deprecated::Str:
+        case Property_Deprecated::BoolArray:
+        case Property_Deprecated::IntArray:
+        case Property_Deprecated::DblArray:
+        case Property_Deprecated::StrArray:
+        case Property_Deprecated::Obj:
+        case Property_Deprecated::ObjPtr:
+        case Property_Deprecated::ObjArray:
+            break;
+        default:
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename T>
+bool writeSimpleValues(std::ostream& out, const AbstractProperty& prop,
+        ValueFormat format) {
+    const auto* propT = dynamic_cast<const Property<T>*>(&prop);
+    if (!propT) return false;
+    writeValue(out, format);
+    writeValue(out, (std::uint32_t)propT->size());
+    for (int i = 0; i < propT->size(); ++i) writeValue(out, propT->getValue(i));
+    return true;
+}
+
+template <typename T>
+void readSimpleValues(std::istream& in, AbstractProperty& prop) {
+    auto* propT = dynamic_cast<Property<T>*>(&prop);
+    OPENSIM_THROW_IF(!propT, Exception,
+            "Property '{}' in the object snapshot has a different type ({}).",
+            prop.getName(), prop.getTypeName());
+    const auto size = readValue<std::uint32_t>(in);
+    propT->clearValues();
+    for (std::uint32_t i = 0; i < size; ++i)
+        propT->appendValue(readValue<T>(in));
+}
+
+void writeObject(std::ostream& out, const Object& object);
+Object* readObject(std::istream& in);
+void readBinaryObject(std::istream& in, Object& object);
+
+// Read the object in the stream, reusing `existing` (if not null) when it
+// has the same concrete type. Returns the new object, or null if `existing`
+// was reused.
+Object* readObjectInto(std::istream& in, Object* existing) {
+    const auto format = readValue<std::uint8_t>(in);
+    const auto className = readValue<std::string>(in);
+    if (format == XMLFormat) {
+        SimTK::Xml::Document document;
+        document.readFromString(readValue<std::string>(in));
+        SimTK::Xml::Element element = document.getRootElement();
+        std::unique_ptr<Object> object(
+                Object::newInstanceOfType(element.getElementTag()));
+        OPENSIM_THROW_IF(!object, Exception,
+                "Type '{}' in the object snapshot is not registered.",
+                element.getElementTag());
+        object->updateFromXMLNode(element, XMLDocument::getLatestVersion());
+        return object.release();
+    }
+    OPENSIM_THROW_IF(format != BinaryFormat, Exception,
+            "Object snapshot is corrupt (unknown object format {}).",
+            (int)format);
+    if (existing && existing->getConcreteClassName() == className) {
+        readBinaryObject(in, *existing);
+        return nullptr;
+    }
+    std::unique_ptr<Object> object(Object::newInstanceOfType(className));
+    OPENSIM_THROW_IF(!object, Exception,
+            "Type '{}' in the object snapshot is not registered.", className);
+    readBinaryObject(in, *object);
+    return object.release();
+}
+
+Object* readObject(std::istream& in) {
+    return readObjectInto(in, nullptr);
+}
+
+void writeProperty(std::ostream& out, const AbstractProperty& prop) {
+    if (prop.isObjectProperty()) {
+        writeValue(out, ObjectValues);
+        writeValue(out, (std::uint32_t)prop.size());
+        for (int i = 0; i < prop.size(); ++i)
+            writeObject(out, prop.getValueAsObject(i));
+        return;
+    }
+    if (writeSimpleValues<double>(out, prop, DoubleValues)) return;
+    if (writeSimpleValues<int>(out, prop, IntValues)) return;
+    if (writeSimpleValues<bool>(out, prop, BoolValues)) return;
+    if (writeSimpleValues<std::string>(out, prop, StringValues)) return;
+    if (writeSimpleValues<SimTK::Vec3>(out, prop, Vec3Values)) return;
+    SimTK::Xml::Element element(prop.getName());
+    prop.writeToXMLElement(element);
+    writeValue(out, TextValues);
+    writeValue(out, std::string(element.getValue()));
+}
+
+void readProperty(std::istream& in, AbstractProperty& prop) {
+    const auto format = readValue<std::uint8_t>(in);
+    switch (format) {
+    case ObjectValues: {
+        const auto size = (int)readValue<std::uint32_t>(in);
+        if (prop.size() != size) prop.clearValues();
+        for (int i = 0; i < size; ++i) {
+            Object* existing = i < prop.size() ? &prop.updValueAsObject(i)
+                                               : nullptr;
+            std::unique_ptr<Object> object(readObjectInto(in, existing));
+            if (!object) continue;
+            if (i < prop.size()) {
+                prop.setValueAsObject(*object, i);
+            } else {
+                prop.adoptAndAppendValueAsObject(object.get());
+                object.release();
+            }
+        }
+        break;
+    }
+    case DoubleValues: readSimpleValues<double>(in, prop); break;
+    case IntValues: readSimpleValues<int>(in, prop); break;
+    case BoolValues: readSimpleValues<bool>(in, prop); break;
+    case StringValues: readSimpleValues<std::string>(in, prop); break;
+    case Vec3Values: readSimpleValues<SimTK::Vec3>(in, prop); break;
+    case TextValues: {
+        SimTK::Xml::Element element(prop.getName(),
+                readValue<std::string>(in));
+        prop.readFromXMLElement(element, XMLDocument::getLatestVersion());
+        break;
+    }
+    default:
+        OPENSIM_THROW(Exception,
+                "Object snapshot is corrupt (unknown value format {}).",
+                (int)format);
+    }
+}
+
+template <typename T>
+void writeArray(std::ostream& out, const Array<T>& array) {
+    writeValue(out, (std::uint32_t)array.getSize());
+    for (int i = 0; i < array.getSize(); ++i) writeValue(out, array[i]);
+}
+
+template <typename T>
+Array<T> readArray(std::istream& in) {
+    const auto size = (int)readValue<std::uint32_t>(in);
+    Array<T> array;
+    array.setSize(size);
+    for (int i = 0; i < size; ++i) array[i] = readValue<T>(in);
+    return array;
+}
+
+void writeDeprecatedProperty(
+        std::ostream& out, const Property_Deprecated& prop) {
+    switch (prop.getType()) {
+    case Property_Deprecated::Bool:
+        writeValue(out, prop.getValueBool()); break;
+    case Property_Deprecated::Int:
+        writeValue(out, prop.getValueInt()); break;
+    case Property_Deprecated::Dbl:
+        writeValue(out, prop.getValueDbl()); break;
+    case Property_Deprecated::Str:
+        writeValue(out, prop.getValueStr()); break;
+    case Property_Deprecated::BoolArray:
+        writeArray(out, prop.getValueBoolArray()); break;
+    case Property_Deprecated::IntArray:
+        writeArray(out, prop.getValueIntArray()); break;
+    case Property_Deprecated::DblArray:
+        writeArray(out, prop.getValueDblArray()); break;
+    case Property_Deprecated::StrArray:
+        writeArray(out, prop.getValueStrArray()); break;
+    case Property_Deprecated::Obj:
+        writeObject(out, prop.getValueObj()); break;
+    case Property_Deprecated::ObjPtr:
+        writeValue(out, prop.getValueObjPtr() != nullptr);
+        if (prop.getValueObjPtr()) writeObject(out, *prop.getValueObjPtr());
+        break;
+    case Property_Deprecated::ObjArray:
+        writeValue(out, (std::uint32_t)prop.getArraySize());
+        for (int i = 0; i < prop.getArraySize(); ++i)
+            writeObject(out, *prop.getValueObjPtr(i));
+        break;
+    default:
+        // Excluded by mustWriteAsXML().
+        OPENSIM_THROW(Exception, "Unexpected type for property '{}'.",
+                prop.getName());
+    }
+}
+
+void readDeprecatedProperty(std::istream& in, Property_Deprecated& prop) {
+    switch (prop.getType()) {
+    case Property_Deprecated::Bool:
+        prop.setValue(readValue<bool>(in)); break;
+    case Property_Deprecated::Int:
+        prop.setValue(readValue<int>(in)); break;
+    case Property_Deprecated::Dbl:
+        prop.setValue(readValue<double>(in)); break;
+    case Property_Deprecated::Str:
+        prop.setValue(readValue<std::string>(in)); break;
+    case Property_Deprecated::BoolArray:
+        prop.setValue(readArray<bool>(in)); break;
+    case Property_Deprecated::IntArray:
+        prop.setValue(readArray<int>(in)); break;
+    case Property_Deprecated::DblArray:
+        prop.setValue(readArray<double>(in)); break;
+    case Property_Deprecated::StrArray:
+        prop.setValue(readArray<std::string>(in)); break;
+    case Property_Deprecated::Obj: {
+        std::unique_ptr<Object> object(
+                readObjectInto(in, &prop.getValueObj()));
+        OPENSIM_THROW_IF(object != nullptr, Exception,
+                "Object in property '{}' has a different type.",
+                prop.getName());
+        break;
+    }
+    case Property_Deprecated::ObjPtr:
+        if (readValue<bool>(in)) prop.setValue(readObject(in));
+        break;
+    case Property_Deprecated::ObjArray: {
+        const auto size = readValue<std::uint32_t>(in);
+        prop.clearObjArray();
+        for (std::uint32_t i = 0; i < size; ++i) {
+            std::unique_ptr<Object> object(readObject(in));
+            prop.appendValue(object.get());
+            object.release();
+        }
+        break;
+    }
+    default:
+        OPENSIM_THROW(Exception, "Unexpected type for property '{}'.",
+                prop.getName());
+    }
+}
+
+void writeObject(std::ostream& out, const Object& object) {
+    if (mustWriteAsXML(object)) {
+        writeValue(out, XMLFormat);
+        writeValue(out, object.getConcreteClassName());
+        SimTK::Xml::Element parent("snapshot");
+        object.updateXMLNode(parent);
+        SimTK::String text;
+        parent.element_begin()->writeToString(text, true);
+        writeValue(out, std::string(text));
+        return;
+    }
+    writeValue(out, BinaryFormat);
+    writeValue(out, object.getConcreteClassName());
+    writeValue(out, object.getName());
+    writeValue(out, object.getDescription());
+    writeValue(out, object.getAuthors());
+    writeValue(out, object.getReferences());
+
+    writeValue(out, (std::uint32_t)object.getNumProperties());
+    for (int i = 0; i < object.getNumProperties(); ++i) {
+        const AbstractProperty& prop = object.getPropertyByIndex(i);
+        writeValue(out, prop.getName());
+        writeValue(out, prop.getValueIsDefault());
+        writeProperty(out, prop);
+    }
+
+    const PropertySet& propertySet = object.getPropertySet();
+    writeValue(out, (std::uint32_t)propertySet.getSize());
+    for (int i = 0; i < propertySet.getSize(); ++i) {
+        const Property_Deprecated& prop = *propertySet.get(i);
+        writeValue(out, prop.getName());
+        writeValue(out, prop.getValueIsDefault());
+        writeDeprecatedProperty(out, prop);
+    }
+}
+
+// Properties are read in the order in which the object declares them; the
+// names are only checked, to detect a snapshot from a different build.
+void readBinaryObject(std::istream& in, Object& object) {
+    object.setName(readValue<std::string>(in));
+    object.setDescription(readValue<std::string>(in));
+    object.setAuthors(readValue<std::string>(in));
+    object.setReferences(readValue<std::string>(in));
+
+    const auto numProperties = (int)readValue<std::uint32_t>(in);
+    OPENSIM_THROW_IF(numProperties != object.getNumProperties(), Exception,
+            "{} in the object snapshot has {} properties, but expected {}.",
+            object.getConcreteClassName(), numProperties,
+            object.getNumProperties());
+    for (int i = 0; i < numProperties; ++i) {
+        AbstractProperty& prop = object.updPropertyByIndex(i);
+        const auto name = readValue<std::string>(in);
+        OPENSIM_THROW_IF(name != prop.getName(), Exception,
+                "Expected property '{}' of {} in the object snapshot, but "
+                "found '{}'.", prop.getName(), object.getConcreteClassName(),
+                name);
+        const bool isDefault = readValue<bool>(in);
+        readProperty(in, prop);
+        prop.setValueIsDefault(isDefault);
+    }
+
+    PropertySet& propertySet = object.getPropertySet();
+    const auto numDeprecated = (int)readValue<std::uint32_t>(in);
+    OPENSIM_THROW_IF(numDeprecated != propertySet.getSize(), Exception,
+            "{} in the object snapshot has {} deprecated properties, but "
+            "expected {}.", object.getConcreteClassName(), numDeprecated,
+            propertySet.getSize());
+    for (int i = 0; i < numDeprecated; ++i) {
+        Property_Deprecated& prop = *propertySet.get(i);
+        const auto name = readValue<std::string>(in);
+        OPENSIM_THROW_IF(name != prop.getName(), Exception,
+                "Expected property '{}' of {} in the object snapshot, but "
+                "found '{}'.", prop.getName(), object.getConcreteClassName(),
+                name);
+        const bool isDefault = readValue<bool>(in);
+        readDeprecatedProperty(in, prop);
+        prop.setValueIsDefault(isDefault);
+    }
+}
+
+} // anonymous namespace
+
+void ObjectSnapshot::write(std::ostream& out, const Object& object) {
+    writeObject(out, object);
+    OPENSIM_THROW_IF(!out, Exception, "Failed to write object snapshot.");
+}
+
+Object* ObjectSnapshot::read(std::istream& in) {
+    return readObject(in);
+}
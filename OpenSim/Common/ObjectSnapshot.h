@@ -0,0 +1,58 @@
+#ifndef OPENSIM_OBJECT_SNAPSHOT_H_
+#define OPENSIM_OBJECT_SNAPSHOT_H_
+/* -------------------------------------------------------------------------- *
+ *                         OpenSim:  ObjectSnapshot.h                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2020 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimCommonDLL.h"
+
+#include <iosfwd>
+
+namespace OpenSim {
+
+class Object;
+
+/** Write and read Objects (and everything they contain) in a compact binary
+format, as a faster alternative to XML for caching Objects that were loaded
+from files. The property values are written as they are in memory: no XML
+document is created or parsed for the properties of most objects, and no
+version updates are applied when reading, so a snapshot is only meant to be
+read by the same build of OpenSim that wrote it.
+
+The few kinds of objects that compute members from their properties while
+being read from XML (e.g., Functions, which compute their coefficients) are
+written as XML so that they are read exactly as they are from a file.
+
+See ModelSnapshot for caching Models. */
+class OSIMCOMMON_API ObjectSnapshot {
+public:
+    /** Write `object` to the binary stream `out`. */
+    static void write(std::ostream& out, const Object& object);
+    /** Read an object written by write() from the binary stream `in`. The
+    caller takes ownership of the object.
+    @throws Exception if the stream does not contain a valid object or if the
+    object contains a type that is not registered. */
+    static Object* read(std::istream& in);
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_OBJECT_SNAPSHOT_H_
@@ -1109,6 +1109,7 @@ public:
     void writeToXMLElement
        (SimTK::Xml::Element& propertyElement) const override final;
     void setValueAsObject(const Object& obj, int index=-1) override final;
+    int adoptAndAppendValueAsObject(Object* obj) override final;
 
     bool isUnnamedProperty() const override final {return isUnnamed;}
     bool isObjectProperty() const override final {return true;}
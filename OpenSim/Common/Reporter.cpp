@@ -118,5 +118,18 @@ void AbstractReporter::report(const SimTK::State& s) const
     implementReport(s);
 }
 
+void AbstractReporter::prepareToReport(
+        double initialTime, double finalTime) const
+{
+    const double reportInterval = get_report_time_interval();
+    if (reportInterval < SimTK::Eps || finalTime < initialTime) return;
+
+    // The periodic event reporter fires at integer multiples of the interval.
+    const double first = std::ceil(initialTime / reportInterval - SimTK::SqrtEps);
+    const double last = std::floor(finalTime / reportInterval + SimTK::SqrtEps);
+    if (last < first) return;
+    implementReserveReports(static_cast<int>(last - first) + 1);
+}
+
 
 } // end of namespace OpenSim
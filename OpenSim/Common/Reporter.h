@@ -60,6 +60,13 @@ public:
     /** Report values given the state and top-level Component (e.g. Model) */
     void report(const SimTK::State& s) const;
 
+    /** Inform the reporter that a simulation will run from initialTime to
+    finalTime, so that it can allocate storage for its reports ahead of time.
+    Manager::integrate() calls this on every reporter in the model. This has
+    no effect if report_time_interval is 0, since the number of reports then
+    depends on the integrator's step sizes. */
+    void prepareToReport(double initialTime, double finalTime) const;
+
 protected:
     /** Default constructor sets up Reporter-level properties; can only be
     called from a derived class constructor. **/
@@ -75,6 +82,10 @@ protected:
     //--------------------------------------------------------------------------
     virtual void implementReport(const SimTK::State& state) const = 0;
 
+    /** Allocate storage for the given number of upcoming reports. The default
+    implementation does nothing. */
+    virtual void implementReserveReports(int /*numReports*/) const {}
+
     //--------------------------------------------------------------------------
     // Component interface.
     //--------------------------------------------------------------------------
@@ -225,6 +236,16 @@ protected:
         }
     }
 
+    void implementReserveReports(int numReports) const override {
+        // Grow geometrically so that a loop of many short integrations
+        // does not reallocate the table on every call.
+        auto& table = const_cast<Self*>(this)->_outputTable;
+        const size_t numRows = table.getNumRows() + numReports;
+        if (numRows > table.getRowCapacity()) {
+            table.reserve(std::max(numRows, 2 * table.getRowCapacity()));
+        }
+    }
+
     void extendFinalizeConnections(Component& root) override {
         Super::extendFinalizeConnections(root);
 
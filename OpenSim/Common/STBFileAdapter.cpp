@@ -0,0 +1,281 @@
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  STBFileAdapter.cpp                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2020 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "STBFileAdapter.h"
+
+#include "MappedFile.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+using namespace OpenSim;
+
+namespace {
+
+const char signature[8] = {'O', 'S', 'I', 'M', 'S', 'T', 'B', '\0'};
+const std::uint32_t byteOrderMark = 0x01020304;
+const std::uint32_t version = 1;
+
+std::size_t paddingFor(std::size_t offset) {
+    return (sizeof(double) - offset % sizeof(double)) % sizeof(double);
+}
+
+int numComponentsOf(const std::string& dataType) {
+    if (dataType == "double") return 1;
+    if (dataType == "Vec3") return 3;
+    if (dataType == "Quaternion") return 4;
+    return 0;
+}
+
+// Bounds-checked reading of the header of an STB file.
+class HeaderReader {
+public:
+    HeaderReader(const MappedFile& file) :
+            _begin(file.data()), _pos(file.data()), _end(file.end()),
+            _fileName(file.getFileName()) {}
+
+    template <typename U>
+    U read() {
+        require(sizeof(U));
+        U value;
+        std::memcpy(&value, _pos, sizeof(U));
+        _pos += sizeof(U);
+        return value;
+    }
+
+    std::string readString() {
+        const auto length = read<std::uint32_t>();
+        require(length);
+        std::string str(_pos, length);
+        _pos += length;
+        return str;
+    }
+
+    void skipPadding() {
+        const std::size_t padding = paddingFor(_pos - _begin);
+        require(padding);
+        _pos += padding;
+    }
+
+    const char* position() const { return _pos; }
+    std::size_t remaining() const { return std::size_t(_end - _pos); }
+
+private:
+    void require(std::size_t numBytes) const {
+        OPENSIM_THROW_IF(remaining() < numBytes, InvalidSTBFile, _fileName,
+                "Unexpected end of file.");
+    }
+
+    const char* _begin;
+    const char* _pos;
+    const char* _end;
+    const std::string& _fileName;
+};
+
+void writeString(std::ostream& out, const std::string& str) {
+    const auto length = static_cast<std::uint32_t>(str.size());
+    out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+    out.write(str.data(), str.size());
+}
+
+template <typename U>
+void writeValue(std::ostream& out, const U& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(U));
+}
+
+template <typename ETY>
+void writeTable(const TimeSeriesTable_<ETY>& table,
+        const std::string& dataType, const std::string& fileName) {
+    std::ofstream out(fileName, std::ios::binary);
+    OPENSIM_THROW_IF(!out, IOError,
+            "Could not open file '" + fileName + "' for writing.");
+
+    std::vector<std::pair<std::string, std::string>> metaData;
+    for (const auto& key : table.getTableMetaDataKeys()) {
+        try {
+            metaData.emplace_back(
+                    key, table.template getTableMetaData<std::string>(key));
+        } catch (const InvalidTemplateArgument&) {}
+    }
+    const auto labels = table.getColumnLabels();
+    const std::size_t nrow = table.getNumRows();
+
+    out.write(signature, sizeof(signature));
+    writeValue(out, byteOrderMark);
+    writeValue(out, version);
+    writeString(out, dataType);
+    writeValue(out, static_cast<std::uint64_t>(nrow));
+    writeValue(out, static_cast<std::uint64_t>(labels.size()));
+    writeValue(out, static_cast<std::uint64_t>(metaData.size()));
+    for (const auto& keyValue : metaData) {
+        writeString(out, keyValue.first);
+        writeString(out, keyValue.second);
+    }
+    for (const auto& label : labels) writeString(out, label);
+    const char zeros[sizeof(double)] = {};
+    out.write(zeros, paddingFor(static_cast<std::size_t>(out.tellp())));
+
+    const auto& time = table.getIndependentColumn();
+    out.write(reinterpret_cast<const char*>(time.data()),
+            nrow * sizeof(double));
+
+    // Gather each column into a contiguous block.
+    const auto& matrix = table.getMatrix();
+    std::vector<ETY> column(nrow);
+    for (int j = 0; j < matrix.ncol(); ++j) {
+        for (int i = 0; i < matrix.nrow(); ++i) column[i] = matrix(i, j);
+        out.write(reinterpret_cast<const char*>(column.data()),
+                nrow * sizeof(ETY));
+    }
+    OPENSIM_THROW_IF(!out, IOError,
+            "Error writing to file '" + fileName + "'.");
+}
+
+} // anonymous namespace
+
+MappedSTBFile::MappedSTBFile(const std::string& fileName) :
+        _file(new MappedFile(fileName)) {
+    HeaderReader reader(*_file);
+    char fileSignature[sizeof(signature)];
+    for (auto& c : fileSignature) c = reader.read<char>();
+    OPENSIM_THROW_IF(std::memcmp(fileSignature, signature, sizeof(signature)),
+            InvalidSTBFile, fileName, "Signature not found.");
+    OPENSIM_THROW_IF(reader.read<std::uint32_t>() != byteOrderMark,
+            InvalidSTBFile, fileName,
+            "The file was written with a different byte order.");
+    const auto fileVersion = reader.read<std::uint32_t>();
+    OPENSIM_THROW_IF(fileVersion > version, InvalidSTBFile, fileName,
+            "Unsupported version " + std::to_string(fileVersion) + ".");
+
+    _dataType = reader.readString();
+    _numComponents = numComponentsOf(_dataType);
+    OPENSIM_THROW_IF(_numComponents == 0, InvalidSTBFile, fileName,
+            "Unsupported data type '" + _dataType + "'.");
+    const auto numRows = reader.read<std::uint64_t>();
+    const auto numColumns = reader.read<std::uint64_t>();
+    const auto numMetaData = reader.read<std::uint64_t>();
+    for (std::uint64_t i = 0; i < numMetaData; ++i) {
+        auto key = reader.readString();
+        _metaData.emplace_back(std::move(key), reader.readString());
+    }
+    for (std::uint64_t j = 0; j < numColumns; ++j) {
+        _labels.push_back(reader.readString());
+    }
+    reader.skipPadding();
+
+    // Check the counts before multiplying them, so a corrupt header cannot
+    // overflow the expected payload size.
+    const std::size_t available = reader.remaining() / sizeof(double);
+    OPENSIM_THROW_IF(numRows > available ||
+                     (numRows > 0 && numColumns * _numComponents >
+                                             available / numRows),
+            InvalidSTBFile, fileName, "Data is truncated.");
+    _numRows = static_cast<std::size_t>(numRows);
+    const std::size_t payloadSize =
+            _numRows * (1 + _labels.size() * _numComponents) * sizeof(double);
+    OPENSIM_THROW_IF(reader.remaining() != payloadSize, InvalidSTBFile,
+            fileName,
+            "Expected " + std::to_string(payloadSize) + " bytes of data but "
+            "found " + std::to_string(reader.remaining()) + ".");
+
+    _indData = reinterpret_cast<const double*>(reader.position());
+    _depData = _indData + _numRows;
+}
+
+MappedSTBFile::~MappedSTBFile() = default;
+
+const std::string& MappedSTBFile::getFileName() const {
+    return _file->getFileName();
+}
+
+size_t MappedSTBFile::getColumnIndex(const std::string& label) const {
+    for (size_t j = 0; j < _labels.size(); ++j) {
+        if (_labels[j] == label) return j;
+    }
+    OPENSIM_THROW(KeyNotFound, label);
+}
+
+const double* MappedSTBFile::getDependentColumnData(size_t index) const {
+    OPENSIM_THROW_IF(index >= _labels.size(), IndexOutOfRange, index, 0,
+            _labels.size() - 1);
+    return _depData + index * _numRows * _numComponents;
+}
+
+bool MappedSTBFile::isMapped() const { return _file->isMapped(); }
+
+STBFileAdapter* STBFileAdapter::clone() const {
+    return new STBFileAdapter{*this};
+}
+
+const std::string STBFileAdapter::tableString() { return "table"; }
+
+STBFileAdapter::OutputTables STBFileAdapter::extendRead(
+        const std::string& fileName) const {
+    OPENSIM_THROW_IF(fileName.empty(), EmptyFileName);
+
+    auto file = std::make_shared<const MappedSTBFile>(fileName);
+    std::shared_ptr<AbstractDataTable> table;
+    if (file->getDataType() == "double") {
+        table = std::make_shared<TimeSeriesTable_<double>>(
+                MappedTimeSeriesTable_<double>(file).extractTable());
+    } else if (file->getDataType() == "Vec3") {
+        table = std::make_shared<TimeSeriesTable_<SimTK::Vec3>>(
+                MappedTimeSeriesTable_<SimTK::Vec3>(file).extractTable());
+    } else {
+        table = std::make_shared<TimeSeriesTable_<SimTK::Quaternion>>(
+                MappedTimeSeriesTable_<SimTK::Quaternion>(file)
+                        .extractTable());
+    }
+
+    OutputTables output_tables{};
+    output_tables.emplace(tableString(), table);
+    return output_tables;
+}
+
+void STBFileAdapter::extendWrite(const InputTables& absTables,
+        const std::string& fileName) const {
+    OPENSIM_THROW_IF(absTables.empty(), NoTableFound);
+    OPENSIM_THROW_IF(fileName.empty(), EmptyFileName);
+
+    const AbstractDataTable* absTable{};
+    try {
+        absTable = absTables.at(tableString());
+    } catch (std::out_of_range&) {
+        OPENSIM_THROW(KeyMissing, tableString());
+    }
+
+    if (auto table =
+                dynamic_cast<const TimeSeriesTable_<double>*>(absTable)) {
+        writeTable(*table, "double", fileName);
+    } else if (auto table = dynamic_cast<
+                       const TimeSeriesTable_<SimTK::Vec3>*>(absTable)) {
+        writeTable(*table, "Vec3", fileName);
+    } else if (auto table = dynamic_cast<
+                       const TimeSeriesTable_<SimTK::Quaternion>*>(absTable)) {
+        writeTable(*table, "Quaternion", fileName);
+    } else {
+        OPENSIM_THROW(IncorrectTableType,
+                "STB files hold TimeSeriesTable_ of double, Vec3 or "
+                "Quaternion.");
+    }
+}
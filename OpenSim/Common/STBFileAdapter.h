@@ -0,0 +1,258 @@
+/* -------------------------------------------------------------------------- *
+ *                         OpenSim:  STBFileAdapter.h                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2020 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#ifndef OPENSIM_STB_FILE_ADAPTER_H_
+#define OPENSIM_STB_FILE_ADAPTER_H_
+
+#include "FileAdapter.h"
+#include "TimeSeriesTable.h"
+
+#include <memory>
+
+namespace OpenSim {
+
+class MappedFile;
+
+class InvalidSTBFile : public IOError {
+public:
+    InvalidSTBFile(const std::string& file,
+                   size_t line,
+                   const std::string& func,
+                   const std::string& filename,
+                   const std::string& message) :
+        IOError(file, line, func) {
+        std::string msg = "File '" + filename + "' is not a valid STB file. ";
+        msg += message;
+
+        addMessage(msg);
+    }
+};
+
+/** Read-only access to the contents of an STB file (see STBFileAdapter). The
+file is memory-mapped and its header is parsed on construction; the data of a
+column is only paged in by the operating system when that column is accessed,
+so it is cheap to open a large file and use a few of its columns. The pointers
+returned by the get*Data() methods remain valid for the lifetime of this
+object.                                                                       */
+class OSIMCOMMON_API MappedSTBFile {
+public:
+    /** Open and map the given file. Throws FileDoesNotExist if the file
+    cannot be opened and InvalidSTBFile if it is not a valid STB file.        */
+    explicit MappedSTBFile(const std::string& fileName);
+    MappedSTBFile(const MappedSTBFile&)            = delete;
+    MappedSTBFile& operator=(const MappedSTBFile&) = delete;
+    ~MappedSTBFile();
+
+    const std::string& getFileName() const;
+    /** Name of the element type of the table: "double", "Vec3" or
+    "Quaternion".                                                             */
+    const std::string& getDataType() const { return _dataType; }
+    /** Number of doubles in each element of the table.                      */
+    int getNumComponents() const { return _numComponents; }
+    size_t getNumRows() const { return _numRows; }
+    size_t getNumColumns() const { return _labels.size(); }
+    const std::vector<std::string>& getColumnLabels() const { return _labels; }
+    /** Index of the column with the given label. Throws KeyNotFound if there
+    is no such column.                                                        */
+    size_t getColumnIndex(const std::string& label) const;
+    /** Table metadata with string values.                                    */
+    const std::vector<std::pair<std::string, std::string>>&
+    getTableMetaData() const { return _metaData; }
+
+    /** The getNumRows() values of the independent (time) column.           */
+    const double* getIndependentColumnData() const { return _indData; }
+    /** The getNumRows() * getNumComponents() values of a dependent column,
+    stored element by element.                                                */
+    const double* getDependentColumnData(size_t index) const;
+
+    /** Whether the file is memory-mapped rather than copied into memory (see
+    MappedFile).                                                              */
+    bool isMapped() const;
+
+private:
+    std::unique_ptr<MappedFile> _file;
+    std::string _dataType;
+    int _numComponents{0};
+    size_t _numRows{0};
+    std::vector<std::string> _labels;
+    std::vector<std::pair<std::string, std::string>> _metaData;
+    const double* _indData{nullptr};
+    const double* _depData{nullptr};
+};
+
+/** Typed, read-only view of an STB file holding a TimeSeriesTable_<ETY>.
+Columns are accessed in place in the mapped file, without parsing or copying
+the rest of the table. Use extractTable() to create a TimeSeriesTable_ from
+all or some of the columns.
+\tparam ETY Element type: double, SimTK::Vec3 or SimTK::Quaternion.          */
+template<typename ETY>
+class MappedTimeSeriesTable_ {
+public:
+    /** Throws IncorrectTableType if the file does not hold elements of type
+    ETY.                                                                      */
+    explicit MappedTimeSeriesTable_(const std::string& fileName) :
+            MappedTimeSeriesTable_(
+                    std::make_shared<const MappedSTBFile>(fileName)) {}
+    /** Use a file that is already open.                                      */
+    explicit MappedTimeSeriesTable_(
+            std::shared_ptr<const MappedSTBFile> file);
+
+    size_t getNumRows() const { return _file->getNumRows(); }
+    size_t getNumColumns() const { return _file->getNumColumns(); }
+    const std::vector<std::string>& getColumnLabels() const {
+        return _file->getColumnLabels();
+    }
+    size_t getColumnIndex(const std::string& label) const {
+        return _file->getColumnIndex(label);
+    }
+    const MappedSTBFile& getFile() const { return *_file; }
+
+    /** Pointer to the getNumRows() times of the table.                      */
+    const double* getIndependentColumn() const {
+        return _file->getIndependentColumnData();
+    }
+    /** Pointer to the getNumRows() elements of a column, in the mapped file.
+    */
+    const ETY* getDependentColumnAtIndex(size_t index) const {
+        return reinterpret_cast<const ETY*>(
+                _file->getDependentColumnData(index));
+    }
+    const ETY* getDependentColumn(const std::string& label) const {
+        return getDependentColumnAtIndex(getColumnIndex(label));
+    }
+    /** Copy of a single column.                                              */
+    SimTK::Vector_<ETY> copyDependentColumn(const std::string& label) const;
+
+    /** Create a TimeSeriesTable_ containing all the columns of the file.    */
+    TimeSeriesTable_<ETY> extractTable() const {
+        return extractTable(getColumnLabels());
+    }
+    /** Create a TimeSeriesTable_ containing only the given columns, in the
+    given order. Only these columns of the file are read.                     */
+    TimeSeriesTable_<ETY>
+    extractTable(const std::vector<std::string>& labels) const;
+
+private:
+    std::shared_ptr<const MappedSTBFile> _file;
+};
+
+/** STBFileAdapter reads and writes TimeSeriesTable_ of double, SimTK::Vec3 or
+SimTK::Quaternion in a binary, column-major format (extension ".stb"). Unlike
+STO files, nothing needs to be parsed when reading: the file is memory-mapped
+and each column is copied (or viewed, see MappedTimeSeriesTable_) directly from
+its contiguous block of doubles, and values round-trip exactly. The layout of
+the file is:
+\code
+"OSIMSTB\0"                    8-byte signature
+uint32 byte-order mark         0x01020304 in the byte order of the writer
+uint32 version
+string data type               "double", "Vec3" or "Quaternion"
+uint64 number of rows
+uint64 number of columns
+uint64 number of metadata entries
+string key, string value       for each metadata entry
+string label                   for each column
+padding                        zeros, up to a multiple of 8 bytes
+double time[rows]
+double data[rows][components]  for each column
+\endcode
+where each string is stored as a uint32 length followed by its characters.
+Only table metadata with string values is written, as for STO files. Files
+written on a machine with a different byte order cannot be read.             */
+class OSIMCOMMON_API STBFileAdapter : public FileAdapter {
+public:
+    STBFileAdapter()                                 = default;
+    STBFileAdapter(const STBFileAdapter&)            = default;
+    STBFileAdapter(STBFileAdapter&&)                 = default;
+    STBFileAdapter& operator=(const STBFileAdapter&) = default;
+    STBFileAdapter& operator=(STBFileAdapter&&)      = default;
+    ~STBFileAdapter()                                = default;
+
+    STBFileAdapter* clone() const override;
+
+    /** Write an STB file. ETY must be double, SimTK::Vec3 or
+    SimTK::Quaternion.                                                        */
+    template<typename ETY>
+    static void write(const TimeSeriesTable_<ETY>& table,
+                      const std::string& fileName);
+
+    /** Key of the table in the tables read and written by this adapter.     */
+    static const std::string tableString();
+
+protected:
+    OutputTables extendRead(const std::string& fileName) const override;
+
+    void extendWrite(const InputTables& tables,
+                     const std::string& fileName) const override;
+};
+
+template<typename ETY>
+void STBFileAdapter::write(const TimeSeriesTable_<ETY>& table,
+                           const std::string& fileName) {
+    InputTables tables{};
+    tables.emplace(tableString(), &table);
+    STBFileAdapter{}.extendWrite(tables, fileName);
+}
+
+template<typename ETY>
+MappedTimeSeriesTable_<ETY>::MappedTimeSeriesTable_(
+        std::shared_ptr<const MappedSTBFile> file) : _file(std::move(file)) {
+    static_assert(sizeof(ETY) % sizeof(double) == 0,
+            "Element type must be made up of doubles.");
+    const int numComponents = int(sizeof(ETY) / sizeof(double));
+    OPENSIM_THROW_IF(_file->getNumComponents() != numComponents,
+            IncorrectTableType,
+            "File '" + _file->getFileName() + "' contains elements of type " +
+            _file->getDataType() + ".");
+}
+
+template<typename ETY>
+SimTK::Vector_<ETY> MappedTimeSeriesTable_<ETY>::copyDependentColumn(
+        const std::string& label) const {
+    const ETY* data = getDependentColumn(label);
+    SimTK::Vector_<ETY> column(static_cast<int>(getNumRows()));
+    for (int i = 0; i < column.size(); ++i) column[i] = data[i];
+    return column;
+}
+
+template<typename ETY>
+TimeSeriesTable_<ETY> MappedTimeSeriesTable_<ETY>::extractTable(
+        const std::vector<std::string>& labels) const {
+    const int nrow = static_cast<int>(getNumRows());
+    const int ncol = static_cast<int>(labels.size());
+    const double* time = getIndependentColumn();
+    std::vector<double> timeVec(time, time + nrow);
+    SimTK::Matrix_<ETY> matrix(nrow, ncol);
+    for (int j = 0; j < ncol; ++j) {
+        const ETY* data = getDependentColumn(labels[j]);
+        for (int i = 0; i < nrow; ++i) matrix(i, j) = data[i];
+    }
+    TimeSeriesTable_<ETY> table(timeVec, matrix, labels);
+    for (const auto& keyValue : _file->getTableMetaData()) {
+        table.addTableMetaData(keyValue.first, keyValue.second);
+    }
+    return table;
+}
+
+} // namespace OpenSim
+
+#endif // OPENSIM_STB_FILE_ADAPTER_H_
@@ -24,6 +24,7 @@
 // INCLUDES
 //=============================================================================
 #include "SmoothSegmentedFunction.h"
+#include <algorithm>
 #include <fstream>
 #include "simmath/internal/SplineFitter.h"
 
@@ -39,9 +40,40 @@ static double UTOL = (double)SimTK::Eps*1e2;
 static double INTTOL = (double)SimTK::Eps*1e2;
 static int MAXITER = 20;
 static int NUM_SAMPLE_PTS = 100;
+//The most nodes a lookup table may use for a single Bezier section.
+static int MAX_LOOKUP_TABLE_INTERVALS = 1 << 20;
 //=============================================================================
 // UTILITY FUNCTIONS
 //=============================================================================
+//Power-basis coefficients c of the quintic Bezier curve with control points
+//p, so that the curve is c[0] + c[1]*u + ... + c[5]*u^5.
+static SimTK::Vec6 calcPowerBasisCoefficients(const SimTK::Vector& p)
+{
+    SimTK::Vec6 c;
+    c[0] = p(0);
+    c[1] = 5*(p(1) - p(0));
+    c[2] = 10*(p(2) - 2*p(1) + p(0));
+    c[3] = 10*(p(3) - 3*p(2) + 3*p(1) - p(0));
+    c[4] = 5*(p(4) - 4*p(3) + 6*p(2) - 4*p(1) + p(0));
+    c[5] = p(5) - 5*p(4) + 10*p(3) - 10*p(2) + 5*p(1) - p(0);
+    return c;
+}
+
+static inline double calcPolynomial(const SimTK::Vec6& c, double u)
+{
+    return c[0] + u*(c[1] + u*(c[2] + u*(c[3] + u*(c[4] + u*c[5]))));
+}
+
+static inline double calcPolynomialDeriv1(const SimTK::Vec6& c, double u)
+{
+    return c[1] + u*(2*c[2] + u*(3*c[3] + u*(4*c[4] + u*5*c[5])));
+}
+
+static inline double calcPolynomialDeriv2(const SimTK::Vec6& c, double u)
+{
+    return 2*c[2] + u*(6*c[3] + u*(12*c[4] + u*20*c[5]));
+}
+
 /*
  DETAILED COMPUTATIONAL COSTS:
  =========================================================================
@@ -100,6 +132,7 @@ _x0(x0),_x1(x1),_y0(y0),_y1(y1),_dydx0(dydx0),_dydx1(dydx1),
     
 
     _numBezierSections = mX.ncol();
+    _xSamples.resize(NUM_SAMPLE_PTS*_numBezierSections);
 
     //////////////////////////////////////////////////
     //Generate the set of splines that approximate u(x)
@@ -118,6 +151,7 @@ _x0(x0),_x1(x1),_y0(y0),_y1(y1),_dydx0(dydx0),_dydx1(dydx1),
             u(i) = ( (double)i )/( (double)(NUM_SAMPLE_PTS-1) );
             x(i) = SegmentedQuinticBezierToolkit::
                 calcQuinticBezierCurveVal(u(i),mX(s));            
+            _xSamples[s*NUM_SAMPLE_PTS + i] = x(i);
             if(_numBezierSections > 1){
                 //Skip the last point of a set that has another set of points
                 //after it. Why? The last point and the starting point of the
@@ -157,9 +191,15 @@ _x0(x0),_x1(x1),_y0(y0),_y1(y1),_dydx0(dydx0),_dydx1(dydx1),
     
     _mXVec.resize(_numBezierSections);
     _mYVec.resize(_numBezierSections);
+    _xSectionStart.resize(_numBezierSections);
+    _xCoefs.resize(_numBezierSections);
+    _yCoefs.resize(_numBezierSections);
     for(int s=0; s < _numBezierSections; s++){
         _mXVec[s] = mX(s); 
         _mYVec[s] = mY(s); 
+        _xSectionStart[s] = mX(0,s);
+        _xCoefs[s] = calcPowerBasisCoefficients(_mXVec[s]);
+        _yCoefs[s] = calcPowerBasisCoefficients(_mYVec[s]);
     }
 }
 
@@ -200,7 +240,11 @@ ________________________________________________________________________
 double SmoothSegmentedFunction::calcValue(double x) const
 {
     double yVal = 0;
-    if(x >= _x0 && x <= _x1 )
+    if(x >= _x0 && x <= _x1 && !_lookupTableSections.empty())
+    {
+        yVal = calcLookupTableValue(x);
+    }
+    else if(x >= _x0 && x <= _x1 )
     {
         int idx  = SegmentedQuinticBezierToolkit::calcIndex(x,_mXVec);
         double u = SegmentedQuinticBezierToolkit::
@@ -269,7 +313,10 @@ double SmoothSegmentedFunction::calcDerivative(double x, int order) const
     if(order==0){
                 yVal = calcValue(x);
     }else{
-            if(x >= _x0 && x <= _x1){        
+            if(order == 1 && x >= _x0 && x <= _x1
+                    && !_lookupTableSections.empty()){
+                yVal = calcLookupTableDerivative(x);
+            }else if(x >= _x0 && x <= _x1){        
                 int idx  = SegmentedQuinticBezierToolkit::calcIndex(x,_mXVec);
                 double u = SegmentedQuinticBezierToolkit::
                                 calcU(x,_mXVec[idx], _arraySplineUX[idx], 
@@ -388,6 +435,266 @@ double SmoothSegmentedFunction::calcIntegral(double x) const
     return yVal;
 }
 
+//=============================================================================
+// MULTI-POINT EVALUATION
+//=============================================================================
+int SmoothSegmentedFunction::calcSectionIndex(double x) const
+{
+    //Same result as SegmentedQuinticBezierToolkit::calcIndex, but without
+    //branching so that the compiler can vectorize the loop.
+    int idx = 0;
+    for(int s=1; s < _numBezierSections; s++){
+        idx += (x >= _xSectionStart[s]);
+    }
+    return idx;
+}
+
+double SmoothSegmentedFunction::calcSectionU(double x, int idx) const
+{
+    //Interpolate the samples of x(u) for the initial guess; they increase
+    //monotonically with u.
+    const double* xs = &_xSamples[idx*NUM_SAMPLE_PTS];
+    const int k = (int)(std::upper_bound(xs + 1, xs + NUM_SAMPLE_PTS - 1, x)
+                        - xs) - 1;
+    const double dxs = xs[k+1] - xs[k];
+    double u = ( (double)k + (dxs > 0 ? (x - xs[k])/dxs : 0.0) )
+               / ( (double)(NUM_SAMPLE_PTS-1) );
+
+    //Newton iterate to the same tolerance as SegmentedQuinticBezierToolkit
+    const SimTK::Vec6& cx = _xCoefs[idx];
+    for(int iter=0; iter < MAXITER; iter++){
+        const double f = calcPolynomial(cx, u) - x;
+        const double df = calcPolynomialDeriv1(cx, u);
+        if(abs(f) <= UTOL || df == 0){
+            break;
+        }
+        u = std::min(1.0, std::max(0.0, u - f/df));
+    }
+    return u;
+}
+
+double SmoothSegmentedFunction::calcSectionValue(double x) const
+{
+    const int idx = calcSectionIndex(x);
+    return calcPolynomial(_yCoefs[idx], calcSectionU(x, idx));
+}
+
+double SmoothSegmentedFunction::
+    calcSectionDerivative(double x, int order) const
+{
+    const int idx = calcSectionIndex(x);
+    const double u = calcSectionU(x, idx);
+    const SimTK::Vec6& cx = _xCoefs[idx];
+    const SimTK::Vec6& cy = _yCoefs[idx];
+    const double dxdu = calcPolynomialDeriv1(cx, u);
+    const double dydu = calcPolynomialDeriv1(cy, u);
+    if(order == 1){
+        return dydu/dxdu;
+    }else if(order == 2){
+        const double d2xdu2 = calcPolynomialDeriv2(cx, u);
+        const double d2ydu2 = calcPolynomialDeriv2(cy, u);
+        return (d2ydu2*dxdu - dydu*d2xdu2)/(dxdu*dxdu*dxdu);
+    }
+    return SegmentedQuinticBezierToolkit::
+        calcQuinticBezierCurveDerivDYDX(u, _mXVec[idx], _mYVec[idx], order);
+}
+
+void SmoothSegmentedFunction::
+    calcValues(int n, const double* x, double* y) const
+{
+    const bool useTable = !_lookupTableSections.empty();
+    for(int i=0; i < n; i++){
+        const double xi = x[i];
+        if(xi < _x0){
+            y[i] = _y0 + _dydx0*(xi-_x0);
+        }else if(xi > _x1){
+            y[i] = _y1 + _dydx1*(xi-_x1);
+        }else if(useTable){
+            y[i] = calcLookupTableValue(xi);
+        }else{
+            y[i] = calcSectionValue(xi);
+        }
+    }
+}
+
+void SmoothSegmentedFunction::
+    calcDerivatives(int n, const double* x, int order, double* dydx) const
+{
+    if(order == 0){
+        calcValues(n, x, dydx);
+        return;
+    }
+    const bool useTable = order == 1 && !_lookupTableSections.empty();
+    for(int i=0; i < n; i++){
+        const double xi = x[i];
+        if(xi < _x0 || xi > _x1){
+            if(order == 1){
+                dydx[i] = xi < _x0 ? _dydx0 : _dydx1;
+            }else{
+                dydx[i] = 0;
+            }
+        }else if(useTable){
+            dydx[i] = calcLookupTableDerivative(xi);
+        }else{
+            dydx[i] = calcSectionDerivative(xi, order);
+        }
+    }
+}
+
+void SmoothSegmentedFunction::
+    calcValues(const SimTK::Vector& x, SimTK::Vector& y) const
+{
+    y = x;
+    calcValues(y.size(), y.getContiguousScalarData(),
+               y.updContiguousScalarData());
+}
+
+void SmoothSegmentedFunction::calcDerivatives(const SimTK::Vector& x,
+    int order, SimTK::Vector& dydx) const
+{
+    dydx = x;
+    calcDerivatives(dydx.size(), dydx.getContiguousScalarData(), order,
+                    dydx.updContiguousScalarData());
+}
+
+//=============================================================================
+// LOOKUP TABLE
+//=============================================================================
+double SmoothSegmentedFunction::calcHermiteValue(
+    const LookupTableSection& sec, const std::vector<SimTK::Vec2>& nodes,
+    double x)
+{
+    double t = (x - sec.x0)*sec.invDx;
+    const int k = std::max(0, std::min((int)t, sec.numIntervals-1));
+    t -= k;
+    const SimTK::Vec2& a = nodes[sec.firstNode + k];
+    const SimTK::Vec2& b = nodes[sec.firstNode + k + 1];
+    //Cubic Hermite basis functions
+    const double s = 1 - t;
+    const double h00 = (1 + 2*t)*s*s;
+    const double h10 = t*s*s;
+    const double h01 = t*t*(3 - 2*t);
+    const double h11 = -t*t*s;
+    return h00*a[0] + h01*b[0] + sec.dx*(h10*a[1] + h11*b[1]);
+}
+
+double SmoothSegmentedFunction::calcHermiteDerivative(
+    const LookupTableSection& sec, const std::vector<SimTK::Vec2>& nodes,
+    double x)
+{
+    double t = (x - sec.x0)*sec.invDx;
+    const int k = std::max(0, std::min((int)t, sec.numIntervals-1));
+    t -= k;
+    const SimTK::Vec2& a = nodes[sec.firstNode + k];
+    const SimTK::Vec2& b = nodes[sec.firstNode + k + 1];
+    //Derivatives of the cubic Hermite basis functions with respect to t
+    const double dh00 = 6*t*(t - 1);
+    const double dh10 = t*(3*t - 4) + 1;
+    const double dh11 = t*(3*t - 2);
+    return dh00*(a[0] - b[0])*sec.invDx + dh10*a[1] + dh11*b[1];
+}
+
+double SmoothSegmentedFunction::calcLookupTableValue(double x) const
+{
+    return calcHermiteValue(_lookupTableSections[calcSectionIndex(x)],
+                            _lookupTableNodes, x);
+}
+
+double SmoothSegmentedFunction::calcLookupTableDerivative(double x) const
+{
+    return calcHermiteDerivative(_lookupTableSections[calcSectionIndex(x)],
+                                 _lookupTableNodes, x);
+}
+
+void SmoothSegmentedFunction::buildLookupTable(double tolerance)
+{
+    SimTK_ERRCHK2_ALWAYS(tolerance > 0,
+        "SmoothSegmentedFunction::buildLookupTable",
+        "%s: The tolerance must be positive, but it was %f.",
+        _name.c_str(), tolerance);
+
+    //Points between each pair of nodes at which the interpolation error is
+    //checked, as fractions of the node spacing.
+    const double checkPoints[] = {0.125, 0.375, 0.5, 0.625, 0.875};
+
+    std::vector<LookupTableSection> sections(_numBezierSections);
+    std::vector<SimTK::Vec2> nodes;
+    for(int s=0; s < _numBezierSections; s++){
+        LookupTableSection& sec = sections[s];
+        const double xStart = _mXVec[s](0);
+        const double xEnd = _mXVec[s](5);
+        sec.x0 = xStart;
+        sec.firstNode = (int)nodes.size();
+        sec.numIntervals = 8;
+        while(true){
+            sec.dx = (xEnd - xStart)/sec.numIntervals;
+            sec.invDx = sec.dx > 0 ? 1.0/sec.dx : 0.0;
+            nodes.resize(sec.firstNode + sec.numIntervals + 1);
+            const SimTK::Vec6& cx = _xCoefs[s];
+            const SimTK::Vec6& cy = _yCoefs[s];
+            for(int k=0; k <= sec.numIntervals; k++){
+                //Use the section end points exactly.
+                double u = (double)k/sec.numIntervals;
+                if(k > 0 && k < sec.numIntervals){
+                    u = calcSectionU(xStart + k*sec.dx, s);
+                }
+                nodes[sec.firstNode + k] = SimTK::Vec2(calcPolynomial(cy, u),
+                    calcPolynomialDeriv1(cy, u)/calcPolynomialDeriv1(cx, u));
+            }
+            if(sec.dx == 0){
+                break;
+            }
+            double maxError = 0;
+            for(int k=0; k < sec.numIntervals; k++){
+                for(double t : checkPoints){
+                    const double xk = xStart + (k + t)*sec.dx;
+                    const double valueError = abs(
+                        calcHermiteValue(sec, nodes, xk)
+                        - calcSectionValue(xk));
+                    const double slopeError = abs(
+                        calcHermiteDerivative(sec, nodes, xk)
+                        - calcSectionDerivative(xk, 1));
+                    maxError = std::max(maxError,
+                                        std::max(valueError, slopeError));
+                }
+            }
+            if(maxError <= 0.5*tolerance){
+                break;
+            }
+            SimTK_ERRCHK2_ALWAYS(sec.numIntervals < MAX_LOOKUP_TABLE_INTERVALS,
+                "SmoothSegmentedFunction::buildLookupTable",
+                "%s: A lookup table with a tolerance of %g needs too many "
+                "nodes.", _name.c_str(), tolerance);
+            sec.numIntervals *= 2;
+        }
+    }
+    _lookupTableSections = sections;
+    _lookupTableNodes = nodes;
+    _lookupTableTolerance = tolerance;
+}
+
+void SmoothSegmentedFunction::clearLookupTable()
+{
+    _lookupTableSections.clear();
+    _lookupTableNodes.clear();
+    _lookupTableTolerance = 0;
+}
+
+bool SmoothSegmentedFunction::hasLookupTable() const
+{
+    return !_lookupTableSections.empty();
+}
+
+double SmoothSegmentedFunction::getLookupTableTolerance() const
+{
+    return _lookupTableTolerance;
+}
+
+int SmoothSegmentedFunction::getLookupTableSize() const
+{
+    return (int)_lookupTableNodes.size();
+}
+
 bool SmoothSegmentedFunction::isIntegralAvailable() const
 {
     return _computeIntegral;
@@ -25,6 +25,8 @@
 #include "osimCommonDLL.h"
 #include "SegmentedQuinticBezierToolkit.h"
 
+#include <vector>
+
 namespace OpenSim { 
 
     /**
@@ -132,6 +134,83 @@ namespace OpenSim {
        using Function_<double>::calcDerivative;
 #endif
 
+       /**Evaluates the curve at every point in x. The results are identical
+       (to within the tolerance of the Newton iteration for u) to calling
+       calcValue(double) for each point, but the Bezier section of each point
+       is found without branching, and x(u) and y(u) are evaluated from
+       contiguous power-basis coefficients rather than through
+       SimTK::Vector. Use this to evaluate many points at once, for example
+       all of the collocation points of a direct collocation problem.
+
+       @param x The domain points of interest
+       @param y The values of the curve at each point in x. This is resized
+                to have the same size as x.
+       */
+       void calcValues(const SimTK::Vector& x, SimTK::Vector& y) const;
+
+       /**Evaluates the derivative of the given order at every point in x.
+       See calcValues() and calcDerivative(double x, int order).
+
+       @param x      The domain points of interest
+       @param order  The order of the derivative to compute (0 to 6)
+       @param dydx   The derivative at each point in x. This is resized to
+                     have the same size as x.
+       */
+       void calcDerivatives(const SimTK::Vector& x, int order,
+                            SimTK::Vector& dydx) const;
+
+#ifndef SWIG
+       /**Same as calcValues(const SimTK::Vector&, SimTK::Vector&), for n
+       contiguous points. x and y may be the same array. */
+       void calcValues(int n, const double* x, double* y) const;
+
+       /**Same as calcDerivatives(const SimTK::Vector&, int, SimTK::Vector&),
+       for n contiguous points. x and dydx may be the same array. */
+       void calcDerivatives(int n, const double* x, int order,
+                            double* dydx) const;
+#endif
+
+       /**Replaces the evaluation of the curve and of its first derivative,
+       within the curve domain, by the interpolation of a precomputed table.
+       The table holds the exact value and slope of the curve at uniformly
+       spaced nodes within each Bezier section, and is interpolated with
+       cubic Hermite polynomials, so no Newton iteration is needed.
+
+       The spacing of the nodes is halved until the interpolation error of
+       both the value and the first derivative, checked at five sample
+       points between every pair of nodes, is below half of the tolerance.
+       The error is not bounded between the sample points, but the margin of
+       half of the tolerance keeps the error of calcValue() and of
+       calcDerivative(x, 1) below the tolerance for smooth curves. Higher
+       order derivatives, calcIntegral(), and points in the linear
+       extrapolation regions are still evaluated exactly.
+
+       @param tolerance The absolute error of the value and of the first
+                        derivative of the curve allowed at the sample points,
+                        with the margin described above (must be positive).
+       @throws OpenSim::Exception
+        -If tolerance is not positive
+        -If the tolerance cannot be met with fewer than 2^20 nodes per
+         Bezier section
+       */
+       void buildLookupTable(double tolerance);
+
+       /**Removes the lookup table, if any, so that the curve is evaluated
+       exactly again. */
+       void clearLookupTable();
+
+       /**@return true if buildLookupTable() has been called (and
+       clearLookupTable() has not been called since).*/
+       bool hasLookupTable() const;
+
+       /**@return The tolerance passed to buildLookupTable(), or 0 if there
+       is no lookup table.*/
+       double getLookupTableTolerance() const;
+
+       /**@return The number of nodes in the lookup table, or 0 if there is
+       no lookup table.*/
+       int getLookupTableSize() const;
+
 
        /**This will return the value of the integral of this objects curve 
        evaluated at x. 
@@ -307,7 +386,36 @@ namespace OpenSim {
        ///@endcond
 
     private:
-       
+
+        /**Uniformly spaced nodes of one Bezier section of the lookup
+        table.*/
+        struct LookupTableSection {
+            double x0;
+            double dx;
+            double invDx;
+            int numIntervals;
+            int firstNode;
+        };
+
+        /**Returns the index of the Bezier section that contains x, which
+        must be within the curve domain.*/
+        int calcSectionIndex(double x) const;
+        /**Solves x(u) = x for u within the given Bezier section.*/
+        double calcSectionU(double x, int idx) const;
+        /**Exact value and derivative (order 1 or 2) of the curve at x,
+        which must be within the curve domain.*/
+        double calcSectionValue(double x) const;
+        double calcSectionDerivative(double x, int order) const;
+        /**Interpolates the lookup table at x, which must be within the
+        curve domain.*/
+        double calcLookupTableValue(double x) const;
+        double calcLookupTableDerivative(double x) const;
+        /**Interpolates the nodes of one section of a lookup table at x.*/
+        static double calcHermiteValue(const LookupTableSection& sec,
+            const std::vector<SimTK::Vec2>& nodes, double x);
+        static double calcHermiteDerivative(const LookupTableSection& sec,
+            const std::vector<SimTK::Vec2>& nodes, double x);
+
         /**Array of spline fit functions X(u) for each Bezier elbow*/
         SimTK::Array_<SimTK::Spline> _arraySplineUX;        
         /**Spline fit of the integral of the curve y(x)*/
@@ -323,6 +431,23 @@ namespace OpenSim {
         /**The number of quintic Bezier curves that describe the relation*/
         int _numBezierSections;
 
+        /**The first x value of each Bezier section*/
+        std::vector<double> _xSectionStart;
+        /**Power-basis coefficients of x(u) and y(u) for each Bezier section,
+        used by the multi-point evaluation functions and the lookup table*/
+        std::vector<SimTK::Vec6> _xCoefs;
+        std::vector<SimTK::Vec6> _yCoefs;
+        /**x(u) of each Bezier section, sampled at the uniformly spaced values
+        of u used to fit _arraySplineUX. These give the initial guess of the
+        Newton iteration for u in calcSectionU().*/
+        std::vector<double> _xSamples;
+
+        /**The lookup table (empty unless buildLookupTable() was called):
+        one entry per Bezier section and the value and slope at each node*/
+        std::vector<LookupTableSection> _lookupTableSections;
+        std::vector<SimTK::Vec2> _lookupTableNodes;
+        double _lookupTableTolerance = 0;
+
         /**The minimum value of the domain*/
         double _x0;
         /**The maximum value of the domain*/
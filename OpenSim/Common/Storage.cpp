@@ -29,6 +29,8 @@
 // INCLUDES
 #include "Storage.h"
 
+#include "ColumnMajorStorage.h"
+
 #include "CommonUtilities.h"
 #include "GCVSpline.h"
 #include "GCVSplineSet.h"
@@ -1332,6 +1334,24 @@ Storage::getColumnIndicesForIdentifier(const std::string& identifier) const
 TimeSeriesTable Storage::exportToTable() const {
     TimeSeriesTable table{};
 
+    // Exclude the first column label. It is 'time'. Time is a separate column
+    // in TimeSeriesTable and column label is optional.
+    if (_columnLabels.size() > 1) {
+        // Gather the data into contiguous columns so the table's matrix is
+        // filled at once rather than reallocated for every row.
+        const std::vector<std::string> labels(_columnLabels.get() + 1,
+                _columnLabels.get() + _columnLabels.getSize());
+        // ColumnMajorStorage pads short rows, so check the rows here as
+        // TimeSeriesTable::appendRow() would.
+        for (int i = 0; i < _storage.getSize(); ++i) {
+            const int size = getStateVector(i)->getSize();
+            OPENSIM_THROW_IF(size != (int)labels.size(), IncorrectNumColumns,
+                    labels.size(), static_cast<size_t>(size));
+        }
+        table = ColumnMajorStorage(*this, (int)labels.size())
+                        .exportToTable(labels);
+    }
+
     table.addTableMetaData("header", getName());
     table.addTableMetaData("inDegrees", std::string{_inDegrees ? "yes" : "no"});
     table.addTableMetaData("nRows", std::to_string(_storage.getSize()));
@@ -1339,12 +1359,7 @@ TimeSeriesTable Storage::exportToTable() const {
     if(!getDescription().empty())
         table.addTableMetaData("description", getDescription());
 
-    // Exclude the first column label. It is 'time'. Time is a separate column
-    // in TimeSeriesTable and column label is optional.
-    if (_columnLabels.size() > 1) {
-        table.setColumnLabels(_columnLabels.get() + 1,
-                _columnLabels.get() + _columnLabels.getSize());
-    }
+    if (_columnLabels.size() > 1) return table;
 
     for(int i = 0; i < _storage.getSize(); ++i) {
         const auto& row = getStateVector(i)->getData();
@@ -2323,33 +2338,28 @@ void Storage::
 pad(int aPadSize)
 {
     if (aPadSize==0) return; //Nothing to do
+    ColumnMajorStorage columns(*this);
+    int size = columns.getNumRows();
+    int nc = columns.getNumColumns();
+
     // PAD THE TIME COLUMN
-    Array<double> paddedTime;
-    int size = getTimeColumn(paddedTime);
-    Signal::Pad(aPadSize,paddedTime);
-    int newSize = paddedTime.getSize();
+    std::vector<double> paddedTime =
+            Signal::Pad(aPadSize,size,columns.getTimes());
+    int newSize = (int)paddedTime.size();
 
     // PAD EACH COLUMN
-    int nc = getSmallestNumberOfStates();
-    Array<double> paddedSignal(0.0,size);
-    StateVector *vecs = new StateVector[newSize];
-    for(int j=0;j<newSize;j++) {
-        vecs[j].getData().setSize(nc);
-        vecs[j].setTime(paddedTime[j]);
-    }
+    ColumnMajorStorage padded(nc,newSize);
+    for(int j=0;j<newSize;j++) padded.appendRow(paddedTime[j],0,nullptr);
     for(int i=0;i<nc;i++) {
-        getDataColumn(i,paddedSignal);
-        Signal::Pad(aPadSize,paddedSignal);
-        for(int j=0;j<newSize;j++)
-            vecs[j].setDataValue(i,paddedSignal[j]);
+        std::vector<double> paddedSignal =
+                Signal::Pad(aPadSize,size,columns.getColumn(i));
+        std::copy(paddedSignal.begin(),paddedSignal.end(),padded.updColumn(i));
     }
 
-    // APPEND THE STATEVECTORS
+    // REPLACE THE STATEVECTORS
     _storage.setSize(0);
-    for(int i=0;i<newSize;i++) _storage.append(vecs[i]);
-
-    // CLEANUP
-    delete[] vecs;
+    _storage.ensureCapacity(newSize);
+    padded.exportToStorage(*this);
 }
 
 void Storage::
@@ -2376,20 +2386,14 @@ smoothSpline(int aOrder,double aCutoffFrequency)
     }
 
     // LOOP OVER COLUMNS
-    double *times=NULL;
-    int nc = getSmallestNumberOfStates();
-    double *signal=NULL;
+    ColumnMajorStorage columns(*this);
     Array<double> filt(0.0,size);
-    getTimeColumn(times,0);
-    for(int i=0;i<nc;i++) {
-        getDataColumn(i,signal);
-        Signal::SmoothSpline(aOrder,dtmin,aCutoffFrequency,size,times,signal,&filt[0]);
-        setDataColumn(i,filt);
+    for(int i=0;i<columns.getNumColumns();i++) {
+        Signal::SmoothSpline(aOrder,dtmin,aCutoffFrequency,size,
+                columns.updTimes(),columns.updColumn(i),&filt[0]);
+        std::copy(filt.get(),filt.get()+size,columns.updColumn(i));
     }
-
-    // CLEANUP
-    delete[] times;
-    delete[] signal;
+    columns.setDataColumnsOf(*this);
 }
 
 void Storage::
@@ -2416,17 +2420,14 @@ lowpassIIR(double aCutoffFrequency)
     }
 
     // LOOP OVER COLUMNS
-    int nc = getSmallestNumberOfStates();
-    double *signal=NULL;
+    ColumnMajorStorage columns(*this);
     Array<double> filt(0.0,size);
-    for(int i=0;i<nc;i++) {
-        getDataColumn(i,signal);
-        Signal::LowpassIIR(dtmin,aCutoffFrequency,size,signal,&filt[0]);
-        setDataColumn(i,filt);
+    for(int i=0;i<columns.getNumColumns();i++) {
+        Signal::LowpassIIR(dtmin,aCutoffFrequency,size,columns.getColumn(i),
+                &filt[0]);
+        std::copy(filt.get(),filt.get()+size,columns.updColumn(i));
     }
-
-    // CLEANUP
-    delete[] signal;
+    columns.setDataColumnsOf(*this);
 }
 
 void Storage::
@@ -2453,17 +2454,14 @@ lowpassFIR(int aOrder,double aCutoffFrequency)
     }
 
     // LOOP OVER COLUMNS
-    int nc = getSmallestNumberOfStates();
-    double *signal=NULL;
+    ColumnMajorStorage columns(*this);
     Array<double> filt(0.0,size);
-    for(int i=0;i<nc;i++) {
-        getDataColumn(i,signal);
-        Signal::LowpassFIR(aOrder,dtmin,aCutoffFrequency,size,signal,&filt[0]);
-        setDataColumn(i,filt);
+    for(int i=0;i<columns.getNumColumns();i++) {
+        Signal::LowpassFIR(aOrder,dtmin,aCutoffFrequency,size,
+                columns.updColumn(i),&filt[0]);
+        std::copy(filt.get(),filt.get()+size,columns.updColumn(i));
     }
-
-    // CLEANUP
-    delete[] signal;
+    columns.setDataColumnsOf(*this);
 }
 
 
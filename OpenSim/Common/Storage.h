@@ -207,7 +207,9 @@ public:
     void getDataColumn(const std::string& columnName, Array<double>& data, double startTime=0.0) override;
 
     /** Convert to a TimeSeriesTable. This may be useful if you need to use
-    parts of the API that require a TimeSeriesTable instead of a Storage. */
+    parts of the API that require a TimeSeriesTable instead of a Storage.
+    \throws IncorrectNumColumns If a row does not have one value for each
+    column label other than time. */
     TimeSeriesTable exportToTable() const;
 
 #ifndef SWIG
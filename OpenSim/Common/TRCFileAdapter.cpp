@@ -1,4 +1,6 @@
 #include "TRCFileAdapter.h"
+#include "DelimTextParser.h"
+#include "MappedFile.h"
 #include <OpenSim/Common/IO.h>
 #include <fstream>
 #include <iomanip>
@@ -41,19 +43,17 @@ TRCFileAdapter::extendRead(const std::string& fileName) const {
     OPENSIM_THROW_IF(fileName.empty(),
                      EmptyFileName);
 
-    std::ifstream in_stream{fileName};
-    OPENSIM_THROW_IF(!in_stream.good(),
-                     FileDoesNotExist,
-                     fileName);
+    // Throws FileDoesNotExist if the file cannot be opened.
+    const MappedFile file{fileName};
+    DelimTextParser parser{file.data(), file.end()};
 
     // Callable to get the next line in form of vector of tokens.
     auto nextLine = [&] {
-        return getNextLine(in_stream, _delimitersRead);
+        return tokenize(parser.nextLine().str(), _delimitersRead);
     };
 
     // First line of the stream is considered the header.
-    std::string header{};
-    std::getline(in_stream, header);
+    std::string header = parser.nextLine().str();
     auto header_tokens = tokenize(header, _headerDelimiters);
     OPENSIM_THROW_IF(header_tokens.empty(),
                      FileIsEmpty,
@@ -156,67 +156,58 @@ TRCFileAdapter::extendRead(const std::string& fileName) const {
         }
     }
 
-    // Read the rows one at a time and fill up the time column container and
-    // the data container.
-    std::size_t line_num{_dataStartsAtLine};
-    std::vector<std::string> row = nextLine();
     // skip immediate blank lines between header and data.
-    while(row.empty() || row.at(0).empty()) {
-        row = nextLine();
-        ++line_num;
+    std::vector<DelimTextParser::Token> tokens{};
+    while(!parser.atEnd()) {
+        DelimTextParser::tokenize(parser.peekLine(), _delimitersRead, tokens);
+        if(!tokens.empty() && !tokens.front().empty())
+            break;
+        parser.nextLine();
     }
+    // An empty line during data parsing denotes end of data
+    const auto rowStarts = parser.findRowStarts();
+    const std::size_t first_line_num{parser.getLineNumber() + 1};
     
     const size_t expected{ column_labels.size() * 3 + 2 };
-    // Will first store data in a SimTK::Matrix to avoid expensive calls 
-    // to the table's appendRow() which reallocates and copies the whole table.
-    int rowNumber = 0;
-    int last_size = 1024; 
-    SimTK::Matrix_<SimTK::Vec3> markerData{last_size, static_cast<int>(num_markers_expected)};
-    std::vector<double> times;
-    times.resize(last_size);
-
-    // An empty line during data parsing denotes end of data
-    while (!row.empty()) {
-        OPENSIM_THROW_IF(row.size() != expected,
-                         RowLengthMismatch,
-                         fileName,
-                         line_num,
-                         expected,
-                         row.size());
-
-        // Columns 2 till the end are data.
-        TimeSeriesTableVec3::RowVector 
-            row_vector{static_cast<int>(num_markers_expected), 
-                       SimTK::Vec3(SimTK::NaN)};
-        int ind{0};
-        for (std::size_t c = 2; c < column_labels.size() * 3 + 2; c += 3) {
-            //only if each component is specified read process as a Vec3
-            if ( !(row.at(c).empty() || row.at(c + 1).empty() 
-                                     || row.at(c + 2).empty()) ) {
-                row_vector[ind] = SimTK::Vec3{ std::stod(row.at(c)),
-                                               std::stod(row.at(c + 1)),
-                                               std::stod(row.at(c + 2)) };
-            } // otherwise the value will remain NaN (default)
-            ++ind;
-        }
-        markerData[rowNumber] = row_vector;
-        // Column 1 is time.
-        times[rowNumber] = std::stod(row.at(1));
-        rowNumber++;
-        if (rowNumber== last_size) {
-            // resize all Data/Matrices, double the size  while keeping data
-            int newSize = last_size * 2;
-            times.resize(newSize);
-            // Repeat for Data matrices in use
-            markerData.resizeKeep(newSize, (int)num_markers_expected);
-            last_size = newSize;
+    // All rows are found before parsing, so the data is stored in a
+    // SimTK::Matrix allocated once to avoid expensive calls to the table's
+    // appendRow() which reallocates and copies the whole table.
+    const int nrow = static_cast<int>(rowStarts.size());
+    SimTK::Matrix_<SimTK::Vec3> markerData{nrow,
+            static_cast<int>(num_markers_expected), SimTK::Vec3(SimTK::NaN)};
+    std::vector<double> times(nrow);
+
+    auto parseRows = [&](std::size_t firstRow, std::size_t lastRow) {
+        std::vector<DelimTextParser::Token> row{};
+        for(std::size_t r = firstRow; r < lastRow; ++r) {
+            DelimTextParser::tokenize(parser.getLine(rowStarts[r]),
+                                      _delimitersRead, row);
+            OPENSIM_THROW_IF(row.size() != expected,
+                             RowLengthMismatch,
+                             fileName,
+                             first_line_num + r,
+                             expected,
+                             row.size());
+
+            // Columns 2 till the end are data.
+            int ind{0};
+            for (std::size_t c = 2; c < expected; c += 3) {
+                //only if each component is specified read process as a Vec3
+                if ( !(row[c].empty() || row[c + 1].empty() 
+                                      || row[c + 2].empty()) ) {
+                    markerData(static_cast<int>(r), ind) = SimTK::Vec3{
+                            DelimTextParser::parseDouble(row[c]),
+                            DelimTextParser::parseDouble(row[c + 1]),
+                            DelimTextParser::parseDouble(row[c + 2]) };
+                } // otherwise the value will remain NaN (default)
+                ++ind;
+            }
+            // Column 1 is time.
+            times[r] = DelimTextParser::parseDouble(row[1]);
         }
-        row = nextLine();
-        ++line_num;
-    }
-    // Trim Matrices in use to actual data and move into tables
-    times.resize(rowNumber);
-    markerData.resizeKeep(rowNumber, (int)num_markers_expected);
+    };
+    DelimTextParser::parseInParallel(rowStarts.size(), _numReadThreads,
+                                     parseRows);
 
     // Set the column labels of the table.
     std::vector<std::string> labels{};
@@ -154,6 +154,12 @@ public:
     /** Key used for table associative array returned/accepted by write/read. */
     static const std::string              _markers;
 
+    /** Set the number of threads used to parse the data rows when reading.
+    The default is 1 (parse on the calling thread); 0 uses all hardware
+    threads. Files with few rows are always parsed on the calling thread.     */
+    void setNumReadThreads(int numThreads) { _numReadThreads = numThreads; }
+    int getNumReadThreads() const { return _numReadThreads; }
+
 protected:
     /** Implementation of the read functionality.                             */
     OutputTables extendRead(const std::string& filename) const override;
@@ -187,6 +193,8 @@ private:
     static const unsigned                 _dataStartsAtLine;
     /** Ordered collection of metadata keys.                                  */
     static const std::vector<std::string> _metadataKeys;
+    /** Number of threads used to parse the data rows.                        */
+    int                                   _numReadThreads{1};
 };
 
 } // namespace OpenSim
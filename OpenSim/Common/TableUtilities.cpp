@@ -166,13 +166,13 @@ void TableUtilities::pad(
             "got {}.",
             numRowsToPrependAndAppend);
 
-    table._indData = Signal::Pad(numRowsToPrependAndAppend,
+    std::vector<double> newIndData = Signal::Pad(numRowsToPrependAndAppend,
             (int)table._indData.size(), table._indData.data());
 
     size_t numColumns = table.getNumColumns();
 
-    // _indData.size() is now the number of rows after padding.
-    SimTK::Matrix newMatrix((int)table._indData.size(), (int)numColumns);
+    // newIndData.size() is the number of rows after padding.
+    SimTK::Matrix newMatrix((int)newIndData.size(), (int)numColumns);
     for (size_t icol = 0; icol < numColumns; ++icol) {
         SimTK::Vector column = table.getDependentColumnAtIndex(icol);
         const std::vector<double> newColumn =
@@ -182,6 +182,7 @@ void TableUtilities::pad(
                 SimTK::Vector((int)newColumn.size(), newColumn.data(), true);
     }
     table.updMatrix() = newMatrix;
+    table._indData = newIndData;
 }
 
 namespace {
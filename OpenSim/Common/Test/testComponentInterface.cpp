@@ -1238,6 +1238,43 @@ void testGetStateVariableValue() {
     SimTK_TEST_MUST_THROW_EXC(
             top.getStateVariableValue(s, "typo/b/subState"),
             OpenSim::Exception);
+
+    // Absolute paths.
+    SimTK_TEST(top.getStateVariableValue(s, "/a/b/subState") == 30);
+    SimTK_TEST(b->getStateVariableValue(s, "/internalSub/subState") == 10);
+
+    // Handles.
+    auto handle = top.getStateVariableHandle("a/b/subState");
+    SimTK_TEST(handle.isValid());
+    SimTK_TEST(handle.getName() == "subState");
+    SimTK_TEST(&handle.getOwner() == b);
+    SimTK_TEST(handle.getSystemYIndex() == 2);
+    SimTK_TEST(handle.getValue(s) == 30);
+    handle.setValue(s, 35);
+    SimTK_TEST(s.getY()[2] == 35);
+    SimTK_TEST(a->getStateVariableValue(s, "b/subState") == 35);
+    SimTK_TEST(a->getStateVariableHandle("../internalSub/subState")
+                    .getSystemYIndex() == 0);
+    SimTK_TEST(!Component::StateVariableHandle().isValid());
+    SimTK_TEST_MUST_THROW_EXC(top.getStateVariableHandle("a/typo"),
+            OpenSim::Exception);
+
+    // Lookups remain correct after the System is rebuilt.
+    Sub* c = new Sub();
+    c->setName("c");
+    a->addComponent(c);
+    MultibodySystem system2;
+    top.buildUpSystem(system2);
+    State s2 = system2.realizeTopology();
+    SimTK_TEST(s2.getNY() == 4);
+    for (int i = 0; i < s2.getNY(); ++i) s2.updY()[i] = i;
+    const auto names = top.getStateVariableNames();
+    for (int i = 0; i < names.size(); ++i) {
+        const auto handle2 = top.getStateVariableHandle(names[i]);
+        SimTK_TEST(top.getStateVariableValue(s2, names[i]) ==
+                   s2.getY()[handle2.getSystemYIndex()]);
+    }
+    SimTK_TEST(top.getStateVariableHandle("a/c/subState").isValid());
 }
 
 void testInputOutputConnections()
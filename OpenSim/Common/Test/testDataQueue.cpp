@@ -0,0 +1,188 @@
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  testDataQueue.cpp                          *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2020 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Common/DataQueue.h>
+#include <OpenSim/Common/Stopwatch.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#define CATCH_CONFIG_MAIN
+#include <OpenSim/Auxiliary/catch.hpp>
+
+using namespace OpenSim;
+
+namespace {
+SimTK::RowVector makeRow(int size, double value) {
+    return SimTK::RowVector(size, value);
+}
+} // namespace
+
+TEST_CASE("DataQueue unbounded preserves order") {
+    DataQueue_<double> queue;
+    CHECK(queue.isEmpty());
+    CHECK_FALSE(queue.isBounded());
+    for (int i = 0; i < 5; ++i) queue.push_back(0.1 * i, makeRow(3, i));
+    CHECK(queue.getSize() == 5);
+
+    double time;
+    SimTK::RowVector row;
+    for (int i = 0; i < 5; ++i) {
+        queue.pop_front(time, row);
+        CHECK(time == Approx(0.1 * i));
+        REQUIRE(row.size() == 3);
+        CHECK(row[2] == i);
+    }
+    CHECK(queue.isEmpty());
+    CHECK_FALSE(queue.try_pop(time, row));
+}
+
+TEST_CASE("DataQueue bounded ring buffer") {
+    DataQueue_<double> queue(4);
+    CHECK(queue.isBounded());
+    CHECK(queue.getCapacity() == 4);
+
+    double time;
+    SimTK::RowVector row;
+    CHECK_FALSE(queue.try_pop(time, row));
+
+    SECTION("Overflow drops the newest samples") {
+        for (int i = 0; i < 6; ++i) {
+            CHECK(queue.try_push(i, makeRow(2, i)) == (i < 4));
+        }
+        CHECK(queue.getSize() == 4);
+        CHECK(queue.getNumOverflows() == 2);
+        CHECK(queue.getNumDropped() == 2);
+        for (int i = 0; i < 4; ++i) {
+            REQUIRE(queue.try_pop(time, row));
+            CHECK(time == i);
+            CHECK(row[1] == i);
+        }
+        CHECK(queue.isEmpty());
+    }
+
+    SECTION("Wraps around") {
+        for (int i = 0; i < 20; ++i) {
+            queue.push_back(i, makeRow(2, i));
+            queue.pop_front(time, row);
+            CHECK(time == i);
+            CHECK(row[0] == i);
+        }
+        CHECK(queue.getNumOverflows() == 0);
+    }
+
+    SECTION("Pop latest skips stale samples") {
+        for (int i = 0; i < 3; ++i) queue.push_back(i, makeRow(2, i));
+        REQUIRE(queue.try_pop_latest(time, row));
+        CHECK(time == 2);
+        CHECK(queue.isEmpty());
+        CHECK(queue.getNumDropped() == 2);
+        CHECK(queue.getNumOverflows() == 0);
+    }
+
+    SECTION("Copy") {
+        queue.push_back(1.5, makeRow(2, 3));
+        DataQueue_<double> copy(queue);
+        CHECK(copy.getCapacity() == 4);
+        REQUIRE(copy.try_pop(time, row));
+        CHECK(time == 1.5);
+        CHECK(queue.getSize() == 1);
+    }
+
+    SECTION("Back to unbounded") {
+        queue.push_back(0, makeRow(2, 0));
+        queue.setCapacity(0);
+        CHECK_FALSE(queue.isBounded());
+        CHECK(queue.isEmpty());
+    }
+}
+
+TEST_CASE("DataQueue bounded single producer single consumer") {
+    const int numSamples = 20000;
+    DataQueue_<double> queue(64);
+    std::thread producer([&]() {
+        for (int i = 0; i < numSamples; ++i) {
+            // Retry so that every sample is delivered.
+            while (!queue.try_push(i, makeRow(8, i))) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    double time;
+    SimTK::RowVector row;
+    bool inOrder = true;
+    for (int i = 0; i < numSamples; ++i) {
+        queue.pop_front(time, row);
+        inOrder = inOrder && time == i && row[7] == i;
+    }
+    producer.join();
+    CHECK(inOrder);
+    CHECK(queue.isEmpty());
+    CHECK(queue.getNumDropped() == queue.getNumOverflows());
+}
+
+// Report the latency from push_back() on a producer thread to the matching
+// pop_front() on the consumer thread, at a rate similar to live IMU streams.
+TEST_CASE("DataQueue latency benchmark", "[.benchmark]") {
+    const int numSamples = 400;
+    const int numSensors = 16;
+    const auto period = std::chrono::microseconds(2500); // 400 Hz
+    auto runBenchmark = [&](DataQueue_<double>& queue) {
+        std::vector<long long> latencies(numSamples);
+        const long long start = SimTK::realTimeInNs();
+        std::thread producer([&]() {
+            for (int i = 0; i < numSamples; ++i) {
+                SimTK::RowVector row(numSensors, double(i));
+                // Encode the push time so the consumer can compute latency.
+                queue.push_back(
+                        double(SimTK::realTimeInNs() - start), row);
+                std::this_thread::sleep_for(period);
+            }
+        });
+        double pushTime;
+        SimTK::RowVector row;
+        for (int i = 0; i < numSamples; ++i) {
+            queue.pop_front(pushTime, row);
+            latencies[i] =
+                    SimTK::realTimeInNs() - start - (long long)pushTime;
+        }
+        producer.join();
+        std::sort(latencies.begin(), latencies.end());
+        return std::make_pair(latencies[numSamples / 2],
+                latencies[(99 * numSamples) / 100]);
+    };
+
+    DataQueue_<double> unbounded;
+    DataQueue_<double> bounded(32);
+    const auto unboundedLatency = runBenchmark(unbounded);
+    const auto boundedLatency = runBenchmark(bounded);
+    std::cout << "DataQueue push-to-pop latency (median, 99th percentile):\n"
+              << "  unbounded: "
+              << Stopwatch::formatNs(unboundedLatency.first) << ", "
+              << Stopwatch::formatNs(unboundedLatency.second) << "\n"
+              << "  bounded:   "
+              << Stopwatch::formatNs(boundedLatency.first) << ", "
+              << Stopwatch::formatNs(boundedLatency.second) << std::endl;
+    CHECK(bounded.getNumOverflows() == 0);
+}
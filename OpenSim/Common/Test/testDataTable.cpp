@@ -916,3 +916,76 @@ TEST_CASE("TableUtilities::resample") {
         CHECK(column[5] == Approx(0.0).margin(1e-10));
     }
 }
+
+TEST_CASE("DataTable reserve and appendRows") {
+    TimeSeriesTable table;
+    table.setColumnLabels({"a", "b", "c"});
+    table.reserve(10);
+    CHECK(table.getNumRows() == 0);
+    CHECK(table.getRowCapacity() == 10);
+
+    // Appending within the reserved storage does not reallocate.
+    for (int i = 0; i < 10; ++i) {
+        table.appendRow(0.1 * i, RowVector(3, double(i)));
+    }
+    CHECK(table.getNumRows() == 10);
+    CHECK(table.getRowCapacity() == 10);
+
+    // Appending beyond it grows the storage geometrically.
+    table.appendRow(1.0, RowVector(3, 10.0));
+    CHECK(table.getNumRows() == 11);
+    CHECK(table.getRowCapacity() == 20);
+
+    // Accessors only see the rows of the table.
+    CHECK(table.getDependentColumn("b").size() == 11);
+    CHECK(table.getDependentColumnAtIndex(2)[10] == 10.0);
+    CHECK_THROWS_AS(table.getRowAtIndex(11), RowIndexOutOfRange);
+    CHECK_THROWS_AS(table.getMatrixBlock(5, 0, 7, 3), RowIndexOutOfRange);
+
+    // Removing a row does not release storage.
+    table.removeRowAtIndex(0);
+    CHECK(table.getNumRows() == 10);
+    CHECK(table.getRowAtIndex(0)[0] == 1.0);
+    CHECK(table.getDependentColumnAtIndex(0)[9] == 10.0);
+
+    // Append a block of rows at once.
+    Matrix block(5, 3);
+    std::vector<double> time;
+    for (int i = 0; i < 5; ++i) {
+        block.updRow(i) = 11.0 + i;
+        time.push_back(1.1 + 0.1 * i);
+    }
+    table.appendRows(time, block);
+    CHECK(table.getNumRows() == 15);
+    CHECK(table.getRowAtIndex(14)[1] == 15.0);
+    CHECK_THROWS_AS(table.appendRows({2.0}, block), IncorrectNumRows);
+
+    // The whole matrix has exactly as many rows as the table. Reading it
+    // does not release storage (so that const access never reallocates),
+    // but writing to it does.
+    const auto& matrix = table.getMatrix();
+    CHECK(matrix.nrow() == 15);
+    CHECK(table.getRowCapacity() == 20);
+    for (int i = 0; i < 15; ++i) {
+        CHECK(matrix(i, 2) == Approx(i + 1));
+    }
+    CHECK(table.updMatrix().nrow() == 15);
+    CHECK(table.getRowCapacity() == 15);
+
+    // Columns can still be appended and removed after reserving.
+    table.reserve(30);
+    table.appendColumn("d", Vector(15, 1.0));
+    CHECK(table.getMatrix().nrow() == 15);
+    CHECK(table.getNumColumns() == 4);
+    table.reserve(30);
+    table.removeColumn("a");
+    CHECK(table.getNumColumns() == 3);
+    CHECK(table.getRowAtIndex(14)[2] == 1.0);
+
+    // Copies are independent of each other.
+    table.reserve(30);
+    TimeSeriesTable copy = table;
+    copy.appendRow(3.0, RowVector(3, 0.0));
+    CHECK(copy.getNumRows() == 16);
+    CHECK(table.getNumRows() == 15);
+}
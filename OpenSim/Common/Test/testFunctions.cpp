@@ -175,3 +175,37 @@ TEST_CASE("solveBisection()") {
         REQUIRE_THROWS_AS(solveBisection(parabola, -5, 5), OpenSim::Exception);
     }
 }
+
+TEST_CASE("parallelFor()") {
+    // Catch's assertions are not thread-safe, so record and check afterwards.
+    for (int numThreads : {1, 2, 4, 0}) {
+        const int numTasks = 100;
+        std::vector<int> counts(numTasks, 0);
+        std::vector<int> threads(numTasks, -1);
+        parallelFor(numTasks, numThreads, [&](int index, int thread) {
+            ++counts[index];
+            threads[index] = thread;
+        });
+        const int maxThreads = resolveNumThreads(numThreads);
+        for (int index = 0; index < numTasks; ++index) {
+            CHECK(counts[index] == 1);
+            CHECK(threads[index] >= 0);
+            CHECK(threads[index] < maxThreads);
+        }
+    }
+
+    // No more threads than tasks.
+    std::vector<int> threads(2, -1);
+    parallelFor(2, 8, [&](int index, int thread) { threads[index] = thread; });
+    CHECK(threads[0] < 2);
+    CHECK(threads[1] < 2);
+    int numCalls = 0;
+    parallelFor(0, 8, [&](int, int) { ++numCalls; });
+    CHECK(numCalls == 0);
+
+    CHECK_THROWS_AS(parallelFor(10, 4,
+                            [](int index, int) {
+                                if (index == 3) OPENSIM_THROW(Exception, "3");
+                            }),
+            OpenSim::Exception);
+}
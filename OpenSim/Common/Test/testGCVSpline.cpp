@@ -22,6 +22,7 @@
 
 #include <OpenSim/Common/GCVSpline.h>
 #include <OpenSim/Common/GCVSplineSet.h>
+#include <OpenSim/Common/Constant.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 
 using namespace OpenSim;
@@ -82,6 +83,55 @@ int main() {
                 SimTK::Eps, __FILE__, __LINE__,
                 "Duplicate GCVSpline failed to reproduce identical first derivative.");
         }
+
+        // A set of splines fit in parallel must match the set fit serially,
+        // and evaluating the set together must match evaluating each spline.
+        const int nRows = 201;
+        const int nCols = 12;
+        TimeSeriesTable table;
+        std::vector<std::string> labels;
+        for (int j = 0; j < nCols; ++j)
+            labels.push_back("q" + std::to_string(j));
+        table.setColumnLabels(labels);
+        SimTK::RowVector row(nCols);
+        for (int i = 0; i < nRows; ++i) {
+            const double time = 2.0*i/(nRows - 1);
+            for (int j = 0; j < nCols; ++j)
+                row[j] = sin((j + 1)*time + 0.1*j);
+            table.appendRow(time, row);
+        }
+        GCVSplineSet serial(table, {}, 5, 0.0, 1);
+        GCVSplineSet parallel(table, {}, 5, 0.0, 3);
+        for (int j = 0; j < nCols; ++j) {
+            const Array<double>& cs = serial.getGCVSpline(j)->getCoefficients();
+            const Array<double>& cp =
+                    parallel.getGCVSpline(j)->getCoefficients();
+            for (int i = 0; i < nRows; ++i) {
+                ASSERT_EQUAL(cs[i], cp[i], 0.0, __FILE__, __LINE__,
+                    "GCVSplineSet fit in parallel differs from serial fit.");
+            }
+        }
+
+        parallel.adoptAndAppend(new Constant(3.0));
+        SimTK::Vector values, firstDerivs, secondDerivs;
+        for (int i = 0; i < 3 * nRows; ++i) {
+            // Include times between the knots and outside of the data.
+            const double time = -0.1 + 2.2*i/(3*nRows - 1);
+            parallel.calcValues(time, values, &firstDerivs, &secondDerivs);
+            for (int j = 0; j < parallel.getSize(); ++j) {
+                const double value = parallel.evaluate(j, 0, time);
+                const double firstDeriv = parallel.evaluate(j, 1, time);
+                const double secondDeriv = parallel.evaluate(j, 2, time);
+                ASSERT_EQUAL(value, values[j], 1e-10, __FILE__, __LINE__,
+                    "GCVSplineSet::calcValues failed to reproduce value.");
+                ASSERT_EQUAL(firstDeriv, firstDerivs[j], 1e-8,
+                    __FILE__, __LINE__, "GCVSplineSet::calcValues failed "
+                    "to reproduce first derivative.");
+                ASSERT_EQUAL(secondDeriv, secondDerivs[j], 1e-6,
+                    __FILE__, __LINE__, "GCVSplineSet::calcValues failed "
+                    "to reproduce second derivative.");
+            }
+        }
     }
     catch(const Exception& e) {
         e.print(cerr);
@@ -0,0 +1,200 @@
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  testSTBFileAdapter.cpp                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2020 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "OpenSim/Common/Adapters.h"
+#include "OpenSim/Common/Stopwatch.h"
+
+#include <fstream>
+#include <iostream>
+
+#define CATCH_CONFIG_MAIN
+#include <OpenSim/Auxiliary/catch.hpp>
+
+using namespace OpenSim;
+
+namespace {
+double makeElement(double value, double) { return value; }
+SimTK::Vec3 makeElement(double value, SimTK::Vec3) {
+    return {value, 2 * value, 3 * value};
+}
+SimTK::Quaternion makeElement(double value, SimTK::Quaternion) {
+    // Do not normalize, so that the stored values are arbitrary.
+    return SimTK::Quaternion(
+            SimTK::Vec4(value, 2 * value, 3 * value, 4 * value), true);
+}
+
+// Exact comparison, since STB files store the values in binary.
+template <typename ETY>
+bool isEqual(const SimTK::MatrixBase<ETY>& a,
+        const SimTK::MatrixBase<ETY>& b) {
+    if (a.nrow() != b.nrow() || a.ncol() != b.ncol()) return false;
+    for (int i = 0; i < a.nrow(); ++i) {
+        for (int j = 0; j < a.ncol(); ++j) {
+            if (a(i, j) != b(i, j)) return false;
+        }
+    }
+    return true;
+}
+
+template <typename ETY>
+TimeSeriesTable_<ETY> createTable(int nrow, int ncol) {
+    std::vector<double> time(nrow);
+    SimTK::Matrix_<ETY> data(nrow, ncol);
+    std::vector<std::string> labels;
+    for (int j = 0; j < ncol; ++j) labels.push_back("col" + std::to_string(j));
+    for (int i = 0; i < nrow; ++i) {
+        time[i] = 0.01 * i;
+        for (int j = 0; j < ncol; ++j) {
+            // Values that are not exactly representable in decimal.
+            data(i, j) = makeElement(1.0 / (3.0 + i + 7 * j), ETY());
+        }
+    }
+    TimeSeriesTable_<ETY> table(time, data, labels);
+    table.addTableMetaData("inDegrees", std::string("no"));
+    table.addTableMetaData("DataRate", 100);
+    return table;
+}
+
+template <typename ETY>
+void checkRoundTrip(const std::string& fileName) {
+    const auto table = createTable<ETY>(50, 4);
+    STBFileAdapter::write(table, fileName);
+    TimeSeriesTable_<ETY> copy(fileName);
+    REQUIRE(copy.getNumRows() == table.getNumRows());
+    CHECK(copy.getColumnLabels() == table.getColumnLabels());
+    CHECK(copy.getIndependentColumn() == table.getIndependentColumn());
+    CHECK(isEqual(copy.getMatrix(), table.getMatrix()));
+    CHECK(copy.template getTableMetaData<std::string>("inDegrees") == "no");
+    // Only string-valued metadata is written.
+    CHECK_FALSE(copy.getTableMetaData().hasKey("DataRate"));
+}
+} // namespace
+
+TEST_CASE("STBFileAdapter round trip") {
+    checkRoundTrip<double>("testSTBFileAdapter_double.stb");
+    checkRoundTrip<SimTK::Vec3>("testSTBFileAdapter_Vec3.stb");
+    checkRoundTrip<SimTK::Quaternion>("testSTBFileAdapter_Quaternion.stb");
+
+    SECTION("Through FileAdapter::writeFile") {
+        const auto table = createTable<double>(10, 2);
+        DataAdapter::InputTables tables{};
+        tables.emplace(STBFileAdapter::tableString(), &table);
+        FileAdapter::writeFile(tables, "testSTBFileAdapter_writeFile.stb");
+        TimeSeriesTable copy("testSTBFileAdapter_writeFile.stb");
+        CHECK(isEqual(copy.getMatrix(), table.getMatrix()));
+    }
+
+    SECTION("Element type must match") {
+        CHECK_THROWS_AS(
+                TimeSeriesTable_<SimTK::Vec3>("testSTBFileAdapter_double.stb"),
+                InvalidArgument);
+        CHECK_THROWS_AS(MappedTimeSeriesTable_<double>(
+                                "testSTBFileAdapter_Vec3.stb"),
+                IncorrectTableType);
+    }
+
+    SECTION("Unsupported element type") {
+        TimeSeriesTable_<SimTK::Vec6> table(std::vector<double>{0.0});
+        CHECK_THROWS_AS(
+                STBFileAdapter::write(table, "testSTBFileAdapter_Vec6.stb"),
+                IncorrectTableType);
+    }
+}
+
+TEST_CASE("MappedTimeSeriesTable_") {
+    const auto table = createTable<SimTK::Vec3>(100, 5);
+    STBFileAdapter::write(table, "testSTBFileAdapter_mapped.stb");
+    MappedTimeSeriesTable_<SimTK::Vec3> mapped(
+            "testSTBFileAdapter_mapped.stb");
+    REQUIRE(mapped.getNumRows() == 100);
+    REQUIRE(mapped.getNumColumns() == 5);
+    CHECK(mapped.getColumnLabels() == table.getColumnLabels());
+    CHECK(mapped.getIndependentColumn()[99] ==
+            table.getIndependentColumn()[99]);
+
+    const SimTK::Vec3* col3 = mapped.getDependentColumn("col3");
+    for (int i = 0; i < 100; ++i) {
+        CHECK(col3[i] == table.getDependentColumn("col3")[i]);
+    }
+    CHECK(isEqual(mapped.copyDependentColumn("col1"),
+            table.getDependentColumn("col1")));
+    CHECK_THROWS_AS(mapped.getDependentColumn("none"), KeyNotFound);
+
+    const auto subset = mapped.extractTable({"col4", "col0"});
+    CHECK(subset.getColumnLabels() ==
+            std::vector<std::string>({"col4", "col0"}));
+    CHECK(isEqual(subset.getDependentColumn("col0"),
+            table.getDependentColumn("col0")));
+    CHECK(subset.getTableMetaData<std::string>("inDegrees") == "no");
+}
+
+TEST_CASE("STBFileAdapter rejects invalid files") {
+    {
+        std::ofstream out("testSTBFileAdapter_invalid.stb");
+        out << "time\tcol0\n0\t1\n";
+    }
+    CHECK_THROWS_AS(TimeSeriesTable("testSTBFileAdapter_invalid.stb"),
+            InvalidSTBFile);
+
+    // Truncate a valid file.
+    STBFileAdapter::write(createTable<double>(20, 3),
+            "testSTBFileAdapter_truncated.stb");
+    std::string contents;
+    {
+        std::ifstream in("testSTBFileAdapter_truncated.stb", std::ios::binary);
+        contents.assign(std::istreambuf_iterator<char>(in), {});
+    }
+    {
+        std::ofstream out("testSTBFileAdapter_truncated.stb",
+                std::ios::binary);
+        out.write(contents.data(), contents.size() - sizeof(double));
+    }
+    CHECK_THROWS_AS(TimeSeriesTable("testSTBFileAdapter_truncated.stb"),
+            InvalidSTBFile);
+}
+
+// Compare the time to read a large table from STO and STB, and to copy one
+// column of the mapped STB file. The tests above cover the correctness.
+TEST_CASE("STBFileAdapter read throughput", "[.benchmark]") {
+    const auto table = createTable<double>(10000, 100);
+    STOFileAdapter::write(table, "testSTBFileAdapter_throughput.sto");
+    STBFileAdapter::write(table, "testSTBFileAdapter_throughput.stb");
+
+    Stopwatch watch;
+    TimeSeriesTable fromSTO("testSTBFileAdapter_throughput.sto");
+    const long long stoTime = watch.getElapsedTimeInNs();
+    watch.reset();
+    TimeSeriesTable fromSTB("testSTBFileAdapter_throughput.stb");
+    const long long stbTime = watch.getElapsedTimeInNs();
+    watch.reset();
+    MappedTimeSeriesTable_<double> mapped("testSTBFileAdapter_throughput.stb");
+    const auto column = mapped.copyDependentColumn("col50");
+    const long long columnTime = watch.getElapsedTimeInNs();
+
+    std::cout << "Reading a 10000 x 100 table:\n"
+              << "  STO:            " << Stopwatch::formatNs(stoTime) << "\n"
+              << "  STB:            " << Stopwatch::formatNs(stbTime) << "\n"
+              << "  STB one column: " << Stopwatch::formatNs(columnTime)
+              << std::endl;
+    CHECK(isEqual(fromSTB.getMatrix(), table.getMatrix()));
+    CHECK(isEqual(column, table.getDependentColumn("col50")));
+}
@@ -22,6 +22,9 @@
 
 #include "OpenSim/Common/Adapters.h"
 #include "OpenSim/Common/CommonUtilities.h"
+#include "OpenSim/Common/Stopwatch.h"
+#include "OpenSim/Common/Storage.h"
+#include <cmath>
 #include <cstdio>
 #include <fstream>
 #include <unordered_set>
@@ -353,3 +356,78 @@ TEST_CASE("Trimming whitespace in metadata values") {
 
 
 
+
+namespace {
+// Write a numRows x numColumns table of smooth values to an STO file, and
+// return a function that reads it with the given number of threads.
+std::function<TimeSeriesTable(int)> writeLargeTable(
+        const std::string& filename, int numRows, int numColumns) {
+    SimTK::Matrix data(numRows, numColumns);
+    std::vector<double> time(numRows);
+    for (int i = 0; i < numRows; ++i) {
+        time[i] = 0.001 * i;
+        for (int j = 0; j < numColumns; ++j)
+            data(i, j) = std::sin(0.01 * i + j) * (j + 1);
+    }
+    std::vector<std::string> labels;
+    for (int j = 0; j < numColumns; ++j)
+        labels.push_back("col" + std::to_string(j));
+    STOFileAdapter::write(TimeSeriesTable(time, data, labels), filename);
+    return [filename](int numThreads) {
+        STOFileAdapter adapter;
+        adapter.setNumReadThreads(numThreads);
+        auto tables = adapter.read(filename);
+        return *std::dynamic_pointer_cast<TimeSeriesTable>(tables.at("table"));
+    };
+}
+}
+
+TEST_CASE("STOFileAdapter parallel read") {
+    const std::string filename = "testSTOFileAdapter_parallel.sto";
+    FileRemover fileRemover(filename);
+    // Enough rows for the parser to split them among several threads.
+    const int numRows = 4096;
+    const int numColumns = 10;
+    const auto readTable = writeLargeTable(filename, numRows, numColumns);
+
+    const TimeSeriesTable serial = readTable(1);
+    REQUIRE(serial.getNumRows() == (size_t)numRows);
+    REQUIRE(serial.getNumColumns() == (size_t)numColumns);
+    for (int numThreads : {2, 3, 0}) {
+        const TimeSeriesTable parallel = readTable(numThreads);
+        CHECK(serial.getIndependentColumn() ==
+                parallel.getIndependentColumn());
+        CHECK((serial.getMatrix() - parallel.getMatrix()).normRMS() == 0);
+    }
+    CHECK(Storage(filename).getSize() == numRows);
+}
+
+// Report the throughput of the serial and parallel readers on a large file,
+// relative to the legacy Storage parser.
+TEST_CASE("STOFileAdapter read throughput", "[.benchmark]") {
+    const std::string filename = "testSTOFileAdapter_throughput.sto";
+    FileRemover fileRemover(filename);
+    const auto readTable = writeLargeTable(filename, 10000, 100);
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    const double megabytes = double(file.tellg()) / (1024.0 * 1024.0);
+
+    auto reportThroughput = [&](const std::string& name,
+                                const Stopwatch& watch) {
+        std::cout << "  " << name << ": "
+                  << megabytes / watch.getElapsedTime() << " MB/s ("
+                  << watch.getElapsedTimeFormatted() << ")" << std::endl;
+    };
+
+    std::cout << "Reading " << megabytes << " MB STO file:" << std::endl;
+    Stopwatch watch;
+    Storage storage(filename);
+    reportThroughput("Storage", watch);
+
+    watch.reset();
+    readTable(1);
+    reportThroughput("STOFileAdapter, 1 thread", watch);
+
+    watch.reset();
+    readTable(0);
+    reportThroughput("STOFileAdapter, all threads", watch);
+}
@@ -37,6 +37,7 @@
 #include <OpenSim/Common/Exception.h>
 #include <OpenSim/Common/SegmentedQuinticBezierToolkit.h>
 #include <OpenSim/Common/SmoothSegmentedFunctionFactory.h>
+#include <OpenSim/Common/Stopwatch.h>
 
 
 #include <SimTKsimbody.h>
@@ -1132,6 +1133,95 @@ void testMonotonicity(SimTK::Matrix mcfSample)
     cout << endl;
 }
 
+/*
+ 5. calcValues() and calcDerivatives() must match calcValue() and
+    calcDerivative() at every point, and the lookup table must meet its
+    tolerance. The time taken by each method is printed.
+*/
+void testMultiPointEvaluation(SmoothSegmentedFunction mcf)
+{
+    cout << "   TEST: Multi-point evaluation and lookup table " << endl;
+
+    // Sample the curve and both linear extrapolation regions.
+    const SimTK::Vec2 domain = mcf.getCurveDomain();
+    const double width = domain(1) - domain(0);
+    const int n = 20001;
+    SimTK::Vector x(n);
+    for (int i = 0; i < n; ++i) {
+        x[i] = domain(0) - 0.1*width + 1.2*width*i/(n - 1);
+    }
+    x[0] = domain(0);
+    x[n - 1] = domain(1);
+
+    SimTK::Vector y;
+    mcf.calcValues(x, y);
+    SimTK_TEST(y.size() == n);
+    for (int i = 0; i < n; ++i) {
+        const double expected = mcf.calcValue(x[i]);
+        SimTK_TEST_EQ_TOL(y[i], expected, 1e-10*(1 + abs(expected)));
+    }
+    for (int order = 1; order <= 3; ++order) {
+        SimTK::Vector dydx;
+        mcf.calcDerivatives(x, order, dydx);
+        for (int i = 0; i < n; ++i) {
+            const double expected = mcf.calcDerivative(x[i], order);
+            SimTK_TEST_EQ_TOL(dydx[i], expected, 1e-8*(1 + abs(expected)));
+        }
+    }
+
+    // The lookup table is within its tolerance of the exact curve.
+    const SmoothSegmentedFunction exact(mcf);
+    SimTK_TEST(!mcf.hasLookupTable());
+    SimTK_TEST_MUST_THROW(mcf.buildLookupTable(0));
+    const double tol = 1e-8;
+    mcf.buildLookupTable(tol);
+    SimTK_TEST(mcf.hasLookupTable());
+    SimTK_TEST(mcf.getLookupTableTolerance() == tol);
+    SimTK::Vector yTable, dydxTable;
+    mcf.calcValues(x, yTable);
+    mcf.calcDerivatives(x, 1, dydxTable);
+    double maxValueError = 0;
+    double maxSlopeError = 0;
+    for (int i = 0; i < n; ++i) {
+        SimTK_TEST(yTable[i] == mcf.calcValue(x[i]));
+        SimTK_TEST(dydxTable[i] == mcf.calcDerivative(x[i], 1));
+        maxValueError = std::max(maxValueError,
+                abs(yTable[i] - exact.calcValue(x[i])));
+        maxSlopeError = std::max(maxSlopeError,
+                abs(dydxTable[i] - exact.calcDerivative(x[i], 1)));
+        SimTK_TEST_EQ_TOL(mcf.calcDerivative(x[i], 2),
+                exact.calcDerivative(x[i], 2), 1e-14);
+    }
+    SimTK_TEST(maxValueError <= tol);
+    SimTK_TEST(maxSlopeError <= tol);
+    printf("   lookup table: %i nodes, max error %g (value), %g (slope)\n",
+           mcf.getLookupTableSize(), maxValueError, maxSlopeError);
+
+    // Benchmark the scalar path against the multi-point path and the table.
+    Stopwatch watch;
+    double sum = 0;
+    for (int i = 0; i < n; ++i) sum += exact.calcValue(x[i]);
+    const long long scalarTime = watch.getElapsedTimeInNs();
+    watch.reset();
+    exact.calcValues(x, y);
+    const long long multiPointTime = watch.getElapsedTimeInNs();
+    watch.reset();
+    mcf.calcValues(x, yTable);
+    const long long tableTime = watch.getElapsedTimeInNs();
+    printf("   %i evaluations: calcValue() %s, calcValues() %s, "
+           "lookup table %s (checksum %g)\n", n,
+           Stopwatch::formatNs(scalarTime).c_str(),
+           Stopwatch::formatNs(multiPointTime).c_str(),
+           Stopwatch::formatNs(tableTime).c_str(), sum);
+
+    mcf.clearLookupTable();
+    SimTK_TEST(!mcf.hasLookupTable());
+    SimTK_TEST(mcf.getLookupTableSize() == 0);
+    SimTK_TEST(mcf.calcValue(x[n/2]) == exact.calcValue(x[n/2]));
+    cout << "   passed" << endl;
+    cout << endl;
+}
+
 //______________________________________________________________________________
 /**
  * Create a muscle bench marking system. The bench mark consists of a single muscle 
@@ -1885,6 +1975,20 @@ int main(int argc, char* argv[])
                       shoulderVal, plateauSlope, 1.01,false,"test"));
             cout << "    passed"<<endl;
 
+        ///////////////////////////////////////
+        //MULTI-POINT EVALUATION AND LOOKUP TABLES
+        ///////////////////////////////////////
+            cout <<"**************************************************"<<endl;
+            cout <<"SmoothSegmentedFunction Multi-point Evaluation    "<<endl;
+            testMultiPointEvaluation(tendonCurve);
+            testMultiPointEvaluation(fiberFLCurve);
+            testMultiPointEvaluation(fiberCECurve);
+            testMultiPointEvaluation(fiberCEPhiCurve);
+            testMultiPointEvaluation(fiberCECosPhiCurve);
+            testMultiPointEvaluation(fiberFVCurve);
+            testMultiPointEvaluation(fiberFVInvCurve);
+            testMultiPointEvaluation(fiberfalCurve);
+
                     ///////////////////////////////////////
         //FIBER COMPRESSIVE PHI CURVE
         ///////////////////////////////////////
@@ -21,6 +21,7 @@
  * -------------------------------------------------------------------------- */
 
 #include <fstream>
+#include <OpenSim/Common/ColumnMajorStorage.h>
 #include <OpenSim/Common/Storage.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 #include <OpenSim/Common/STOFileAdapter.h>
@@ -170,6 +171,86 @@ void testStorageGetStateIndexBackwardsCompatibility() {
     // TODO: Put XML document version in Storage header.
 }
 
+void testColumnMajorStorage() {
+    // Rows of different lengths; the columns are the shortest row.
+    Storage sto;
+    sto.append(0.0, SimTK::Vector(3, 1.0));
+    sto.append(0.1, SimTK::Vector(4, 2.0));
+    sto.append(0.2, SimTK::Vector(3, 3.0));
+    ColumnMajorStorage columns(sto);
+    SimTK_TEST(columns.getNumRows() == 3);
+    SimTK_TEST(columns.getNumColumns() == 3);
+    SimTK_TEST(columns.getCapacity() >= 3);
+    SimTK_TEST(columns.getTime(1) == 0.1);
+    for (int j = 0; j < 3; ++j) {
+        for (int i = 0; i < 3; ++i) {
+            SimTK_TEST(columns.getColumn(j)[i] == i + 1.0);
+        }
+    }
+    // Missing values are NaN.
+    ColumnMajorStorage wide(sto, 4);
+    SimTK_TEST(wide.getValue(1, 3) == 2.0);
+    SimTK_TEST(SimTK::isNaN(wide.getValue(0, 3)));
+
+    // Appending past the capacity keeps the data, and the matrix view shares
+    // the memory of the storage.
+    ColumnMajorStorage grow(2);
+    SimTK_TEST(grow.getCapacity() == 0);
+    for (int i = 0; i < 100; ++i) {
+        const double row[] = {double(i), -double(i)};
+        grow.appendRow(0.01 * i, 2, row);
+    }
+    SimTK_TEST(grow.getNumRows() == 100);
+    SimTK_TEST(grow.getCapacity() >= 100);
+    const SimTK::MatrixView view = grow.getMatrixView();
+    SimTK_TEST(view.nrow() == 100 && view.ncol() == 2);
+    SimTK_TEST(&view(57, 1) == grow.getColumn(1) + 57);
+    SimTK_TEST(view(57, 1) == -57.0);
+
+    // Round trips to a TimeSeriesTable and a Storage.
+    const TimeSeriesTable table = grow.exportToTable({"a", "b"});
+    SimTK_TEST(table.getNumRows() == 100);
+    SimTK_TEST_EQ(table.getMatrix(), SimTK::Matrix(view));
+    const ColumnMajorStorage fromTable(table);
+    SimTK_TEST(fromTable.getValue(99, 0) == 99.0);
+    SimTK_TEST(fromTable.getTime(99) == table.getIndependentColumn()[99]);
+    Storage roundTrip;
+    fromTable.exportToStorage(roundTrip);
+    SimTK_TEST(roundTrip.getSize() == 100);
+    double value;
+    roundTrip.getData(42, 1, value);
+    SimTK_TEST(value == -42.0);
+}
+
+// Storage::exportToTable() gathers the rows into a ColumnMajorStorage, which
+// must not hide rows whose length does not match the column labels.
+void testStorageExportToTable() {
+    Storage sto;
+    Array<std::string> labels;
+    for (const std::string label : {"time", "a", "b", "c"})
+        labels.append(label);
+    sto.setColumnLabels(labels);
+    for (int i = 0; i < 50; ++i) {
+        const double time = 0.01 * i;
+        const double row[] = {time, 2 * time, 3 * time};
+        sto.append(time, 3, row);
+    }
+    const TimeSeriesTable table = sto.exportToTable();
+    SimTK_TEST(table.getNumRows() == 50);
+    SimTK_TEST(table.getColumnLabels() ==
+               std::vector<std::string>({"a", "b", "c"}));
+    SimTK_TEST(table.getIndependentColumn()[17] == 0.01 * 17);
+    SimTK_TEST(table.getMatrix()(17, 2) == 3 * (0.01 * 17));
+
+    // A short row and a long row.
+    Storage shortRow(sto);
+    shortRow.append(0.5, SimTK::Vector(2, 1.0));
+    SimTK_TEST_MUST_THROW_EXC(shortRow.exportToTable(), IncorrectNumColumns);
+    Storage longRow(sto);
+    longRow.append(0.5, SimTK::Vector(4, 1.0));
+    SimTK_TEST_MUST_THROW_EXC(longRow.exportToTable(), IncorrectNumColumns);
+}
+
 int main() {
     SimTK_START_TEST("testStorage");
 
@@ -194,6 +275,10 @@ int main() {
         SimTK_SUBTEST(testStorageLegacy);
 
         SimTK_SUBTEST(testStorageGetStateIndexBackwardsCompatibility);
+
+        SimTK_SUBTEST(testColumnMajorStorage);
+
+        SimTK_SUBTEST(testStorageExportToTable);
     SimTK_END_TEST();
 }
 
@@ -25,6 +25,7 @@
 
 #include "About.h"
 #include "Adapters.h"
+#include "ColumnMajorStorage.h"
 #include "CommonUtilities.h"
 #include "Constant.h"
 #include "DataTable.h"
@@ -40,6 +41,7 @@
 #include "MultivariatePolynomialFunction.h"
 #include "Object.h"
 #include "ObjectGroup.h"
+#include "ObjectSnapshot.h"
 #include "PiecewiseConstantFunction.h"
 #include "PiecewiseLinearFunction.h"
 #include "PolynomialFunction.h"
@@ -465,6 +465,46 @@ public:
         }
     }
 
+    /// Copy the bounds on the variables and constraints from another problem
+    /// that has the same variables, goals and constraints as this one. This
+    /// allows reusing the functions created by initialize() (and their
+    /// sparsity patterns) when only the bounds change between solves.
+    void updateBounds(const Problem& other) {
+        OPENSIM_THROW_IF(other.m_stateInfos.size() != m_stateInfos.size() ||
+                        other.m_controlInfos.size() != m_controlInfos.size() ||
+                        other.m_multiplierInfos.size() !=
+                                m_multiplierInfos.size() ||
+                        other.m_slackInfos.size() != m_slackInfos.size() ||
+                        other.m_paramInfos.size() != m_paramInfos.size() ||
+                        other.m_endpointConstraintInfos.size() !=
+                                m_endpointConstraintInfos.size() ||
+                        other.m_pathInfos.size() != m_pathInfos.size(),
+                OpenSim::Exception,
+                "Cannot update bounds from a problem with a different "
+                "structure.");
+        m_timeInitialBounds = other.m_timeInitialBounds;
+        m_timeFinalBounds = other.m_timeFinalBounds;
+        m_kinematicConstraintBounds = other.m_kinematicConstraintBounds;
+        copyEndpointBounds(other.m_stateInfos, m_stateInfos);
+        copyEndpointBounds(other.m_controlInfos, m_controlInfos);
+        copyEndpointBounds(other.m_multiplierInfos, m_multiplierInfos);
+        for (int i = 0; i < (int)m_slackInfos.size(); ++i) {
+            m_slackInfos[i].bounds = other.m_slackInfos[i].bounds;
+        }
+        for (int i = 0; i < (int)m_paramInfos.size(); ++i) {
+            m_paramInfos[i].bounds = other.m_paramInfos[i].bounds;
+        }
+        for (int i = 0; i < (int)m_endpointConstraintInfos.size(); ++i) {
+            const auto& info = other.m_endpointConstraintInfos[i];
+            m_endpointConstraintInfos[i].lowerBounds = info.lowerBounds;
+            m_endpointConstraintInfos[i].upperBounds = info.upperBounds;
+        }
+        for (int i = 0; i < (int)m_pathInfos.size(); ++i) {
+            m_pathInfos[i].lowerBounds = other.m_pathInfos[i].lowerBounds;
+            m_pathInfos[i].upperBounds = other.m_pathInfos[i].upperBounds;
+        }
+    }
+
     /// @name Interface for CasOC::Transcription.
     /// @{
     int getNumStates() const { return (int)m_stateInfos.size(); }
@@ -601,6 +641,17 @@ private:
         endpoint.lower = std::max(b.lower, endpoint.lower);
         endpoint.upper = std::min(b.upper, endpoint.upper);
     }
+    /// Copy bounds, initialBounds and finalBounds (state, control and
+    /// multiplier infos).
+    template <typename Info>
+    static void copyEndpointBounds(
+            const std::vector<Info>& from, std::vector<Info>& to) {
+        for (int i = 0; i < (int)to.size(); ++i) {
+            to[i].bounds = from[i].bounds;
+            to[i].initialBounds = from[i].initialBounds;
+            to[i].finalBounds = from[i].finalBounds;
+        }
+    }
 
     Bounds m_timeInitialBounds;
     Bounds m_timeFinalBounds;
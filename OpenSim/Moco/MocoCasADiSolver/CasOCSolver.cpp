@@ -20,12 +20,19 @@
 #include "CasOCTranscription.h"
 #include "CasOCTrapezoidal.h"
 
+#include <OpenSim/Common/Stopwatch.h>
 #include <OpenSim/Moco/MocoUtilities.h>
 
+#include <sstream>
+
 using OpenSim::Exception;
 
 namespace CasOC {
 
+Solver::Solver(const Problem& problem) : m_problem(problem) {}
+
+Solver::~Solver() = default;
+
 std::unique_ptr<Transcription> Solver::createTranscription() const {
     std::unique_ptr<Transcription> transcription;
     if (m_transcriptionScheme == "trapezoidal") {
@@ -68,7 +75,91 @@ void Solver::setParallelism(std::string parallelism, int numThreads) {
     m_numThreads = numThreads;
 }
 
+std::string Solver::createStructureKey() const {
+    std::stringstream ss;
+    auto printBounds = [&ss](const Bounds& bounds) {
+        ss << "[" << bounds.lower << "," << bounds.upper << "]";
+    };
+    ss << "states:";
+    for (const auto& info : m_problem.getStateInfos()) {
+        ss << info.name << "(" << (int)info.type << ");";
+    }
+    ss << "\ncontrols:";
+    for (const auto& info : m_problem.getControlInfos()) ss << info.name << ";";
+    ss << "\nmultipliers:";
+    for (const auto& info : m_problem.getMultiplierInfos()) {
+        ss << info.name << ";";
+    }
+    ss << "\nslacks:";
+    for (const auto& info : m_problem.getSlackInfos()) ss << info.name << ";";
+    ss << "\nparameters:";
+    for (const auto& info : m_problem.getParameterInfos()) {
+        ss << info.name << ";";
+    }
+    ss << "\nauxiliary derivatives:";
+    for (const auto& name : m_problem.getAuxiliaryDerivativeNames()) {
+        ss << name << ";";
+    }
+    ss << "\ncosts:";
+    for (const auto& info : m_problem.getCostInfos()) {
+        ss << info.name << "(" << info.num_outputs << ","
+           << (info.integrand_function != nullptr) << ");";
+    }
+    ss << "\nendpoint constraints:";
+    for (const auto& info : m_problem.getEndpointConstraintInfos()) {
+        ss << info.name << "(" << info.num_outputs << ","
+           << (info.integrand_function != nullptr) << ");";
+    }
+    ss << "\npath constraints:";
+    for (const auto& info : m_problem.getPathConstraintInfos()) {
+        ss << info.name << "(" << info.size() << ");";
+    }
+    ss << "\nkinematic constraints:"
+       << m_problem.getNumHolonomicConstraintEquations() << ","
+       << m_problem.getNumNonHolonomicConstraintEquations() << ","
+       << m_problem.getNumAccelerationConstraintEquations() << ","
+       << m_problem.getEnforceConstraintDerivatives();
+    ss << "\ndynamics mode:" << m_problem.getDynamicsMode()
+       << "\nprescribed kinematics:" << m_problem.isPrescribedKinematics();
+
+    ss.precision(17);
+    ss << "\nmesh:";
+    for (const auto& point : m_mesh) ss << point << ";";
+    ss << "\ntranscription scheme:" << m_transcriptionScheme
+       << "\ninterpolate control midpoints:" << m_interpolateControlMidpoints
+       << "\nminimize Lagrange multipliers:"
+       << m_minimizeLagrangeMultipliers << "," << m_lagrangeMultiplierWeight
+       << "\nminimize implicit multibody accelerations:"
+       << m_minimizeImplicitMultibodyAccelerations << ","
+       << m_implicitMultibodyAccelerationsWeight
+       << "\nminimize implicit auxiliary derivatives:"
+       << m_minimizeImplicitAuxiliaryDerivatives << ","
+       << m_implicitAuxiliaryDerivativesWeight;
+    ss << "\nimplicit multibody acceleration bounds:";
+    printBounds(m_implicitMultibodyAccelerationBounds);
+    ss << "\nimplicit auxiliary derivative bounds:";
+    printBounds(m_implicitAuxiliaryDerivativeBounds);
+    ss << "\nfinite difference scheme:" << m_finite_difference_scheme
+       << "\nsparsity detection:" << m_sparsity_detection << ","
+       << m_sparsity_detection_random_count
+       << "\nwrite sparsity:" << m_write_sparsity
+       << "\ncallback interval:" << m_callbackInterval
+       << "\nparallelism:" << m_parallelism << "," << m_numThreads
+       << "\noptim solver:" << m_optimSolver
+       << "\nplugin options:" << m_pluginOptions
+       << "\nsolver options:" << m_solverOptions;
+    return ss.str();
+}
+
 Solution Solver::solve(const Iterate& guess) const {
+    if (m_transcription) {
+        // The transcription, the problem's functions and the NLP solver were
+        // created by a previous call; only the bounds may have changed.
+        m_transcription->updateBounds();
+        return m_transcription->solve(guess);
+    }
+
+    const OpenSim::Stopwatch stopwatch;
     auto transcription = createTranscription();
     auto pointsForSparsityDetection =
             std::make_shared<std::vector<VariablesDM>>();
@@ -94,7 +185,11 @@ Solution Solver::solve(const Iterate& guess) const {
     m_problem.initialize(m_finite_difference_scheme,
             std::const_pointer_cast<const std::vector<VariablesDM>>(
                     pointsForSparsityDetection));
-    return transcription->solve(guess);
+    // Create the NLP now so that its setup time is included below.
+    transcription->createNlpFunction();
+    m_setupTimeInNs = stopwatch.getElapsedTimeInNs();
+    m_transcription = std::move(transcription);
+    return m_transcription->solve(guess);
 }
 
 } // namespace CasOC
@@ -34,7 +34,8 @@ class Transcription;
 /// collocation.
 class Solver {
 public:
-    Solver(const Problem& problem) : m_problem(problem) {}
+    Solver(const Problem& problem);
+    ~Solver();
     void setNumMeshIntervals(int numMeshIntervals) {
         for (int i = 0; i < (numMeshIntervals + 1); ++i) {
             m_mesh.push_back(i / (double)(numMeshIntervals));
@@ -169,8 +170,23 @@ public:
     /// The contents of this iterate depends on the transcription scheme.
     Iterate createRandomIterateWithinBounds() const;
 
+    /// The first call creates the transcription, the problem's functions
+    /// (including their sparsity patterns) and the NLP solver. Subsequent
+    /// calls reuse them, and only update the bounds (from the problem; see
+    /// Problem::updateBounds()) and the guess. Do not edit the settings of
+    /// this solver after the first call.
     Solution solve(const Iterate& guess) const;
 
+    /// Create a string describing everything that determines the structure
+    /// of the NLP: the names and sizes of the problem's variables, goals and
+    /// constraints, and the settings of this solver. Problems with the same
+    /// key can be solved by a single Solver, after updating the bounds.
+    std::string createStructureKey() const;
+    /// The real time spent creating the transcription, the problem's
+    /// functions and the NLP solver during the first call to solve(); 0 if
+    /// solve() has not been called.
+    long long getSetupTimeInNs() const { return m_setupTimeInNs; }
+
 private:
     std::unique_ptr<Transcription> createTranscription() const;
 
@@ -196,6 +212,8 @@ private:
     casadi::Dict m_pluginOptions;
     casadi::Dict m_solverOptions;
     std::string m_optimSolver;
+    mutable std::unique_ptr<Transcription> m_transcription;
+    mutable long long m_setupTimeInNs = 0;
 };
 
 } // namespace CasOC
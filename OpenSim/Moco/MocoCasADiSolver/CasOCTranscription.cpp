@@ -70,6 +70,7 @@ public:
         ++evalCount;
         return {0};
     }
+    void resetEvalCount() { evalCount = 0; }
 
 private:
     const Transcription& m_transcription;
@@ -170,8 +171,18 @@ void Transcription::createVariablesAndSetBounds(const casadi::DM& grid,
     m_meshInteriorIndices =
             makeTimeIndices(meshInteriorIndicesVector);
 
-    // Set variable bounds.
-    // --------------------
+    initializeVariableBounds();
+    initializeConstraintBounds();
+}
+
+Transcription::~Transcription() = default;
+
+void Transcription::updateBounds() {
+    initializeVariableBounds();
+    initializeConstraintBounds();
+}
+
+void Transcription::initializeVariableBounds() {
     auto initializeBounds = [&](VariablesDM& bounds) {
         for (auto& kv : m_vars) {
             bounds[kv.first] = DM(kv.second.rows(), kv.second.columns());
@@ -250,6 +261,55 @@ void Transcription::createVariablesAndSetBounds(const casadi::DM& grid,
     }
 }
 
+void Transcription::initializeConstraintBounds() {
+    m_constraintsLowerBounds.defects =
+            DM::zeros(m_numDefectsPerMeshInterval, m_numMeshIntervals);
+    m_constraintsUpperBounds.defects =
+            DM::zeros(m_numDefectsPerMeshInterval, m_numMeshIntervals);
+
+    m_constraintsLowerBounds.multibody_residuals =
+            DM::zeros(m_numMultibodyResiduals, m_numGridPoints);
+    m_constraintsUpperBounds.multibody_residuals =
+            DM::zeros(m_numMultibodyResiduals, m_numGridPoints);
+
+    m_constraintsLowerBounds.auxiliary_residuals =
+            DM::zeros(m_numAuxiliaryResiduals, m_numGridPoints);
+    m_constraintsUpperBounds.auxiliary_residuals =
+            DM::zeros(m_numAuxiliaryResiduals, m_numGridPoints);
+
+    const int numKinematicConstraints =
+            m_problem.getNumKinematicConstraintEquations();
+    const auto& kcBounds = m_problem.getKinematicConstraintBounds();
+    m_constraintsLowerBounds.kinematic = casadi::DM::repmat(
+            kcBounds.lower, numKinematicConstraints, m_numMeshPoints);
+    m_constraintsUpperBounds.kinematic = casadi::DM::repmat(
+            kcBounds.upper, numKinematicConstraints, m_numMeshPoints);
+
+    const auto& endpointInfos = m_problem.getEndpointConstraintInfos();
+    m_constraintsLowerBounds.endpoint.resize(endpointInfos.size());
+    m_constraintsUpperBounds.endpoint.resize(endpointInfos.size());
+    for (int iec = 0; iec < (int)endpointInfos.size(); ++iec) {
+        m_constraintsLowerBounds.endpoint[iec] = endpointInfos[iec].lowerBounds;
+        m_constraintsUpperBounds.endpoint[iec] = endpointInfos[iec].upperBounds;
+    }
+
+    const auto& pathInfos = m_problem.getPathConstraintInfos();
+    m_constraintsLowerBounds.path.resize(pathInfos.size());
+    m_constraintsUpperBounds.path.resize(pathInfos.size());
+    for (int ipc = 0; ipc < (int)pathInfos.size(); ++ipc) {
+        // TODO: Is it sufficiently general to apply these to mesh points?
+        m_constraintsLowerBounds.path[ipc] = casadi::DM::repmat(
+                pathInfos[ipc].lowerBounds, 1, m_numMeshPoints);
+        m_constraintsUpperBounds.path[ipc] = casadi::DM::repmat(
+                pathInfos[ipc].upperBounds, 1, m_numMeshPoints);
+    }
+
+    const auto boundsOnInterpControls = casadi::DM::zeros(
+            m_problem.getNumControls(), (int)m_pointsForInterpControls.numel());
+    m_constraintsLowerBounds.interp_controls = boundsOnInterpControls;
+    m_constraintsUpperBounds.interp_controls = boundsOnInterpControls;
+}
+
 void Transcription::transcribe() {
 
     // Cost.
@@ -272,28 +332,16 @@ void Transcription::transcribe() {
     m_xdot = MX(NS, m_numGridPoints);
     m_constraints.defects = MX(casadi::Sparsity::dense(
             m_numDefectsPerMeshInterval, m_numMeshIntervals));
-    m_constraintsLowerBounds.defects =
-            DM::zeros(m_numDefectsPerMeshInterval, m_numMeshIntervals);
-    m_constraintsUpperBounds.defects =
-            DM::zeros(m_numDefectsPerMeshInterval, m_numMeshIntervals);
 
     // Initialize memory for implicit multibody residuals.
     // ---------------------------------------------------
     m_constraints.multibody_residuals = MX(casadi::Sparsity::dense(
             m_numMultibodyResiduals, m_numGridPoints));
-    m_constraintsLowerBounds.multibody_residuals =
-            DM::zeros(m_numMultibodyResiduals, m_numGridPoints);
-    m_constraintsUpperBounds.multibody_residuals =
-            DM::zeros(m_numMultibodyResiduals, m_numGridPoints);
 
     // Initialize memory for implicit auxiliary residuals.
     // ---------------------------------------------------
     m_constraints.auxiliary_residuals = MX(casadi::Sparsity::dense(
             m_numAuxiliaryResiduals, m_numGridPoints));
-    m_constraintsLowerBounds.auxiliary_residuals =
-            DM::zeros(m_numAuxiliaryResiduals, m_numGridPoints);
-    m_constraintsUpperBounds.auxiliary_residuals =
-            DM::zeros(m_numAuxiliaryResiduals, m_numGridPoints);
 
     // Initialize memory for kinematic constraints.
     // --------------------------------------------
@@ -302,12 +350,6 @@ void Transcription::transcribe() {
     m_constraints.kinematic = MX(
             casadi::Sparsity::dense(numKinematicConstraints, m_numMeshPoints));
 
-    const auto& kcBounds = m_problem.getKinematicConstraintBounds();
-    m_constraintsLowerBounds.kinematic = casadi::DM::repmat(
-            kcBounds.lower, numKinematicConstraints, m_numMeshPoints);
-    m_constraintsUpperBounds.kinematic = casadi::DM::repmat(
-            kcBounds.upper, numKinematicConstraints, m_numMeshPoints);
-
     // qdot
     // ----
     const MX u = m_vars[states](Slice(NQ, NQ + NU), Slice());
@@ -418,18 +460,11 @@ void Transcription::transcribe() {
     // maximize CasADi's ability to take derivatives efficiently.
     int numPathConstraints = (int)m_problem.getPathConstraintInfos().size();
     m_constraints.path.resize(numPathConstraints);
-    m_constraintsLowerBounds.path.resize(numPathConstraints);
-    m_constraintsUpperBounds.path.resize(numPathConstraints);
     for (int ipc = 0; ipc < (int)m_constraints.path.size(); ++ipc) {
         const auto& info = m_problem.getPathConstraintInfos()[ipc];
-        // TODO: Is it sufficiently general to apply these to mesh points?
         const auto out = evalOnTrajectory(*info.function,
                 {states, controls, multipliers, derivatives}, m_meshIndices);
         m_constraints.path[ipc] = out.at(0);
-        m_constraintsLowerBounds.path[ipc] =
-                casadi::DM::repmat(info.lowerBounds, 1, m_numMeshPoints);
-        m_constraintsUpperBounds.path[ipc] =
-                casadi::DM::repmat(info.upperBounds, 1, m_numMeshPoints);
     }
 
     // Interpolating controls.
@@ -437,10 +472,6 @@ void Transcription::transcribe() {
     m_constraints.interp_controls =
             casadi::DM(casadi::Sparsity::dense(m_problem.getNumControls(),
                     (int)m_pointsForInterpControls.numel()));
-    const auto boundsOnInterpControls = casadi::DM::zeros(
-            m_problem.getNumControls(), (int)m_pointsForInterpControls.numel());
-    m_constraintsLowerBounds.interp_controls = boundsOnInterpControls;
-    m_constraintsUpperBounds.interp_controls = boundsOnInterpControls;
 
     calcInterpolatingControls();
 }
@@ -550,8 +581,6 @@ void Transcription::setObjectiveAndEndpointConstraints() {
     int numEndpointConstraints =
             (int)m_problem.getEndpointConstraintInfos().size();
     m_constraints.endpoint.resize(numEndpointConstraints);
-    m_constraintsLowerBounds.endpoint.resize(numEndpointConstraints);
-    m_constraintsUpperBounds.endpoint.resize(numEndpointConstraints);
     for (int iec = 0; iec < (int)m_constraints.endpoint.size(); ++iec) {
         const auto& info = m_problem.getEndpointConstraintInfos()[iec];
 
@@ -579,54 +608,15 @@ void Transcription::setObjectiveAndEndpointConstraints() {
                         integral},
                 endpointOut);
         m_constraints.endpoint[iec] = endpointOut.at(0);
-        m_constraintsLowerBounds.endpoint[iec] = info.lowerBounds;
-        m_constraintsUpperBounds.endpoint[iec] = info.upperBounds;
     }
 }
 
-Solution Transcription::solve(const Iterate& guessOrig) {
+void Transcription::createNlpFunction() {
 
     // Define the NLP.
     // ---------------
     transcribe();
 
-    // Resample the guess.
-    // -------------------
-    const auto guessTimes = createTimes(guessOrig.variables.at(initial_time),
-            guessOrig.variables.at(final_time));
-    auto guess = guessOrig.resample(guessTimes);
-
-    // Adjust guesses for the slack variables to ensure they are the correct
-    // length (i.e. slacks.size2() == m_numPointsIgnoringConstraints).
-    if (guess.variables.find(Var::slacks) != guess.variables.end()) {
-        auto& slacks = guess.variables.at(Var::slacks);
-
-        // If slack variables provided in the guess are equal to the grid
-        // length, remove the elements on the mesh points where the slack
-        // variables are not defined.
-        if (slacks.size2() == m_numGridPoints) {
-            casadi::DM meshIndices = createMeshIndices();
-            std::vector<casadi_int> slackColumnsToRemove;
-            for (int itime = 0; itime < m_numGridPoints; ++itime) {
-                if (meshIndices(itime).__nonzero__()) {
-                    slackColumnsToRemove.push_back(itime);
-                }
-            }
-            // The first argument is an empty vector since we don't want to
-            // remove an entire row.
-            slacks.remove(std::vector<casadi_int>(), slackColumnsToRemove);
-        }
-
-        // Check that either that the slack variables provided in the guess
-        // are the correct length, or that the correct number of columns
-        // were removed.
-        OPENSIM_THROW_IF(slacks.size2() != m_numMeshInteriorPoints,
-                OpenSim::Exception,
-                "Expected slack variables to be length {}, but they are length "
-                "{}.",
-                m_numMeshInteriorPoints, slacks.size2());
-    }
-
     // Create the CasADi NLP function.
     // -------------------------------
     // Option handling is copied from casadi::OptiNode::solver().
@@ -643,12 +633,14 @@ Solution Transcription::solve(const Iterate& guessOrig) {
     auto g = flattenConstraints(m_constraints);
     casadi_int numConstraints = g.numel();
 
-    NlpsolCallback callback(*this, m_problem, numVariables, numConstraints,
-            m_solver.getCallbackInterval());
-    options["iteration_callback"] = callback;
+    // The callback must outlive the NLP function.
+    m_callback = OpenSim::make_unique<NlpsolCallback>(*this, m_problem,
+            numVariables, numConstraints, m_solver.getCallbackInterval());
+    options["iteration_callback"] = *m_callback;
 
     // The inputs to nlpsol() are symbolic (casadi::MX).
-    casadi::MXDict nlp;
+    casadi::MXDict& nlp = m_nlp;
+    nlp.clear();
     nlp.emplace(std::make_pair("x", x));
     // The objective symbolic variable holds an expression graph including
     // all the calculations performed on the variables x.
@@ -675,14 +667,59 @@ Solution Transcription::solve(const Iterate& guessOrig) {
         jacobian.sparsity().to_file(
                 prefix + "constraint_Jacobian_sparsity.mtx");
     }
-    const casadi::Function nlpFunc =
-            casadi::nlpsol("nlp", m_solver.getOptimSolver(), nlp, options);
+    m_nlpFunc = casadi::nlpsol("nlp", m_solver.getOptimSolver(), nlp, options);
+    m_objectiveFunc = casadi::Function("objective", {x}, {m_objectiveTerms});
+}
+
+Solution Transcription::solve(const Iterate& guessOrig) {
+
+    // The NLP is created only once; subsequent solves only update the
+    // guess and the bounds.
+    if (m_nlpFunc.is_null()) createNlpFunction();
+    m_callback->resetEvalCount();
+
+    // Resample the guess.
+    // -------------------
+    const auto guessTimes = createTimes(guessOrig.variables.at(initial_time),
+            guessOrig.variables.at(final_time));
+    auto guess = guessOrig.resample(guessTimes);
+
+    // Adjust guesses for the slack variables to ensure they are the correct
+    // length (i.e. slacks.size2() == m_numPointsIgnoringConstraints).
+    if (guess.variables.find(Var::slacks) != guess.variables.end()) {
+        auto& slacks = guess.variables.at(Var::slacks);
+
+        // If slack variables provided in the guess are equal to the grid
+        // length, remove the elements on the mesh points where the slack
+        // variables are not defined.
+        if (slacks.size2() == m_numGridPoints) {
+            casadi::DM meshIndices = createMeshIndices();
+            std::vector<casadi_int> slackColumnsToRemove;
+            for (int itime = 0; itime < m_numGridPoints; ++itime) {
+                if (meshIndices(itime).__nonzero__()) {
+                    slackColumnsToRemove.push_back(itime);
+                }
+            }
+            // The first argument is an empty vector since we don't want to
+            // remove an entire row.
+            slacks.remove(std::vector<casadi_int>(), slackColumnsToRemove);
+        }
+
+        // Check that either that the slack variables provided in the guess
+        // are the correct length, or that the correct number of columns
+        // were removed.
+        OPENSIM_THROW_IF(slacks.size2() != m_numMeshInteriorPoints,
+                OpenSim::Exception,
+                "Expected slack variables to be length {}, but they are length "
+                "{}.",
+                m_numMeshInteriorPoints, slacks.size2());
+    }
 
     // Run the optimization (evaluate the CasADi NLP function).
     // --------------------------------------------------------
     // The inputs and outputs of nlpFunc are numeric (casadi::DM).
     const casadi::DMDict nlpResult =
-            nlpFunc(casadi::DMDict{{"x0", flattenVariables(guess.variables)},
+            m_nlpFunc(casadi::DMDict{{"x0", flattenVariables(guess.variables)},
                     {"lbx", flattenVariables(m_lowerBounds)},
                     {"ubx", flattenVariables(m_upperBounds)},
                     {"lbg", flattenConstraints(m_constraintsLowerBounds)},
@@ -696,14 +733,13 @@ Solution Transcription::solve(const Iterate& guessOrig) {
     solution.objective = nlpResult.at("f").scalar();
 
     casadi::DMVector finalVarsDMV{finalVariables};
-    casadi::Function objectiveFunc("objective", {x}, {m_objectiveTerms});
     casadi::DMVector objectiveOut;
-    objectiveFunc.call(finalVarsDMV, objectiveOut);
+    m_objectiveFunc.call(finalVarsDMV, objectiveOut);
     solution.objective_breakdown = expandObjectiveTerms(objectiveOut[0]);
 
     solution.times = createTimes(
             solution.variables[initial_time], solution.variables[final_time]);
-    solution.stats = nlpFunc.stats();
+    solution.stats = m_nlpFunc.stats();
 
     // Print breakdown of objective.
     printObjectiveBreakdown(solution, objectiveOut[0]);
@@ -712,7 +748,8 @@ Solution Transcription::solve(const Iterate& guessOrig) {
 
         // For some reason, nlpResult.at("g") is all 0. So we calculate the
         // constraints ourselves.
-        casadi::Function constraintFunc("constraints", {x}, {g});
+        casadi::Function constraintFunc(
+                "constraints", {m_nlp.at("x")}, {m_nlp.at("g")});
         casadi::DMVector constraintsOut;
         constraintFunc.call(finalVarsDMV, constraintsOut);
         printConstraintValues(solution, expandConstraints(constraintsOut[0]));
@@ -22,6 +22,8 @@
 
 namespace CasOC {
 
+class NlpsolCallback;
+
 /// This is the base class for transcription schemes that convert a
 /// CasOC::Problem into a general nonlinear programming problem. If you are
 /// creating a new derived class, make sure to override all virtual functions
@@ -30,7 +32,7 @@ class Transcription {
 public:
     Transcription(const Solver& solver, const Problem& problem)
             : m_solver(solver), m_problem(problem) {}
-    virtual ~Transcription() = default;
+    virtual ~Transcription();
     Iterate createInitialGuessFromBounds() const;
     /// Use the provided random number generator to generate an iterate.
     /// Random::Uniform is used if a generator is not provided. The generator
@@ -62,6 +64,15 @@ public:
         return meshIndices;
     }
 
+    /// Transcribe the problem and create the NLP solver (casadi::nlpsol()).
+    /// This requires that the problem is initialized, and is invoked by the
+    /// first call to solve() if it has not been invoked already.
+    void createNlpFunction();
+    /// Recompute the bounds on the NLP variables and constraints from the
+    /// problem (see Problem::updateBounds()). This does not affect the NLP
+    /// function, as the bounds are numeric inputs to it.
+    void updateBounds();
+
     Solution solve(const Iterate& guessOrig);
 
 protected:
@@ -150,6 +161,11 @@ private:
     Constraints<casadi::DM> m_constraintsLowerBounds;
     Constraints<casadi::DM> m_constraintsUpperBounds;
 
+    casadi::MXDict m_nlp;
+    casadi::Function m_nlpFunc;
+    casadi::Function m_objectiveFunc;
+    std::unique_ptr<NlpsolCallback> m_callback;
+
 private:
     /// Override this function in your derived class to compute a vector of
     /// quadrature coeffecients (of length m_numGridPoints) required to set the
@@ -170,6 +186,8 @@ private:
                 "Must provide constraints for interpolating controls.")
     }
 
+    void initializeVariableBounds();
+    void initializeConstraintBounds();
     void transcribe();
     void setObjectiveAndEndpointConstraints();
     void calcDefects() {
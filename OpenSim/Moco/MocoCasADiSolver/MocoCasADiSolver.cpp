@@ -37,6 +37,17 @@
 
 using namespace OpenSim;
 
+#ifdef OPENSIM_WITH_CASADI
+struct MocoCasADiSolver::NLPSession {
+    std::string structureKey;
+    std::unique_ptr<MocoCasOCProblem> problem;
+    std::unique_ptr<CasOC::Solver> solver;
+    int numReuses = 0;
+};
+#else
+struct MocoCasADiSolver::NLPSession {};
+#endif
+
 MocoCasADiSolver::MocoCasADiSolver() { constructProperties(); }
 
 void MocoCasADiSolver::constructProperties() {
@@ -44,6 +55,7 @@ void MocoCasADiSolver::constructProperties() {
     constructProperty_optim_sparsity_detection("none");
     constructProperty_optim_write_sparsity("");
     constructProperty_optim_finite_difference_scheme("central");
+    constructProperty_optim_reuse_nlp(false);
     constructProperty_parallel();
     constructProperty_output_interval(0);
 
@@ -334,6 +346,23 @@ std::unique_ptr<CasOC::Solver> MocoCasADiSolver::createCasOCSolver(
 #endif
 }
 
+int MocoCasADiSolver::getNumNLPReuses() const {
+#ifdef OPENSIM_WITH_CASADI
+    return m_nlpSession ? m_nlpSession->numReuses : 0;
+#else
+    return 0;
+#endif
+}
+
+double MocoCasADiSolver::getNLPSetupTimeSaved() const {
+#ifdef OPENSIM_WITH_CASADI
+    if (!m_nlpSession || !m_nlpSession->numReuses) return 0;
+    return SimTK::nsToSec(m_nlpSession->solver->getSetupTimeInNs());
+#else
+    return 0;
+#endif
+}
+
 MocoSolution MocoCasADiSolver::solveImpl() const {
 #ifdef OPENSIM_WITH_CASADI
     const Stopwatch stopwatch;
@@ -347,14 +376,40 @@ MocoSolution MocoCasADiSolver::solveImpl() const {
     }
     auto casProblem = createCasOCProblem();
     auto casSolver = createCasOCSolver(*casProblem);
+    if (get_optim_reuse_nlp()) {
+        std::string structureKey = casSolver->createStructureKey();
+        if (m_nlpSession && m_nlpSession->structureKey == structureKey) {
+            // Keep the NLP (and the functions it evaluates), but take the
+            // bounds and problem reps of the new problem.
+            m_nlpSession->problem->updateFrom(*casProblem);
+            ++m_nlpSession->numReuses;
+            if (get_verbosity()) {
+                log_info("Reusing the NLP from a previous solve (saves {} "
+                         "of setup).",
+                        stopwatch.formatNs(
+                                m_nlpSession->solver->getSetupTimeInNs()));
+            }
+        } else {
+            m_nlpSession.reset(new NLPSession());
+            m_nlpSession->structureKey = std::move(structureKey);
+            m_nlpSession->problem = std::move(casProblem);
+            m_nlpSession->solver = std::move(casSolver);
+        }
+    } else {
+        m_nlpSession.reset();
+    }
+    const MocoCasOCProblem& casProblemToUse =
+            m_nlpSession ? *m_nlpSession->problem : *casProblem;
+    const CasOC::Solver& casSolverToUse =
+            m_nlpSession ? *m_nlpSession->solver : *casSolver;
     if (get_verbosity()) {
-        log_info("Number of threads: {}", casProblem->getJarSize());
+        log_info("Number of threads: {}", casProblemToUse.getJarSize());
     }
 
     MocoTrajectory guess = getGuess();
     CasOC::Iterate casGuess;
     if (guess.empty()) {
-        casGuess = casSolver->createInitialGuessFromBounds();
+        casGuess = casSolverToUse.createInitialGuessFromBounds();
     } else {
         casGuess = convertToCasOCIterate(guess);
     }
@@ -365,7 +420,7 @@ MocoSolution MocoCasADiSolver::solveImpl() const {
     Logger::setLevel(Logger::Level::Warn);
     CasOC::Solution casSolution;
     try {
-        casSolution = casSolver->solve(casGuess);
+        casSolution = casSolverToUse.solve(casGuess);
     } catch (...) {
         OpenSim::Logger::setLevel(origLoggerLevel);
     }
@@ -98,6 +98,25 @@ not affect the solution. We encourage you to use the environment variable
 instead, as this allows different users to solve the same problem with the
 parallelization they prefer.
 
+Reusing the NLP
+===============
+Creating the nonlinear program (transcribing the problem, detecting the
+sparsity of its derivatives, and creating the NLP solver) can take a
+substantial portion of the solve time for small problems, and this work is
+repeated for every solve. If you solve many problems that differ only in
+the guess, the bounds, goal weights, or other properties of the model and
+goals (e.g., in a parameter sweep), set the optim_reuse_nlp property to true.
+The solver then keeps the NLP created by the first solve and reuses it for
+any subsequent solve of a problem with the same structure: the same
+variables, goals and constraints, and the same solver settings. Otherwise,
+the NLP is created from scratch. Use getNumNLPReuses() and
+getNLPSetupTimeSaved() to check whether the NLP was reused.
+
+Be careful when combining this with optim_sparsity_detection: the sparsity
+pattern is detected only for the first solve, so it must also be valid for
+the subsequent problems (e.g., do not change which model components affect
+which state variables). Copies of the solver do not share the NLP.
+
 Parameter variables
 ===================
 By default, MocoCasADiSolver is much slower than MocoTroperSolver at
@@ -137,6 +156,11 @@ public:
     OpenSim_DECLARE_PROPERTY(optim_finite_difference_scheme, std::string,
             "The finite difference scheme CasADi will use to calculate problem "
             "derivatives (default: 'central').");
+    OpenSim_DECLARE_PROPERTY(optim_reuse_nlp, bool,
+            "Reuse the NLP (transcription, sparsity patterns, and NLP solver) "
+            "from the previous solve if the problem has the same structure; "
+            "only the guess, bounds, and problem properties are updated "
+            "(default: false).");
 
     OpenSim_DECLARE_OPTIONAL_PROPERTY(parallel, int,
             "Evaluate integral costs and the differential-algebraic "
@@ -216,6 +240,20 @@ public:
 
     /// @}
 
+    /// @name Reusing the NLP
+    /// See the optim_reuse_nlp property.
+    /// @{
+
+    /// The number of consecutive solves that reused the NLP created by an
+    /// earlier solve; 0 if the most recent solve created a new NLP.
+    int getNumNLPReuses() const;
+    /// The real time (in seconds) spent creating the NLP that the most
+    /// recent solve reused, which that solve did not have to spend. This is
+    /// 0 if the most recent solve created a new NLP.
+    double getNLPSetupTimeSaved() const;
+
+    /// @}
+
 protected:
     MocoSolution solveImpl() const override;
 
@@ -235,6 +273,10 @@ private:
     MocoTrajectory m_guessFromAPI;
     mutable SimTK::ResetOnCopy<MocoTrajectory> m_guessFromFile;
     mutable SimTK::ReferencePtr<const MocoTrajectory> m_guessToUse;
+
+    // The NLP kept for reuse across solves (optim_reuse_nlp).
+    struct NLPSession;
+    mutable SimTK::ResetOnCopy<std::shared_ptr<NLPSession>> m_nlpSession;
 };
 
 } // namespace OpenSim
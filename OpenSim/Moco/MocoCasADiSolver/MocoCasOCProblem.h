@@ -200,6 +200,21 @@ public:
 
     int getJarSize() const { return (int)m_jar->size(); }
 
+    /// Take the bounds and the MocoProblemRep%s from another problem created
+    /// for a MocoProblem with the same structure (see
+    /// CasOC::Solver::createStructureKey()). The CasADi functions that were
+    /// created for this problem evaluate the MocoProblemRep%s in the jar, so
+    /// they reflect the other problem's goal weights, model properties, etc.
+    void updateFrom(MocoCasOCProblem& other) {
+        updateBounds(other);
+        m_jar = std::move(other.m_jar);
+        m_paramsRequireInitSystem = other.m_paramsRequireInitSystem;
+        m_formattedTimeString = other.m_formattedTimeString;
+        m_fileDeletionThrower = std::move(other.m_fileDeletionThrower);
+        m_yIndexMap = other.m_yIndexMap;
+        m_modelControlIndices = other.m_modelControlIndices;
+    }
+
 private:
     void calcMultibodySystemExplicit(const ContinuousInput& input,
             bool calcKCErrors,
@@ -22,6 +22,7 @@
 
 #include <OpenSim/Common/GCVSplineSet.h>
 #include <OpenSim/Common/TimeSeriesTable.h>
+#include <OpenSim/Moco/MocoUtilities.h>
 #include <OpenSim/Simulation/MarkersReference.h>
 
 namespace OpenSim {
@@ -89,6 +90,8 @@ protected:
             "not in the model (such data would be ignored). Default: false.");
 
     mutable GCVSplineSet m_refsplines;
+    /// Values of m_refsplines at the times the integrand is evaluated.
+    mutable GCVSplineSetSampleCache m_refSamples;
     mutable std::vector<SimTK::ReferencePtr<const Marker>> m_model_markers;
     mutable std::vector<int> m_refindices;
     mutable SimTK::Array_<double> m_marker_weights;
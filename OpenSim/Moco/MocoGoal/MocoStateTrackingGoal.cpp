@@ -97,22 +97,19 @@ void MocoStateTrackingGoal::initializeOnModelImpl(const Model& model) const {
         m_refsplines.cloneAndAppend(allSplines[iref]);
         m_state_names.push_back(refName);
     }
+    m_refSamples.clear();
 
     setRequirements(1, 1, SimTK::Stage::Time);
 }
 
 void MocoStateTrackingGoal::calcIntegrandImpl(
         const IntegrandInput& input, SimTK::Real& integrand) const {
-    const auto& time = input.time;
+    const auto& refValues = m_refSamples.getValues(m_refsplines, input.time);
 
-    SimTK::Vector timeVec(1, time);
-
-    // TODO cache the reference coordinate values at the mesh points, rather
-    // than evaluating the spline.
     integrand = 0;
     for (int iref = 0; iref < m_refsplines.getSize(); ++iref) {
         const auto& modelValue = input.state.getY()[m_sysYIndices[iref]];
-        const auto& refValue = m_refsplines[iref].calcValue(timeVec);
+        const auto& refValue = refValues[iref];
         integrand +=
                 m_state_weights[iref] * SimTK::square(modelValue - refValue);
     }
@@ -22,6 +22,7 @@
 
 #include <OpenSim/Common/GCVSplineSet.h>
 #include <OpenSim/Common/TimeSeriesTable.h>
+#include <OpenSim/Moco/MocoUtilities.h>
 #include <OpenSim/Moco/MocoWeightSet.h>
 #include <OpenSim/Simulation/TableProcessor.h>
 
@@ -157,6 +158,8 @@ private:
     }
 
     mutable GCVSplineSet m_refsplines;
+    /// Values of m_refsplines at the times the integrand is evaluated.
+    mutable GCVSplineSetSampleCache m_refSamples;
     /// The indices in Y corresponding to the provided reference coordinates.
     mutable std::vector<int> m_sysYIndices;
     mutable std::vector<double> m_state_weights;
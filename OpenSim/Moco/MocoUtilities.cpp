@@ -274,6 +274,16 @@ int OpenSim::getMocoParallelEnvironmentVariable() {
     return -1;
 }
 
+const SimTK::Vector& GCVSplineSetSampleCache::getValues(
+        const GCVSplineSet& splines, double time) {
+    auto it = m_samples.find(time);
+    if (it != m_samples.end()) return it->second;
+    if ((int)m_samples.size() >= m_maxNumSamples) m_samples.clear();
+    SimTK::Vector& values = m_samples[time];
+    splines.calcValues(time, values);
+    return values;
+}
+
 TimeSeriesTable OpenSim::createExternalLoadsTableForGait(Model model,
         const StatesTrajectory& trajectory,
         const std::vector<std::string>& forcePathsRightFoot,
@@ -22,6 +22,7 @@
 #include "osimMocoDLL.h"
 #include <condition_variable>
 #include <regex>
+#include <unordered_map>
 
 #include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/GCVSplineSet.h>
@@ -65,11 +66,11 @@ class MocoProblem;
 template <typename T>
 TimeSeriesTable_<T> analyzeMocoTrajectory(
         Model model, const MocoTrajectory& trajectory,
-        const std::vector<std::string>& outputPaths) {
+        const std::vector<std::string>& outputPaths, int numThreads = 1) {
     const TimeSeriesTable statesTable = trajectory.exportToStatesTable();
     const TimeSeriesTable controlsTable = trajectory.exportToControlsTable();
-    return analyze<T>(
-            std::move(model), statesTable, controlsTable, outputPaths);
+    return analyze<T>(std::move(model), statesTable, controlsTable,
+            outputPaths, numThreads);
 }
 
 /// Given a MocoTrajectory and the associated OpenSim model, return the model
@@ -218,6 +219,42 @@ private:
     const std::string m_filepath;
 };
 
+/// This class caches the values of the functions in a GCVSplineSet at the
+/// times at which they are requested. Goals that track reference data (e.g.,
+/// MocoStateTrackingGoal) evaluate their reference splines at the same times
+/// (the times of the transcription grid) many times during a solve, since the
+/// integrand is evaluated for many perturbations of the states and controls
+/// but only a few perturbations of time. For problems with fixed initial and
+/// final times, the values are therefore computed once per grid time. Times
+/// that are not in the cache are evaluated with GCVSplineSet::calcValues(),
+/// which evaluates all splines together.
+///
+/// The cache is keyed by the exact value of time. Once it holds
+/// maxNumSamples samples, it is cleared before adding another sample, so its
+/// size stays bounded when the times change between iterations (e.g., when
+/// the final time is a variable).
+///
+/// The cache is not thread-safe; each copy of a goal (e.g., in each thread of
+/// MocoCasADiSolver) has its own cache.
+/// @ingroup mocoutil
+class OSIMMOCO_API GCVSplineSetSampleCache {
+public:
+    explicit GCVSplineSetSampleCache(int maxNumSamples = 10000)
+            : m_maxNumSamples(maxNumSamples) {}
+    /// Get the values of all functions in the spline set at the given time.
+    /// The returned reference is valid until the cache is cleared.
+    /// The spline set must be the same for every call until clear() is
+    /// called.
+    const SimTK::Vector& getValues(const GCVSplineSet& splines, double time);
+    /// Remove all samples; call this when the spline set changes.
+    void clear() { m_samples.clear(); }
+    int getNumSamples() const { return (int)m_samples.size(); }
+
+private:
+    int m_maxNumSamples;
+    std::unordered_map<double, SimTK::Vector> m_samples;
+};
+
 /// Obtain the ground reaction forces, centers of pressure, and torques
 /// resulting from Force elements (e.g., SmoothSphereHalfSpaceForce), using a
 /// model and states trajectory. Forces and torques are expressed in the ground
@@ -472,6 +472,62 @@ TEST_CASE("Test MocoSumSquaredStateGoal") {
     CHECK_THROWS(goal6->initializeOnModel(model));
 }
 
+TEST_CASE("Tracking goals cache reference samples") {
+    Model model = ModelFactory::createDoublePendulum();
+    SimTK::State state = model.initSystem();
+    const auto& q0 = model.getCoordinateSet().get("q0");
+    const auto& q1 = model.getCoordinateSet().get("q1");
+
+    TimeSeriesTable reference;
+    reference.setColumnLabels({q0.getAbsolutePathString() + "/value",
+            q1.getAbsolutePathString() + "/value"});
+    for (int i = 0; i < 11; ++i) {
+        const double t = 0.1 * i;
+        reference.appendRow(
+                t, SimTK::RowVector(SimTK::Vec2(std::sin(t), 0.5 * t * t)));
+    }
+    GCVSplineSet splines(reference);
+
+    SECTION("GCVSplineSetSampleCache") {
+        GCVSplineSetSampleCache cache(3);
+        SimTK::Vector timeVec(1, 0.35);
+        const auto& values = cache.getValues(splines, 0.35);
+        CHECK(cache.getNumSamples() == 1);
+        REQUIRE(values.size() == 2);
+        CHECK(values[0] == Approx(splines[0].calcValue(timeVec)).margin(1e-15));
+        CHECK(values[1] == Approx(splines[1].calcValue(timeVec)).margin(1e-15));
+
+        // Requesting the same time does not add a sample.
+        CHECK(&cache.getValues(splines, 0.35) == &values);
+        CHECK(cache.getNumSamples() == 1);
+        cache.getValues(splines, 0.4);
+        cache.getValues(splines, 0.45);
+        CHECK(cache.getNumSamples() == 3);
+        // The cache is full, so it is cleared before adding the next sample.
+        cache.getValues(splines, 0.5);
+        CHECK(cache.getNumSamples() == 1);
+        cache.clear();
+        CHECK(cache.getNumSamples() == 0);
+    }
+
+    SECTION("MocoStateTrackingGoal") {
+        MocoStateTrackingGoal goal;
+        goal.setReference(reference);
+        goal.initializeOnModel(model);
+        q0.setValue(state, 0.2);
+        q1.setValue(state, -0.1);
+        for (const double t : {0.35, 0.72, 0.35}) {
+            state.setTime(t);
+            SimTK::Vector timeVec(1, t);
+            const double expected =
+                    SimTK::square(0.2 - splines[0].calcValue(timeVec)) +
+                    SimTK::square(-0.1 - splines[1].calcValue(timeVec));
+            CHECK(goal.calcIntegrand({t, state, {}}) ==
+                    Approx(expected).epsilon(1e-12));
+        }
+    }
+}
+
 class MocoPeriodicish : public MocoGoal {
     OpenSim_DECLARE_CONCRETE_OBJECT(MocoPeriodicish, MocoGoal);
 
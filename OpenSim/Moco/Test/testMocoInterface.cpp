@@ -2023,6 +2023,46 @@ TEST_CASE("Objective breakdown", "[casadi]") {
     CHECK(solution.getObjectiveTerm("goal_b") == Approx(0.01 * 7.3));
 }
 
+TEST_CASE("Reusing the NLP", "[casadi]") {
+    MocoStudy study = createSlidingMassMocoStudy<MocoCasADiSolver>();
+    auto& solver = study.updSolver<MocoCasADiSolver>();
+    solver.set_optim_sparsity_detection("random");
+    solver.set_optim_reuse_nlp(true);
+    MocoSolution original = study.solve();
+    CHECK(solver.getNumNLPReuses() == 0);
+    CHECK(solver.getNLPSetupTimeSaved() == 0);
+
+    // Only the bounds change, so the NLP is reused.
+    study.updProblem().setStateInfo("/slider/position/value",
+            MocoBounds(0, 1), MocoInitialBounds(0), MocoFinalBounds(0.5));
+    MocoSolution reused = study.solve();
+    CHECK(solver.getNumNLPReuses() == 1);
+    CHECK(solver.getNLPSetupTimeSaved() > 0);
+    // The time-optimal solution for a distance d is 2 sqrt(d).
+    CHECK(original.getFinalTime() == Approx(2.0).epsilon(1e-2));
+    CHECK(reused.getFinalTime() == Approx(2.0 * sqrt(0.5)).epsilon(1e-2));
+
+    // Reusing the NLP gives the same solution as creating a new NLP.
+    solver.set_optim_reuse_nlp(false);
+    MocoSolution fresh = study.solve();
+    CHECK(solver.getNumNLPReuses() == 0);
+    CHECK(fresh.isNumericallyEqual(reused, 1e-6));
+
+    // Changing the structure of the NLP creates a new NLP.
+    solver.set_optim_reuse_nlp(true);
+    study.solve();
+    CHECK(solver.getNumNLPReuses() == 0);
+    solver.set_num_mesh_intervals(10);
+    study.solve();
+    CHECK(solver.getNumNLPReuses() == 0);
+    study.solve();
+    CHECK(solver.getNumNLPReuses() == 1);
+
+    // Copies do not share the NLP.
+    MocoCasADiSolver copy(solver);
+    CHECK(copy.getNumNLPReuses() == 0);
+}
+
 TEST_CASE("Solver isAvailable()") {
 #ifdef OPENSIM_WITH_CASADI
     CHECK(MocoCasADiSolver::isAvailable());
@@ -77,6 +77,14 @@ public:
      * the client provided data that was queued earlier using putValues call. */
     void getValuesAtTime(double time,
             SimTK::Array_<SimTK::Rotation_<double>>& values) const override;
+    /** Same as above; queued values are read in order, so the cursor and
+     * interpolation do not apply. */
+    void getValuesAtTime(double time,
+            SimTK::Array_<SimTK::Rotation_<double>>& values,
+            ReferenceCursor& /*cursor*/,
+            bool /*interpolate*/ = false) const override {
+        getValuesAtTime(time, values);
+    }
 
     /** add passed in values to data procesing Queue */
     void putValues(double time, const SimTK::RowVector_<SimTK::Rotation>& dataRow);
@@ -89,9 +97,35 @@ public:
     void setFinished(bool finished) { 
         _finished = finished;
     };
+
+    /** Hold at most `capacity` rows of queued values in a preallocated,
+     * lock-free single-producer/single-consumer ring buffer rather than in
+     * the default unbounded queue. Values passed to putValues() while the
+     * buffer is full are dropped instead of blocking the producer. A
+     * capacity of 0 restores the unbounded queue. Any queued values are
+     * discarded, so call this before streaming starts. */
+    void setBufferCapacity(int capacity) {
+        _orientationDataQueue.setCapacity(capacity);
+    }
+    /** The maximum number of queued rows, or 0 if the queue is unbounded. */
+    int getBufferCapacity() const {
+        return _orientationDataQueue.getCapacity();
+    }
+    /** The number of putValues() calls whose values were dropped because the
+     * bounded buffer was full. */
+    std::size_t getNumBufferOverflows() const {
+        return _orientationDataQueue.getNumOverflows();
+    }
+    /** The number of queued rows that were never consumed. */
+    std::size_t getNumDroppedValues() const {
+        return _orientationDataQueue.getNumDropped();
+    }
+
 private:
     // Use a specialized data structure for holding the orientation data
     mutable DataQueue_<SimTK::Rotation> _orientationDataQueue;
+    // Row popped from the queue, reused to avoid allocating on every frame
+    mutable SimTK::RowVector_<SimTK::Rotation> _nextRow;
     bool _finished{false};
     //=============================================================================
 };  // END of class BufferedOrientationsReference
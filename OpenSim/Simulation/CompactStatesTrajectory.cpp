@@ -0,0 +1,185 @@
+/* -------------------------------------------------------------------------- *
+ *                   OpenSim:  CompactStatesTrajectory.cpp                    *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2020 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "CompactStatesTrajectory.h"
+
+#include <OpenSim/Simulation/Model/Model.h>
+
+#include <algorithm>
+
+using namespace OpenSim;
+
+CompactStatesTrajectory::CompactStatesTrajectory(const Component& model) {
+    OPENSIM_THROW_IF(!model.hasSystem(), ComponentHasNoSystem, model);
+    const auto addDiscreteVariables = [this](const Component& component) {
+        std::string path = component.getAbsolutePathString();
+        if (path.back() != '/') path += "/";
+        const auto subsystem = component.getSystem()
+                                       .getDefaultSubsystem()
+                                       .getMySubsystemIndex();
+        for (const auto& nameAndIndex :
+                component.getDiscreteVariableNamesAndIndices()) {
+            m_discreteVariableNames.push_back(path + nameAndIndex.first);
+            m_discreteVariables.push_back({subsystem, nameAndIndex.second});
+        }
+    };
+    addDiscreteVariables(model);
+    for (const auto& component : model.getComponentList()) {
+        addDiscreteVariables(component);
+    }
+}
+
+const SimTK::State& CompactStatesTrajectory::getState(size_t index) const {
+    OPENSIM_THROW_IF(index >= getSize(), IndexOutOfRange, index, 0,
+            static_cast<unsigned>(getSize() - 1));
+    if (m_scratchIndex != static_cast<int>(index)) {
+        m_scratch.setTime(m_times[index]);
+        m_scratch.updY() = getY(index);
+        const int icol = static_cast<int>(index);
+        for (int idv = 0; idv < (int)m_discreteVariables.size(); ++idv) {
+            const auto& dv = m_discreteVariables[idv];
+            SimTK::Value<double>::downcast(
+                    m_scratch.updDiscreteVariable(dv.subsystem, dv.index))
+                    .upd() = m_discreteValues(idv, icol);
+        }
+        m_scratchIndex = static_cast<int>(index);
+    }
+    return m_scratch;
+}
+
+void CompactStatesTrajectory::clear() {
+    m_times.clear();
+    m_scratchIndex = -1;
+}
+
+void CompactStatesTrajectory::reserve(size_t numStates) {
+    const int capacity = static_cast<int>(numStates);
+    if (capacity > m_y.ncol()) {
+        m_y.resizeKeep(m_y.nrow(), capacity);
+        m_discreteValues.resizeKeep(m_discreteValues.nrow(), capacity);
+    }
+}
+
+void CompactStatesTrajectory::append(const SimTK::State& state) {
+    if (m_scratch.getNumSubsystems() == 0) {
+        m_scratch = state;
+        m_y.resize(state.getNY(), m_y.ncol());
+        m_discreteValues.resize((int)m_discreteVariables.size(), m_y.ncol());
+    } else {
+        if (!m_times.empty()) {
+            SimTK_APIARGCHECK2_ALWAYS(m_times.back() <= state.getTime(),
+                    "CompactStatesTrajectory", "append",
+                    "New state's time (%f) must be equal to or greater than "
+                    "the time for the last state in the trajectory (%f).",
+                    state.getTime(), m_times.back());
+        }
+        OPENSIM_THROW_IF(!m_scratch.isConsistent(state),
+                StatesTrajectory::InconsistentState, state.getTime());
+    }
+
+    // Grow the storage geometrically so that appending is amortized O(1).
+    const int icol = static_cast<int>(m_times.size());
+    if (icol == m_y.ncol()) reserve(std::max(2 * m_times.size(), size_t(1)));
+
+    m_y.updCol(icol) = state.getY();
+    for (int idv = 0; idv < (int)m_discreteVariables.size(); ++idv) {
+        const auto& dv = m_discreteVariables[idv];
+        m_discreteValues(idv, icol) = SimTK::Value<double>::downcast(
+                state.getDiscreteVariable(dv.subsystem, dv.index)).get();
+    }
+    m_times.push_back(state.getTime());
+}
+
+StatesTrajectory CompactStatesTrajectory::createStatesTrajectory() const {
+    StatesTrajectory states;
+    states.m_states.reserve(getSize());
+    for (const auto& state : *this) states.append(state);
+    return states;
+}
+
+TimeSeriesTable CompactStatesTrajectory::exportToTable(const Model& model,
+        const std::vector<std::string>& stateVars) const {
+    OPENSIM_THROW_IF(getSize() != 0 && model.getNumSpeeds() != front().getNU(),
+            StatesTrajectory::IncompatibleModel, model);
+
+    std::vector<std::string> labels = stateVars;
+    if (labels.empty()) {
+        const auto names = model.getStateVariableNames();
+        for (int i = 0; i < names.size(); ++i) labels.push_back(names[i]);
+    }
+    std::vector<Component::StateVariableHandle> handles;
+    handles.reserve(labels.size());
+    for (const auto& name : labels) {
+        handles.push_back(model.getStateVariableHandle(name));
+    }
+
+    TimeSeriesTable table;
+    table.setColumnLabels(labels);
+    table.reserve(getSize());
+    TimeSeriesTable::RowVector row(static_cast<int>(labels.size()));
+    for (const auto& state : *this) {
+        for (int icol = 0; icol < (int)handles.size(); ++icol) {
+            row[icol] = handles[icol].getValue(state);
+        }
+        table.appendRow(state.getTime(), row);
+    }
+    return table;
+}
+
+CompactStatesTrajectory CompactStatesTrajectory::createFromStatesTable(
+        const Model& model,
+        const TimeSeriesTable& table,
+        bool allowMissingColumns,
+        bool allowExtraColumns,
+        bool assemble) {
+
+    // Make a copy of the model so that we can get a corresponding state.
+    Model localModel(model);
+    auto state = localModel.initSystem();
+
+    const int numStateVariables = localModel.getNumStateVariables();
+    const auto statesToFillUp = StatesTrajectory::mapStatesTableColumns(
+            localModel, table, allowMissingColumns, allowExtraColumns);
+
+    CompactStatesTrajectory states(localModel);
+    states.reserve(table.getNumRows());
+
+    // Initialize so that missing columns end up as NaN.
+    SimTK::Vector statesValues(numStateVariables, SimTK::NaN);
+    state.updY().setToNaN();
+
+    for (int itime = 0; itime < (int)table.getNumRows(); ++itime) {
+        const auto& row = table.getRowAtIndex(itime);
+        state.setTime(table.getIndependentColumn()[itime]);
+        for (const auto& kv : statesToFillUp) {
+            // 'first': index for the table; 'second': index for the model.
+            statesValues[kv.second] = row[kv.first];
+        }
+        localModel.setStateVariableValues(state, statesValues);
+        if (assemble) {
+            localModel.assemble(state);
+        }
+        states.append(state);
+    }
+
+    return states;
+}
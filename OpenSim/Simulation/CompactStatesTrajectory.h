@@ -0,0 +1,242 @@
+#ifndef OPENSIM_COMPACT_STATES_TRAJECTORY_H_
+#define OPENSIM_COMPACT_STATES_TRAJECTORY_H_
+/* -------------------------------------------------------------------------- *
+ *                    OpenSim:  CompactStatesTrajectory.h                     *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2020 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "StatesTrajectory.h"
+
+#include <iterator>
+#include <SimTKcommon/internal/State.h>
+
+namespace OpenSim {
+
+class Component;
+
+/** This class holds a sequence of SimTK::State%s in a compact form. A
+ * StatesTrajectory holds a complete copy of each SimTK::State, including its
+ * cache entries; for a full-body model, a long trajectory can occupy
+ * gigabytes. This class instead stores, for each state, only the time, the
+ * continuous state variables (Y), and the values of the discrete variables
+ * that Component%s in the model added with Component::addDiscreteVariable().
+ * These are stored contiguously, with one column per state.
+ *
+ * A complete SimTK::State is reconstituted on demand, in a scratch state that
+ * the trajectory reuses: the scratch state is a copy of the first state that
+ * was appended, with the time, Y, and discrete variables of the requested
+ * state. Everything else in the reconstituted state (e.g., modeling options,
+ * other discrete variables, and instance variables) is that of the first
+ * state.
+ *
+ * @code{.cpp}
+ * CompactStatesTrajectory states =
+ *         CompactStatesTrajectory::createFromStatesTable(model, table);
+ * for (const SimTK::State& state : states) {
+ *     model.realizePosition(state);
+ *     std::cout << state.getTime() << " "
+ *               << model.calcMassCenterPosition(state) << std::endl;
+ * }
+ * @endcode
+ *
+ * The reference returned by getState(), operator[], and the iterators refers
+ * to the scratch state, so it is only valid until another state is requested
+ * from the trajectory. You can modify the cache of the scratch state (e.g., by
+ * realizing it), but do not modify its state variables. Since the trajectory
+ * modifies its scratch state, a single trajectory must not be accessed from
+ * several threads at once. Use a copy of the trajectory for each thread.
+ *
+ * You can obtain a CompactStatesTrajectory during a simulation from a
+ * StatesTrajectoryReporter whose `compact` property is true.
+ */
+class OSIMSIMULATION_API CompactStatesTrajectory {
+public:
+    /** Create an empty trajectory that stores only the time and Y of each
+     * state. */
+    CompactStatesTrajectory() = default;
+    /** Create an empty trajectory that also stores the discrete variables
+     * added by the model and its subcomponents (see
+     * getDiscreteVariableNames()). The model (usually a Model, but any root
+     * Component is allowed) must have a System (see Model::initSystem()), and
+     * the states appended to the trajectory must belong to this System. The
+     * trajectory does not keep a reference to the model. */
+    explicit CompactStatesTrajectory(const Component& model);
+
+    /** The number of states in the trajectory. */
+    size_t getSize() const { return m_times.size(); }
+    /** The number of continuous state variables (the size of Y) in each
+     * state. */
+    int getNumY() const { return m_y.nrow(); }
+    /** The names of the discrete variables stored for each state, as
+     * "<component path>/<discrete variable name>". */
+    const std::vector<std::string>& getDiscreteVariableNames() const {
+        return m_discreteVariableNames;
+    }
+
+    /// @name Accessing the stored values
+    /// These methods do not reconstitute a SimTK::State.
+    /// @{
+    double getTime(size_t index) const { return m_times[index]; }
+    /** The times of all the states. */
+    const std::vector<double>& getTimes() const { return m_times; }
+    /** The Y vector of the state at the given index. */
+    SimTK::VectorView getY(size_t index) const {
+        return m_y.col(static_cast<int>(index));
+    }
+    /** The values of the discrete variables (in the order of
+     * getDiscreteVariableNames()) of the state at the given index. */
+    SimTK::VectorView getDiscreteVariableValues(size_t index) const {
+        return m_discreteValues.col(static_cast<int>(index));
+    }
+    /// @}
+
+    /// @name Accessing individual SimTK::State%s
+    /// @{
+    /** Reconstitute the state at the given index in the scratch state and
+     * return a reference to the scratch state. The reference is valid until
+     * another state is requested from this trajectory.
+     * @throws IndexOutOfRange If the index is greater than the size of the
+     *                         trajectory. */
+    const SimTK::State& getState(size_t index) const;
+    /** Same as getState(). */
+    const SimTK::State& operator[](size_t index) const {
+        return getState(index);
+    }
+    const SimTK::State& front() const { return getState(0); }
+    const SimTK::State& back() const { return getState(getSize() - 1); }
+    /// @}
+
+#ifndef SWIG
+    /** Iterator that reconstitutes each state in the scratch state of the
+     * trajectory; the states are never copied. Dereferencing the iterator
+     * invalidates references obtained from other iterators of the same
+     * trajectory. */
+    class const_iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = SimTK::State;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const SimTK::State*;
+        using reference = const SimTK::State&;
+
+        const_iterator(const CompactStatesTrajectory* trajectory,
+                size_t index) : m_trajectory(trajectory), m_index(index) {}
+        reference operator*() const {
+            return m_trajectory->getState(m_index);
+        }
+        pointer operator->() const { return &operator*(); }
+        const_iterator& operator++() {
+            ++m_index;
+            return *this;
+        }
+        const_iterator operator++(int) {
+            const_iterator copy = *this;
+            ++m_index;
+            return copy;
+        }
+        bool operator==(const const_iterator& other) const {
+            return m_trajectory == other.m_trajectory &&
+                   m_index == other.m_index;
+        }
+        bool operator!=(const const_iterator& other) const {
+            return !operator==(other);
+        }
+        /** The index of the state to which the iterator points. */
+        size_t getIndex() const { return m_index; }
+
+    private:
+        const CompactStatesTrajectory* m_trajectory;
+        size_t m_index;
+    };
+
+    /// @name Iterating through the trajectory
+    /// @{
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, getSize()); }
+    /// @}
+#endif
+
+    /// @name Modify the contents of the trajectory
+    /// @{
+    /** Clear all the states in the trajectory. The discrete variables to
+     * store are kept. */
+    void clear();
+    /** Allocate memory for the given number of states, to avoid
+     * reallocating while appending states. */
+    void reserve(size_t numStates);
+    /** Append the time, Y, and discrete variables of a SimTK::State to this
+     * trajectory. The first state appended to the trajectory is copied into
+     * the scratch state. The time of the new state must be greater than or
+     * equal to the time of the last state in the trajectory, and the new
+     * state must be consistent with the first state (see
+     * StatesTrajectory::isConsistent()).
+     * @throws StatesTrajectory::InconsistentState */
+    void append(const SimTK::State& state);
+    /// @}
+
+    /** Create a StatesTrajectory that contains a copy of each state in this
+     * trajectory. */
+    StatesTrajectory createStatesTrajectory() const;
+
+    /** Export the continuous state variables to a data table. This is the
+     * same as StatesTrajectory::exportToTable(). */
+    TimeSeriesTable exportToTable(const Model& model,
+            const std::vector<std::string>& stateVars = {}) const;
+
+    /** Same as StatesTrajectory::createFromStatesTable(), but the resulting
+     * trajectory is compact. This is faster than
+     * StatesTrajectory::createFromStatesTable() since the states are not
+     * copied, and the resulting trajectory stores the discrete variables of
+     * the copy of the model used to fill it. The reconstituted states are
+     * realized to SimTK::Stage::Instance and should only be used with the
+     * provided model.
+     * @throws StatesTrajectory::MissingColumns
+     * @throws StatesTrajectory::ExtraColumns
+     * @throws StatesTrajectory::DataIsInDegrees */
+    static CompactStatesTrajectory createFromStatesTable(const Model& model,
+            const TimeSeriesTable& table,
+            bool allowMissingColumns = false,
+            bool allowExtraColumns = false,
+            bool assemble = false);
+
+private:
+    // Location of a discrete variable in the State.
+    struct DiscreteVariable {
+        SimTK::SubsystemIndex subsystem;
+        SimTK::DiscreteVariableIndex index;
+    };
+    std::vector<std::string> m_discreteVariableNames;
+    std::vector<DiscreteVariable> m_discreteVariables;
+
+    // One entry (or column) per state. The matrices have at least as many
+    // columns as there are states; the extra columns are capacity.
+    std::vector<double> m_times;
+    SimTK::Matrix m_y;
+    SimTK::Matrix m_discreteValues;
+
+    // The state in which states are reconstituted (empty until a state is
+    // appended), and the index of the state it currently holds (or -1).
+    mutable SimTK::State m_scratch;
+    mutable int m_scratchIndex = -1;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_COMPACT_STATES_TRAJECTORY_H_
@@ -31,6 +31,31 @@
 using namespace OpenSim;
 using namespace std;
 
+namespace {
+// Equivalent to aNodes.searchBinary() for a node at time aT, but without
+// writing to a search node, so that controls can be evaluated from multiple
+// threads.
+int searchNodesBinary(const ArrayPtrs<ControlLinearNode>& aNodes, double aT)
+{
+    int lo = 0;
+    int hi = aNodes.getSize() - 1;
+    int mid = -1;
+    if(lo>hi) return(-1);
+    while(lo <= hi) {
+        mid = (lo + hi) / 2;
+        const double t = aNodes[mid]->getTime();
+        if(aT < t) {
+            hi = mid - 1;
+        } else if(t < aT) {
+            lo = mid + 1;
+        } else {
+            break;
+        }
+    }
+    if(aT < aNodes[mid]->getTime()) mid--;
+    return(mid);
+}
+} // anonymous namespace
 
 //=============================================================================
 // CONSTRUCTOR(S)
@@ -425,8 +450,7 @@ getControlValue(ArrayPtrs<ControlLinearNode> &aNodes,double aT)
     if(size<=0) return(SimTK::NaN);
 
     // GET NODE
-    _searchNode.setTime(aT);
-    int i = aNodes.searchBinary(_searchNode);
+    int i = searchNodesBinary(aNodes, aT);
 
     // BEFORE FIRST
     double value;
@@ -0,0 +1,171 @@
+/* -------------------------------------------------------------------------- *
+ *                   OpenSim:  DifferentiableExpression.cpp                   *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2020 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "DifferentiableExpression.h"
+
+#include <OpenSim/Common/Exception.h>
+
+#include <lepton/Operation.h>
+#include <lepton/ParsedExpression.h>
+#include <lepton/Parser.h>
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <mutex>
+
+using namespace OpenSim;
+
+DifferentiableExpression::Compiled::Compiled(
+        const Lepton::ParsedExpression& expression,
+        const std::vector<std::string>& variables)
+        : program(expression.createProgram()) {
+    for (int i = 0; i < program.getNumOperations(); ++i) {
+        const Lepton::Operation& operation = program.getOperation(i);
+        int index = -1;
+        if (operation.getId() == Lepton::Operation::VARIABLE) {
+            const auto it = std::find(variables.begin(), variables.end(),
+                    operation.getName());
+            if (it != variables.end()) index = int(it - variables.begin());
+        }
+        variableIndices.push_back(index);
+    }
+}
+
+struct DifferentiableExpression::Programs {
+    explicit Programs(const Lepton::ParsedExpression& expression, int n)
+            : parsed(expression), firstDerivatives(n),
+              compiled(1 + n + n * (n + 1) / 2),
+              ready(new std::atomic<const Compiled*>[compiled.size()]) {
+        for (size_t k = 0; k < compiled.size(); ++k) ready[k] = nullptr;
+    }
+    const Lepton::ParsedExpression parsed;
+    // Guards the members below, except for reading `ready`.
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Lepton::ParsedExpression>> firstDerivatives;
+    // The expression, its first derivatives, then the upper triangle of
+    // its second derivatives, row by row.
+    std::vector<std::unique_ptr<Compiled>> compiled;
+    // The elements of `compiled` that have been compiled, so that evaluating
+    // a program that is already compiled does not lock the mutex.
+    std::unique_ptr<std::atomic<const Compiled*>[]> ready;
+};
+
+DifferentiableExpression::DifferentiableExpression(
+        const std::string& expression, std::vector<std::string> variables)
+        : m_variables(std::move(variables)) {
+    m_programs = std::make_shared<Programs>(
+            Lepton::Parser::parse(expression).optimize(), getNumVariables());
+    const Compiled& compiled = getProgram(-1, -1);
+    const auto& program = compiled.program;
+    for (int i = 0; i < program.getNumOperations(); ++i) {
+        const Lepton::Operation& operation = program.getOperation(i);
+        OPENSIM_THROW_IF(operation.getId() == Lepton::Operation::VARIABLE &&
+                                 compiled.variableIndices[i] < 0,
+                Exception,
+                "Expression '{}' uses unknown variable '{}'.", expression,
+                operation.getName());
+    }
+}
+
+const DifferentiableExpression::Compiled&
+DifferentiableExpression::getProgram(int i, int j) const {
+    const int n = getNumVariables();
+    const int index = i < 0 ? 0 :
+                      j < 0 ? 1 + i : 1 + n + i * n - i * (i - 1) / 2 + (j - i);
+    Programs& programs = *m_programs;
+    if (const Compiled* compiled =
+                    programs.ready[index].load(std::memory_order_acquire)) {
+        return *compiled;
+    }
+
+    std::lock_guard<std::mutex> lock(programs.mutex);
+    if (!programs.compiled[index]) {
+        auto firstDerivative = [&](int k) -> const Lepton::ParsedExpression& {
+            auto& derivative = programs.firstDerivatives[k];
+            if (!derivative) {
+                derivative.reset(new Lepton::ParsedExpression(
+                        programs.parsed.differentiate(m_variables[k])
+                                .optimize()));
+            }
+            return *derivative;
+        };
+        const Lepton::ParsedExpression expression =
+                i < 0 ? programs.parsed :
+                j < 0 ? firstDerivative(i) :
+                        firstDerivative(i).differentiate(m_variables[j])
+                                .optimize();
+        programs.compiled[index].reset(new Compiled(expression, m_variables));
+        programs.ready[index].store(programs.compiled[index].get(),
+                std::memory_order_release);
+    }
+    return *programs.compiled[index];
+}
+
+// This mirrors Lepton::ExpressionProgram::evaluate(), except that variables
+// are loaded from `x` by position instead of from a std::map, and the stack
+// is local to the call.
+double DifferentiableExpression::evaluate(
+        const Compiled& compiled, const double* x) {
+    // Only variables look up the map, and we load those ourselves.
+    static const std::map<std::string, double> noVariables;
+    const Lepton::ExpressionProgram& program = compiled.program;
+    const int stackSize = program.getStackSize();
+    double smallStack[16];
+    std::vector<double> largeStack;
+    double* stack = smallStack;
+    if (stackSize + 1 > 16) {
+        largeStack.resize(stackSize + 1);
+        stack = largeStack.data();
+    }
+    int stackPointer = stackSize;
+    for (int i = 0; i < program.getNumOperations(); ++i) {
+        const Lepton::Operation& operation = program.getOperation(i);
+        const int variable = compiled.variableIndices[i];
+        const double result = variable >= 0 ? x[variable] :
+                operation.evaluate(&stack[stackPointer], noVariables);
+        stackPointer += operation.getNumArguments() - 1;
+        stack[stackPointer] = result;
+    }
+    return stack[stackSize - 1];
+}
+
+double DifferentiableExpression::calcValue(const double* x) const {
+    return evaluate(getProgram(-1, -1), x);
+}
+
+double DifferentiableExpression::calcDerivative(const double* x, int i) const {
+    OPENSIM_THROW_IF(i < 0 || i >= getNumVariables(), IndexOutOfRange,
+            (size_t)i, 0, (size_t)getNumVariables() - 1);
+    return evaluate(getProgram(i, -1), x);
+}
+
+double DifferentiableExpression::calcSecondDerivative(
+        const double* x, int i, int j) const {
+    const int n = getNumVariables();
+    OPENSIM_THROW_IF(i < 0 || i >= n, IndexOutOfRange, (size_t)i, 0,
+            (size_t)n - 1);
+    OPENSIM_THROW_IF(j < 0 || j >= n, IndexOutOfRange, (size_t)j, 0,
+            (size_t)n - 1);
+    if (j < i) std::swap(i, j);
+    return evaluate(getProgram(i, j), x);
+}
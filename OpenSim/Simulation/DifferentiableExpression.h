@@ -0,0 +1,114 @@
+#ifndef OPENSIM_DIFFERENTIABLE_EXPRESSION_H_
+#define OPENSIM_DIFFERENTIABLE_EXPRESSION_H_
+/* -------------------------------------------------------------------------- *
+ *                    OpenSim:  DifferentiableExpression.h                    *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2020 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimSimulationDLL.h"
+
+#include <lepton/ExpressionProgram.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Lepton {
+class ParsedExpression;
+}
+
+namespace OpenSim {
+
+/** A Lepton expression of a fixed, ordered list of variables, compiled
+together with its first and second partial derivatives.
+
+The expression is compiled to a Lepton::ExpressionProgram, and the values
+of the variables are passed by position, in the order given to the
+constructor, rather than looked up by name in a std::map. The partial
+derivatives are obtained symbolically with Lepton's differentiate() and
+compiled in the same way, so that they can be evaluated analytically instead
+of by finite differences. Each derivative is differentiated and compiled the
+first time that it is evaluated, so derivatives that are never used cost
+nothing; copies of a DifferentiableExpression share the compiled programs.
+
+@code
+DifferentiableExpression expr("-10*q^3-5*q*qdot", {"q", "qdot"});
+const double x[] = {0.5, 2.0};
+double force = expr.calcValue(x);
+double dforce_dq = expr.calcDerivative(x, 0);
+double d2force_dqdqdot = expr.calcSecondDerivative(x, 0, 1);
+@endcode
+
+Evaluation uses only storage local to the call, so a
+DifferentiableExpression can be evaluated from several threads at once. */
+class OSIMSIMULATION_API DifferentiableExpression {
+public:
+    DifferentiableExpression() = default;
+    /** Parse and compile the expression. Its partial derivatives are
+    compiled when they are first evaluated.
+    @throws Exception if the expression uses a variable that is not in
+            `variables`. Lepton throws Lepton::Exception if the expression
+            cannot be parsed. */
+    DifferentiableExpression(const std::string& expression,
+            std::vector<std::string> variables);
+
+    /** The variables of the expression, in the order in which their values
+    are passed to the calc functions. */
+    const std::vector<std::string>& getVariableNames() const
+    {   return m_variables; }
+    int getNumVariables() const { return (int)m_variables.size(); }
+
+    /** The value of the expression. `x` holds the value of each variable,
+    in the order of getVariableNames(). */
+    double calcValue(const double* x) const;
+    /** The partial derivative of the expression with respect to variable
+    `i`. */
+    double calcDerivative(const double* x, int i) const;
+    /** The second partial derivative of the expression with respect to
+    variables `i` and `j` (in either order). */
+    double calcSecondDerivative(const double* x, int i, int j) const;
+
+private:
+    struct Compiled {
+        explicit Compiled(const Lepton::ParsedExpression& expression,
+                const std::vector<std::string>& variables);
+        Lepton::ExpressionProgram program;
+        // For each operation of the program, the index of the variable that
+        // it loads, or -1 if the operation does not load a variable.
+        std::vector<int> variableIndices;
+    };
+
+    // The parsed expression and the programs compiled so far (defined in
+    // the .cpp file).
+    struct Programs;
+
+    // The program of the expression (if `i` is negative), of its derivative
+    // with respect to variable `i` (if `j` is negative), or of its second
+    // derivative with respect to variables i <= j. It is compiled on first
+    // use.
+    const Compiled& getProgram(int i, int j) const;
+    static double evaluate(const Compiled& compiled, const double* x);
+
+    std::vector<std::string> m_variables;
+    std::shared_ptr<Programs> m_programs;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_DIFFERENTIABLE_EXPRESSION_H_
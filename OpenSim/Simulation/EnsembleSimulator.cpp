@@ -0,0 +1,132 @@
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  EnsembleSimulator.cpp                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2020 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "EnsembleSimulator.h"
+#include "Manager/Manager.h"
+#include "Model/Model.h"
+
+#include <OpenSim/Common/CommonUtilities.h>
+
+#include <algorithm>
+
+using namespace OpenSim;
+
+EnsembleSimulator::EnsembleSimulator(
+        const Model& model, const SimTK::State& initialState)
+        : _model(new Model(model)), _initialState(initialState) {
+    _model->setUseVisualizer(false);
+    _model->initSystem();
+}
+
+EnsembleSimulator::~EnsembleSimulator() = default;
+
+std::vector<TimeSeriesTable> EnsembleSimulator::simulate(
+        const TimeSeriesTable& perturbations, double finalTime) const {
+    const int numMembers = (int)perturbations.getNumRows();
+    std::vector<TimeSeriesTable> results(numMembers);
+    if (numMembers == 0) return results;
+
+    // Sort the columns into initial values of state variables and values of
+    // properties, checking that each names something in the model.
+    const Array<std::string> stateNames = _model->getStateVariableNames();
+    const auto& labels = perturbations.getColumnLabels();
+    std::vector<int> stateColumns;
+    std::vector<int> propertyColumns;
+    std::vector<std::pair<std::string, std::string>> properties;
+    for (int icol = 0; icol < (int)labels.size(); ++icol) {
+        const std::string& label = labels[icol];
+        if (stateNames.findIndex(label) >= 0) {
+            stateColumns.push_back(icol);
+            continue;
+        }
+        const auto bar = label.rfind('|');
+        OPENSIM_THROW_IF(bar == std::string::npos, Exception,
+                "Expected column label '{}' to be a state variable path or "
+                "of the form '<component path>|<property name>'.", label);
+        const std::string path = label.substr(0, bar);
+        const std::string name = label.substr(bar + 1);
+        const auto& property =
+                _model->getComponent(path).getPropertyByName(name);
+        OPENSIM_THROW_IF(property.isListProperty() ||
+                                 property.getTypeName() != "double",
+                Exception,
+                "Expected property '{}' of '{}' to hold a single double, "
+                "but it holds {}.", name, path, property.getTypeName());
+        propertyColumns.push_back(icol);
+        properties.emplace_back(path, name);
+    }
+
+    const int numThreads =
+            std::min(resolveNumThreads(_numThreads), numMembers);
+
+    // Copying the models, setting their properties, and initializing their
+    // Systems is done serially, before the simulations start. If the
+    // properties are perturbed, each member gets its own copy of the model;
+    // otherwise, each thread reuses one copy for all the members it takes.
+    const bool modelPerMember = !propertyColumns.empty();
+    const int numModels = modelPerMember ? numMembers : numThreads;
+    std::vector<std::unique_ptr<Model>> models;
+    for (int imodel = 0; imodel < numModels; ++imodel) {
+        models.emplace_back(new Model(*_model));
+        if (modelPerMember) {
+            const auto& row = perturbations.getRowAtIndex(imodel);
+            for (int ip = 0; ip < (int)propertyColumns.size(); ++ip) {
+                models.back()->updComponent(properties[ip].first)
+                        .updPropertyByName(properties[ip].second)
+                        .updValue<double>() = row[propertyColumns[ip]];
+            }
+        }
+        models.back()->initSystem();
+    }
+
+    parallelFor(numMembers, numThreads, [&](int member, int thread) {
+        auto& modelPtr = models[modelPerMember ? member : thread];
+        Model& model = *modelPtr;
+        const auto& row = perturbations.getRowAtIndex(member);
+
+        SimTK::State state = model.getWorkingState();
+        state.setTime(_initialState.getTime());
+        state.updY() = _initialState.getY();
+        for (int icol : stateColumns) {
+            model.setStateVariableValue(state, labels[icol], row[icol]);
+        }
+        if (_equilibrate) model.equilibrateMuscles(state);
+
+        Manager manager(model);
+        manager.setPerformAnalyses(false);
+        if (!SimTK::isNaN(_accuracy))
+            manager.setIntegratorAccuracy(_accuracy);
+        if (!SimTK::isNaN(_minStepSize))
+            manager.setIntegratorMinimumStepSize(_minStepSize);
+        if (!SimTK::isNaN(_maxStepSize))
+            manager.setIntegratorMaximumStepSize(_maxStepSize);
+        if (_maxSteps > 0)
+            manager.setIntegratorInternalStepLimit(_maxSteps);
+        manager.initialize(state);
+        manager.integrate(finalTime);
+        results[member] = manager.getStatesTable();
+
+        // A member's own model is no longer needed.
+        if (modelPerMember) modelPtr.reset();
+    });
+    return results;
+}
@@ -0,0 +1,120 @@
+#ifndef OPENSIM_ENSEMBLE_SIMULATOR_H_
+#define OPENSIM_ENSEMBLE_SIMULATOR_H_
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  EnsembleSimulator.h                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2020 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimSimulationDLL.h"
+#include <OpenSim/Common/TimeSeriesTable.h>
+#include <SimTKcommon/internal/State.h>
+
+#include <memory>
+
+namespace OpenSim {
+
+class Model;
+
+/** Simulate an ensemble of variations of a model, e.g., for a Monte-Carlo
+study of the effect of uncertain muscle parameters or initial states, without
+loading the model once for each simulation.
+
+Each row of the perturbations table passed to simulate() describes one member
+of the ensemble. A column whose label is the path of a state variable (e.g.,
+`/jointset/knee/knee_angle_r/value`) gives the member's initial value of that
+state variable. Any other column label must have the form
+`<component path>|<property name>` and names a property of type double (e.g.,
+`/forceset/soleus_r|max_isometric_force`); the column gives the member's value
+of that property. The rows' times are not used.
+
+The members are simulated on several threads, each with its own copy of the
+model. If the table perturbs properties, each member instead gets its own copy
+of the model, which is created and initialized before the simulations start;
+keep this memory in mind for large ensembles of large models. Each thread takes the next member that has not been simulated yet when
+it finishes one, so members that take longer to simulate do not hold up the
+others. The results do not depend on the number of threads.
+
+@code{.cpp}
+Model model("arm26.osim");
+SimTK::State& state = model.initSystem();
+TimeSeriesTable perturbations;
+perturbations.setColumnLabels({"/forceset/TRIlong|max_isometric_force",
+                               "/jointset/r_elbow/r_elbow_flex/value"});
+const double member0[] = {700.0, 0.5};
+const double member1[] = {900.0, 0.6};
+perturbations.appendRow(0, SimTK::RowVector(2, member0));
+perturbations.appendRow(1, SimTK::RowVector(2, member1));
+EnsembleSimulator ensemble(model, state);
+std::vector<TimeSeriesTable> statesTables =
+        ensemble.simulate(perturbations, 1.0);
+@endcode
+@ingroup simulationutil */
+class OSIMSIMULATION_API EnsembleSimulator {
+public:
+    /** The model is copied; later changes to `model` do not affect the
+    ensemble. The initial state must be from `model`'s system; each member
+    starts from its time and state variable values. */
+    EnsembleSimulator(const Model& model, const SimTK::State& initialState);
+    ~EnsembleSimulator();
+
+    /** %Set the number of threads used to simulate the members. The default,
+    0, uses all available hardware threads. */
+    void setNumThreads(int numThreads) { _numThreads = numThreads; }
+    int getNumThreads() const { return _numThreads; }
+
+    /** %Set whether to solve for equilibrium of the muscles of each member
+    after setting its initial state and properties. The default is false. */
+    void setEquilibrateMuscles(bool equilibrate) { _equilibrate = equilibrate; }
+    bool getEquilibrateMuscles() const { return _equilibrate; }
+
+    /** @name Configure the Integrator
+    These are passed on to the Manager of each member (see Manager). By
+    default, the Manager's defaults are used.
+    @{ */
+    void setIntegratorAccuracy(double accuracy) { _accuracy = accuracy; }
+    void setIntegratorMinimumStepSize(double hmin) { _minStepSize = hmin; }
+    void setIntegratorMaximumStepSize(double hmax) { _maxStepSize = hmax; }
+    void setIntegratorInternalStepLimit(int nSteps) { _maxSteps = nSteps; }
+    /** @} */
+
+    /** Simulate each member of the ensemble described by `perturbations`
+    (see above) from the initial state's time to `finalTime`. The returned
+    vector is allocated before the simulations start and element i is filled
+    in with the states table (see Manager::getStatesTable()) of the member in
+    row i as soon as that member is done. Analyses in the model are not run.
+    @throws Exception if a column label does not name a state variable or a
+    double property of the model, or if any member fails to simulate. */
+    std::vector<TimeSeriesTable> simulate(
+            const TimeSeriesTable& perturbations, double finalTime) const;
+
+private:
+    std::unique_ptr<Model> _model;
+    SimTK::State _initialState;
+    int _numThreads = 0;
+    bool _equilibrate = false;
+    double _accuracy = SimTK::NaN;
+    double _minStepSize = SimTK::NaN;
+    double _maxStepSize = SimTK::NaN;
+    int _maxSteps = -1;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_ENSEMBLE_SIMULATOR_H_
@@ -24,6 +24,7 @@
 #include "InverseDynamicsSolver.h"
 #include "Model/Model.h"
 #include <OpenSim/Common/FunctionSet.h>
+#include <OpenSim/Common/GCVSplineSet.h>
 
 using namespace std;
 using namespace SimTK;
@@ -113,10 +114,17 @@ Vector InverseDynamicsSolver::solve(SimTK::State &s, const FunctionSet &Qs, doub
     Vector &u = s.updU();
     Vector &udot = s.updUDot();
 
-    for(int i=0; i<nq; i++){
-        q[i] = Qs.evaluate(i, 0, time);
-        u[i] = Qs.evaluate(i, 1, time);
-        udot[i] = Qs.evaluate(i, 2, time);
+    // Splines are evaluated together, sharing the search for the knot interval
+    const GCVSplineSet* splines = dynamic_cast<const GCVSplineSet*>(&Qs);
+    if(splines){
+        splines->calcValues(time, q, &u, &udot);
+    }
+    else{
+        for(int i=0; i<nq; i++){
+            q[i] = Qs.evaluate(i, 0, time);
+            u[i] = Qs.evaluate(i, 1, time);
+            udot[i] = Qs.evaluate(i, 2, time);
+        }
     }
 
     // Perform general inverse dynamics
@@ -497,17 +497,19 @@ void InverseKinematicsSolver::updateGoals(SimTK::State &s)
 
     double nextTime = s.getTime();
     // specify the marker observations to be matched
+    // The references are read with cursors and into the same arrays at every
+    // frame, so tracking a trial does not search or allocate at each frame.
     if (_markersReference && _markersReference->getNumRefs() > 0) {
-        SimTK::Array_<SimTK::Vec3> markerValues;
-        _markersReference->getValuesAtTime(nextTime, markerValues);
-        _markerAssemblyCondition->moveAllObservations(markerValues);
+        _markersReference->getValuesAtTime(
+                nextTime, _markerValues, _markersCursor);
+        _markerAssemblyCondition->moveAllObservations(_markerValues);
     }
 
     // specify the orientation observations to be matched
     if (_orientationsReference && _orientationsReference->getNumRefs() > 0) {
-        SimTK::Array_<SimTK::Rotation> orientationValues;
-        _orientationsReference->getValuesAtTime(nextTime, orientationValues);
-        _orientationAssemblyCondition->moveAllObservations(orientationValues);
+        _orientationsReference->getValuesAtTime(
+                nextTime, _orientationValues, _orientationsCursor);
+        _orientationAssemblyCondition->moveAllObservations(_orientationValues);
     }
 }
 
@@ -255,6 +255,12 @@ private:
     // The orientation reference values and weightings
     std::shared_ptr<OrientationsReference> _orientationsReference;
 
+    // Positions in, and values read from, the references at the last frame
+    ReferenceCursor _markersCursor;
+    ReferenceCursor _orientationsCursor;
+    SimTK::Array_<SimTK::Vec3> _markerValues;
+    SimTK::Array_<SimTK::Rotation> _orientationValues;
+
     // Markers collectively form a single assembly condition for the 
     // SimTK::Assembler and the memory is managed by the Assembler
     SimTK::ReferencePtr<SimTK::Markers> _markerAssemblyCondition;
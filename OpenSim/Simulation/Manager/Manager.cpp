@@ -30,6 +30,7 @@
 #include <OpenSim/Simulation/Model/AnalysisSet.h>
 #include <OpenSim/Simulation/Model/ControllerSet.h>
 #include <OpenSim/Common/Array.h>
+#include <OpenSim/Common/Reporter.h>
 
 
 using namespace OpenSim;
@@ -696,6 +697,11 @@ const SimTK::State& Manager::integrate(double finalTime)
         _integ->setReturnEveryInternalStep(true);
     }
 
+    // Let reporters with a fixed reporting interval allocate their storage.
+    for (const auto& reporter : _model->getComponentList<AbstractReporter>()) {
+        reporter.prepareToReport(initialTime, finalTime);
+    }
+
     _model->realizeVelocity(s);
     initializeStorageAndAnalyses(s);
 
@@ -162,6 +162,36 @@ void MarkersReference::getValuesAtTime(double time,
         values.push_back(rowView[i]);
 }
 
+void MarkersReference::getValuesAtTime(double time,
+        SimTK::Array_<Vec3>& values, ReferenceCursor& cursor,
+        bool interpolate) const {
+    const auto& times = _markerTable.getIndependentColumn();
+    OPENSIM_THROW_IF(times.empty(), EmptyTable);
+    const double eps = SimTK::SignificantReal;
+    OPENSIM_THROW_IF(time < times.front() - eps || time > times.back() + eps,
+            TimeOutOfRange, time, times.front(), times.back());
+
+    const int nm = getNumRefs();
+    if (int(values.size()) != nm) values.resize(nm);
+
+    size_t row = cursor.seek(times, time);
+    const bool hasNext = row + 1 < times.size();
+    if (interpolate && hasNext && time > times[row]) {
+        const double alpha =
+                (time - times[row]) / (times[row + 1] - times[row]);
+        const auto before = _markerTable.getRowAtIndex(row);
+        const auto after = _markerTable.getRowAtIndex(row + 1);
+        for (int i = 0; i < nm; ++i)
+            values[i] = before[i] + alpha * (after[i] - before[i]);
+        return;
+    }
+    // Same tie-breaking as TimeSeriesTable::getNearestRowIndexForTime().
+    if (hasNext && times[row + 1] - time <= time - times[row]) ++row;
+    const auto rowView = _markerTable.getRowAtIndex(row);
+    for (int i = 0; i < nm; ++i)
+        values[i] = rowView[i];
+}
+
 // void
 // MarkersReference::getSpeedValues(const SimTK::State &s,
 //                                  SimTK::Array_<Vec3> &speedValues) const {
@@ -146,6 +146,17 @@ public:
     /** get the value of the MarkersReference  */
     void getValuesAtTime(
             double time, SimTK::Array_<SimTK::Vec3> &values) const override;
+    /** Get the marker values at `time` for a reader that visits times in
+        order, such as the InverseKinematicsSolver. The row is found starting
+        from where `cursor` was left by the previous call instead of by
+        searching the time column, and `values` is only resized if it does not
+        already hold getNumRefs() values, so reusing `values` between calls
+        does not allocate. If `interpolate` is false, the values are those of
+        the nearest row, as in getValuesAtTime() above; otherwise they are
+        interpolated linearly between the rows before and after `time`.
+        @throws TimeOutOfRange if `time` is outside getValidTimeRange(). */
+    void getValuesAtTime(double time, SimTK::Array_<SimTK::Vec3>& values,
+            ReferenceCursor& cursor, bool interpolate = false) const;
     // The following two methods are commented out as they are not implemented
     // and we don't want users to think it *is* implemented when viewing
     // doxygen.
@@ -352,6 +352,27 @@ ArrayPtrs<Storage>& Analysis::getStorageList()
     return _storageList;
 }
 
+//_____________________________________________________________________________
+/**
+ * Append the results of a copy of this analysis that analyzed a later time
+ * interval.
+ */
+void Analysis::appendResults(Analysis& aAnalysis)
+{
+    ArrayPtrs<Storage>& storages = getStorageList();
+    ArrayPtrs<Storage>& otherStorages = aAnalysis.getStorageList();
+    OPENSIM_THROW_IF_FRMOBJ(storages.getSize() != otherStorages.getSize(),
+            Exception,
+            "Expected analysis '{}' to have {} storages, but it has {}.",
+            aAnalysis.getName(), storages.getSize(), otherStorages.getSize());
+    for(int i=0;i<storages.getSize();i++) {
+        const Storage& other = *otherStorages[i];
+        for(int j=0;j<other.getSize();j++) {
+            storages[i]->append(*other.getStateVector(j), false);
+        }
+    }
+}
+
 // GET AND SET
 //=============================================================================
 //_____________________________________________________________________________
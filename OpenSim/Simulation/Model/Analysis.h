@@ -231,6 +231,31 @@ public:
         printResults(const std::string &aBaseName,const std::string &aDir="",
         double aDT=-1.0,const std::string &aExtension=".sto");
 
+    //--------------------------------------------------------------------------
+    // HISTORY-FREE ANALYSES
+    //--------------------------------------------------------------------------
+    /**
+     * Whether what this analysis records at a time depends only on the state
+     * at that time, and not on the states it was given earlier. begin(),
+     * step() (with a step interval of 1), and end() must then each record one
+     * row for the given state. A tool may then give separate time intervals
+     * to copies of this analysis, process them concurrently, and combine the
+     * results with appendResults() (see AnalyzeTool::setNumThreads()).
+     *
+     * @return false unless overridden.
+     */
+    virtual bool isHistoryFree() const { return false; }
+    /**
+     * Append the results of a copy of this analysis, which analyzed a later
+     * time interval, to the results of this analysis. The default
+     * implementation appends the rows of each storage in
+     * aAnalysis.getStorageList() to the corresponding storage in
+     * getStorageList().
+     *
+     * @param aAnalysis Copy of this analysis, with the same settings.
+     */
+    virtual void appendResults(Analysis& aAnalysis);
+
 //=============================================================================
 };  // END of class Analysis
 
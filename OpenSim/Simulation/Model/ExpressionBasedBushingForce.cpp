@@ -24,14 +24,25 @@
 //=============================================================================
 // INCLUDES
 //=============================================================================
-#include <Lepton.h>
 
 #include "ExpressionBasedBushingForce.h"
 
+#include <algorithm>
+
 using namespace std;
 using namespace SimTK;
 using namespace OpenSim;
 
+namespace {
+    // The variables of the stiffness expressions, in the order of the
+    // components of the deflection.
+    const std::vector<std::string>& deflectionVariables() {
+        static const std::vector<std::string> variables{
+            "theta_x", "theta_y", "theta_z", "delta_x", "delta_y", "delta_z"};
+        return variables;
+    }
+}
+
 
 // string formatting helper utility
 
@@ -221,7 +232,8 @@ void ExpressionBasedBushingForce::setMxExpression(std::string expression)
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Mx_expression(expression);
-    MxProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    _stiffnessExpressions[0] =
+            DifferentiableExpression(expression, deflectionVariables());
 }
 
 /** Set the expression for the My function and create it's lepton program */
@@ -231,7 +243,8 @@ void ExpressionBasedBushingForce::setMyExpression(std::string expression)
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_My_expression(expression);
-    MyProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    _stiffnessExpressions[1] =
+            DifferentiableExpression(expression, deflectionVariables());
 }
 
 /** Set the expression for the Mz function and create it's lepton program */
@@ -240,7 +253,8 @@ void ExpressionBasedBushingForce::setMzExpression(std::string expression)
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Mz_expression(expression);
-    MzProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    _stiffnessExpressions[2] =
+            DifferentiableExpression(expression, deflectionVariables());
 }
 
 /** Set the expression for the Fx function and create it's lepton program */
@@ -249,7 +263,8 @@ void ExpressionBasedBushingForce::setFxExpression(std::string expression)
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Fx_expression(expression);
-    FxProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    _stiffnessExpressions[3] =
+            DifferentiableExpression(expression, deflectionVariables());
 }
 
 /** Set the expression for the Fy function and create it's lepton program */
@@ -258,7 +273,8 @@ void ExpressionBasedBushingForce::setFyExpression(std::string expression)
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Fy_expression(expression);
-    FyProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    _stiffnessExpressions[4] =
+            DifferentiableExpression(expression, deflectionVariables());
 }
 
 /** Set the expression for the Fz function and create it's lepton program */
@@ -267,7 +283,8 @@ void ExpressionBasedBushingForce::setFzExpression(std::string expression)
     expression.erase( remove_if(expression.begin(), expression.end(), ::isspace), 
                         expression.end() );
     set_Fz_expression(expression);
-    FzProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    _stiffnessExpressions[5] =
+            DifferentiableExpression(expression, deflectionVariables());
 }
 //=============================================================================
 // COMPUTATION
@@ -281,24 +298,48 @@ SimTK::Vec6 ExpressionBasedBushingForce::
     Vec6 dq = computeDeflection(s);
 
     Vec6 fk = Vec6(0.0);
+    for (int i = 0; i < 6; ++i) {
+        fk[i] = _stiffnessExpressions[i].calcValue(&dq[0]);
+    }
 
-    std::map<std::string, double> deflectionVars;
-    deflectionVars["theta_x"] = dq[0];
-    deflectionVars["theta_y"] = dq[1];
-    deflectionVars["theta_z"] = dq[2];
-    deflectionVars["delta_x"] = dq[3];
-    deflectionVars["delta_y"] = dq[4];
-    deflectionVars["delta_z"] = dq[5];
+    return -fk;
+}
+
+/* Calculate the derivatives of the stiffness force w.r.t. the deflection. */
+SimTK::Mat66 ExpressionBasedBushingForce::
+    calcStiffnessForceJacobian(const SimTK::State& s) const
+{
+    Vec6 dq = computeDeflection(s);
 
+    Mat66 jacobian;
+    for (int i = 0; i < 6; ++i) {
+        for (int j = 0; j < 6; ++j) {
+            jacobian(i, j) =
+                    -_stiffnessExpressions[i].calcDerivative(&dq[0], j);
+        }
+    }
+    return jacobian;
+}
 
-    fk[0] = MxProg.evaluate(deflectionVars);
-    fk[1] = MyProg.evaluate(deflectionVars);
-    fk[2] = MzProg.evaluate(deflectionVars);
-    fk[3] = FxProg.evaluate(deflectionVars);
-    fk[4] = FyProg.evaluate(deflectionVars);
-    fk[5] = FzProg.evaluate(deflectionVars);
+/* Calculate the second derivatives of one component of the stiffness force
+   w.r.t. the deflection. */
+SimTK::Mat66 ExpressionBasedBushingForce::
+    calcStiffnessForceHessian(const SimTK::State& s, int index) const
+{
+    OPENSIM_THROW_IF_FRMOBJ(index < 0 || index > 5, Exception,
+            "Expected index to be between 0 and 5, but got "
+            + std::to_string(index) + ".");
+    Vec6 dq = computeDeflection(s);
 
-    return -fk;
+    const DifferentiableExpression& expression = _stiffnessExpressions[index];
+    Mat66 hessian;
+    for (int i = 0; i < 6; ++i) {
+        for (int j = i; j < 6; ++j) {
+            hessian(i, j) = -expression.calcSecondDerivative(&dq[0], i, j);
+            hessian(j, i) = hessian(i, j);
+        }
+    }
+    return hessian;
 }
 
 /* Calculate the bushing force contribution due to its damping. */
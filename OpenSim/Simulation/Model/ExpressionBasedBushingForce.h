@@ -27,6 +27,9 @@
 // INCLUDE
 #include "Force.h"
 #include <OpenSim/Simulation/Model/TwoFrameLinker.h>
+#include <OpenSim/Simulation/DifferentiableExpression.h>
+
+#include <array>
 
 namespace OpenSim {
 
@@ -226,6 +229,20 @@ public:
         function of the deflection rate between the bushing frames. It is the 
         force on frame2 from frame1 in the basis of the deflection rate (dqdot).*/
     SimTK::Vec6 calcDampingForce(const SimTK::State& state) const;
+
+    /** Calculate the partial derivatives of calcStiffnessForce() with respect
+        to the deflection between the bushing frames (dq): element (i, j) is
+        the derivative of component i of the stiffness force with respect to
+        component j of dq. These come from the symbolic derivatives of the
+        expressions, so they are exact and can be used in place of finite
+        differences. */
+    SimTK::Mat66 calcStiffnessForceJacobian(const SimTK::State& state) const;
+
+    /** Calculate the second partial derivatives of component `index` (0-5,
+        in the order Mx, My, Mz, Fx, Fy, Fz) of calcStiffnessForce() with
+        respect to the deflection between the bushing frames (dq). */
+    SimTK::Mat66 calcStiffnessForceHessian(const SimTK::State& state,
+                                           int index) const;
   
 
     //--------------------------------------------------------------------------
@@ -272,8 +289,9 @@ private:
 
     SimTK::Mat66 _dampingMatrix{ 0.0 };
 
-    // parser programs for efficiently evaluating the expressions
-    Lepton::ExpressionProgram MxProg, MyProg, MzProg, FxProg, FyProg, FzProg;
+    // compiled expressions (of the deflection) for Mx, My, Mz, Fx, Fy and Fz,
+    // and their derivatives
+    std::array<DifferentiableExpression, 6> _stiffnessExpressions;
 
 //==============================================================================
 };  // END of class ExpressionBasedBushingForce
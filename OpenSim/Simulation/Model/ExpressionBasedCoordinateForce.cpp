@@ -26,8 +26,8 @@
 //=============================================================================
 #include "ExpressionBasedCoordinateForce.h"
 #include <OpenSim/Simulation/Model/Model.h>
-#include <lepton/Parser.h>
-#include <lepton/ParsedExpression.h>
+
+#include <algorithm>
 
 using namespace OpenSim;
 using namespace std;
@@ -97,7 +97,7 @@ void ExpressionBasedCoordinateForce::extendConnectToModel(Model& aModel)
             remove_if(expression.begin(), expression.end(), ::isspace), 
                       expression.end() );
     
-    _forceProg = Lepton::Parser::parse(expression).optimize().createProgram();
+    _forceExpression = DifferentiableExpression(expression, {"q", "qdot"});
 
     // Look up the coordinate
     if (!_model->updCoordinateSet().contains(coordName)) {
@@ -135,16 +135,33 @@ void ExpressionBasedCoordinateForce::computeForce(const SimTK::State& s,
 double ExpressionBasedCoordinateForce::calcExpressionForce(const SimTK::State& s ) const
 {
     using namespace SimTK;
-    double q = _coord->getValue(s);
-    double qdot = _coord->getSpeedValue(s);
-    std::map<std::string, double> forceVars;
-    forceVars["q"] = q;
-    forceVars["qdot"] = qdot;
-    double forceMag = _forceProg.evaluate(forceVars);
+    const double vars[] = {_coord->getValue(s), _coord->getSpeedValue(s)};
+    double forceMag = _forceExpression.calcValue(vars);
     setCacheVariableValue(s, _forceMagnitudeCV, forceMag);
     return forceMag;
 }
 
+SimTK::Vec2 ExpressionBasedCoordinateForce::
+    calcExpressionForceGradient(const SimTK::State& s) const
+{
+    const double vars[] = {_coord->getValue(s), _coord->getSpeedValue(s)};
+    return SimTK::Vec2(_forceExpression.calcDerivative(vars, 0),
+                       _forceExpression.calcDerivative(vars, 1));
+}
+
+SimTK::Mat22 ExpressionBasedCoordinateForce::
+    calcExpressionForceHessian(const SimTK::State& s) const
+{
+    const double vars[] = {_coord->getValue(s), _coord->getSpeedValue(s)};
+    SimTK::Mat22 hessian;
+    for (int i = 0; i < 2; ++i) {
+        for (int j = 0; j < 2; ++j) {
+            hessian(i, j) = _forceExpression.calcSecondDerivative(vars, i, j);
+        }
+    }
+    return hessian;
+}
+
 // get the force magnitude that has already been computed
 const double& ExpressionBasedCoordinateForce::
     getForceMagnitude(const SimTK::State& s)
@@ -24,7 +24,7 @@
  * -------------------------------------------------------------------------- */
 // INCLUDE
 #include "Force.h"
-#include <lepton/ExpressionProgram.h>
+#include <OpenSim/Simulation/DifferentiableExpression.h>
 
 namespace OpenSim {
 
@@ -100,6 +100,16 @@ public:
     /** Force calculation operator. **/
     double calcExpressionForce( const SimTK::State& s) const;
 
+    /** The partial derivatives of the force magnitude with respect to the
+    coordinate value (first element) and speed (second element). These come
+    from the symbolic derivatives of the expression, so they are exact and
+    can be used in place of finite differences. **/
+    SimTK::Vec2 calcExpressionForceGradient(const SimTK::State& s) const;
+
+    /** The second partial derivatives of the force magnitude with respect to
+    the coordinate value and speed, in that order. **/
+    SimTK::Mat22 calcExpressionForceHessian(const SimTK::State& s) const;
+
 //==============================================================================
 // Reporting
 //==============================================================================
@@ -126,8 +136,8 @@ private:
     void setNull();
     void constructProperties();
 
-    // parser programs for efficiently evaluating the expressions
-    Lepton::ExpressionProgram _forceProg;
+    // compiled expression (of q and qdot) and its derivatives
+    DifferentiableExpression _forceExpression;
 
     // Corresponding generalized coordinate to which the force
     // is applied.
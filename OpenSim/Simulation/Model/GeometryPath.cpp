@@ -107,6 +107,9 @@ void GeometryPath::extendConnectToModel(Model& aModel)
     // We consider this cache entry valid any time after it has been created
     // and first marked valid, and we won't ever invalidate it.
     this->_colorCV = addCacheVariable("color", get_Appearance().get_color(), SimTK::Stage::Topology);
+
+    // Scratch space for applyWrapObjects(); it is never marked valid.
+    this->_wrapWorkspaceCV = addCacheVariable("wrap_workspace", WrapWorkspace{}, SimTK::Stage::Position);
 }
 
  void GeometryPath::extendInitStateFromProperties(SimTK::State& s) const
@@ -152,7 +155,7 @@ generateDecorations(bool fixed, const ModelDisplayHints& hints,
 
         if (pwp) {
             // A PathWrapPoint provides points on the wrapping surface as Vec3s
-            Array<Vec3>& surfacePoints = pwp->getWrapPath();
+            const Array<Vec3>& surfacePoints = pwp->getWrapPath(state);
             // The surface points are expressed w.r.t. the wrap surface's body frame.
             // Transform the surface points into the ground reference frame to draw
             // the surface point as the wrapping portion of the GeometryPath
@@ -863,33 +866,42 @@ void GeometryPath::computeLengtheningSpeed(const SimTK::State& s) const
 void GeometryPath::
 applyWrapObjects(const SimTK::State& s, Array<AbstractPathPoint*>& path) const 
 {
-    if (get_PathWrapSet().getSize() < 1)
+    const int numWraps = get_PathWrapSet().getSize();
+    if (numWraps < 1)
         return;
 
-    WrapResult best_wrap;
-    Array<int> result, order;
+    // Reuse the buffers from previous calls with this State.
+    WrapWorkspace& workspace = updCacheVariableValue(s, _wrapWorkspaceCV);
+    Array<int>& result = workspace.result;
+    Array<int>& order = workspace.order;
 
-    result.setSize(get_PathWrapSet().getSize());
-    order.setSize(get_PathWrapSet().getSize());
+    result.setSize(numWraps);
+    order.setSize(numWraps);
 
     // Set the initial order to be the order they are listed in the path.
-    for (int i = 0; i < get_PathWrapSet().getSize(); i++)
+    for (int i = 0; i < numWraps; i++)
         order[i] = i;
 
     // If there is only one wrap object, calculate the wrapping only once.
     // If there are two or more objects, perform up to 8 iterations where
     // the result from one wrap object is used as the starting point for
     // the next wrap.
-    const int maxIterations = get_PathWrapSet().getSize() < 2 ? 1 : 8;
+    const int maxIterations = numWraps < 2 ? 1 : 8;
     double last_length = SimTK::Infinity;
+    int lastNumWrapped = 0;
     for (int kk = 0; kk < maxIterations; kk++)
     {
-        for (int i = 0; i < get_PathWrapSet().getSize(); i++)
+        int numWrapped = 0;
+        for (int i = 0; i < numWraps; i++)
         {
             result[i] = 0;
             PathWrap& ws = get_PathWrapSet().get(order[i]);
             const WrapObject* wo = ws.getWrapObject();
-            best_wrap.wrap_pts.setSize(0);
+            // Rather than copying the trial wrap into the best wrap, swap the
+            // roles of the two WrapResults in the workspace.
+            WrapResult* best_wrap = &workspace.wraps[0];
+            WrapResult* wr = &workspace.wraps[1];
+            best_wrap->wrap_pts.setSize(0);
             double min_length_change = SimTK::Infinity;
 
             // First remove this object's wrapping points from the current path.
@@ -970,12 +982,19 @@ applyWrapObjects(const SimTK::State& s, Array<AbstractPathPoint*>& path) const
                         || (   path.get(pt1)->getWrapObject() 
                             != path.get(pt2)->getWrapObject()))
                     {
-                        WrapResult wr;
-                        wr.startPoint = pt1;
-                        wr.endPoint   = pt2;
+                        // Start the trial from a clean WrapResult, as a newly
+                        // constructed one would be, but keep the capacity of
+                        // its wrap points.
+                        wr->startPoint = pt1;
+                        wr->endPoint   = pt2;
+                        wr->wrap_pts.setSize(0);
+                        wr->wrap_path_length = 0.0;
+                        wr->r1 = wr->r2 = wr->c1 = wr->sv =
+                                SimTK::Vec3(SimTK::NaN);
+                        wr->factor = SimTK::NaN;
 
                         result[i] = wo->wrapPathSegment(s, *path.get(pt1), 
-                                                        *path.get(pt2), ws, wr);
+                                                        *path.get(pt2), ws, *wr);
                         if (result[i] == WrapObject::mandatoryWrap) {
                             // "mandatoryWrap" means the path actually 
                             // intersected the wrap object. In this case, you 
@@ -984,10 +1003,10 @@ applyWrapObjects(const SimTK::State& s, Array<AbstractPathPoint*>& path) const
                             // that intersects the object, the first one is
                             // taken as the mandatory wrap (this is considered 
                             // an ill-conditioned case).
-                            best_wrap = wr;
+                            std::swap(best_wrap, wr);
                             // Store the best wrap in the pathWrap for possible 
                             // use next time.
-                            ws.setPreviousWrap(wr);
+                            ws.setPreviousWrap(s, *best_wrap);
                             break;
                         }  else if (result[i] == WrapObject::wrapped) {
                             // "wrapped" means the path segment was wrapped over
@@ -995,19 +1014,18 @@ applyWrapObjects(const SimTK::State& s, Array<AbstractPathPoint*>& path) const
                             // segments as well to see if one
                             // wraps with a smaller length change.
                             double path_length_change = 
-                                calcPathLengthChange(s, *wo, wr, path);
+                                calcPathLengthChange(s, *wo, *wr, path);
                             if (path_length_change < min_length_change)
                             {
-                                best_wrap = wr;
+                                std::swap(best_wrap, wr);
                                 // Store the best wrap in the pathWrap for 
                                 // possible use next time
-                                ws.setPreviousWrap(wr);
+                                ws.setPreviousWrap(s, *best_wrap);
                                 min_length_change = path_length_change;
                             } else {
                                 // The wrap was not shorter than the current 
-                                // minimum, so just free the wrap points that 
-                                // were allocated.
-                                wr.wrap_pts.setSize(0);
+                                // minimum; the trial is reset before it is
+                                // used again.
                             }
                         } else {
                             // Nothing to do.
@@ -1015,18 +1033,23 @@ applyWrapObjects(const SimTK::State& s, Array<AbstractPathPoint*>& path) const
                     }
                 }
 
-                // Deallocate previous wrapping points if necessary.
-                ws.updWrapPoint2().getWrapPath().setSize(0);
+                const PathWrapPoint& wrapPoint1 = ws.getWrapPoint1();
+                const PathWrapPoint& wrapPoint2 = ws.getWrapPoint2();
+                Array<SimTK::Vec3>& wrapPath = wrapPoint2.updWrapPath(s);
 
-                if (best_wrap.wrap_pts.getSize() == 0) {
-                    ws.resetPreviousWrap();
-                    ws.updWrapPoint2().getWrapPath().setSize(0);
+                if (best_wrap->wrap_pts.getSize() == 0) {
+                    ws.resetPreviousWrap(s);
+                    wrapPath.setSize(0);
                 } else {
                     // If wrapping did occur, copy wrap info into the PathStruct.
-                    ws.updWrapPoint1().getWrapPath().setSize(0);
+                    ++numWrapped;
+                    wrapPoint1.updWrapPath(s).setSize(0);
 
-                    Array<SimTK::Vec3>& wrapPath = ws.updWrapPoint2().getWrapPath();
-                    wrapPath = best_wrap.wrap_pts;
+                    // Copy element-wise; Array::operator=() would reallocate
+                    // the State's buffer.
+                    wrapPath.setSize(best_wrap->wrap_pts.getSize());
+                    for (int j = 0; j < wrapPath.getSize(); j++)
+                        wrapPath[j] = best_wrap->wrap_pts[j];
 
                     // In OpenSim, all conversion to/from the wrap object's 
                     // reference frame will be performed inside 
@@ -1038,15 +1061,15 @@ applyWrapObjects(const SimTK::State& s, Array<AbstractPathPoint*>& path) const
                     //            ms->ground_segment);
                     // }
 
-                    ws.updWrapPoint1().setWrapLength(0.0);
-                    ws.updWrapPoint2().setWrapLength(best_wrap.wrap_path_length);
+                    wrapPoint1.setWrapLength(s, 0.0);
+                    wrapPoint2.setWrapLength(s, best_wrap->wrap_path_length);
 
-                    ws.updWrapPoint1().setLocation(best_wrap.r1);
-                    ws.updWrapPoint2().setLocation(best_wrap.r2);
+                    wrapPoint1.setLocation(s, best_wrap->r1);
+                    wrapPoint2.setLocation(s, best_wrap->r2);
 
                     // Now insert the two new wrapping points into mp[] array.
-                    path.insert(best_wrap.endPoint, &ws.updWrapPoint1());
-                    path.insert(best_wrap.endPoint + 1, &ws.updWrapPoint2());
+                    path.insert(best_wrap->endPoint, &ws.updWrapPoint1());
+                    path.insert(best_wrap->endPoint + 1, &ws.updWrapPoint2());
                 }
             }
         }
@@ -1058,7 +1081,8 @@ applyWrapObjects(const SimTK::State& s, Array<AbstractPathPoint*>& path) const
             last_length = length;
         }
 
-        if (kk == 0 && get_PathWrapSet().getSize() > 1) {
+        bool reordered = false;
+        if (kk == 0 && numWraps > 1) {
             // If the first wrap was a no wrap, and the second was a no wrap
             // because a point was inside the object, switch the order of
             // the first two objects and try again.
@@ -1067,6 +1091,7 @@ applyWrapObjects(const SimTK::State& s, Array<AbstractPathPoint*>& path) const
             {
                 order[0] = 1;
                 order[1] = 0;
+                reordered = true;
 
                 // remove wrap object 0 from the list of path points
                 PathWrap& ws = get_PathWrapSet().get(0);
@@ -1079,6 +1104,14 @@ applyWrapObjects(const SimTK::State& s, Array<AbstractPathPoint*>& path) const
                 }
             }
         }
+
+        // If this pass started from a path without wrap points and no object
+        // wrapped it, the next pass would see the same path and find the
+        // same result, so there is no need to iterate further.
+        if (!reordered && numWrapped == 0 && lastNumWrapped == 0) {
+            break;
+        }
+        lastNumWrapped = numWrapped;
     }
 }
 
@@ -1128,7 +1161,7 @@ calcLengthAfterPathComputation(const SimTK::State& s,
         {
             const PathWrapPoint* smwp = dynamic_cast<const PathWrapPoint*>(p2);
             if (smwp)
-                length += smwp->getWrapLength();
+                length += smwp->getWrapLength(s);
         } else {
             length += p1->calcDistanceBetween(s, *p2);
         }
@@ -29,6 +29,7 @@
 #include "OpenSim/Simulation/Model/ModelComponent.h"
 #include "PathPointSet.h"
 #include <OpenSim/Simulation/Wrap/PathWrapSet.h>
+#include <OpenSim/Simulation/Wrap/WrapResult.h>
 #include <OpenSim/Simulation/MomentArmSolver.h>
 
 
@@ -91,6 +92,24 @@ private:
     mutable CacheVariable<double> _speedCV;
     mutable CacheVariable<Array<AbstractPathPoint*>> _currentPathCV;
     mutable CacheVariable<SimTK::Vec3> _colorCV;
+
+    // Scratch space for applyWrapObjects(). It is kept in the State, rather
+    // than allocated on each call, so that wrapping does not allocate once
+    // the buffers have grown and so that paths can be wrapped concurrently
+    // with different States. It is never marked valid.
+    struct WrapWorkspace {
+        // The best and the trial wrap for the wrap object being applied.
+        WrapResult wraps[2];
+        Array<int> result;
+        Array<int> order;
+        friend std::ostream& operator<<(std::ostream& o,
+                const WrapWorkspace&) {
+            o << "GeometryPath::WrapWorkspace should not be serialized!"
+              << std::endl;
+            return o;
+        }
+    };
+    mutable CacheVariable<WrapWorkspace> _wrapWorkspaceCV;
     
 //=============================================================================
 // METHODS
@@ -0,0 +1,236 @@
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  ModelSnapshot.cpp                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2020 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "ModelSnapshot.h"
+
+#include "Model.h"
+
+#include <OpenSim/Common/About.h>
+#include <OpenSim/Common/FileAdapter.h>
+#include <OpenSim/Common/IO.h>
+#include <OpenSim/Common/Logger.h>
+#include <OpenSim/Common/ObjectSnapshot.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <unordered_map>
+
+using namespace OpenSim;
+
+namespace {
+const char magic[] = "OSIMSNAP";
+const std::uint32_t formatVersion = 1;
+
+template <typename T>
+void writeValue(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+void writeString(std::ostream& out, const std::string& value) {
+    writeValue(out, (std::uint32_t)value.size());
+    out.write(value.data(), value.size());
+}
+template <typename T>
+T readValue(std::istream& in) {
+    T value;
+    in.read(reinterpret_cast<char*>(&value), sizeof(T));
+    OPENSIM_THROW_IF(!in, Exception, "Unexpected end of model snapshot.");
+    return value;
+}
+std::string readString(std::istream& in) {
+    std::string value(readValue<std::uint32_t>(in), '\0');
+    in.read(&value[0], value.size());
+    OPENSIM_THROW_IF(!in, Exception, "Unexpected end of model snapshot.");
+    return value;
+}
+
+// The build is part of the snapshot's header, since the binary layout of a
+// snapshot depends on the properties of each class.
+std::string getBuild() {
+    return GetVersionAndDate();
+}
+
+// 64-bit FNV-1a hash of the file's contents, in hexadecimal.
+std::string hashFile(const std::string& fileName) {
+    std::ifstream file(fileName, std::ios::binary);
+    OPENSIM_THROW_IF(!file, FileDoesNotExist, fileName);
+    std::uint64_t hash = 14695981039346656037ull;
+    char buffer[65536];
+    while (file) {
+        file.read(buffer, sizeof(buffer));
+        for (std::streamsize i = 0; i < file.gcount(); ++i) {
+            hash ^= (unsigned char)buffer[i];
+            hash *= 1099511628211ull;
+        }
+    }
+    std::stringstream ss;
+    ss << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return ss.str();
+}
+
+} // anonymous namespace
+
+void ModelSnapshot::write(const Model& model,
+        const std::string& snapshotFileName) {
+    std::ofstream out(snapshotFileName, std::ios::binary);
+    OPENSIM_THROW_IF(!out, Exception,
+            "Could not open '{}' for writing.", snapshotFileName);
+    out.write(magic, sizeof(magic) - 1);
+    writeValue(out, formatVersion);
+    writeString(out, getBuild());
+    writeString(out, model.getInputFileName());
+
+    ObjectSnapshot::write(out, model);
+
+    // Store the connectee of each connected single-valued socket as its index
+    // in the list of components (the model, followed by the components in the
+    // order of getComponentList()), so that reading does not need to search
+    // for connectees by path. List sockets are connected by path.
+    std::vector<const Component*> components{&model};
+    for (const auto& component : model.getComponentList())
+        components.push_back(&component);
+    std::unordered_map<const Object*, std::int32_t> indices;
+    for (int i = 0; i < (int)components.size(); ++i)
+        indices[components[i]] = i;
+    writeValue(out, (std::uint32_t)components.size());
+    for (const Component* component : components) {
+        const auto names = component->getSocketNames();
+        writeValue(out, (std::uint32_t)names.size());
+        for (const auto& name : names) {
+            const AbstractSocket& socket = component->getSocket(name);
+            std::int32_t index = -1;
+            if (!socket.isListSocket() && socket.isConnected()) {
+                const auto it = indices.find(&socket.getConnecteeAsObject());
+                if (it != indices.end()) index = it->second;
+            }
+            writeString(out, name);
+            writeValue(out, index);
+        }
+    }
+    OPENSIM_THROW_IF(!out, Exception,
+            "Failed to write model snapshot '{}'.", snapshotFileName);
+}
+
+std::unique_ptr<Model> ModelSnapshot::read(
+        const std::string& snapshotFileName) {
+    std::ifstream in(snapshotFileName, std::ios::binary);
+    OPENSIM_THROW_IF(!in, FileDoesNotExist, snapshotFileName);
+    char header[sizeof(magic) - 1];
+    in.read(header, sizeof(header));
+    OPENSIM_THROW_IF(!in || std::string(header, sizeof(header)) != magic,
+            Exception, "'{}' is not a model snapshot.", snapshotFileName);
+    const auto version = readValue<std::uint32_t>(in);
+    const auto build = readString(in);
+    OPENSIM_THROW_IF(version != formatVersion || build != getBuild(),
+            Exception,
+            "Model snapshot '{}' was written by a different build of OpenSim "
+            "({}).", snapshotFileName, build);
+    const auto inputFileName = readString(in);
+
+    std::unique_ptr<Object> object(ObjectSnapshot::read(in));
+    std::unique_ptr<Model> model(dynamic_cast<Model*>(object.get()));
+    OPENSIM_THROW_IF(!model, Exception,
+            "Snapshot '{}' contains a {}, not a Model.", snapshotFileName,
+            object->getConcreteClassName());
+    object.release();
+    model->setInputFileName(inputFileName);
+    model->finalizeFromProperties();
+
+    // Connecting sockets does not change properties, so avoid
+    // updComponentList(), which would require finalizeFromProperties() again.
+    std::vector<Component*> components{model.get()};
+    for (const auto& component : model->getComponentList())
+        components.push_back(&const_cast<Component&>(component));
+    const auto numComponents = readValue<std::uint32_t>(in);
+    OPENSIM_THROW_IF(numComponents != components.size(), Exception,
+            "Model snapshot '{}' is corrupt (expected {} components but found "
+            "{}).", snapshotFileName, numComponents, components.size());
+    for (Component* component : components) {
+        const auto numSockets = readValue<std::uint32_t>(in);
+        for (std::uint32_t i = 0; i < numSockets; ++i) {
+            const auto name = readString(in);
+            const auto index = readValue<std::int32_t>(in);
+            if (index < 0) continue;
+            OPENSIM_THROW_IF(index >= (std::int32_t)components.size(),
+                    Exception, "Model snapshot '{}' is corrupt.",
+                    snapshotFileName);
+            component->updSocket(name).connect(*components[index]);
+        }
+    }
+    return model;
+}
+
+std::string ModelSnapshot::getSnapshotFileName(
+        const std::string& modelFileName) {
+    return IO::GetFileNameFromURI(modelFileName) + "." +
+           hashFile(modelFileName) + ".osimsnap";
+}
+
+std::unique_ptr<Model> ModelSnapshot::load(const std::string& modelFileName,
+        const std::string& cacheDirectory) {
+    std::string directory = cacheDirectory.empty()
+            ? IO::getParentDirectory(modelFileName) : cacheDirectory;
+    if (!directory.empty() && directory.back() != '/' &&
+            directory.back() != '\\')
+        directory += "/";
+    const std::string snapshotFileName =
+            directory + getSnapshotFileName(modelFileName);
+
+    if (IO::FileExists(snapshotFileName)) {
+        try {
+            auto model = read(snapshotFileName);
+            log_info("Loaded model {} from snapshot {}", model->getName(),
+                    snapshotFileName);
+            return model;
+        } catch (const std::exception& e) {
+            log_warn("Could not read model snapshot '{}'; loading '{}' "
+                     "instead (details: {}).",
+                    snapshotFileName, modelFileName, e.what());
+        }
+    }
+
+    std::unique_ptr<Model> model(new Model(modelFileName));
+    model->finalizeConnections();
+    // Other processes may be loading the same model, so write to a file of
+    // our own and then move it into place.
+    const std::string partialFileName = snapshotFileName + "." +
+            std::to_string(std::random_device{}()) + ".partial";
+    try {
+        write(*model, partialFileName);
+#ifdef _WIN32
+        // On Windows, rename() fails if the destination exists, so a stale
+        // or corrupt snapshot could never be replaced.
+        std::remove(snapshotFileName.c_str());
+#endif
+        OPENSIM_THROW_IF(
+                std::rename(partialFileName.c_str(), snapshotFileName.c_str()),
+                Exception, "Could not rename '{}'.", partialFileName);
+    } catch (const std::exception& e) {
+        std::remove(partialFileName.c_str());
+        log_warn("Could not write model snapshot '{}' (details: {}).",
+                snapshotFileName, e.what());
+    }
+    return model;
+}
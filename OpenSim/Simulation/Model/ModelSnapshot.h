@@ -0,0 +1,82 @@
+#ifndef OPENSIM_MODEL_SNAPSHOT_H_
+#define OPENSIM_MODEL_SNAPSHOT_H_
+/* -------------------------------------------------------------------------- *
+ *                         OpenSim:  ModelSnapshot.h                          *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2020 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <OpenSim/Simulation/osimSimulationDLL.h>
+
+#include <memory>
+#include <string>
+
+namespace OpenSim {
+
+class Model;
+
+/** Save a Model loaded from an .osim file as a binary snapshot from which it
+can be loaded again much faster, and cache such snapshots by the contents of
+the .osim file. Loading a model from a snapshot skips parsing XML, updating
+the model from older file versions, and resolving the connectee paths of the
+model's sockets; it returns a model on which finalizeFromProperties() has been
+called and whose sockets are connected, ready for initSystem().
+
+A snapshot can only be read by the same build of OpenSim that wrote it (see
+ObjectSnapshot); read() throws for snapshots from other builds, and load()
+then replaces them.
+
+@code{.cpp}
+// The first call parses the .osim file and writes a snapshot to the cache
+// directory; subsequent calls (e.g., in other processes) read the snapshot.
+std::unique_ptr<Model> model = ModelSnapshot::load("Rajagopal2015.osim");
+SimTK::State& state = model->initSystem();
+@endcode */
+class OSIMSIMULATION_API ModelSnapshot {
+public:
+    /** Write a snapshot of `model` to the file `snapshotFileName`. The
+    sockets of the model must be connected (e.g., by finalizeConnections() or
+    initSystem()) for their connectees to be stored in the snapshot; the
+    connectees of other sockets are found from their paths when the snapshot
+    is read. */
+    static void write(const Model& model, const std::string& snapshotFileName);
+
+    /** Read the model in the snapshot file `snapshotFileName`.
+    @throws Exception if the file is not a snapshot written by this build of
+    OpenSim. */
+    static std::unique_ptr<Model> read(const std::string& snapshotFileName);
+
+    /** Load the model in the .osim file `modelFileName` from its snapshot in
+    `cacheDirectory`, if the cache contains a snapshot of the current contents
+    of the file. Otherwise, load the model from the .osim file and write its
+    snapshot to the cache. The cache directory defaults to the directory
+    containing the .osim file. Failing to write the snapshot is not an error.
+    */
+    static std::unique_ptr<Model> load(const std::string& modelFileName,
+            const std::string& cacheDirectory = "");
+
+    /** The name of the snapshot file of the current contents of the .osim file
+    `modelFileName` (without a directory): the name of the .osim file followed
+    by a hash of its contents and the extension ".osimsnap". */
+    static std::string getSnapshotFileName(const std::string& modelFileName);
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_MODEL_SNAPSHOT_H_
@@ -23,6 +23,7 @@
 
 #include "MomentArmSolver.h"
 #include "Model/PointForceDirection.h"
+#include "Model/GeometryPath.h"
 #include "Model/Model.h"
 
 using namespace std;
@@ -132,6 +133,56 @@ double MomentArmSolver::solve(const State &state, const Coordinate &aCoord,
     return ~_coupling*_generalizedForces;
 }
 
+SimTK::Matrix MomentArmSolver::solve(const State& state,
+        const std::vector<const Coordinate*>& coordinates,
+        const std::vector<const GeometryPath*>& paths) const
+{
+    const int nc = (int)coordinates.size();
+    const int np = (int)paths.size();
+
+    //Local modifiable copy of the state
+    State& s_ma = _stateCopy;
+    s_ma.updQ() = state.getQ();
+
+    // The coupling between coordinates due to constraints depends only on
+    // the configuration, so compute it once per coordinate and reuse it for
+    // every path. Each column of C is the coupling vector of one coordinate.
+    Matrix C(s_ma.getNU(), nc);
+    for (int j = 0; j < nc; ++j) {
+        C(j) = computeCouplingVector(s_ma, *coordinates[j]);
+    }
+
+    // set speeds to zero
+    s_ma.updU() = 0;
+
+    const SimbodyMatterSubsystem& matter =
+        getModel().getMultibodySystem().getMatterSubsystem();
+
+    Matrix ma(np, nc);
+    Vector pathDependentMobilityForces(s_ma.getNU(), 0.0);
+    for (int i = 0; i < np; ++i) {
+        // zero out all the forces
+        _bodyForces *= 0;
+        _generalizedForces = 0;
+        pathDependentMobilityForces = 0;
+
+        // apply a tension of unity to the bodies of the path
+        paths[i]->addInEquivalentForces(s_ma, 1.0, _bodyForces,
+                pathDependentMobilityForces);
+
+        // Convert body spatial forces F to equivalent mobility forces f
+        // based on geometry (no dynamics required): f = ~J(q) * F.
+        matter.multiplyBySystemJacobianTranspose(s_ma, _bodyForces,
+                _generalizedForces);
+
+        _generalizedForces += pathDependentMobilityForces;
+
+        // Moment-arms about all coordinates at once: r = ~f * C
+        ma[i] = ~_generalizedForces * C;
+    }
+    return ma;
+}
+
 SimTK::Vector MomentArmSolver::computeCouplingVector(SimTK::State &state, 
         const Coordinate &coordinate) const
 {
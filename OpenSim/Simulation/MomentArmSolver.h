@@ -25,6 +25,7 @@
 
 #include "Solver.h"
 #include "SimTKcommon/internal/State.h"
+#include <vector>
 
 namespace OpenSim {
 
@@ -83,6 +84,22 @@ public:
     double solve(const SimTK::State& state, const Coordinate &coordinate, 
         const Array<PointForceDirection *> &pfds) const;
 
+    /** Solve for the effective moment-arms of every GeometryPath about every
+        Coordinate in a single pass. The constraint coupling vector of each
+        coordinate is computed once and shared by all paths, and the
+        generalized forces due to a unit tension are computed once per path,
+        so the cost is proportional to (paths + coordinates) realizations
+        rather than (paths x coordinates) as when calling solve() per pair.
+    @param  state               current state of the model
+    @param  coordinates         Coordinates about which we want moment-arms
+    @param  paths               GeometryPaths for which to calculate moment-arms
+    @return ma                  matrix of moment-arms with one row per path
+                                and one column per coordinate
+    */
+    SimTK::Matrix solve(const SimTK::State& state,
+        const std::vector<const Coordinate*>& coordinates,
+        const std::vector<const GeometryPath*>& paths) const;
+
 private:
     // Internal state of the solver initialized as a copy of the default state
     mutable SimTK::State _stateCopy;
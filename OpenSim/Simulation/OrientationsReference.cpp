@@ -170,6 +170,44 @@ void OrientationsReference::getValuesAtTime(
     }
 }
 
+void OrientationsReference::getValuesAtTime(double time,
+        SimTK::Array_<Rotation>& values, ReferenceCursor& cursor,
+        bool interpolate) const
+{
+    const auto& times = _orientationData.getIndependentColumn();
+    OPENSIM_THROW_IF(times.empty(), EmptyTable);
+    const double eps = SimTK::SignificantReal;
+    OPENSIM_THROW_IF(time < times.front() - eps || time > times.back() + eps,
+            TimeOutOfRange, time, times.front(), times.back());
+
+    const int no = getNumRefs();
+    if (int(values.size()) != no)
+        values.resize(no);
+
+    size_t row = cursor.seek(times, time);
+    const bool hasNext = row + 1 < times.size();
+    if (interpolate && hasNext && time > times[row]) {
+        const double alpha =
+                (time - times[row]) / (times[row + 1] - times[row]);
+        const auto before = _orientationData.getRowAtIndex(row);
+        const auto after = _orientationData.getRowAtIndex(row + 1);
+        for (int i = 0; i < no; ++i) {
+            // Rotate by a fraction of the relative rotation between rows.
+            const Vec4 angleAxis =
+                    (~before[i] * after[i]).convertRotationToAngleAxis();
+            values[i] = before[i] * Rotation(alpha * angleAxis[0],
+                    UnitVec3(angleAxis[1], angleAxis[2], angleAxis[3]));
+        }
+        return;
+    }
+    // Same tie-breaking as TimeSeriesTable::getNearestRowIndexForTime().
+    if (hasNext && times[row + 1] - time <= time - times[row])
+        ++row;
+    const auto rowView = _orientationData.getRowAtIndex(row);
+    for (int i = 0; i < no; ++i)
+        values[i] = rowView[i];
+}
+
 /** get the weights of the Orientations */
 void  OrientationsReference::getWeights(const SimTK::State &s, SimTK::Array_<double> &weights) const
 {
@@ -125,6 +125,18 @@ public:
     /** get the value of the OrientationsReference */
     void getValuesAtTime(double time,
         SimTK::Array_<SimTK::Rotation_<double>>& values) const override;
+    /** Get the orientation values at `time` for a reader that visits times in
+        order, such as the InverseKinematicsSolver. The row is found starting
+        from where `cursor` was left by the previous call, and `values` is only
+        resized if it does not already hold getNumRefs() values. If
+        `interpolate` is false, the values are those of the nearest row;
+        otherwise each orientation is rotated from its value in the row before
+        `time` toward its value in the row after `time`, about their relative
+        rotation axis, by the fraction of the interval elapsed at `time`.
+        @throws TimeOutOfRange if `time` is outside getValidTimeRange(). */
+    virtual void getValuesAtTime(double time,
+            SimTK::Array_<SimTK::Rotation_<double>>& values,
+            ReferenceCursor& cursor, bool interpolate = false) const;
     /** Default implementation does not support streaming */
     virtual void getNextValuesAndTime(
             double& time, SimTK::Array_<SimTK::Rotation_<double>>& values) override {
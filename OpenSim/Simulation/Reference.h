@@ -29,12 +29,57 @@
 #include "SimTKcommon/internal/Array.h"
 #include "SimTKcommon/internal/ResetOnCopy.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace SimTK {
 class State;
 }
 
 namespace OpenSim {
 
+//=============================================================================
+//=============================================================================
+/**
+ * A ReferenceCursor remembers where a reader of a Reference's time samples
+ * left off, so that reading values at the next time does not search all the
+ * samples again. Readers that visit times in order, such as the
+ * InverseKinematicsSolver, hold on to a cursor and pass it to each read. A
+ * cursor belongs to one reader; it holds no pointer to the Reference, and a
+ * cursor that was used with different samples still gives correct results.
+ */
+class ReferenceCursor {
+public:
+    /** Find the index of the last of the sorted `times` that is at or before
+        `time`, or 0 if `time` is before all of them. Starting from the
+        previous index, the next index is found in constant time; the times
+        are searched only after jumping forward by more than one sample or
+        moving backward. */
+    size_t seek(const std::vector<double>& times, double time) {
+        const size_t n = times.size();
+        if (n == 0) return _index = 0;
+        if (_index >= n) _index = n - 1;
+        if (times[_index] <= time) {
+            if (_index + 1 < n && times[_index + 1] <= time) {
+                ++_index;
+                if (_index + 1 < n && times[_index + 1] <= time)
+                    _index = std::upper_bound(times.begin() + _index + 1,
+                                     times.end(), time) - times.begin() - 1;
+            }
+        } else {
+            const size_t after = std::upper_bound(times.begin(),
+                    times.begin() + _index, time) - times.begin();
+            _index = after > 0 ? after - 1 : 0;
+        }
+        return _index;
+    }
+    /** Start the next seek() from the first sample. */
+    void reset() { _index = 0; }
+
+private:
+    size_t _index = 0;
+};
+
 //=============================================================================
 //=============================================================================
 /**
@@ -25,10 +25,12 @@
 
 #include "StatesTrajectory.h"
 #include "osimSimulationDLL.h"
+#include <algorithm>
 #include <regex>
 
 #include <SimTKcommon/internal/State.h>
 
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/Reporter.h>
 #include <OpenSim/Common/Storage.h>
 #include <OpenSim/Simulation/Model/Model.h>
@@ -211,11 +213,16 @@ OSIMSIMULATION_API void checkLabelsMatchModelStates(
 /// For example, in a model with a patella whose location is determined by a
 /// CoordinateCouplerConstraint, the length of a muscle that crosses the patella
 /// will be incorrect.
+///
+/// The rows can be analyzed in parallel by setting numThreads to a value
+/// other than 1 (0 uses all available hardware threads). The rows are then
+/// split into contiguous blocks, each analyzed by a separate copy of the model
+/// into its own rows of the result, which is the same as with one thread.
 /// @ingroup simulationutil
 template <typename T>
 TimeSeriesTable_<T> analyze(Model model, const TimeSeriesTable& statesTable,
         const TimeSeriesTable& controlsTable,
-        const std::vector<std::string>& outputPaths) {
+        const std::vector<std::string>& outputPaths, int numThreads = 1) {
 
     // Initialize the system so we can access the outputs.
     model.initSystem();
@@ -255,7 +262,6 @@ TimeSeriesTable_<T> analyze(Model model, const TimeSeriesTable& statesTable,
             controlsTable.getColumnLabels();
     const std::unordered_map<std::string, int> controlMap =
             createSystemControlIndexMap(model);
-    SimTK::Vector controls((int)controlsTable.getNumColumns(), 0.0);
 
     OPENSIM_THROW_IF(statesTable.getNumRows() != controlsTable.getNumRows(),
             Exception,
@@ -264,31 +270,75 @@ TimeSeriesTable_<T> analyze(Model model, const TimeSeriesTable& statesTable,
             "and controlsTable contains {} rows.",
             statesTable.getNumRows(), controlsTable.getNumRows());
 
-    // Loop through the states trajectory to create the report.
-    for (int itime = 0; itime < (int)statesTraj.getSize(); ++itime) {
-        // Get the current state.
-        auto state = statesTraj[itime];
+    // Report the outputs for rows [begin, end) of the states trajectory.
+    // The states of the trajectory belong to the System of `model`, so the
+    // time and Y of each are copied into a state of rowModel's own System.
+    auto analyzeRows = [&](const Model& rowModel, int begin, int end) {
+        SimTK::Vector controls((int)controlsTable.getNumColumns(), 0.0);
+        SimTK::State state = rowModel.getWorkingState();
+        for (int itime = begin; itime < end; ++itime) {
+            // Get the current state.
+            state.setTime(statesTraj[itime].getTime());
+            state.updY() = statesTraj[itime].getY();
+
+            // Enforce any SimTK::Motion's included in the model.
+            rowModel.getSystem().prescribe(state);
+
+            // Create a SimTK::Vector of the control values for the current
+            // state.
+            const auto& controlsRow = controlsTable.getRowAtIndex(itime);
+            for (int icontrol = 0; icontrol < (int)controlNames.size();
+                    ++icontrol) {
+                controls[controlMap.at(controlNames[icontrol])] =
+                        controlsRow[icontrol];
+            }
 
-        // Enforce any SimTK::Motion's included in the model.
-        model.getSystem().prescribe(state);
+            // Set the controls on the state object.
+            rowModel.realizeVelocity(state);
+            rowModel.setControls(state, controls);
 
-        // Create a SimTK::Vector of the control values for the current state.
-        const auto& controlsRow = controlsTable.getRowAtIndex(itime);
-        for (int icontrol = 0; icontrol < (int)controlNames.size();
-                ++icontrol) {
-            controls[controlMap.at(controlNames[icontrol])] =
-                    controlsRow[icontrol];
+            // Generate report results for the current state.
+            rowModel.realizeReport(state);
         }
+    };
 
-        // Set the controls on the state object.
-        model.realizeVelocity(state);
-        model.setControls(state, controls);
+    const int numRows = (int)statesTraj.getSize();
+    numThreads = std::min(resolveNumThreads(numThreads), numRows);
+    if (numThreads <= 1) {
+        analyzeRows(model, 0, numRows);
+        return reporter->getTable();
+    }
 
-        // Generate report results for the current state.
-        model.realizeReport(state);
+    // Each thread analyzes a contiguous block of rows with its own copy of
+    // the model (including the reporter), and then copies the rows reported
+    // by its reporter into the preallocated result. Copying and initializing
+    // the models is done serially.
+    const std::string reporterPath = reporter->getAbsolutePathString();
+    std::vector<std::unique_ptr<Model>> models;
+    for (int ithread = 0; ithread < numThreads; ++ithread) {
+        models.emplace_back(new Model(model));
+        models.back()->setUseVisualizer(false);
+        models.back()->initSystem();
     }
+    std::vector<double> times(numRows);
+    SimTK::Matrix_<T> values(numRows, (int)reporter->getInput("inputs")
+                                              .getNumConnectees());
+    parallelFor(numThreads, numThreads, [&](int block, int) {
+        const int begin = (int)((long long)numRows * block / numThreads);
+        const int end = (int)((long long)numRows * (block + 1) / numThreads);
+        const Model& blockModel = *models[block];
+        analyzeRows(blockModel, begin, end);
+        const auto& blockTable =
+                blockModel.getComponent<TableReporter_<T>>(reporterPath)
+                        .getTable();
+        for (int irow = 0; irow < end - begin; ++irow) {
+            times[begin + irow] = blockTable.getIndependentColumn()[irow];
+            values.updRow(begin + irow) = blockTable.getRowAtIndex(irow);
+        }
+    });
 
-    return reporter->getTable();
+    return TimeSeriesTable_<T>(
+            times, values, reporter->getTable().getColumnLabels());
 }
 
 } // end of namespace OpenSim
@@ -139,6 +139,15 @@ TimeSeriesTable StatesTrajectory::exportToTable(const Model& model,
     table.setColumnLabels(stateVars);
     size_t numDepColumns = stateVars.size();
 
+    // Resolve the requested names once rather than for every row.
+    std::vector<Component::StateVariableHandle> handles;
+    if (!requestedStateVars.empty()) {
+        handles.reserve(numDepColumns);
+        for (const auto& name : stateVars) {
+            handles.push_back(model.getStateVariableHandle(name));
+        }
+    }
+
     // Fill up the table with the data.
     for (size_t itime = 0; itime < getSize(); ++itime) {
         const auto& state = get(itime);
@@ -150,8 +159,7 @@ TimeSeriesTable StatesTrajectory::exportToTable(const Model& model,
             row = model.getStateVariableValues(state).transpose();
         } else {
             for (unsigned icol = 0; icol < numDepColumns; ++icol) {
-                row[static_cast<int>(icol)] =
-                    model.getStateVariableValue(state, stateVars[icol]);
+                row[static_cast<int>(icol)] = handles[icol].getValue(state);
             }
         }
 
@@ -171,24 +179,11 @@ StatesTrajectory StatesTrajectory::createFromStatesStorage(
             allowMissingColumns, allowExtraColumns, assemble);
 }
 
-StatesTrajectory StatesTrajectory::createFromStatesTable(
+std::map<int, int> StatesTrajectory::mapStatesTableColumns(
         const Model& model,
         const TimeSeriesTable& table,
         bool allowMissingColumns,
-        bool allowExtraColumns,
-        bool assemble) {
-
-    // Assemble the required objects.
-    // ==============================
-
-    // This is what we'll return.
-    StatesTrajectory states;
-
-    // Make a copy of the model so that we can get a corresponding state.
-    Model localModel(model);
-
-    // We'll keep editing this state as we loop through time.
-    auto state = localModel.initSystem();
+        bool allowExtraColumns) {
 
     // The labels of the columns in the storage file.
     const auto& tableLabels = table.getColumnLabels();
@@ -207,7 +202,7 @@ StatesTrajectory StatesTrajectory::createFromStatesTable(
 
     // Check if states are missing from the Storage.
     // ---------------------------------------------
-    const auto& modelStateNames = localModel.getStateVariableNames();
+    const auto& modelStateNames = model.getStateVariableNames();
     std::vector<std::string> missingColumnNames;
     // Also, assemble the indices of the states that we will actually set in the
     // trajectory.
@@ -224,7 +219,7 @@ StatesTrajectory StatesTrajectory::createFromStatesTable(
     }
     OPENSIM_THROW_IF(!allowMissingColumns && !missingColumnNames.empty(),
             MissingColumns,
-            localModel.getName(), missingColumnNames);
+            model.getName(), missingColumnNames);
 
     // Check if the Storage has columns that are not states in the Model.
     // ------------------------------------------------------------------
@@ -239,11 +234,37 @@ StatesTrajectory StatesTrajectory::createFromStatesTable(
                     extraColumnNames.push_back(tableLabels[ic]);
                 }
             }
-            OPENSIM_THROW(ExtraColumns, localModel.getName(),
+            OPENSIM_THROW(ExtraColumns, model.getName(),
                     extraColumnNames);
         }
     }
 
+    return statesToFillUp;
+}
+
+StatesTrajectory StatesTrajectory::createFromStatesTable(
+        const Model& model,
+        const TimeSeriesTable& table,
+        bool allowMissingColumns,
+        bool allowExtraColumns,
+        bool assemble) {
+
+    // Assemble the required objects.
+    // ==============================
+
+    // This is what we'll return.
+    StatesTrajectory states;
+
+    // Make a copy of the model so that we can get a corresponding state.
+    Model localModel(model);
+
+    // We'll keep editing this state as we loop through time.
+    auto state = localModel.initSystem();
+
+    const auto& modelStateNames = localModel.getStateVariableNames();
+    const auto statesToFillUp = mapStatesTableColumns(
+            localModel, table, allowMissingColumns, allowExtraColumns);
+
     // Fill up trajectory.
     // ===================
 
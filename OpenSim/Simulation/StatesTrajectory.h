@@ -23,6 +23,7 @@
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
 
+#include <map>
 #include <vector>
 
 #include <OpenSim/Common/Exception.h>
@@ -136,6 +137,10 @@ class Model;
  *               << std::endl;
  * }
  * @endcode
+ *
+ * Each SimTK::State in the trajectory is a complete copy, including its cache.
+ * For long trajectories of large models, CompactStatesTrajectory uses much
+ * less memory.
  */
 class OSIMSIMULATION_API StatesTrajectory {
 public:
@@ -288,6 +293,17 @@ public:
             const std::vector<std::string>& stateVars = {}) const;
 
 private:
+    friend class CompactStatesTrajectory;
+
+    /** Check the columns of a states table against the continuous state
+     * variables of the model, which must have a System, and map the index
+     * of each column that is used to the index of its state variable in
+     * Model::getStateVariableNames(). See createFromStatesTable() for the
+     * checks that are performed. */
+    static std::map<int, int> mapStatesTableColumns(const Model& model,
+            const TimeSeriesTable& table,
+            bool allowMissingColumns,
+            bool allowExtraColumns);
 
     std::vector<SimTK::State> m_states;
 
@@ -25,15 +25,37 @@
 
 using namespace OpenSim;
 
+StatesTrajectoryReporter::StatesTrajectoryReporter() {
+    constructProperty_compact(false);
+}
 
 void StatesTrajectoryReporter::clear() {
     m_states.clear();
+    m_compactStates.clear();
+    m_compactStatesInitialized = false;
 }
 
 const StatesTrajectory& StatesTrajectoryReporter::getStates() const {
+    OPENSIM_THROW_IF_FRMOBJ(get_compact(), Exception,
+            "The states are stored compactly; use getCompactStates().");
     return m_states;
 }
 
+const CompactStatesTrajectory&
+StatesTrajectoryReporter::getCompactStates() const {
+    OPENSIM_THROW_IF_FRMOBJ(!get_compact(), Exception,
+            "The states are not stored compactly; use getStates() or set the "
+            "'compact' property to true.");
+    return m_compactStates;
+}
+
+void StatesTrajectoryReporter::initializeCompactStates() const {
+    if (!m_compactStatesInitialized) {
+        m_compactStates = CompactStatesTrajectory(getRoot());
+        m_compactStatesInitialized = true;
+    }
+}
+
 /*
 TODO we have to discuss if the trajectory should be cleared.
 void StatesTrajectoryReporter::extendRealizeInstance(const SimTK::State& state) const {
@@ -43,5 +65,17 @@ void StatesTrajectoryReporter::extendRealizeInstance(const SimTK::State& state)
 */
 
 void StatesTrajectoryReporter::implementReport(const SimTK::State& state) const {
-    m_states.append(state);
+    if (get_compact()) {
+        initializeCompactStates();
+        m_compactStates.append(state);
+    } else {
+        m_states.append(state);
+    }
+}
+
+void StatesTrajectoryReporter::implementReserveReports(int numReports) const {
+    if (get_compact()) {
+        initializeCompactStates();
+        m_compactStates.reserve(m_compactStates.getSize() + numReports);
+    }
 }
@@ -23,7 +23,7 @@
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
 
-#include "StatesTrajectory.h"
+#include "CompactStatesTrajectory.h"
 #include <OpenSim/Common/Reporter.h>
 
 #include "osimSimulationDLL.h"
@@ -35,14 +35,29 @@ namespace OpenSim {
  * This class was introduced in v4.0 and is intended to replace the
  * StatesReporter analysis.
  *
+ * A StatesTrajectory holds a complete copy of every reported state. For long
+ * simulations of large models, set the `compact` property to true to store
+ * the states in a CompactStatesTrajectory instead (see getCompactStates()).
+ *
  * @ingroup reporters
  */
 class OSIMSIMULATION_API StatesTrajectoryReporter : public AbstractReporter {
 OpenSim_DECLARE_CONCRETE_OBJECT(StatesTrajectoryReporter, AbstractReporter);
 
 public:
-    /** Access the accumulated states. */
+    OpenSim_DECLARE_PROPERTY(compact, bool,
+            "Store the time, continuous state variables, and discrete "
+            "variables of the states in a CompactStatesTrajectory, which uses "
+            "much less memory than storing complete states. Default: false.");
+
+    StatesTrajectoryReporter();
+
+    /** Access the accumulated states.
+     * @throws Exception if the `compact` property is true. */
     const StatesTrajectory& getStates() const; 
+    /** Access the accumulated states, when the `compact` property is true.
+     * @throws Exception if the `compact` property is false. */
+    const CompactStatesTrajectory& getCompactStates() const;
     /** Clear the accumulated states. */ 
     void clear();
 
@@ -55,10 +70,20 @@ protected:
     /** Appends the provided state to the trajectory. */
     void implementReport(const SimTK::State& state) const override;
 
+    /** Allocates memory for the states in the compact trajectory. */
+    void implementReserveReports(int numReports) const override;
+
 private:
+    // The compact trajectory stores the discrete variables of the model,
+    // which are known once the model's System is complete. It is therefore
+    // created at the first report (or reservation) after clear().
+    void initializeCompactStates() const;
+
     // Mutable because we append during reporting. This is OK to do since
     // reporting never occurs for trial states.
     mutable StatesTrajectory m_states;
+    mutable CompactStatesTrajectory m_compactStates;
+    mutable bool m_compactStatesInitialized = false;
 };
 
 } // namespace
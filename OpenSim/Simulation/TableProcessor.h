@@ -44,7 +44,9 @@ to a table or an in-memory TimeSeriesTable. In C++, one can easily chain
 together the operators in a processor using the C++ pipe operator:
 @code
 TableProcessor proc = TableProcessor("file.sto") | TabOpLowPassFilter(6);
-@endcode */
+@endcode
+The file can be in any format that TimeSeriesTable can read; large tables
+load fastest from STB files (see STBFileAdapter). */
 class OSIMSIMULATION_API TableProcessor : public Object {
     OpenSim_DECLARE_CONCRETE_OBJECT(TableProcessor, Object);
 
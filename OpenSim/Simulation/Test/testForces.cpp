@@ -70,6 +70,7 @@ void testCoordinateLimitForce();
 void testCoordinateLimitForceRotational();
 void testExpressionBasedPointToPointForce();
 void testExpressionBasedCoordinateForce();
+void testExpressionBasedForceDerivatives();
 void testSerializeDeserialize();
 void testTranslationalDampingEffect(Model& osimModel, Coordinate& sliderCoord,
         double start_h, Component& componentWithDamping);
@@ -161,6 +162,12 @@ int main() {
         failures.push_back("testExpressionBasedCoordinateForce");
     }
 
+    try { testExpressionBasedForceDerivatives(); }
+    catch (const std::exception& e){
+        cout << e.what() <<endl;
+        failures.push_back("testExpressionBasedForceDerivatives");
+    }
+
     try { testSerializeDeserialize(); }
     catch (const std::exception& e){
         cout << e.what() <<endl;
@@ -287,6 +294,108 @@ void testExpressionBasedCoordinateForce() {
     osimModel.disownAllComponents();
 }
 
+// The analytic derivatives of the expression-based forces must match the
+// derivatives of their expressions.
+void testExpressionBasedForceDerivatives() {
+    using namespace SimTK;
+
+    Model model;
+    auto* base = new OpenSim::Body("base", 1, Vec3(0), Inertia(1));
+    auto* ball = new OpenSim::Body("ball", 1, Vec3(0), Inertia(1));
+    model.addBody(base);
+    model.addBody(ball);
+    auto* slider = new SliderJoint("slider", model.getGround(), Vec3(0),
+            Vec3(0), *base, Vec3(0), Vec3(0));
+    slider->updCoordinate().setName("h");
+    model.addJoint(slider);
+    model.addJoint(new FreeJoint("free", *base, Vec3(0), Vec3(0), *ball,
+            Vec3(0), Vec3(0)));
+
+    auto* coordForce = new ExpressionBasedCoordinateForce(
+            "h", "-10*q^3-5*q*qdot+sin(qdot)");
+    model.addForce(coordForce);
+
+    auto* bushing = new ExpressionBasedBushingForce("bushing", *base,
+            Vec3(0), Vec3(0), *ball, Vec3(0), Vec3(0));
+    bushing->setMxExpression("2*theta_x^3+theta_y*delta_z");
+    bushing->setFzExpression("exp(delta_z)*cos(theta_x)");
+    model.addForce(bushing);
+
+    SimTK::State& state = model.initSystem();
+    const double q = 0.3;
+    const double qdot = -0.7;
+    state.updQ() = 0.2;
+    state.updU() = 0;
+    slider->getCoordinate().setValue(state, q, false);
+    slider->getCoordinate().setSpeedValue(state, qdot);
+    model.realizeVelocity(state);
+
+    const Vec2 gradient = coordForce->calcExpressionForceGradient(state);
+    ASSERT_EQUAL(-30*q*q - 5*qdot, gradient[0], 1e-12);
+    ASSERT_EQUAL(-5*q + cos(qdot), gradient[1], 1e-12);
+    const Mat22 hessian = coordForce->calcExpressionForceHessian(state);
+    ASSERT_EQUAL(-60*q, hessian(0, 0), 1e-12);
+    ASSERT_EQUAL(-5.0, hessian(0, 1), 1e-12);
+    ASSERT_EQUAL(-5.0, hessian(1, 0), 1e-12);
+    ASSERT_EQUAL(-sin(qdot), hessian(1, 1), 1e-12);
+    ASSERT_EQUAL(-10*q*q*q - 5*q*qdot + sin(qdot),
+            coordForce->calcExpressionForce(state), 1e-12);
+
+    // The stiffness force is the negative of the expressions.
+    const Vec6 dq = bushing->computeDeflection(state);
+    Mat66 expected(0);
+    expected(0, 0) = -6*dq[0]*dq[0];
+    expected(0, 1) = -dq[5];
+    expected(0, 5) = -dq[1];
+    expected(5, 0) = exp(dq[5])*sin(dq[0]);
+    expected(5, 5) = -exp(dq[5])*cos(dq[0]);
+    const Mat66 jacobian = bushing->calcStiffnessForceJacobian(state);
+    for (int i = 0; i < 6; ++i) {
+        for (int j = 0; j < 6; ++j) {
+            ASSERT_EQUAL(expected(i, j), jacobian(i, j), 1e-12);
+        }
+    }
+
+    Mat66 expectedMx(0);
+    expectedMx(0, 0) = -12*dq[0];
+    expectedMx(1, 5) = expectedMx(5, 1) = -1;
+    Mat66 expectedFz(0);
+    expectedFz(0, 0) = exp(dq[5])*cos(dq[0]);
+    expectedFz(0, 5) = expectedFz(5, 0) = exp(dq[5])*sin(dq[0]);
+    expectedFz(5, 5) = -exp(dq[5])*cos(dq[0]);
+    const Mat66 hessianMx = bushing->calcStiffnessForceHessian(state, 0);
+    const Mat66 hessianFy = bushing->calcStiffnessForceHessian(state, 4);
+    const Mat66 hessianFz = bushing->calcStiffnessForceHessian(state, 5);
+    for (int i = 0; i < 6; ++i) {
+        for (int j = 0; j < 6; ++j) {
+            ASSERT_EQUAL(expectedMx(i, j), hessianMx(i, j), 1e-12);
+            ASSERT_EQUAL(0.0, hessianFy(i, j), 1e-12);
+            ASSERT_EQUAL(expectedFz(i, j), hessianFz(i, j), 1e-12);
+        }
+    }
+    ASSERT_THROW(OpenSim::Exception,
+            bushing->calcStiffnessForceHessian(state, 6));
+
+    // The derivatives survive copying the model.
+    Model copy(model);
+    SimTK::State& copyState = copy.initSystem();
+    copyState.updQ() = state.getQ();
+    copyState.updU() = state.getU();
+    copy.realizeVelocity(copyState);
+    const auto& copyBushing =
+            copy.getComponent<ExpressionBasedBushingForce>("forceset/bushing");
+    const Mat66 copyJacobian =
+            copyBushing.calcStiffnessForceJacobian(copyState);
+    for (int i = 0; i < 6; ++i) {
+        for (int j = 0; j < 6; ++j) {
+            ASSERT_EQUAL(jacobian(i, j), copyJacobian(i, j), 1e-15);
+        }
+    }
+
+    // Expressions may only use the variables of the force.
+    ASSERT_THROW(OpenSim::Exception, bushing->setFxExpression("2*delta_w"));
+}
+
 void testExpressionBasedPointToPointForce() {
     using namespace SimTK;
 
@@ -44,6 +44,9 @@ void testMarkersReference();
 // Verify that the orientations sensor weights are consistent with the initial
 // Set of OrientationWeights used to construct the OrientationsReference
 void testOrientationsReference();
+// Verify that reading references with a cursor, in any order of times,
+// gives the nearest-row values of getValuesAtTime(), or interpolated values.
+void testReferenceCursors();
 
 // Utility function to build a simple pendulum with markers attached
 Model* constructPendulumWithMarkers();
@@ -103,6 +106,11 @@ int main()
         cout << e.what() << endl;
         failures.push_back("testOrientationsReference");
     }
+    try { testReferenceCursors(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testReferenceCursors");
+    }
     
     try { testAccuracy(); }
     catch (const std::exception& e) {
@@ -280,6 +288,86 @@ void testOrientationsReference() {
     }
 }
 
+void testReferenceCursors()
+{
+    vector<std::string> labels{"A", "B", "C"};
+    const int nc = int(labels.size());
+    const int nr = 200;
+    const double dt = 0.01;
+
+    // Values vary linearly in time for markers, and at a constant rate
+    // about a fixed axis for orientations, so interpolation is exact.
+    TimeSeriesTable_<SimTK::Vec3> markerData;
+    markerData.setColumnLabels(labels);
+    TimeSeriesTable_<SimTK::Rotation> orientationData;
+    orientationData.setColumnLabels(labels);
+    for (int r = 0; r < nr; ++r) {
+        const double t = dt*r;
+        SimTK::RowVector_<SimTK::Vec3> markerRow(nc);
+        SimTK::RowVector_<SimTK::Rotation> orientationRow(nc);
+        for (int j = 0; j < nc; ++j) {
+            markerRow[j] = (j + 1)*SimTK::Vec3(t, 2*t, -t);
+            orientationRow[j] = SimTK::Rotation((j + 1)*t, SimTK::ZAxis);
+        }
+        markerData.appendRow(t, markerRow);
+        orientationData.appendRow(t, orientationRow);
+    }
+    MarkersReference markersRef(markerData, Set<MarkerWeight>());
+    OrientationsReference orientationsRef(orientationData);
+
+    // Sweep forward, then jump backward and forward.
+    vector<double> times;
+    for (double t = 0; t <= dt*(nr - 1); t += 0.37*dt) times.push_back(t);
+    times.push_back(0.5);
+    times.push_back(0.1234);
+    times.push_back(1.9);
+    times.push_back(0.0);
+
+    ReferenceCursor cursor;
+    SimTK::Array_<SimTK::Vec3> markerValues, expectedMarkerValues;
+    for (double t : times) {
+        markersRef.getValuesAtTime(t, markerValues, cursor);
+        markersRef.getValuesAtTime(t, expectedMarkerValues);
+        SimTK_ASSERT_ALWAYS(markerValues == expectedMarkerValues,
+                "MarkersReference with a cursor did not read nearest row.");
+    }
+
+    cursor.reset();
+    for (double t : times) {
+        markersRef.getValuesAtTime(t, markerValues, cursor, true);
+        for (int j = 0; j < nc; ++j) {
+            const SimTK::Vec3 expected = (j + 1)*SimTK::Vec3(t, 2*t, -t);
+            SimTK_ASSERT_ALWAYS((markerValues[j] - expected).norm() < 1e-12,
+                    "MarkersReference failed to interpolate marker values.");
+        }
+    }
+
+    ReferenceCursor orientationsCursor;
+    SimTK::Array_<SimTK::Rotation> orientationValues, expectedValues;
+    for (int r = nr - 1; r >= 0; r -= 7) {
+        // Times near samples are read as the samples.
+        orientationsRef.getValuesAtTime(
+                dt*r + 0.1*dt, orientationValues, orientationsCursor);
+        orientationsRef.getValuesAtTime(dt*r, expectedValues);
+        for (int j = 0; j < nc; ++j) {
+            SimTK_ASSERT_ALWAYS(orientationValues[j].isSameRotationToWithinAngle(
+                    expectedValues[j], 1e-12), "OrientationsReference with a "
+                    "cursor did not read nearest row.");
+        }
+    }
+    for (double t : times) {
+        orientationsRef.getValuesAtTime(
+                t, orientationValues, orientationsCursor, true);
+        for (int j = 0; j < nc; ++j) {
+            SimTK_ASSERT_ALWAYS(orientationValues[j].isSameRotationToWithinAngle(
+                    SimTK::Rotation((j + 1)*t, SimTK::ZAxis), 1e-10),
+                    "OrientationsReference failed to interpolate orientations.");
+        }
+    }
+
+    SimTK_TEST_MUST_THROW_EXC(markersRef.getValuesAtTime(
+            2.5, markerValues, cursor), TimeOutOfRange);
+}
 
 void testAccuracy()
 {
@@ -22,16 +22,21 @@
 
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 #include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/Model/ModelSnapshot.h>
 #include <OpenSim/Simulation/Model/PhysicalOffsetFrame.h>
 #include <OpenSim/Simulation/SimbodyEngine/PinJoint.h>
 #include <OpenSim/Simulation/Manager/Manager.h>
+#include <OpenSim/Common/IO.h>
 #include <OpenSim/Common/LoadOpenSimLibrary.h>
 
+#include <fstream>
+
 using namespace OpenSim;
 using namespace std;
 
 void testModelFinalizePropertiesAndConnections();
 void testModelTopologyErrors();
+void testModelSnapshot();
 
 int main() {
     LoadOpenSimLibrary("osimActuators");
@@ -39,6 +44,7 @@ int main() {
     SimTK_START_TEST("testModelInterface");
         SimTK_SUBTEST(testModelFinalizePropertiesAndConnections);
         SimTK_SUBTEST(testModelTopologyErrors);
+        SimTK_SUBTEST(testModelSnapshot);
     SimTK_END_TEST();
 }
 
@@ -227,3 +233,51 @@ void testModelTopologyErrors()
 
     ASSERT_THROW(JointFramesHaveSameBaseFrame, degenerate.initSystem());
 }
+
+void testModelSnapshot()
+{
+    // This model has CustomJoints with spline functions, muscles, and wrap
+    // objects.
+    const std::string modelFile = "gait2354_simbody.osim";
+    Model model(modelFile);
+    model.finalizeConnections();
+    const std::string snapshotFile = "testModelInterface_gait2354.osimsnap";
+    ModelSnapshot::write(model, snapshotFile);
+
+    std::unique_ptr<Model> snapshot = ModelSnapshot::read(snapshotFile);
+
+    ASSERT(*snapshot == model);
+    ASSERT(snapshot->getInputFileName() == modelFile);
+    ASSERT(snapshot->isObjectUpToDateWithProperties());
+    // The sockets are connected without searching for connectees by path.
+    const Joint& joint = snapshot->getJointSet().get(1);
+    ASSERT(joint.getSocket("parent_frame").isConnected());
+    ASSERT(&joint.getParentFrame().getRoot() == snapshot.get());
+
+    // The snapshot behaves like the original model.
+    SimTK::State& state = model.initSystem();
+    SimTK::State& snapshotState = snapshot->initSystem();
+    ASSERT(state.getNY() == snapshotState.getNY());
+    model.realizeAcceleration(state);
+    snapshot->realizeAcceleration(snapshotState);
+    SimTK_TEST_EQ_TOL(state.getY(), snapshotState.getY(), 1e-15);
+    SimTK_TEST_EQ_TOL(state.getYDot(), snapshotState.getYDot(), 1e-12);
+    // Printing a model loaded from a snapshot writes the same file.
+    snapshot->print("testModelInterface_gait2354_snapshot.osim");
+    ASSERT(Model("testModelInterface_gait2354_snapshot.osim") == model);
+
+    // load() writes a snapshot to the cache and reads it next time.
+    const std::string cachedFile = ModelSnapshot::getSnapshotFileName(modelFile);
+    std::remove(cachedFile.c_str());
+    std::unique_ptr<Model> loaded = ModelSnapshot::load(modelFile, ".");
+    ASSERT(IO::FileExists(cachedFile));
+    loaded = ModelSnapshot::load(modelFile, ".");
+    ASSERT(*loaded == model);
+
+    // A file that is not a snapshot is detected, and load() replaces it.
+    std::ofstream(cachedFile) << "not a snapshot";
+    ASSERT_THROW(OpenSim::Exception, ModelSnapshot::read(cachedFile));
+    loaded = ModelSnapshot::load(modelFile, ".");
+    ASSERT(*loaded == model);
+    ASSERT(*ModelSnapshot::read(cachedFile) == model);
+}
@@ -55,6 +55,7 @@ void testMomentArmDefinitionForModel(const string &filename,
                                      double mass = -1.0, string errorMessage = "");
 
 void testMomentArmsAcrossCompoundJoint();
+void testBatchedMomentArms(const string& filename);
 
 int main()
 {
@@ -67,6 +68,9 @@ int main()
         testMomentArmsAcrossCompoundJoint();
         cout << "Joint composed of more than one mobilized body: PASSED\n" << endl;
 
+        testBatchedMomentArms("testMomentArmsConstraintB.osim");
+        cout << "Batched moment arms match per coordinate moment arms: PASSED\n" << endl;
+
         testMomentArmDefinitionForModel("BothLegs22.osim", "r_knee_angle", "VASINT", 
             SimTK::Vec2(-2*SimTK::Pi/3, SimTK::Pi/18), 0.0, 
             "VASINT of BothLegs with no mass: FAILED");
@@ -166,6 +170,43 @@ void testMomentArmsAcrossCompoundJoint()
         0.0, "testMomentArmsAcrossCompoundJoint: FAILED");
 }
 
+// The batched (all paths x all coordinates) solve must reproduce the moment
+// arms computed one path-coordinate pair at a time, including for coordinates
+// coupled through constraints.
+void testBatchedMomentArms(const string& filename)
+{
+    Model model(filename);
+    SimTK::State& s = model.initSystem();
+
+    MomentArmSolver maSolver(model);
+
+    std::vector<const Coordinate*> coords;
+    for (const auto& coord : model.getComponentList<Coordinate>()) {
+        coords.push_back(&coord);
+    }
+    std::vector<const GeometryPath*> paths;
+    for (const auto& muscle : model.getComponentList<Muscle>()) {
+        paths.push_back(&muscle.getGeometryPath());
+    }
+
+    const Coordinate& knee = model.getCoordinateSet().get("knee_angle_r");
+    for (double angle : {-SimTK::Pi/2, -SimTK::Pi/6, 0.0}) {
+        knee.setValue(s, angle, true);
+        model.realizePosition(s);
+
+        SimTK::Matrix ma = maSolver.solve(s, coords, paths);
+        ASSERT(ma.nrow() == (int)paths.size());
+        ASSERT(ma.ncol() == (int)coords.size());
+
+        for (int i = 0; i < (int)paths.size(); ++i) {
+            for (int j = 0; j < (int)coords.size(); ++j) {
+                double expected = maSolver.solve(s, *coords[j], *paths[i]);
+                ASSERT_EQUAL(expected, ma(i, j), 1e-10);
+            }
+        }
+    }
+}
+
 //==========================================================================================================
 // moment_arm = dl/dtheta, definition using inexact perturbation technique
 //==========================================================================================================
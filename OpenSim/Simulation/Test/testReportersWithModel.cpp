@@ -116,9 +116,39 @@ void testTableReporterLabels() {
     SimTK_TEST(headings[1] == "height");
 }
 
+void testTableReporterReservesRows() {
+    Model model;
+    auto* ball = new OpenSim::Body("ball", 1., Vec3(0), Inertia(0));
+    model.addBody(ball);
+    auto* slider = new SliderJoint("slider", model.getGround(), Vec3(0),
+        Vec3(0,0,Pi/2.), *ball, Vec3(0), Vec3(0,0,Pi/2.));
+    model.addJoint(slider);
+
+    auto* reporter = new TableReporter();
+    reporter->set_report_time_interval(0.1);
+    reporter->addToReport(slider->getCoordinate().getOutput("value"));
+    model.addComponent(reporter);
+
+    // The Manager lets the reporter size its table for the whole simulation.
+    State& state = model.initSystem();
+    Manager manager(model);
+    manager.initialize(state);
+    manager.integrate(1.0);
+    const auto& table = reporter->getTable();
+    SimTK_TEST(table.getNumRows() >= 10);
+    SimTK_TEST(table.getRowCapacity() <= 11);
+
+    // Continuing the simulation does not invalidate the rows so far.
+    manager.integrate(2.0);
+    SimTK_TEST(table.getNumRows() >= 20);
+    SimTK_TEST_EQ(table.getIndependentColumn().back(), 2.0);
+    SimTK_TEST(table.getMatrix().nrow() == (int)table.getNumRows());
+}
+
 int main() {
     SimTK_START_TEST("testReporters");
         SimTK_SUBTEST(testConsoleReporterLabels);
         SimTK_SUBTEST(testTableReporterLabels);
+        SimTK_SUBTEST(testTableReporterReservesRows);
     SimTK_END_TEST();
 };
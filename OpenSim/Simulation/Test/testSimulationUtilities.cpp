@@ -25,18 +25,27 @@
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/SimbodyEngine/FreeJoint.h>
 #include <OpenSim/Simulation/SimulationUtilities.h>
+#include <OpenSim/Simulation/EnsembleSimulator.h>
+#include <OpenSim/Simulation/Model/PointToPointSpring.h>
 #include <OpenSim/Common/LoadOpenSimLibrary.h>
+#include <OpenSim/Common/ComponentProfiler.h>
 
 using namespace OpenSim;
 using namespace std;
 
 void testUpdatePre40KinematicsFor40MotionType();
+void testParallelAnalyze();
+void testEnsembleSimulator();
+void testComponentProfiler();
 
 int main() {
     LoadOpenSimLibrary("osimActuators");
 
     SimTK_START_TEST("testSimulationUtilities");
         SimTK_SUBTEST(testUpdatePre40KinematicsFor40MotionType);
+        SimTK_SUBTEST(testParallelAnalyze);
+        SimTK_SUBTEST(testEnsembleSimulator);
+        SimTK_SUBTEST(testComponentProfiler);
     SimTK_END_TEST();
 }
 
@@ -174,22 +183,162 @@ void testUpdatePre40KinematicsFor40MotionType() {
     }
 }
 
+// The parallel analyze() must produce the same table as the serial one.
+void testParallelAnalyze() {
+    Model model("testSimulationUtilities_leg6dof9musc_20303.osim");
+    SimTK::State state = model.initSystem();
+
+    // Sweep the hip and knee through a range of motion.
+    const int numRows = 50;
+    StatesTrajectory states;
+    for (int i = 0; i < numRows; ++i) {
+        const double phase = 2 * SimTK::Pi * i / numRows;
+        state.setTime(0.01 * i);
+        model.getCoordinateSet().get("hip_flexion_r").setValue(
+                state, 0.5 * sin(phase), false);
+        model.getCoordinateSet().get("knee_angle_r").setValue(
+                state, -0.6 - 0.5 * sin(phase), false);
+        model.getCoordinateSet().get("knee_angle_r").setSpeedValue(
+                state, -cos(phase));
+        states.append(state);
+    }
+    const TimeSeriesTable statesTable = states.exportToTable(model);
+
+    const auto controlNames = createControlNamesFromModel(model);
+    SimTK::Matrix controlsMatrix(numRows, (int)controlNames.size(), 0.3);
+    const TimeSeriesTable controlsTable(statesTable.getIndependentColumn(),
+            controlsMatrix, controlNames);
+
+    const std::vector<std::string> outputPaths{
+            ".*length", ".*tendon_force"};
+    const auto serial = analyze<double>(
+            model, statesTable, controlsTable, outputPaths);
+    SimTK_TEST(serial.getNumRows() == numRows);
+    SimTK_TEST(serial.getNumColumns() > 0);
+
+    for (int numThreads : {2, 3, 0}) {
+        const auto parallel = analyze<double>(model, statesTable,
+                controlsTable, outputPaths, numThreads);
+        SimTK_TEST(parallel.getColumnLabels() == serial.getColumnLabels());
+        SimTK_TEST(parallel.getIndependentColumn() ==
+                   serial.getIndependentColumn());
+        const auto& a = serial.getMatrix();
+        const auto& b = parallel.getMatrix();
+        SimTK_TEST(a.nrow() == b.nrow() && a.ncol() == b.ncol());
+        for (int i = 0; i < a.nrow(); ++i) {
+            for (int j = 0; j < a.ncol(); ++j) {
+                SimTK_TEST(a(i, j) == b(i, j));
+            }
+        }
+    }
+}
 
+void testEnsembleSimulator() {
+    using SimTK::Vec3;
 
+    // A ball hanging from a spring, whose stiffness and initial height vary
+    // across the ensemble.
+    Model model;
+    auto ball = new Body("ball", 1., Vec3(0), SimTK::Inertia::sphere(1.));
+    model.addBody(ball);
+    auto freeJoint = new FreeJoint("freeJoint", model.getGround(), *ball);
+    model.addJoint(freeJoint);
+    auto spring = new PointToPointSpring(
+            model.getGround(), Vec3(0), *ball, Vec3(0), 10.0, 0.5);
+    spring->setName("spring");
+    model.addForce(spring);
+    SimTK::State state = model.initSystem();
+    const std::string height =
+            freeJoint->getCoordinate(FreeJoint::Coord::TranslationY)
+                    .getAbsolutePathString() + "/value";
+
+    const int numMembers = 7;
+    const double finalTime = 1.0;
+    TimeSeriesTable perturbations;
+    perturbations.setColumnLabels({"/forceset/spring|stiffness", height});
+    for (int i = 0; i < numMembers; ++i) {
+        const double row[] = {10.0 + 5 * i, -1.0 - 0.1 * i};
+        perturbations.appendRow(i, SimTK::RowVector(2, row));
+    }
 
+    EnsembleSimulator ensemble(model, state);
+    for (int numThreads : {1, 3}) {
+        ensemble.setNumThreads(numThreads);
+        const auto statesTables = ensemble.simulate(perturbations, finalTime);
+        SimTK_TEST((int)statesTables.size() == numMembers);
+
+        for (int i = 0; i < numMembers; ++i) {
+            // Simulate the same member on its own.
+            Model member(model);
+            member.updComponent<PointToPointSpring>("/forceset/spring")
+                    .setStiffness(10.0 + 5 * i);
+            SimTK::State& s = member.initSystem();
+            member.setStateVariableValue(s, height, -1.0 - 0.1 * i);
+            const SimTK::State finalState = simulate(member, s, finalTime);
+
+            const auto& table = statesTables[i];
+            SimTK_TEST_EQ(table.getIndependentColumn().back(), finalTime);
+            const auto lastRow = table.getRowAtIndex(table.getNumRows() - 1);
+            const auto& labels = table.getColumnLabels();
+            for (int j = 0; j < (int)labels.size(); ++j) {
+                SimTK_TEST_EQ_TOL(lastRow[j],
+                        member.getStateVariableValue(finalState, labels[j]), 1e-10);
+            }
+        }
+    }
 
+    TimeSeriesTable invalid;
+    invalid.setColumnLabels({"/forceset/spring|not_a_property"});
+    invalid.appendRow(0, SimTK::RowVector(1, 0.0));
+    SimTK_TEST_MUST_THROW(ensemble.simulate(invalid, finalTime));
+}
 
+void testComponentProfiler() {
+    using SimTK::Vec3;
 
-
-
-
-
-
-
-
-
-
-
-
-
-
+    Model model;
+    auto ball = new Body("ball", 1., Vec3(0), SimTK::Inertia::sphere(1.));
+    model.addBody(ball);
+    model.addJoint(new FreeJoint("freeJoint", model.getGround(), *ball));
+    auto spring = new PointToPointSpring(
+            model.getGround(), Vec3(0), *ball, Vec3(0), 10.0, 0.5);
+    spring->setName("spring");
+    model.addForce(spring);
+    SimTK::State& state = model.initSystem();
+
+    // Nothing is recorded for components that are not being profiled.
+    SimTK_TEST(ComponentProfiler::getRecord(*spring) == nullptr);
+
+    ComponentProfiler profiler(model);
+    SimTK_TEST(ComponentProfiler::getRecord(*spring) != nullptr);
+    // A component can only be profiled by one profiler at a time.
+    SimTK_TEST_MUST_THROW(ComponentProfiler another(model));
+
+    simulate(model, state, 0.5);
+    profiler.stop();
+    SimTK_TEST(ComponentProfiler::getRecord(*spring) == nullptr);
+
+    const auto table = profiler.getTable();
+    const auto names = ComponentProfiler::getStatisticNames();
+    SimTK_TEST(table.getNumRows() == names.size());
+    const auto& labels = table.getColumnLabels();
+    SimTK_TEST(std::find(labels.begin(), labels.end(), "/") != labels.end());
+    const auto computeForce = std::find(names.begin(), names.end(),
+            "compute_force_calls") - names.begin();
+    const auto& springCalls =
+            table.getDependentColumn("/forceset/spring")[(int)computeForce];
+    SimTK_TEST(springCalls > 0);
+
+    // Profiling has stopped, so simulating does not change the statistics.
+    simulate(model, state, 1.0);
+    SimTK_TEST_EQ(profiler.getTable().getDependentColumn("/forceset/spring")
+                          [(int)computeForce], springCalls);
+
+    const std::string json = profiler.getFlameGraphJSON();
+    SimTK_TEST(json.find("{\"name\"") == 0);
+    SimTK_TEST(json.find("\"spring\"") != std::string::npos);
+
+    profiler.reset();
+    SimTK_TEST_EQ(profiler.getTable().getDependentColumn("/forceset/spring")
+                          [(int)computeForce], 0.0);
+}
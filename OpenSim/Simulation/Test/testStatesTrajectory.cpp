@@ -24,6 +24,7 @@
 #include <OpenSim/Simulation/osimSimulation.h>
 #include <OpenSim/Common/Constant.h>
 #include <OpenSim/Common/LoadOpenSimLibrary.h>
+#include <algorithm>
 #include <random>
 #include <cstdio>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
@@ -770,6 +771,95 @@ void testExport() {
             OpenSim::Exception);
 }
 
+void testCompactStatesTrajectory() {
+    Model gait("gait2354_simbody.osim");
+    gait.initSystem();
+
+    // The compact trajectory reconstitutes the same states.
+    const TimeSeriesTable table(statesStoFname);
+    const auto states = StatesTrajectory::createFromStatesTable(gait, table);
+    const auto compact =
+            CompactStatesTrajectory::createFromStatesTable(gait, table);
+    SimTK_TEST(compact.getSize() == states.getSize());
+    SimTK_TEST(compact.getNumY() == states[0].getNY());
+    size_t itime = 0;
+    for (const auto& state : compact) {
+        SimTK_TEST(state.getTime() == states[itime].getTime());
+        SimTK_TEST_EQ(state.getY(), states[itime].getY());
+        SimTK_TEST_EQ(compact.getY(itime), states[itime].getY());
+        ++itime;
+    }
+    SimTK_TEST(itime == states.getSize());
+    SimTK_TEST(compact.back().getTime() == states.back().getTime());
+    SimTK_TEST_MUST_THROW_EXC(compact.getState(compact.getSize()),
+            IndexOutOfRange);
+
+    // The states can be used with the model.
+    gait.realizePosition(compact[1]);
+    gait.realizePosition(states[1]);
+    SimTK_TEST_EQ(gait.calcMassCenterPosition(compact[1]),
+            gait.calcMassCenterPosition(states[1]));
+
+    // Exported data matches the data in the trajectory.
+    const auto tableAll = compact.exportToTable(gait);
+    tableAndTrajectoryMatch(gait, tableAll, states);
+
+    // Converting back to a StatesTrajectory.
+    const auto statesCopy = compact.createStatesTrajectory();
+    SimTK_TEST(statesCopy.getSize() == states.getSize());
+    SimTK_TEST_EQ(statesCopy.back().getY(), states.back().getY());
+
+    // Discrete variables are stored.
+    {
+        Model arm26("arm26.osim");
+        SimTK::State state = arm26.initSystem();
+        const ScalarActuator& actu = arm26.getMuscles().get(0);
+        CompactStatesTrajectory trajectory(arm26);
+        const auto& names = trajectory.getDiscreteVariableNames();
+        SimTK_TEST(std::find(names.begin(), names.end(),
+                           actu.getAbsolutePathString() +
+                                   "/override_actuation") != names.end());
+        for (int i = 0; i < 3; ++i) {
+            state.setTime(0.1 * i);
+            actu.setOverrideActuation(state, 10.0 * i);
+            trajectory.append(state);
+        }
+        SimTK_TEST(actu.getOverrideActuation(trajectory[0]) == 0);
+        SimTK_TEST(actu.getOverrideActuation(trajectory[2]) == 20.0);
+        SimTK_TEST(actu.getOverrideActuation(trajectory[1]) == 10.0);
+
+        // Appending states out of order or from another model throws.
+        state.setTime(0.1);
+        SimTK_TEST_MUST_THROW(trajectory.append(state));
+        SimTK_TEST_MUST_THROW_EXC(trajectory.append(gait.getWorkingState()),
+                StatesTrajectory::InconsistentState);
+    }
+
+    // The StatesTrajectoryReporter can store the states compactly.
+    {
+        Model model("arm26.osim");
+        auto* reporter = new StatesTrajectoryReporter();
+        reporter->setName("reporter");
+        reporter->set_compact(true);
+        reporter->set_report_time_interval(0.01);
+        model.addComponent(reporter);
+        SimTK::State& state = model.initSystem();
+        Manager manager(model);
+        manager.initialize(state);
+        manager.integrate(0.05);
+
+        const auto& reported = reporter->getCompactStates();
+        SimTK_TEST(reported.getSize() == 6);
+        for (size_t i = 0; i < reported.getSize(); ++i) {
+            ASSERT_EQUAL(reported.getTime(i), 0.01 * i, 1e-5);
+        }
+        SimTK_TEST_EQ(reported.back().getY(), manager.getState().getY());
+        SimTK_TEST_MUST_THROW_EXC(reporter->getStates(), OpenSim::Exception);
+        reporter->clear();
+        SimTK_TEST(reporter->getCompactStates().getSize() == 0);
+    }
+}
+
 int main() {
     SimTK_START_TEST("testStatesTrajectory");
         // actuators library is not loaded automatically (unless using clang).
@@ -803,5 +893,7 @@ int main() {
         // Export to data table.
         SimTK_SUBTEST(testExport);
 
+        SimTK_SUBTEST(testCompactStatesTrajectory);
+
     SimTK_END_TEST();
 }
@@ -63,7 +63,8 @@ PathWrap::~PathWrap()
  */
 void PathWrap::setNull()
 {
-    resetPreviousWrap();
+    _wrapObject = nullptr;
+    _path = nullptr;
 }
 
 //_____________________________________________________________________________
@@ -118,6 +119,23 @@ void PathWrap::extendConnectToModel(Model& model)
     }
 }
 
+void PathWrap::extendAddToSystem(SimTK::MultibodySystem& system) const
+{
+    Super::extendAddToSystem(system);
+
+    // The previous wrap is kept across changes to the State so that it can
+    // serve as the starting point for the next wrap; it is therefore only
+    // read and written through updCacheVariableValue().
+    WrapResult reset;
+    reset.startPoint = -1;
+    reset.endPoint = -1;
+    reset.wrap_path_length = 0.0;
+    reset.r1 = reset.r2 = reset.sv =
+        SimTK::Vec3(-std::numeric_limits<SimTK::Real>::infinity());
+    this->_previousWrapCV = addCacheVariable("previous_wrap", reset,
+            SimTK::Stage::Position);
+}
+
 void PathWrap::setStartPoint( const SimTK::State& s, int aIndex)
 {
     if ((aIndex != get_range(0)) && 
@@ -136,25 +154,41 @@ void PathWrap::setEndPoint( const SimTK::State& s, int aIndex)
     }
 }
 
-void PathWrap::resetPreviousWrap()
+const WrapResult& PathWrap::getPreviousWrap(const SimTK::State& s) const
+{
+    return updCacheVariableValue(s, _previousWrapCV);
+}
+
+void PathWrap::resetPreviousWrap(const SimTK::State& s) const
 {
-    _previousWrap.startPoint = -1;
-    _previousWrap.endPoint = -1;
+    WrapResult& previousWrap = updCacheVariableValue(s, _previousWrapCV);
+    previousWrap.startPoint = -1;
+    previousWrap.endPoint = -1;
 
-    _previousWrap.wrap_pts.setSize(0);
-    _previousWrap.wrap_path_length = 0.0;
+    previousWrap.wrap_path_length = 0.0;
 
     int i;
     for (i = 0; i < 3; i++) {
-        _previousWrap.r1[i] = -std::numeric_limits<SimTK::Real>::infinity();
-        _previousWrap.r2[i] = -std::numeric_limits<SimTK::Real>::infinity();
-        _previousWrap.sv[i] = -std::numeric_limits<SimTK::Real>::infinity();
+        previousWrap.r1[i] = -std::numeric_limits<SimTK::Real>::infinity();
+        previousWrap.r2[i] = -std::numeric_limits<SimTK::Real>::infinity();
+        previousWrap.sv[i] = -std::numeric_limits<SimTK::Real>::infinity();
     }
 }
 
-void PathWrap::setPreviousWrap(const WrapResult& aWrapResult)
+void PathWrap::setPreviousWrap(const SimTK::State& s,
+        const WrapResult& aWrapResult) const
 {
-    _previousWrap = aWrapResult;
+    // Copy member-wise rather than with WrapResult::operator=() so that the
+    // wrap points, which are not needed for warm starting, are not copied
+    // (and no memory is allocated). As with operator=(), factor is not copied.
+    WrapResult& previousWrap = updCacheVariableValue(s, _previousWrapCV);
+    previousWrap.startPoint = aWrapResult.startPoint;
+    previousWrap.endPoint = aWrapResult.endPoint;
+    previousWrap.wrap_path_length = aWrapResult.wrap_path_length;
+    previousWrap.r1 = aWrapResult.r1;
+    previousWrap.r2 = aWrapResult.r2;
+    previousWrap.c1 = aWrapResult.c1;
+    previousWrap.sv = aWrapResult.sv;
 }
 
 void PathWrap::setWrapObject(WrapObject& aWrapObject)
@@ -112,13 +112,19 @@ public:
     void setMethod(WrapMethod aMethod);
     const std::string& getMethodName() const { return get_method(); }
 
-    const WrapResult& getPreviousWrap() const { return _previousWrap; }
-    void setPreviousWrap(const WrapResult& aWrapResult);
-    void resetPreviousWrap();
+    /** The result of the last successful wrap over this PathWrap's wrap
+    object, used as the starting point for the next wrap. It is stored in the
+    State so that paths can be evaluated concurrently with different States.
+    The wrap points (wrap_pts) of the result are not retained. */
+    const WrapResult& getPreviousWrap(const SimTK::State& s) const;
+    void setPreviousWrap(const SimTK::State& s,
+            const WrapResult& aWrapResult) const;
+    void resetPreviousWrap(const SimTK::State& s) const;
 
 private:
     void constructProperties();
     void extendConnectToModel(Model& model) override;
+    void extendAddToSystem(SimTK::MultibodySystem& system) const override;
     void setNull();
 
 private:
@@ -127,7 +133,9 @@ private:
     const WrapObject* _wrapObject;
     const GeometryPath* _path;
 
-    WrapResult _previousWrap;  // results from previous wrapping
+    // results from previous wrapping; persists in the State across
+    // realizations and is never marked valid
+    mutable CacheVariable<WrapResult> _previousWrapCV;
 
     MemberSubcomponentIndex _wrapPoint1Ix{
         constructSubcomponent<PathWrapPoint>("pwpt1") };
@@ -0,0 +1,97 @@
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  PathWrapPoint.cpp                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2020 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+//=============================================================================
+// INCLUDES
+//=============================================================================
+#include "PathWrapPoint.h"
+
+//=============================================================================
+// STATICS
+//=============================================================================
+using namespace std;
+using namespace OpenSim;
+
+void PathWrapPoint::extendAddToSystem(SimTK::MultibodySystem& system) const
+{
+    Super::extendAddToSystem(system);
+
+    this->_wrapLocationCV = addCacheVariable("wrap_location",
+            SimTK::Vec3(0), SimTK::Stage::Position);
+    this->_wrapPathCV = addCacheVariable("wrap_path", Array<SimTK::Vec3>{},
+            SimTK::Stage::Position);
+    this->_wrapLengthCV = addCacheVariable("wrap_length", 0.0,
+            SimTK::Stage::Position);
+}
+
+SimTK::Vec3 PathWrapPoint::getLocation(const SimTK::State& s) const
+{
+    return updCacheVariableValue(s, _wrapLocationCV);
+}
+
+void PathWrapPoint::setLocation(const SimTK::State& s,
+        const SimTK::Vec3& location) const
+{
+    updCacheVariableValue(s, _wrapLocationCV) = location;
+    // The kinematics of this point in Ground (see Point) were computed from
+    // its previous location.
+    markCacheVariableInvalid(s, "location");
+    markCacheVariableInvalid(s, "velocity");
+    markCacheVariableInvalid(s, "acceleration");
+}
+
+const Array<SimTK::Vec3>& PathWrapPoint::getWrapPath(
+        const SimTK::State& s) const
+{
+    return updCacheVariableValue(s, _wrapPathCV);
+}
+
+Array<SimTK::Vec3>& PathWrapPoint::updWrapPath(const SimTK::State& s) const
+{
+    return updCacheVariableValue(s, _wrapPathCV);
+}
+
+double PathWrapPoint::getWrapLength(const SimTK::State& s) const
+{
+    return updCacheVariableValue(s, _wrapLengthCV);
+}
+
+void PathWrapPoint::setWrapLength(const SimTK::State& s, double aLength) const
+{
+    updCacheVariableValue(s, _wrapLengthCV) = aLength;
+}
+
+SimTK::Vec3 PathWrapPoint::calcLocationInGround(const SimTK::State& s) const
+{
+    return getParentFrame().findStationLocationInGround(s, getLocation(s));
+}
+
+SimTK::Vec3 PathWrapPoint::calcVelocityInGround(const SimTK::State& s) const
+{
+    return getParentFrame().findStationVelocityInGround(s, getLocation(s));
+}
+
+SimTK::Vec3 PathWrapPoint::calcAccelerationInGround(
+        const SimTK::State& s) const
+{
+    return getParentFrame().findStationAccelerationInGround(s, getLocation(s));
+}
@@ -34,7 +34,10 @@ class WrapObject;
 //=============================================================================
 /**
  * A class implementing a path wrapping point, which is a path point that
- * is produced by a PathWrap.
+ * is produced by a PathWrap. The location of the point, and the points and
+ * length of the path over the wrap object, depend on the State and are
+ * stored in it, so that a path can be wrapped concurrently with different
+ * States.
  *
  * @author Peter Loan
  * @version 1.0
@@ -51,20 +54,43 @@ public:
     PathWrapPoint() {}
     virtual ~PathWrapPoint() {}
 
-    Array<SimTK::Vec3>& getWrapPath() { return _wrapPath; }
-    double getWrapLength() const { return _wrapPathLength; }
-    void setWrapLength(double aLength) { _wrapPathLength = aLength; }
+    /** The location of the point in its parent (the wrap object's) frame, as
+    computed by the most recent wrapping of the path with this State. */
+    SimTK::Vec3 getLocation(const SimTK::State& s) const override;
+    void setLocation(const SimTK::State& s, const SimTK::Vec3& location) const;
+
+    /** Points defining the path on the surface of the wrap object, expressed
+    in the wrap object's frame. */
+    const Array<SimTK::Vec3>& getWrapPath(const SimTK::State& s) const;
+    Array<SimTK::Vec3>& updWrapPath(const SimTK::State& s) const;
+    /** Length of the path over the surface of the wrap object. */
+    double getWrapLength(const SimTK::State& s) const;
+    void setWrapLength(const SimTK::State& s, double aLength) const;
+
     const WrapObject* getWrapObject() const override { return _wrapObject.get(); }
     void setWrapObject(const WrapObject* wrapObject) { _wrapObject.reset(wrapObject); }
 
+protected:
+    void extendAddToSystem(SimTK::MultibodySystem& system) const override;
+
+private:
+    SimTK::Vec3 calcLocationInGround(const SimTK::State& s) const override;
+    SimTK::Vec3 calcVelocityInGround(const SimTK::State& s) const override;
+    SimTK::Vec3 calcAccelerationInGround(
+            const SimTK::State& s) const override;
+
 //=============================================================================
 // DATA
 //=============================================================================
 private:
+    // The following are computed by GeometryPath::applyWrapObjects() and
+    // persist in the State across realizations, so they are never marked
+    // valid and are accessed only with updCacheVariableValue().
+    mutable CacheVariable<SimTK::Vec3> _wrapLocationCV;
     // points defining muscle path on surface of wrap object
-    Array<SimTK::Vec3> _wrapPath{};
-    // length of _wrapPath TODO this should be a cache variable!
-    double _wrapPathLength{ 0.0 };
+    mutable CacheVariable<Array<SimTK::Vec3>> _wrapPathCV;
+    // length of the path on the surface of the wrap object
+    mutable CacheVariable<double> _wrapLengthCV;
 
     // the wrap object this point is on
     SimTK::ReferencePtr<const WrapObject> _wrapObject; 
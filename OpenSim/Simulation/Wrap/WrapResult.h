@@ -74,6 +74,14 @@ public:
     WrapResult(const WrapResult& other);
     WrapResult& operator=(const WrapResult& aWrapResult);
 
+    /** Required to store a WrapResult in a cache variable. */
+    friend std::ostream& operator<<(std::ostream& o, const WrapResult& wr) {
+        o << "WrapResult(" << wr.startPoint << ", " << wr.endPoint
+          << ", length=" << wr.wrap_path_length << ", r1=" << wr.r1
+          << ", r2=" << wr.r2 << ")";
+        return o;
+    }
+
 private:
     void copyData(const WrapResult& aWrapResult);
 
@@ -27,6 +27,7 @@
 #include "Model/Bhargava2004MuscleMetabolicsProbe.h"
 #include "Model/Model.h"
 #include "Model/ModelVisualizer.h"
+#include "Model/ModelSnapshot.h"
 #include "Model/ForceSet.h"
 #include "Model/BodyScale.h"
 #include "Model/BodyScaleSet.h"
@@ -114,6 +115,7 @@
 
 #include "AssemblySolver.h"
 #include "CoordinateReference.h"
+#include "DifferentiableExpression.h"
 #include "InverseDynamicsSolver.h"
 #include "InverseKinematicsSolver.h"
 #include "MarkersReference.h"
@@ -122,11 +124,13 @@
 #include "Reference.h"
 #include "Solver.h"
 #include "StatesTrajectory.h"
+#include "CompactStatesTrajectory.h"
 #include "StatesTrajectoryReporter.h"
 #include "TableProcessor.h"
 #include "OpenSense/OpenSenseUtilities.h"
 
 #include "SimulationUtilities.h"
+#include "EnsembleSimulator.h"
 
 #include "RegisterTypes_osimSimulation.h"   // to expose RegisterTypes_osimSimulation
 
@@ -47,6 +47,7 @@ public:
 };
 
 void testWrapCylinder();
+void testConcurrentWrapping(const string& modelFile);
 void testWrapObjectUpdateFromXMLNode30515();
 void simulate(Model& osimModel, State& si, double initialTime, double finalTime);
 void simulateModelWithMusclesNoViz(const string &modelFile, double finalTime, double activation=0.5);
@@ -67,6 +68,13 @@ int main()
         std::cout << "Exception: " << e.what() << std::endl;
         failures.push_back("TestShoulderModel (multiple wrap)"); }
 
+    try {
+        testConcurrentWrapping("TestShoulderWrapping.osim");
+    } catch (const std::exception& e) {
+        std::cout << "Exception: " << e.what() << std::endl;
+        failures.push_back("testConcurrentWrapping");
+    }
+
     try{
         testWrapObjectUpdateFromXMLNode30515();
     } catch (const std::exception& e) {
@@ -403,6 +411,59 @@ void testWrapCylinder()
 }
 
 
+// The wrapping of a path depends only on the State, so the path lengths of a
+// model must be the same whether the poses are evaluated serially with one
+// State or concurrently with one State per thread.
+void testConcurrentWrapping(const string& modelFile)
+{
+    Model model(modelFile);
+    const State& defaultState = model.initSystem();
+
+    // Sweep every coordinate through a fraction of its range.
+    const int numPoses = 20;
+    const auto& coords = model.getCoordinateSet();
+    auto setPose = [&](State& s, int pose) {
+        for (int ic = 0; ic < coords.getSize(); ++ic) {
+            const Coordinate& c = coords[ic];
+            if (c.getLocked(s) || c.isPrescribed(s)) continue;
+            const double mid = 0.5*(c.getRangeMin() + c.getRangeMax());
+            const double amp = 0.25*(c.getRangeMax() - c.getRangeMin());
+            c.setValue(s, mid + amp*std::sin(0.3*pose + ic), false);
+        }
+        model.realizePosition(s);
+    };
+
+    std::vector<const GeometryPath*> paths;
+    for (const auto& path : model.getComponentList<GeometryPath>())
+        paths.push_back(&path);
+    const int numPaths = (int)paths.size();
+
+    // Each thread sweeps a contiguous block of poses with its own State. The
+    // serial sweep visits the same blocks, each starting from the default
+    // State, so that the wrapping is warm started identically.
+    const int numThreads = 4;
+    const int posesPerThread = numPoses/numThreads;
+    auto sweep = [&](int t, std::vector<double>& lengths) {
+        State s = defaultState;
+        for (int p = t*posesPerThread; p < (t+1)*posesPerThread; ++p) {
+            setPose(s, p);
+            for (int k = 0; k < numPaths; ++k)
+                lengths[p*numPaths + k] = paths[k]->getLength(s);
+        }
+    };
+
+    std::vector<double> expected(numPoses*numPaths, SimTK::NaN);
+    for (int t = 0; t < numThreads; ++t)
+        sweep(t, expected);
+
+    std::vector<double> actual(numPoses*numPaths, SimTK::NaN);
+    parallelFor(numThreads, numThreads,
+            [&](int t, int) { sweep(t, actual); });
+
+    for (int i = 0; i < numPoses*numPaths; ++i)
+        ASSERT_EQUAL<double>(expected[i], actual[i], SimTK::Eps);
+}
+
 void simulateModelWithMusclesNoViz(const string &modelFile, double finalTime, double activation)
 {
     // Create a new OpenSim model
@@ -626,7 +687,7 @@ void simulateModelWithCables(const string &modelFile, double finalTime)
             }
             else { // next two path points should be a wrap point
                 for (int k = 0; k < wrapSet.getSize(); ++k) {
-                    const Vec3& wrapStartPointLoc = wrapSet[k].getPreviousWrap().r1;
+                    const Vec3& wrapStartPointLoc = wrapSet[k].getPreviousWrap(si).r1;
                     if (!wrapStartPointLoc.isInf() && pp->getLocation(si).isNumericallyEqual(wrapStartPointLoc)) {
                         ObstacleInfo* obs = wrapObs[k];
                         obs->isActive = true;
@@ -676,7 +737,7 @@ void simulateModelWithCables(const string &modelFile, double finalTime)
 //            cout << "wrap object " << j << " name = " << wrapSet[j].getName() << endl;
 //            cout << "wrap point 0 = " << wrapSet[j].getWrapPoint(0).getLocation() << endl;
 //            cout << "wrap point 1 = " << wrapSet[j].getWrapPoint(1).getLocation() << endl;
-//            const WrapResult& wr = wrapSet[j].getPreviousWrap();
+//            const WrapResult& wr = wrapSet[j].getPreviousWrap(si);
 //            cout << "wrap result r1 = " << wr.r1 << endl;
 //            cout << "wrap result r2 = " << wr.r2 << endl;
 //            cout << "wrap result startpt = " << wr.startPoint << endl;
@@ -21,6 +21,7 @@
  * -------------------------------------------------------------------------- */
 #include <OpenSim/Common/XMLDocument.h>
 #include "AnalyzeTool.h"
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/IO.h>
 #include <OpenSim/Common/GCVSplineSet.h>
 
@@ -35,6 +36,9 @@
 #include <OpenSim/Simulation/Model/PrescribedForce.h>
 #include <OpenSim/Actuators/Thelen2003Muscle.h>
 
+#include <algorithm>
+#include <memory>
+
 using namespace OpenSim;
 using namespace std;
 
@@ -59,6 +63,7 @@ AnalyzeTool::AnalyzeTool() :
     _coordinatesFileName(_coordinatesFileNameProp.getValueStr()),
     _speedsFileName(_speedsFileNameProp.getValueStr()),
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
+    _numThreads(_numThreadsProp.getValueInt()),
     _printResultFiles(true),
     _loadModelAndInput(false)
 {
@@ -79,6 +84,7 @@ AnalyzeTool::AnalyzeTool(const string &aFileName, bool aLoadModelAndInput) :
     _coordinatesFileName(_coordinatesFileNameProp.getValueStr()),
     _speedsFileName(_speedsFileNameProp.getValueStr()),
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
+    _numThreads(_numThreadsProp.getValueInt()),
     _printResultFiles(true),
     _loadModelAndInput(aLoadModelAndInput)
 {
@@ -111,6 +117,7 @@ AnalyzeTool::AnalyzeTool(Model& aModel) :
     _coordinatesFileName(_coordinatesFileNameProp.getValueStr()),
     _speedsFileName(_speedsFileNameProp.getValueStr()),
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
+    _numThreads(_numThreadsProp.getValueInt()),
     _printResultFiles(true),
     _loadModelAndInput(false)
 {
@@ -171,6 +178,7 @@ AnalyzeTool(const AnalyzeTool &aTool) :
     _coordinatesFileName(_coordinatesFileNameProp.getValueStr()),
     _speedsFileName(_speedsFileNameProp.getValueStr()),
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
+    _numThreads(_numThreadsProp.getValueInt()),
     _loadModelAndInput(false)
 {
     setNull();
@@ -191,6 +199,7 @@ setNull()
     _coordinatesFileName = "";
     _speedsFileName = "";
     _lowpassCutoffFrequency = -1.0;
+    _numThreads = 1;
 
     _statesStore = NULL;
 
@@ -236,6 +245,13 @@ void AnalyzeTool::setupProperties()
     _lowpassCutoffFrequencyProp.setName("lowpass_cutoff_frequency_for_coordinates");
     _propertySet.append( &_lowpassCutoffFrequencyProp );
 
+    comment = "Number of threads used to run the analyses (default: 1). Use 0 to use all available hardware threads. "
+                 "Only used if all analyses that are on are history-free (e.g., MuscleAnalysis, BodyKinematics, "
+                 "PointKinematics, JointReaction); the time range is then split among copies of the model and analyses.";
+    _numThreadsProp.setComment(comment);
+    _numThreadsProp.setName("num_threads");
+    _propertySet.append( &_numThreadsProp );
+
 }
 
 
@@ -259,6 +275,7 @@ operator=(const AnalyzeTool &aTool)
     _coordinatesFileName = aTool._coordinatesFileName;
     _speedsFileName = aTool._speedsFileName;
     _lowpassCutoffFrequency= aTool._lowpassCutoffFrequency;
+    _numThreads = aTool._numThreads;
     _statesStore = aTool._statesStore;
     _printResultFiles = aTool._printResultFiles;
     return(*this);
@@ -590,7 +607,7 @@ bool AnalyzeTool::run(bool plotting)
     //}
 
     log_info("Executing the analyses from {} to {}...", ti, tf);
-    run(s, *_model, iInitial, iFinal, *_statesStore, _solveForEquilibriumForAuxiliaryStates);
+    runInParallel(s, iInitial, iFinal);
     _model->getMultibodySystem().realize(s, SimTK::Stage::Position );
     } catch (const Exception& x) {
         x.print(cout);
@@ -613,7 +630,105 @@ bool AnalyzeTool::run(bool plotting)
 //=============================================================================
 // HELPER
 //=============================================================================
+/**
+ * Run the analyses, splitting the time range among threads if the tool uses
+ * more than one thread and all the analyses that are on are history-free
+ * with a step interval of 1. Otherwise, the analyses are run serially by
+ * run().
+ *
+ * The analyses of the model are begun at the initial time and ended at the
+ * final time. Each thread analyzes a contiguous block of the times in
+ * between with its own copy of the model and its analyses, and the results
+ * of the copies are appended, in time order, to the results of the analyses
+ * of the model before they are ended.
+ */
+void AnalyzeTool::runInParallel(SimTK::State& s, int iInitial, int iFinal)
+{
+    const int numThreads =
+            std::min(resolveNumThreads(_numThreads), iFinal - iInitial - 1);
+
+    AnalysisSet& analysisSet = _model->updAnalysisSet();
+    bool historyFree = true;
+    for(int i=0;i<analysisSet.getSize();i++) {
+        const Analysis& analysis = analysisSet.get(i);
+        if(!analysis.getOn()) continue;
+        if(!analysis.isHistoryFree()) {
+            if(numThreads > 1) {
+                log_info("Analysis '{}' is not history-free; running the "
+                         "analyses on 1 thread.", analysis.getName());
+            }
+            historyFree = false;
+        } else if(analysis.getStepInterval() != 1) {
+            if(numThreads > 1) {
+                log_info("Analysis '{}' has a step interval of {} instead "
+                         "of 1; running the analyses on 1 thread.",
+                        analysis.getName(), analysis.getStepInterval());
+            }
+            historyFree = false;
+        }
+    }
+    if(numThreads <= 1 || !historyFree) {
+        run(s, *_model, iInitial, iFinal, *_statesStore,
+                _solveForEquilibriumForAuxiliaryStates);
+        return;
+    }
+
+    // Begin the analyses of the model with the initial time.
+    run(s, *_model, iInitial, iInitial, *_statesStore,
+            _solveForEquilibriumForAuxiliaryStates, true, false);
+
+    // Copy the model (with its analyses) and the states for each thread.
+    // The copies are created and initialized serially.
+    std::vector<std::unique_ptr<Model>> models;
+    std::vector<SimTK::State*> states;
+    std::vector<Storage> statesStores(numThreads, *_statesStore);
+    for(int t=0;t<numThreads;t++) {
+        models.emplace_back(_model->clone());
+        Model& model = *models.back();
+        model.setUseVisualizer(false);
+        AnalysisSet& copies = model.updAnalysisSet();
+        for(int i=0;i<copies.getSize();i++) {
+            copies.get(i).setModel(model);
+        }
+        states.push_back(&model.initSystem());
+    }
+
+    // Thread t analyzes the times (iInitial, iFinal) in block t.
+    const int numTimes = iFinal - iInitial - 1;
+    parallelFor(numThreads, numThreads, [&](int t, int) {
+        const int first = iInitial + 1 + (numTimes*t)/numThreads;
+        const int last = iInitial + (numTimes*(t + 1))/numThreads;
+        run(*states[t], *models[t], first, last, statesStores[t],
+                _solveForEquilibriumForAuxiliaryStates);
+    });
+
+    // Combine the results in time order.
+    for(int t=0;t<numThreads;t++) {
+        AnalysisSet& copies = models[t]->updAnalysisSet();
+        for(int i=0;i<analysisSet.getSize();i++) {
+            Analysis& analysis = analysisSet.get(i);
+            if(!analysis.getOn()) continue;
+            analysis.appendResults(copies.get(analysis.getName()));
+        }
+    }
+
+    // End the analyses of the model with the final time.
+    run(s, *_model, iFinal, iFinal, *_statesStore,
+            _solveForEquilibriumForAuxiliaryStates, false, true);
+}
+
 void AnalyzeTool::run(SimTK::State& s, Model &aModel, int iInitial, int iFinal, const Storage &aStatesStore, bool aSolveForEquilibrium)
+{
+    run(s, aModel, iInitial, iFinal, aStatesStore, aSolveForEquilibrium,
+            true, true);
+}
+
+/**
+ * Run the analyses of aModel for the rows iInitial to iFinal of
+ * aStatesStore. The analyses are begun with row iInitial if aBegin is true,
+ * and ended with row iFinal if aEnd is true; the other rows are steps.
+ */
+void AnalyzeTool::run(SimTK::State& s, Model &aModel, int iInitial, int iFinal, const Storage &aStatesStore, bool aSolveForEquilibrium, bool aBegin, bool aEnd)
 {
     AnalysisSet& analysisSet = aModel.updAnalysisSet();
 
@@ -697,9 +812,9 @@ void AnalyzeTool::run(SimTK::State& s, Model &aModel, int iInitial, int iFinal,
         // Make sure model is at least ready to provide kinematics
         aModel.getMultibodySystem().realize(s, SimTK::Stage::Velocity);
 
-        if(i==iInitial) {
+        if(i==iInitial && aBegin) {
             analysisSet.begin(s);
-        } else if(i==iFinal) {
+        } else if(i==iFinal && aEnd) {
             analysisSet.end(s);
         // Step
         } else {
@@ -68,6 +68,9 @@ private:
     /** Low-pass cut-off frequency for filtering the coordinates (does not apply to states). */
     PropertyDbl _lowpassCutoffFrequencyProp;
     double &_lowpassCutoffFrequency;
+    /** Number of threads used to run history-free analyses. */
+    PropertyInt _numThreadsProp;
+    int &_numThreads;
 
     /** Storage for the model states. */
     Storage *_statesStore;
@@ -119,6 +122,13 @@ public:
     void setSpeedsFileName(const std::string &aFileName) { _speedsFileName = aFileName; }
     double getLowpassCutoffFrequency() const { return _lowpassCutoffFrequency; }
     void setLowpassCutoffFrequency(double aLowpassCutoffFrequency) { _lowpassCutoffFrequency = aLowpassCutoffFrequency; }
+    /** %Set the number of threads used to run the analyses. The default, 1,
+    runs the analyses serially; 0 uses all available hardware threads. More
+    than one thread is used only if every analysis that is on is history-free
+    (see Analysis::isHistoryFree()) and has a step interval of 1; the results
+    are then the same as with 1 thread. */
+    void setNumThreads(int numThreads) { _numThreads = numThreads; }
+    int getNumThreads() const { return _numThreads; }
     bool getLoadModelAndInput() const { return _loadModelAndInput; }
     void setLoadModelAndInput(bool b) { _loadModelAndInput = b; }
 
@@ -142,6 +152,11 @@ public:
 #ifndef SWIG
     static void run(SimTK::State& s, Model &aModel, int iInitial, int iFinal, const Storage &aStatesStore, bool aSolveForEquilibrium);
 #endif
+private:
+    void runInParallel(SimTK::State& s, int iInitial, int iFinal);
+    static void run(SimTK::State& s, Model &aModel, int iInitial, int iFinal,
+            const Storage &aStatesStore, bool aSolveForEquilibrium,
+            bool aBegin, bool aEnd);
 //=============================================================================
 };  // END of class AnalyzeTool
 
@@ -29,6 +29,8 @@
 
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/Manager/Manager.h>
+#include <OpenSim/Simulation/EnsembleSimulator.h>
+#include <OpenSim/Common/STOFileAdapter.h>
 #include <OpenSim/Simulation/SimbodyEngine/SimbodyEngine.h>
 #include "CorrectionController.h"
 
@@ -57,7 +59,9 @@ ForwardTool::~ForwardTool()
 ForwardTool::ForwardTool() :
     AbstractTool(),
     _statesFileName(_statesFileNameProp.getValueStr()),
-    _useSpecifiedDt(_useSpecifiedDtProp.getValueBool())
+    _useSpecifiedDt(_useSpecifiedDtProp.getValueBool()),
+    _ensembleFileName(_ensembleFileNameProp.getValueStr()),
+    _numThreads(_numThreadsProp.getValueInt())
 {
     setNull();
 }
@@ -73,7 +77,9 @@ ForwardTool::ForwardTool() :
 ForwardTool::ForwardTool(const string &aFileName,bool aUpdateFromXMLNode,bool aLoadModel) :
     AbstractTool(aFileName, false),
     _statesFileName(_statesFileNameProp.getValueStr()),
-    _useSpecifiedDt(_useSpecifiedDtProp.getValueBool())
+    _useSpecifiedDt(_useSpecifiedDtProp.getValueBool()),
+    _ensembleFileName(_ensembleFileNameProp.getValueStr()),
+    _numThreads(_numThreadsProp.getValueInt())
 {
     setNull();
 
@@ -126,7 +132,9 @@ ForwardTool::
 ForwardTool(const ForwardTool &aTool) :
     AbstractTool(aTool),
     _statesFileName(_statesFileNameProp.getValueStr()),
-    _useSpecifiedDt(_useSpecifiedDtProp.getValueBool())
+    _useSpecifiedDt(_useSpecifiedDtProp.getValueBool()),
+    _ensembleFileName(_ensembleFileNameProp.getValueStr()),
+    _numThreads(_numThreadsProp.getValueInt())
 {
     setNull();
     *this = aTool;
@@ -143,6 +151,8 @@ void ForwardTool::setNull()
     // BASIC
     _statesFileName = "";
     _useSpecifiedDt = false;
+    _ensembleFileName = "";
+    _numThreads = 0;
     _printResultFiles = true;
 
     _replaceForceSet = false;   // default should be false for Forward.
@@ -188,6 +198,22 @@ void ForwardTool::setupProperties()
     _useSpecifiedDtProp.setName("use_specified_dt");
     _propertySet.append( &_useSpecifiedDtProp );
 
+    comment = "Storage file (.sto) describing an ensemble of simulations to run instead of "
+                 "a single simulation. Each row describes one member of the ensemble. Columns "
+                 "labeled with the path of a state variable give the member's initial value of "
+                 "that state variable; columns labeled '<component path>|<property name>' give "
+                 "the member's value of that property. The states of each member are written to "
+                 "<name>_member<row>_states.sto in the results directory.";
+    _ensembleFileNameProp.setComment(comment);
+    _ensembleFileNameProp.setName("ensemble_file");
+    _propertySet.append( &_ensembleFileNameProp );
+
+    comment = "Number of threads used to simulate the members of the ensemble. "
+                 "0 (the default) uses all available hardware threads.";
+    _numThreadsProp.setComment(comment);
+    _numThreadsProp.setName("num_threads");
+    _propertySet.append( &_numThreadsProp );
+
 
 }
 
@@ -211,6 +237,8 @@ operator=(const ForwardTool &aTool)
     // BASIC INPUT
     _statesFileName = aTool._statesFileName;
     _useSpecifiedDt = aTool._useSpecifiedDt;
+    _ensembleFileName = aTool._ensembleFileName;
+    _numThreads = aTool._numThreads;
 
     return(*this);
 }
@@ -294,6 +322,14 @@ bool ForwardTool::run()
     }
 
 
+    if(_ensembleFileName!="") {
+        s.setTime(_ti);
+        bool completed = runEnsemble(s);
+        cwd.restore();
+        removeAnalysisSetFromModel();
+        return completed;
+    }
+
     bool completed = true;
 
     try {
@@ -355,6 +391,47 @@ void ForwardTool::printResultsInternal()
 
 
 
+//_____________________________________________________________________________
+/**
+ * Simulate each member of the ensemble in the ensemble file from the initial
+ * state s, and print the states of each member.
+ */
+bool ForwardTool::runEnsemble(const SimTK::State& s)
+{
+    if(_useSpecifiedDt) {
+        log_warn("Ignoring 'use_specified_dt' property when simulating the "
+                 "ensemble in '{}'.", _ensembleFileName);
+    }
+    TimeSeriesTable perturbations(_ensembleFileName);
+
+    EnsembleSimulator ensemble(*_model, s);
+    ensemble.setNumThreads(_numThreads);
+    ensemble.setEquilibrateMuscles(_solveForEquilibriumForAuxiliaryStates);
+    ensemble.setIntegratorInternalStepLimit(_maxSteps);
+    ensemble.setIntegratorMaximumStepSize(_maxDT);
+    ensemble.setIntegratorMinimumStepSize(_minDT);
+    ensemble.setIntegratorAccuracy(_errorTolerance);
+
+    log_info("Integrating {} members of the ensemble in '{}' from {} to {}.",
+            perturbations.getNumRows(), _ensembleFileName, _ti, _tf);
+    std::vector<TimeSeriesTable> statesTables;
+    try {
+        statesTables = ensemble.simulate(perturbations, _tf);
+    } catch(const std::exception& x) {
+        log_error("ForwardTool::run() caught an exception: \n {}", x.what());
+        return false;
+    }
+
+    if(_printResultFiles) {
+        IO::makeDir(getResultsDir());
+        for(int i=0; i<(int)statesTables.size(); ++i) {
+            STOFileAdapter::write(statesTables[i], getResultsDir() + "/" +
+                    getName() + "_member" + std::to_string(i) + "_states.sto");
+        }
+    }
+    return true;
+}
+
 //=============================================================================
 // UTILITY
 //=============================================================================
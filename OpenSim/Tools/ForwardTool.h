@@ -71,6 +71,16 @@ protected:
     OpenSim::PropertyBool _useSpecifiedDtProp;
     bool &_useSpecifiedDt;
 
+    /** Name of a storage file (.sto) describing an ensemble of variations of
+    the simulation, one per row (see EnsembleSimulator). If set, each member
+    of the ensemble is simulated instead of the model as is. */
+    PropertyStr _ensembleFileNameProp;
+    std::string &_ensembleFileName;
+
+    /** Number of threads used to simulate the members of the ensemble. */
+    PropertyInt _numThreadsProp;
+    int &_numThreads;
+
     /** Storage for the input states. */
     Storage *_yStore;
     /** Flag indicating whether or not to write to the results (GUI will set this to false). */
@@ -120,6 +130,15 @@ public:
     bool getUseSpecifiedDt() const { return _useSpecifiedDt; }
     void setUseSpecifiedDt(bool aUseSpecifiedDt) { _useSpecifiedDt = aUseSpecifiedDt; }
 
+    const std::string &getEnsembleFileName() const { return _ensembleFileName; }
+    void setEnsembleFileName(const std::string &aFileName) { _ensembleFileName = aFileName; }
+
+    /** %Set the number of threads used to simulate the members of the
+    ensemble, if an ensemble file is set. The default, 0, uses all available
+    hardware threads. */
+    void setNumThreads(int numThreads) { _numThreads = numThreads; }
+    int getNumThreads() const { return _numThreads; }
+
     void setPrintResultFiles(bool aToWrite) { _printResultFiles = aToWrite; }
 
     //--------------------------------------------------------------------------
@@ -131,6 +150,7 @@ public:
     void printResults();
 private:
     void printResultsInternal();
+    bool runEnsemble(const SimTK::State& s);
 public:
 
     //--------------------------------------------------------------------------
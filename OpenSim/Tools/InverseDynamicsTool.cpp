@@ -278,8 +278,9 @@ bool InverseDynamicsTool::run()
             if(_coordinateValues->isInDegrees()){
                 _model->getSimbodyEngine().convertDegreesToRadians(*_coordinateValues);
             }
-            // Create differentiable splines of the coordinate data
-            coordFunctions = new GCVSplineSet(5, _coordinateValues);
+            // Create differentiable splines of the coordinate data, fitting
+            // the splines for the coordinates concurrently.
+            coordFunctions = new GCVSplineSet(5, _coordinateValues, 0.0, 0);
 
             //Functions must correspond to model coordinates and their order for the solver
             for(int i=0; i<nq; i++){
@@ -30,6 +30,7 @@
 #include "IKTaskSet.h"
 
 #include <OpenSim/Analyses/Kinematics.h>
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/Constant.h>
 #include <OpenSim/Common/FunctionSet.h>
 #include <OpenSim/Common/GCVSplineSet.h>
@@ -40,10 +41,103 @@
 #include <OpenSim/Simulation/InverseKinematicsSolver.h>
 #include <OpenSim/Simulation/Model/Model.h>
 
+#include <algorithm>
+
 using namespace OpenSim;
 using namespace std;
 using namespace SimTK;
 
+namespace {
+
+// Solution of one frame, and the quantities reported for it.
+struct IKFrame {
+    SimTK::Vector q;
+    double totalSquaredMarkerError = 0;
+    double maxSquaredMarkerError = 0;
+    int worstMarker = -1;
+    SimTK::Array_<SimTK::Vec3> markerLocations;
+};
+
+void recordFrame(InverseKinematicsSolver& ikSolver,
+        const SimTK::State& s, bool reportErrors, bool reportLocations,
+        SimTK::Array_<double>& squaredMarkerErrors, IKFrame& frame) {
+    frame.q = s.getQ();
+    if (reportErrors) {
+        ikSolver.computeCurrentSquaredMarkerErrors(squaredMarkerErrors);
+        frame.totalSquaredMarkerError = 0.0;
+        frame.maxSquaredMarkerError = 0.0;
+        frame.worstMarker = -1;
+        for (int j = 0; j < (int)squaredMarkerErrors.size(); ++j) {
+            frame.totalSquaredMarkerError += squaredMarkerErrors[j];
+            if (squaredMarkerErrors[j] > frame.maxSquaredMarkerError) {
+                frame.maxSquaredMarkerError = squaredMarkerErrors[j];
+                frame.worstMarker = j;
+            }
+        }
+    }
+    if (reportLocations) {
+        frame.markerLocations.resize(squaredMarkerErrors.size());
+        ikSolver.computeCurrentMarkerLocations(frame.markerLocations);
+    }
+}
+
+// Solve frames startIx to finalIx in blocks of framesPerBlock frames, using
+// numThreads threads. Each block is solved with its own solver, and its first
+// frame is assembled starting from the default state of a copy of the model,
+// so the solution of a block does not depend on which thread solved it or on
+// the other blocks.
+std::vector<IKFrame> solveFrameBlocks(const Model& model,
+        const MarkersReference& markersReference,
+        const SimTK::Array_<CoordinateReference>& coordinateReferences,
+        double constraintWeight, double accuracy,
+        const std::vector<double>& times, int startIx, int finalIx,
+        int framesPerBlock, int numThreads, int numMarkers,
+        bool reportErrors, bool reportLocations) {
+    const int numFrames = finalIx - startIx + 1;
+    const int numBlocks = (numFrames + framesPerBlock - 1) / framesPerBlock;
+    numThreads = std::min(numThreads, numBlocks);
+
+    // Copy the model and the references for each thread. Copying and
+    // initializing models is done serially.
+    std::vector<std::unique_ptr<Model>> models;
+    std::vector<SimTK::State> defaultStates;
+    std::vector<MarkersReference> markersReferences;
+    std::vector<SimTK::Array_<CoordinateReference>> coordRefs;
+    for (int t = 0; t < numThreads; ++t) {
+        models.emplace_back(model.clone());
+        models.back()->setUseVisualizer(false);
+        // The copy does not need the analyses of the original model.
+        models.back()->updAnalysisSet().clearAndDestroy();
+        defaultStates.push_back(models.back()->initSystem());
+        markersReferences.push_back(markersReference);
+        coordRefs.push_back(coordinateReferences);
+    }
+
+    std::vector<IKFrame> frames(numFrames);
+    parallelFor(numBlocks, numThreads, [&](int b, int t) {
+        const int first = startIx + b * framesPerBlock;
+        const int last = std::min(first + framesPerBlock - 1, finalIx);
+        SimTK::Array_<CoordinateReference> blockCoordRefs(coordRefs[t]);
+        InverseKinematicsSolver ikSolver(*models[t],
+                std::make_shared<MarkersReference>(markersReferences[t]),
+                blockCoordRefs, constraintWeight);
+        ikSolver.setAccuracy(accuracy);
+        SimTK::Array_<double> squaredMarkerErrors(numMarkers, 0.0);
+        SimTK::State s = defaultStates[t];
+        s.updTime() = times[first];
+        ikSolver.assemble(s);
+        for (int i = first; i <= last; ++i) {
+            s.updTime() = times[i];
+            ikSolver.track(s);
+            recordFrame(ikSolver, s, reportErrors, reportLocations,
+                    squaredMarkerErrors, frames[i - startIx]);
+        }
+    });
+    return frames;
+}
+
+} // anonymous namespace
+
 //=============================================================================
 // CONSTRUCTOR(S) AND DESTRUCTOR
 //=============================================================================
@@ -86,6 +180,8 @@ void InverseKinematicsTool::constructProperties()
     constructProperty_marker_file("");
     constructProperty_coordinate_file("");
     constructProperty_report_marker_locations(false);
+    constructProperty_num_threads(1);
+    constructProperty_frames_per_block(0);
 }
 
 //=============================================================================
@@ -181,7 +277,6 @@ bool InverseKinematicsTool::run()
         // corresponding model marker for each reference.
         int nm = ikSolver.getNumMarkersInUse();
         SimTK::Array_<double> squaredMarkerErrors(nm, 0.0);
-        SimTK::Array_<Vec3> markerLocations(nm, Vec3(0));
         
         Storage *modelMarkerLocations = get_report_marker_locations() ?
             new Storage(Nframes, "ModelMarkerLocations") : nullptr;
@@ -190,26 +285,45 @@ bool InverseKinematicsTool::run()
 
         Stopwatch watch;
 
+        const int numThreads = resolveNumThreads(get_num_threads());
+        std::vector<IKFrame> frames;
+        if (numThreads > 1 || get_frames_per_block() > 0) {
+            const int framesPerBlock = get_frames_per_block() > 0 ?
+                get_frames_per_block() :
+                (Nframes + numThreads - 1) / numThreads;
+            log_info("Solving {} frames in blocks of {} frames using {} "
+                     "threads.", Nframes, framesPerBlock, numThreads);
+            frames = solveFrameBlocks(*_model, markersReference,
+                coordinateReferences, get_constraint_weight(), get_accuracy(),
+                times, start_ix, final_ix, framesPerBlock, numThreads, nm,
+                get_report_errors(), get_report_marker_locations());
+        }
+
+        IKFrame serialFrame;
         for (int i = start_ix; i <= final_ix; ++i) {
             s.updTime() = times[i];
-            ikSolver.track(s);
+            const IKFrame* frame = &serialFrame;
+            if (frames.empty()) {
+                ikSolver.track(s);
+                recordFrame(ikSolver, s, get_report_errors(),
+                    get_report_marker_locations(), squaredMarkerErrors,
+                    serialFrame);
+            } else {
+                // Pose the model with the solution of this frame so that the
+                // analyses below record it.
+                frame = &frames[i - start_ix];
+                s.updQ() = frame->q;
+                _model->getMultibodySystem().realize(s, Stage::Position);
+            }
             // show progress line every 1000 frames so users see progress
             if (std::remainder(i - start_ix, 1000) == 0 && i != start_ix)
                 log_info("Solved {} frame(s)...", i - start_ix);
             if(get_report_errors()){
                 Array<double> markerErrors(0.0, 3);
-                double totalSquaredMarkerError = 0.0;
-                double maxSquaredMarkerError = 0.0;
-                int worst = -1;
-
-                ikSolver.computeCurrentSquaredMarkerErrors(squaredMarkerErrors);
-                for(int j=0; j<nm; ++j){
-                    totalSquaredMarkerError += squaredMarkerErrors[j];
-                    if(squaredMarkerErrors[j] > maxSquaredMarkerError){
-                        maxSquaredMarkerError = squaredMarkerErrors[j];
-                        worst = j;
-                    }
-                }
+                const double totalSquaredMarkerError =
+                    frame->totalSquaredMarkerError;
+                const double maxSquaredMarkerError =
+                    frame->maxSquaredMarkerError;
 
                 double rms = nm > 0 ? sqrt(totalSquaredMarkerError / nm) : 0;
                 markerErrors.set(0, totalSquaredMarkerError); 
@@ -221,11 +335,11 @@ bool InverseKinematicsTool::run()
                          "marker error: RMS = {}, max = {} ({})", 
                     i, s.getTime(), totalSquaredMarkerError, rms,
                     sqrt(maxSquaredMarkerError), 
-                    ikSolver.getMarkerNameForIndex(worst));
+                    ikSolver.getMarkerNameForIndex(frame->worstMarker));
             }
 
             if(get_report_marker_locations()){
-                ikSolver.computeCurrentMarkerLocations(markerLocations);
+                const auto& markerLocations = frame->markerLocations;
                 Array<double> locations(0.0, 3*nm);
                 for(int j=0; j<nm; ++j){
                     for(int k=0; k<3; ++k)
@@ -71,6 +71,20 @@ public:
             "Flag indicating whether or not to report model marker locations. "
             "Note, model marker locations are expressed in Ground.");
 
+    OpenSim_DECLARE_PROPERTY(num_threads, int,
+            "Number of threads used to solve the frames (default: 1). Use 0 "
+            "to use all available hardware threads. With more than one "
+            "thread, the trial is split into blocks of frames that are "
+            "solved independently (see frames_per_block).");
+
+    OpenSim_DECLARE_PROPERTY(frames_per_block, int,
+            "Number of frames in each block. The first frame of each block is "
+            "assembled from the model's default pose rather than tracked from "
+            "the previous frame. For a given block size, the results do not "
+            "depend on the number of threads. Use 0 (default) to split the "
+            "trial evenly among the threads (with one thread, the trial is "
+            "solved as a single block).");
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -102,6 +116,14 @@ public:
 
     IKTaskSet& getIKTaskSet() { return upd_IKTaskSet(); }
 
+    void setNumThreads(int numThreads) { upd_num_threads() = numThreads; }
+    int getNumThreads() const { return get_num_threads(); }
+
+    void setFramesPerBlock(int framesPerBlock) {
+        upd_frames_per_block() = framesPerBlock;
+    }
+    int getFramesPerBlock() const { return get_frames_per_block(); }
+
     //--------------------------------------------------------------------------
     // INTERFACE
     //--------------------------------------------------------------------------